@@ -20,15 +20,21 @@
 #include "collection_id_cache_entry.hxx"
 #include "core/mcbp/big_endian.hxx"
 #include "core/mcbp/codec.hxx"
+#include "core/metrics/operation_recorders.hxx"
+#include "core/timeout_defaults.hxx"
+#include "core/utils/hedge_budget.hxx"
+#include "core/utils/latency_histogram.hxx"
 #include "couchbase/bucket.hxx"
 #include "dispatcher.hxx"
 #include "impl/bootstrap_state_listener.hxx"
+#include "io/collection_uid_cache.hxx"
 #include "mcbp/operation_queue.hxx"
 #include "mcbp/queue_request.hxx"
 #include "mcbp/queue_response.hxx"
 #include "origin.hxx"
 #include "ping_collector.hxx"
 #include "protocol/cmd_get_cluster_config.hxx"
+#include "protocol/cmd_get_collections_manifest.hxx"
 #include "retry_orchestrator.hxx"
 
 #include <couchbase/metrics/meter.hxx>
@@ -36,12 +42,21 @@
 
 #include <fmt/chrono.h>
 
+#include <algorithm>
+#include <functional>
 #include <mutex>
 #include <queue>
+#include <thread>
 #include <spdlog/fmt/bin_to_hex.h>
 
 namespace couchbase::core
 {
+namespace
+{
+// upper bound for the number of timer wheels of a single bucket
+constexpr std::size_t max_timer_wheels{ 16 };
+} // namespace
+
 class bucket_impl
   : public std::enable_shared_from_this<bucket_impl>
   , public config_listener
@@ -63,6 +78,7 @@ public:
     , origin_{ std::move(origin) }
     , tracer_{ std::move(tracer) }
     , meter_{ std::move(meter) }
+    , operation_recorders_{ meter_ }
     , known_features_{ std::move(known_features) }
     , state_listener_{ std::move(state_listener) }
     , codec_{ { known_features_.begin(), known_features_.end() } }
@@ -73,6 +89,7 @@ public:
                                origin_.options().config_poll_interval
                              ? origin_.options().config_poll_floor
                              : origin_.options().config_poll_interval }
+    , hedge_budget_{ origin_.options().max_hedged_read_ratio }
   {
   }
 
@@ -82,16 +99,7 @@ public:
                         retry_reason reason,
                         std::optional<key_value_error_map_info> error_info)
   {
-    // TODO: copy from mcbp_command, subject to refactor later
-    static std::string meter_name = "db.couchbase.operations";
-    static std::map<std::string, std::string> tags = {
-      { "db.couchbase.service", "kv" },
-      { "db.operation", fmt::format("{}", req->command_) },
-    };
-    meter_->get_value_recorder(meter_name, tags)
-      ->record_value(std::chrono::duration_cast<std::chrono::microseconds>(
-                       std::chrono::steady_clock::now() - req->dispatched_time_)
-                       .count());
+    operation_recorders_.record_latency(req->command_, req->dispatched_time_);
 
     if (ec == asio::error::operation_aborted) {
       // TODO: fix tracing
@@ -376,11 +384,7 @@ public:
         continue;
       }
       couchbase::core::origin origin(origin_.credentials(), hostname, port, origin_.options());
-      io::mcbp_session session =
-        origin_.options().enable_tls
-          ? io::mcbp_session(
-              client_id_, ctx_, tls_, origin, state_listener_, name_, known_features_)
-          : io::mcbp_session(client_id_, ctx_, origin, state_listener_, name_, known_features_);
+      io::mcbp_session session = create_session(origin);
       CB_LOG_DEBUG(R"({} rev={}, restart idx={}, session="{}", address="{}:{}")",
                    log_prefix_,
                    config_->rev_str(),
@@ -433,15 +437,91 @@ public:
     }
   }
 
+  auto create_session(const couchbase::core::origin& origin) -> io::mcbp_session
+  {
+    io::mcbp_session session =
+      origin_.options().enable_tls
+        ? io::mcbp_session(client_id_, ctx_, tls_, origin, state_listener_, name_, known_features_)
+        : io::mcbp_session(client_id_, ctx_, origin, state_listener_, name_, known_features_);
+    session.set_config_parse_recorders(operation_recorders_.config_parse_recorder(),
+                                       operation_recorders_.config_skip_recorder());
+    session.set_write_recorders(operation_recorders_.packets_per_write_recorder(),
+                                operation_recorders_.bytes_per_write_recorder());
+    session.set_collection_uid_cache(collection_uids_);
+    return session;
+  }
+
+  /**
+   * Resolves all collections of the bucket with single request, instead of resolving them one by
+   * one with get_collection_id on each session. When no session has completed bootstrap yet, the
+   * fetch waits in the deferred queue, which is drained once a session is ready.
+   */
+  void fetch_collections_manifest()
+  {
+    if (closed_) {
+      return;
+    }
+    if (bool expected_state{ false };
+        !manifest_fetch_in_progress_.compare_exchange_strong(expected_state, true)) {
+      return;
+    }
+    std::optional<io::mcbp_session> session{};
+    bool bootstrapped{ false };
+    {
+      std::scoped_lock lock(sessions_mutex_);
+      for (auto& [index, candidate] : sessions_) {
+        if (!candidate.is_bootstrapped()) {
+          continue;
+        }
+        bootstrapped = true;
+        if (candidate.supports_feature(protocol::hello_feature::collections)) {
+          session = candidate;
+          break;
+        }
+      }
+    }
+    if (!session) {
+      manifest_fetch_in_progress_ = false;
+      if (bootstrapped) {
+        // the cluster does not support collections
+        return;
+      }
+      defer_command([self = shared_from_this()]() {
+        self->fetch_collections_manifest();
+      });
+      return;
+    }
+    protocol::client_request<protocol::get_collections_manifest_request_body> req;
+    req.opaque(session->next_opaque());
+    session->write_and_subscribe(
+      req.opaque(),
+      req.data(),
+      [self = shared_from_this()](std::error_code ec,
+                                  retry_reason /* reason */,
+                                  io::mcbp_message&& msg,
+                                  std::optional<key_value_error_map_info> /* error_info */) {
+        self->manifest_fetch_in_progress_ = false;
+        if (ec) {
+          CB_LOG_DEBUG(
+            "{} unable to fetch collections manifest: {}", self->log_prefix_, ec.message());
+          return;
+        }
+        protocol::client_response<protocol::get_collections_manifest_response_body> resp(
+          std::move(msg));
+        self->collection_uids_->populate(resp.body().manifest());
+        CB_LOG_DEBUG("{} populated collection cache from manifest uid={:x}, {} collections",
+                     self->log_prefix_,
+                     resp.body().manifest().uid,
+                     self->collection_uids_->size());
+      });
+  }
+
   void bootstrap(utils::movable_function<void(std::error_code, topology::configuration)>&& handler)
   {
     if (state_listener_) {
       state_listener_->register_config_listener(shared_from_this());
     }
-    io::mcbp_session new_session =
-      origin_.options().enable_tls
-        ? io::mcbp_session(client_id_, ctx_, tls_, origin_, state_listener_, name_, known_features_)
-        : io::mcbp_session(client_id_, ctx_, origin_, state_listener_, name_, known_features_);
+    io::mcbp_session new_session = create_session(origin_);
     new_session.bootstrap([self = shared_from_this(), new_session, h = std::move(handler)](
                             std::error_code ec, topology::configuration cfg) mutable {
       if (ec) {
@@ -610,38 +690,10 @@ public:
     }
   }
 
-  /**
-   * copies nodes from rhs that are not in lhs to output vector
-   */
-  void diff_nodes(const std::vector<topology::configuration::node>& lhs,
-                  const std::vector<topology::configuration::node>& rhs,
-                  std::vector<topology::configuration::node>& output)
-  {
-    for (const auto& re : rhs) {
-      bool known = false;
-      const auto& rhost = re.hostname_for(origin_.options().network);
-      const auto rport = re.port_or(
-        origin_.options().network, service_type::key_value, origin_.options().enable_tls, 0);
-      for (const auto& le : lhs) {
-        const auto& lhost = le.hostname_for(origin_.options().network);
-        const auto lport = le.port_or(
-          origin_.options().network, service_type::key_value, origin_.options().enable_tls, 0);
-        if (rhost == lhost && rport == lport) {
-          known = true;
-          break;
-        }
-      }
-      if (!known) {
-        output.push_back(re);
-      }
-    }
-  }
-
   void update_config(topology::configuration config) override
   {
-    std::vector<topology::configuration::node> added{};
-    std::vector<topology::configuration::node> removed{};
-    bool sequence_changed = false;
+    std::shared_ptr<const topology::configuration> snapshot{};
+    std::shared_ptr<const topology::configuration_delta> delta{};
     {
       std::scoped_lock lock(config_mutex_);
       // MB-60405 fixes this for 7.6.2, but for earlier versions we need to protect against using a
@@ -684,40 +736,32 @@ public:
         return;
       }
 
-      if (config_) {
-        diff_nodes(config_->nodes, config.nodes, added);
-        diff_nodes(config.nodes, config_->nodes, removed);
-        if (added.empty() && removed.empty() && config.nodes.size() == config_->nodes.size()) {
-          for (std::size_t i = 0; i < config.nodes.size(); ++i) {
-            if (config.nodes[i] != config_->nodes[i]) {
-              sequence_changed = true;
-              break;
-            }
-          }
-        } else {
-          sequence_changed = true;
-        }
-      } else {
-        sequence_changed = true;
-        added = config.nodes;
-      }
+      delta = std::make_shared<const topology::configuration_delta>(
+        topology::make_configuration_delta(config_, config));
       config_.reset();
-      config_ = config;
+      config_ = std::move(config);
       configured_ = true;
+      // the listeners share one immutable snapshot instead of getting a copy each
+      snapshot = std::make_shared<const topology::configuration>(config_.value());
 
       {
         std::scoped_lock listeners_lock(config_listeners_mutex_);
         for (const auto& listener : config_listeners_) {
-          listener->update_config(*config_);
+          listener->apply_config_delta(snapshot, delta);
         }
       }
     }
-    if (!added.empty() || !removed.empty() || sequence_changed) {
+    if (delta->nodes_changed()) {
       std::scoped_lock lock(sessions_mutex_);
+      std::map<std::pair<std::string, std::uint16_t>, std::size_t> session_by_address{};
+      for (const auto& [index, session] : sessions_) {
+        session_by_address.try_emplace(
+          { session.bootstrap_hostname(), session.bootstrap_port_number() }, index);
+      }
       std::map<size_t, io::mcbp_session> new_sessions{};
 
       std::size_t next_index{ 0 };
-      for (const auto& node : config.nodes) {
+      for (const auto& node : snapshot->nodes) {
         const auto& hostname = node.hostname_for(origin_.options().network);
         auto port = node.port_or(
           origin_.options().network, service_type::key_value, origin_.options().enable_tls, 0);
@@ -725,38 +769,29 @@ public:
           continue;
         }
 
-        bool reused_session{ false };
-        for (auto it = sessions_.begin(); it != sessions_.end(); ++it) {
-          if (it->second.bootstrap_hostname() == hostname &&
-              it->second.bootstrap_port_number() == port) {
-            CB_LOG_DEBUG(R"({} rev={}, preserve session="{}", address="{}:{}", index={}->{})",
-                         log_prefix_,
-                         config.rev_str(),
-                         it->second.id(),
-                         it->second.bootstrap_hostname(),
-                         it->second.bootstrap_port(),
-                         it->first,
-                         next_index);
-            new_sessions.insert_or_assign(next_index, std::move(it->second));
-            reused_session = true;
-            ++next_index;
-            sessions_.erase(it);
-            break;
-          }
-        }
-        if (reused_session) {
+        if (auto address = session_by_address.find({ hostname, port });
+            address != session_by_address.end()) {
+          auto it = sessions_.find(address->second);
+          CB_LOG_DEBUG(R"({} rev={}, preserve session="{}", address="{}:{}", index={}->{})",
+                       log_prefix_,
+                       snapshot->rev_str(),
+                       it->second.id(),
+                       it->second.bootstrap_hostname(),
+                       it->second.bootstrap_port(),
+                       it->first,
+                       next_index);
+          new_sessions.insert_or_assign(next_index, std::move(it->second));
+          ++next_index;
+          sessions_.erase(it);
+          session_by_address.erase(address);
           continue;
         }
 
         couchbase::core::origin origin(origin_.credentials(), hostname, port, origin_.options());
-        io::mcbp_session session =
-          origin_.options().enable_tls
-            ? io::mcbp_session(
-                client_id_, ctx_, tls_, origin, state_listener_, name_, known_features_)
-            : io::mcbp_session(client_id_, ctx_, origin, state_listener_, name_, known_features_);
+        io::mcbp_session session = create_session(origin);
         CB_LOG_DEBUG(R"({} rev={}, add session="{}", address="{}:{}", index={})",
                      log_prefix_,
-                     config.rev_str(),
+                     snapshot->rev_str(),
                      session.id(),
                      hostname,
                      port,
@@ -791,7 +826,7 @@ public:
       for (auto it = new_sessions.begin(); it != new_sessions.end(); ++it) {
         CB_LOG_DEBUG(R"({} rev={}, drop session="{}", address="{}:{}", index={})",
                      log_prefix_,
-                     config.rev_str(),
+                     snapshot->rev_str(),
                      it->second.id(),
                      it->second.bootstrap_hostname(),
                      it->second.bootstrap_port(),
@@ -801,6 +836,10 @@ public:
         }));
       }
     }
+    if (delta->collections_manifest_changed && snapshot->collections_manifest_uid &&
+        collection_uids_->invalidate(snapshot->collections_manifest_uid.value())) {
+      fetch_collections_manifest();
+    }
   }
 
   [[nodiscard]] auto find_session_by_index(std::size_t index) const
@@ -859,6 +898,34 @@ public:
     return meter_;
   }
 
+  [[nodiscard]] auto operation_recorders() -> metrics::operation_recorders&
+  {
+    return operation_recorders_;
+  }
+
+  /**
+   * The hedge fires when the active node takes longer than it does for 95% of its requests, so
+   * only the slow tail of reads ends up sent twice.
+   */
+  [[nodiscard]] auto hedged_read_delay(const document_id& id) -> std::chrono::microseconds
+  {
+    hedge_budget_.record_read();
+    if (auto [partition, server] = map_id(id); server) {
+      if (auto session = find_session_by_index(server.value()); session) {
+        if (const auto& histogram = session->latency_histogram();
+            histogram.count() >= min_hedged_read_samples) {
+          return histogram.percentile(0.95);
+        }
+      }
+    }
+    return timeout_defaults::hedged_read_delay;
+  }
+
+  [[nodiscard]] auto acquire_hedge() -> bool
+  {
+    return hedge_budget_.try_acquire();
+  }
+
   void export_diag_info(diag::diagnostics_result& res) const
   {
     std::map<size_t, io::mcbp_session> sessions;
@@ -909,6 +976,7 @@ private:
   const origin origin_;
   const std::shared_ptr<couchbase::tracing::request_tracer> tracer_;
   const std::shared_ptr<couchbase::metrics::meter> meter_;
+  metrics::operation_recorders operation_recorders_;
   const std::vector<protocol::hello_feature> known_features_;
   const std::shared_ptr<impl::bootstrap_state_listener> state_listener_;
   mcbp::codec codec_;
@@ -920,6 +988,9 @@ private:
   std::chrono::milliseconds heartbeat_interval_;
   std::atomic_size_t heartbeat_next_index_{ 0 };
 
+  static constexpr std::uint64_t min_hedged_read_samples{ 64 };
+  utils::hedge_budget hedge_budget_;
+
   std::atomic_bool closed_{ false };
   std::atomic_bool configured_{ false };
 
@@ -935,6 +1006,11 @@ private:
   std::map<size_t, io::mcbp_session> sessions_{};
   mutable std::mutex sessions_mutex_{};
   std::atomic_size_t round_robin_next_{ 0 };
+
+  std::shared_ptr<io::collection_uid_cache> collection_uids_{
+    std::make_shared<io::collection_uid_cache>()
+  };
+  std::atomic_bool manifest_fetch_in_progress_{ false };
 };
 
 bucket::bucket(std::string client_id,
@@ -958,6 +1034,12 @@ bucket::bucket(std::string client_id,
                                          ctx,
                                          tls) }
 {
+  const auto number_of_wheels =
+    std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, max_timer_wheels);
+  timer_wheels_.reserve(number_of_wheels);
+  for (std::size_t i = 0; i < number_of_wheels; ++i) {
+    timer_wheels_.emplace_back(std::make_shared<io::timer_wheel>(ctx));
+  }
 }
 
 bucket::~bucket()
@@ -999,7 +1081,12 @@ bucket::name() const
 void
 bucket::close()
 {
-  return impl_->close();
+  impl_->close();
+  // pending deadlines and retries keep their commands (and the commands keep the wheels) alive,
+  // so they are completed now instead of waiting for the timers
+  for (const auto& wheel : timer_wheels_) {
+    wheel->expire_all(errc::common::request_canceled);
+  }
 }
 
 const std::string&
@@ -1020,6 +1107,20 @@ bucket::meter() const -> std::shared_ptr<couchbase::metrics::meter>
   return impl_->meter();
 }
 
+auto
+bucket::operation_recorders() const -> metrics::operation_recorders&
+{
+  return impl_->operation_recorders();
+}
+
+auto
+bucket::timer_wheel() const -> const std::shared_ptr<io::timer_wheel>&
+{
+  static thread_local const std::size_t thread_hash =
+    std::hash<std::thread::id>{}(std::this_thread::get_id());
+  return timer_wheels_[thread_hash % timer_wheels_.size()];
+}
+
 auto
 bucket::default_retry_strategy() const -> std::shared_ptr<couchbase::retry_strategy>
 {
@@ -1087,6 +1188,18 @@ bucket::map_id(const document_id& id) -> std::pair<std::uint16_t, std::optional<
   return impl_->map_id(id);
 }
 
+auto
+bucket::hedged_read_delay(const document_id& id) -> std::chrono::microseconds
+{
+  return impl_->hedged_read_delay(id);
+}
+
+auto
+bucket::acquire_hedge() -> bool
+{
+  return impl_->acquire_hedge();
+}
+
 auto
 bucket::config_rev() const -> std::string
 {
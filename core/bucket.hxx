@@ -19,14 +19,18 @@
 
 #include "config_listener.hxx"
 #include "io/mcbp_command.hxx"
+#include "io/timer_wheel.hxx"
 #include "operations.hxx"
+#include "utils/pooled_allocator.hxx"
 
 #include <asio/bind_executor.hpp>
 #include <asio/io_context.hpp>
 #include <asio/post.hpp>
 #include <asio/ssl.hpp>
 
+#include <atomic>
 #include <chrono>
+#include <map>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -82,8 +86,11 @@ public:
     if (is_closed()) {
       return;
     }
-    auto cmd = std::make_shared<operations::mcbp_command<bucket, Request>>(
-      ctx_, shared_from_this(), request, default_timeout());
+    using command_type = operations::mcbp_command<bucket, Request>;
+    auto cmd = std::allocate_shared<command_type>(utils::pooled_allocator<command_type>{},
+                                                  shared_from_this(),
+                                                  std::move(request),
+                                                  default_timeout());
     cmd->start([cmd, handler = std::forward<Handler>(handler)](
                  std::error_code ec, std::optional<io::mcbp_message>&& msg) mutable {
       using encoded_response_type = typename Request::encoded_response_type;
@@ -100,6 +107,116 @@ public:
     });
   }
 
+  /**
+   * Executes the batch of requests with a single completion. The handler receives the responses
+   * in the order of the requests.
+   *
+   * The keys are mapped to nodes once, and the packets for the same node are put into its output
+   * buffer together and flushed once, so that the batch reaches the socket in one gathered write
+   * per node. Every request still retries and times out on its own.
+   */
+  template<typename Request, typename Handler>
+  void execute_multi(std::vector<Request> requests, Handler&& handler)
+  {
+    using command_type = operations::mcbp_command<bucket, Request>;
+    using response_type = typename Request::response_type;
+
+    struct batch_state {
+      batch_state(std::size_t size, std::decay_t<Handler> h)
+        : responses(size)
+        , remaining(size)
+        , handler(std::move(h))
+      {
+      }
+
+      std::vector<response_type> responses;
+      std::atomic_size_t remaining;
+      std::decay_t<Handler> handler;
+    };
+
+    if (is_closed()) {
+      return;
+    }
+    if (requests.empty()) {
+      return handler(std::vector<response_type>{});
+    }
+    auto state = std::make_shared<batch_state>(requests.size(), std::forward<Handler>(handler));
+    std::vector<std::shared_ptr<command_type>> commands{};
+    commands.reserve(requests.size());
+    for (std::size_t index = 0; index < requests.size(); ++index) {
+      auto cmd = std::allocate_shared<command_type>(utils::pooled_allocator<command_type>{},
+                                                    shared_from_this(),
+                                                    std::move(requests[index]),
+                                                    default_timeout());
+      cmd->start([cmd, state, index](std::error_code ec,
+                                     std::optional<io::mcbp_message>&& msg) mutable {
+        using encoded_response_type = typename Request::encoded_response_type;
+        std::uint16_t status_code = msg ? msg->header.status() : 0xffffU;
+        auto resp = msg ? encoded_response_type(std::move(*msg)) : encoded_response_type{};
+        auto ctx = make_key_value_error_context(ec, status_code, cmd, resp);
+        state->responses[index] = cmd->request.make_response(std::move(ctx), std::move(resp));
+        if (state->remaining.fetch_sub(1) == 1) {
+          auto h = std::move(state->handler);
+          h(std::move(state->responses));
+        }
+      });
+      commands.emplace_back(std::move(cmd));
+    }
+    if (is_configured()) {
+      return map_and_send_multi(std::move(commands));
+    }
+    return defer_command([self = shared_from_this(), commands = std::move(commands)]() mutable {
+      self->map_and_send_multi(std::move(commands));
+    });
+  }
+
+  template<typename Request>
+  void map_and_send_multi(
+    std::vector<std::shared_ptr<operations::mcbp_command<bucket, Request>>> commands)
+  {
+    if (is_closed()) {
+      for (const auto& cmd : commands) {
+        cmd->cancel(retry_reason::do_not_retry);
+      }
+      return;
+    }
+    std::map<std::size_t, std::vector<std::shared_ptr<operations::mcbp_command<bucket, Request>>>>
+      commands_by_node{};
+    for (auto& cmd : commands) {
+      if (cmd->request.id.use_any_session()) {
+        map_and_send(std::move(cmd));
+        continue;
+      }
+      auto [partition, server] = map_id(cmd->request.id);
+      if (!server.has_value()) {
+        // let the regular path schedule the retry
+        map_and_send(std::move(cmd));
+        continue;
+      }
+      cmd->request.partition = partition;
+      commands_by_node[server.value()].emplace_back(std::move(cmd));
+    }
+    for (auto& [index, node_commands] : commands_by_node) {
+      auto session = find_session_by_index(index);
+      if (!session || !session->has_config() || session->is_stopped()) {
+        for (auto& cmd : node_commands) {
+          map_and_send(std::move(cmd));
+        }
+        continue;
+      }
+      CB_LOG_TRACE(R"({} send batch of {} operation(s), index={}, address="{}", rev={})",
+                   session->log_prefix(),
+                   node_commands.size(),
+                   index,
+                   session->bootstrap_address(),
+                   config_rev());
+      for (auto& cmd : node_commands) {
+        cmd->send_to(session.value(), false);
+      }
+      session->flush();
+    }
+  }
+
   template<typename Request>
   void map_and_send(std::shared_ptr<operations::mcbp_command<bucket, Request>> cmd)
   {
@@ -115,7 +232,7 @@ public:
         CB_LOG_TRACE(R"([{}] unable to map key="{}" to the node, id={}, partition={}, rev={})",
                      log_prefix(),
                      cmd->request.id,
-                     cmd->id_,
+                     cmd->id(),
                      partition,
                      config_rev());
         return io::retry_orchestrator::maybe_retry(
@@ -129,7 +246,7 @@ public:
       CB_LOG_TRACE(
         R"([{}] defer operation id="{}", key="{}", partition={}, index={}, session={}, address="{}", has_config={}, rev={})",
         log_prefix(),
-        cmd->id_,
+        cmd->id(),
         cmd->request.id,
         cmd->request.partition,
         index,
@@ -146,7 +263,7 @@ public:
         R"([{}] the session has been found for idx={}, but it is stopped, retrying id={}, key="{}", partition={}, session={}, address="{}", rev={})",
         log_prefix(),
         index,
-        cmd->id_,
+        cmd->id(),
         cmd->request.id,
         cmd->request.partition,
         session->id(),
@@ -155,12 +272,10 @@ public:
       return io::retry_orchestrator::maybe_retry(
         cmd->manager_, cmd, retry_reason::node_not_available, errc::common::request_canceled);
     }
-    cmd->last_dispatched_from_ = session->local_address();
-    cmd->last_dispatched_to_ = session->bootstrap_address();
     CB_LOG_TRACE(
       R"({} send operation id="{}", key="{}", partition={}, index={}, address="{}", rev={})",
       session->log_prefix(),
-      cmd->id_,
+      cmd->id(),
       cmd->request.id,
       cmd->request.partition,
       index,
@@ -176,13 +291,14 @@ public:
     if (is_closed()) {
       return cmd->cancel(retry_reason::do_not_retry);
     }
-    cmd->retry_backoff.expires_after(duration);
-    cmd->retry_backoff.async_wait([self = shared_from_this(), cmd](std::error_code ec) mutable {
-      if (ec == asio::error::operation_aborted) {
-        return;
-      }
-      self->map_and_send(cmd);
-    });
+    // the backoff lives on the wheel that already tracks the deadline of this command
+    cmd->timer_wheel_->schedule_after(
+      cmd->retry_backoff, duration, [self = shared_from_this(), cmd](std::error_code ec) {
+        if (ec) {
+          return cmd->invoke_handler(ec);
+        }
+        self->map_and_send(cmd);
+      });
   }
 
   void fetch_config();
@@ -202,6 +318,13 @@ public:
   [[nodiscard]] auto log_prefix() const -> const std::string&;
   [[nodiscard]] auto tracer() const -> std::shared_ptr<couchbase::tracing::request_tracer>;
   [[nodiscard]] auto meter() const -> std::shared_ptr<couchbase::metrics::meter>;
+  [[nodiscard]] auto operation_recorders() const -> metrics::operation_recorders&;
+  /**
+   * Deadlines and retry backoffs are kept on several independent wheels, each with its own lock
+   * and timer. The wheel is selected by the calling thread, so threads that dispatch commands
+   * concurrently do not contend on a single lock for the whole bucket.
+   */
+  [[nodiscard]] auto timer_wheel() const -> const std::shared_ptr<io::timer_wheel>&;
   [[nodiscard]] auto default_retry_strategy() const -> std::shared_ptr<couchbase::retry_strategy>;
   [[nodiscard]] auto is_closed() const -> bool;
   [[nodiscard]] auto is_configured() const -> bool;
@@ -209,6 +332,13 @@ public:
   auto direct_dispatch(std::shared_ptr<mcbp::queue_request> req) -> std::error_code;
   auto direct_re_queue(std::shared_ptr<mcbp::queue_request> req, bool is_retry) -> std::error_code;
 
+  /**
+   * How long a hedged read waits for the active node before it also asks a replica. Every call
+   * counts as one read in the budget consulted by acquire_hedge().
+   */
+  [[nodiscard]] auto hedged_read_delay(const document_id& id) -> std::chrono::microseconds;
+  [[nodiscard]] auto acquire_hedge() -> bool;
+
 private:
   [[nodiscard]] auto default_timeout() const -> std::chrono::milliseconds;
   [[nodiscard]] auto next_session_index() -> std::size_t;
@@ -219,6 +349,7 @@ private:
   [[nodiscard]] auto config_rev() const -> std::string;
 
   asio::io_context& ctx_;
+  std::vector<std::shared_ptr<io::timer_wheel>> timer_wheels_;
   std::shared_ptr<bucket_impl> impl_;
 };
 } // namespace core
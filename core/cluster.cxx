@@ -23,14 +23,17 @@
 #include "capella_ca.hxx"
 #include "core/impl/get_replica.hxx"
 #include "core/impl/lookup_in_replica.hxx"
+#include "core/impl/observe_poll.hxx"
 #include "core/impl/observe_seqno.hxx"
 #include "core/io/http_command.hxx"
 #include "core/io/http_session_manager.hxx"
 #include "core/io/mcbp_command.hxx"
 #include "core/io/mcbp_session.hxx"
+#include "core/io/tls_session_cache.hxx"
 #include "core/management/analytics_link.hxx"
 #include "core/mcbp/completion_token.hxx"
 #include "core/mcbp/queue_request.hxx"
+#include "core/metrics/exporting_meter.hxx"
 #include "core/metrics/logging_meter.hxx"
 #include "core/metrics/noop_meter.hxx"
 #include "core/operations.hxx"
@@ -46,7 +49,9 @@
 #include "core/operations/management/search.hxx"
 #include "core/operations/management/user.hxx"
 #include "core/operations/management/view.hxx"
+#include "core/tracing/exporting_tracer.hxx"
 #include "core/tracing/noop_tracer.hxx"
+#include "core/timeout_defaults.hxx"
 #include "core/tracing/threshold_logging_tracer.hxx"
 #include "core/utils/join_strings.hxx"
 #include "crud_component.hxx"
@@ -154,6 +159,7 @@ public:
     : ctx_(ctx)
     , work_(asio::make_work_guard(ctx_))
     , session_manager_(std::make_shared<io::http_session_manager>(id_, ctx_, tls_))
+    , observe_engine_(ctx_)
   {
   }
 
@@ -162,6 +168,32 @@ public:
     return ctx_;
   }
 
+  [[nodiscard]] auto observe_engine() const -> const impl::observe_engine&
+  {
+    return observe_engine_;
+  }
+
+  [[nodiscard]] auto meter() const -> std::shared_ptr<couchbase::metrics::meter>
+  {
+    return meter_;
+  }
+
+  auto hedged_read_delay(const document_id& id) -> std::chrono::microseconds
+  {
+    if (auto bucket = find_bucket_by_name(id.bucket()); bucket != nullptr) {
+      return bucket->hedged_read_delay(id);
+    }
+    return timeout_defaults::hedged_read_delay;
+  }
+
+  auto acquire_hedge(const std::string& bucket_name) -> bool
+  {
+    if (auto bucket = find_bucket_by_name(bucket_name); bucket != nullptr) {
+      return bucket->acquire_hedge();
+    }
+    return false;
+  }
+
   void configure_tls_options(bool has_capella_host)
   {
     asio::ssl::context::options tls_options =
@@ -177,6 +209,10 @@ public:
       tls_options |= asio::ssl::context::no_tlsv1_2; // published: 2008, still in use
     }
     tls_.set_options(tls_options);
+    tls_session_cache_.install(tls_.native_handle());
+    tls_session_cache_.set_recorders(
+      meter_->get_value_recorder("db.couchbase.tls_handshake", { { "outcome", "resumed" } }),
+      meter_->get_value_recorder("db.couchbase.tls_handshake", { { "outcome", "full" } }));
     switch (origin_.options().tls_verify) {
       case tls_verify_mode::none:
         tls_.set_verify_mode(asio::ssl::verify_none);
@@ -223,8 +259,13 @@ public:
       tracer_ = origin_.options().tracer;
     } else {
       if (origin_.options().enable_tracing) {
-        tracer_ = std::make_shared<tracing::threshold_logging_tracer>(
-          ctx_, origin_.options().tracing_options);
+        if (origin_.options().tracing_exporter_options.sink != nullptr) {
+          tracer_ = std::make_shared<tracing::exporting_tracer>(
+            ctx_, origin_.options().tracing_exporter_options);
+        } else {
+          tracer_ = std::make_shared<tracing::threshold_logging_tracer>(
+            ctx_, origin_.options().tracing_options);
+        }
       } else {
         tracer_ = std::make_shared<tracing::noop_tracer>();
       }
@@ -235,7 +276,13 @@ public:
       meter_ = origin_.options().meter;
     } else {
       if (origin_.options().enable_metrics) {
-        meter_ = std::make_shared<metrics::logging_meter>(ctx_, origin_.options().metrics_options);
+        if (origin_.options().metrics_exporter_options.sink != nullptr) {
+          meter_ = std::make_shared<metrics::exporting_meter>(
+            ctx_, origin_.options().metrics_exporter_options);
+        } else {
+          meter_ =
+            std::make_shared<metrics::logging_meter>(ctx_, origin_.options().metrics_options);
+        }
       } else {
         meter_ = std::make_shared<metrics::noop_meter>();
       }
@@ -284,6 +331,12 @@ public:
     std::shared_ptr<bucket> b{};
     {
       std::scoped_lock lock(buckets_mutex_);
+      if (auto waiters = opening_buckets_.find(bucket_name); waiters != opening_buckets_.end()) {
+        // the bucket is being bootstrapped already, report the outcome of that bootstrap instead
+        // of reporting success before the bucket is ready
+        waiters->second.emplace_back(std::move(handler));
+        return;
+      }
       auto ptr = buckets_.find(bucket_name);
       if (ptr == buckets_.end()) {
         std::vector<protocol::hello_feature> known_features;
@@ -297,6 +350,7 @@ public:
         b = std::make_shared<bucket>(
           id_, ctx_, tls_, tracer_, meter_, bucket_name, origin, known_features, dns_srv_tracker_);
         buckets_.try_emplace(bucket_name, b);
+        opening_buckets_.try_emplace(bucket_name);
       }
     }
     if (b == nullptr) {
@@ -306,13 +360,25 @@ public:
     b->on_configuration_update(session_manager_);
     b->bootstrap([self = shared_from_this(), bucket_name, handler = std::move(handler)](
                    std::error_code ec, const topology::configuration& config) mutable {
-      if (ec) {
+      std::vector<utils::movable_function<void(std::error_code)>> waiters{};
+      {
         std::scoped_lock lock(self->buckets_mutex_);
-        self->buckets_.erase(bucket_name);
-      } else if (self->session_ && !self->session_->supports_gcccp()) {
+        if (auto ptr = self->opening_buckets_.find(bucket_name);
+            ptr != self->opening_buckets_.end()) {
+          waiters = std::move(ptr->second);
+          self->opening_buckets_.erase(ptr);
+        }
+        if (ec) {
+          self->buckets_.erase(bucket_name);
+        }
+      }
+      if (!ec && self->session_ && !self->session_->supports_gcccp()) {
         self->session_manager_->set_configuration(config, self->origin_.options());
       }
       handler(ec);
+      for (auto& waiter : waiters) {
+        waiter(ec);
+      }
     });
   }
 
@@ -337,6 +403,45 @@ public:
     return handler({});
   }
 
+  template<class Request, class Handler>
+  void execute_multi(std::vector<Request> requests, Handler&& handler)
+  {
+    using response_type = typename Request::encoded_response_type;
+    auto fail_all = [](std::vector<Request>& batch, std::error_code ec) {
+      std::vector<typename Request::response_type> responses{};
+      responses.reserve(batch.size());
+      for (auto& request : batch) {
+        responses.emplace_back(
+          request.make_response(make_key_value_error_context(ec, request.id), response_type{}));
+      }
+      return responses;
+    };
+    if (requests.empty()) {
+      return handler({});
+    }
+    if (stopped_) {
+      return handler(fail_all(requests, errc::network::cluster_closed));
+    }
+    // all requests of the batch belong to the same collection
+    auto bucket_name = requests.front().id.bucket();
+    if (auto bucket = find_bucket_by_name(bucket_name); bucket != nullptr) {
+      return bucket->execute_multi(std::move(requests), std::forward<Handler>(handler));
+    }
+    if (bucket_name.empty()) {
+      return handler(fail_all(requests, errc::common::bucket_not_found));
+    }
+    return open_bucket(bucket_name,
+                       [self = shared_from_this(),
+                        fail_all,
+                        requests = std::move(requests),
+                        handler = std::forward<Handler>(handler)](std::error_code ec) mutable {
+                         if (ec) {
+                           return handler(fail_all(requests, ec));
+                         }
+                         return self->execute_multi(std::move(requests), std::move(handler));
+                       });
+  }
+
   std::pair<std::error_code, couchbase::core::origin> origin() const
   {
     if (stopped_) {
@@ -841,12 +946,18 @@ private:
   std::string id_{ uuid::to_string(uuid::random()) };
   asio::io_context& ctx_;
   asio::executor_work_guard<asio::io_context::executor_type> work_;
+  // declared before the TLS context, because the context refers to the cache
+  io::tls_session_cache tls_session_cache_{};
   asio::ssl::context tls_{ asio::ssl::context::tls_client };
   std::shared_ptr<io::http_session_manager> session_manager_;
   std::optional<io::mcbp_session> session_{};
   std::shared_ptr<impl::dns_srv_tracker> dns_srv_tracker_{};
+  impl::observe_engine observe_engine_;
   std::mutex buckets_mutex_{};
   std::map<std::string, std::shared_ptr<bucket>> buckets_{};
+  /* handlers of open_bucket calls waiting for the bootstrap that is already in progress */
+  std::map<std::string, std::vector<utils::movable_function<void(std::error_code)>>>
+    opening_buckets_{};
   couchbase::core::origin origin_{};
   std::shared_ptr<couchbase::tracing::request_tracer> tracer_{ nullptr };
   std::shared_ptr<couchbase::metrics::meter> meter_{ nullptr };
@@ -965,6 +1076,18 @@ cluster::io_context() const -> asio::io_context&
   return impl_->io_context();
 }
 
+auto
+cluster::observe_engine() const -> impl::observe_engine
+{
+  return impl_->observe_engine();
+}
+
+auto
+cluster::meter() const -> std::shared_ptr<couchbase::metrics::meter>
+{
+  return impl_->meter();
+}
+
 void
 cluster::execute(operations::append_request request,
                  utils::movable_function<void(operations::append_response)>&& handler) const
@@ -1041,10 +1164,22 @@ cluster::execute(
     });
 }
 
+void
+cluster::execute(
+  operations::get_hedged_request request,
+  utils::movable_function<void(operations::get_any_replica_response)>&& handler) const
+{
+  return request.execute(impl_, std::move(handler));
+}
+
 void
 cluster::execute(operations::get_projected_request request,
                  utils::movable_function<void(operations::get_projected_response)>&& handler) const
 {
+  if (request.needs_split()) {
+    return operations::get_projected_split_request{ std::move(request) }.execute(
+      impl_, std::move(handler));
+  }
   return impl_->execute(std::move(request), std::move(handler));
 }
 
@@ -1085,6 +1220,14 @@ cluster::execute(
   return request.execute(impl_, std::move(handler));
 }
 
+void
+cluster::execute(
+  operations::lookup_in_hedged_request request,
+  utils::movable_function<void(operations::lookup_in_any_replica_response)>&& handler) const
+{
+  return request.execute(impl_, std::move(handler));
+}
+
 void
 cluster::execute(operations::mutate_in_request request,
                  utils::movable_function<void(operations::mutate_in_response)>&& handler) const
@@ -1148,6 +1291,30 @@ cluster::execute(operations::upsert_request request,
   return impl_->execute(std::move(request), std::move(handler));
 }
 
+void
+cluster::execute(std::vector<operations::get_request> requests,
+                 utils::movable_function<void(std::vector<operations::get_response>)>&& handler)
+  const
+{
+  return impl_->execute_multi(std::move(requests), std::move(handler));
+}
+
+void
+cluster::execute(
+  std::vector<operations::upsert_request> requests,
+  utils::movable_function<void(std::vector<operations::upsert_response>)>&& handler) const
+{
+  return impl_->execute_multi(std::move(requests), std::move(handler));
+}
+
+void
+cluster::execute(
+  std::vector<operations::remove_request> requests,
+  utils::movable_function<void(std::vector<operations::remove_response>)>&& handler) const
+{
+  return impl_->execute_multi(std::move(requests), std::move(handler));
+}
+
 void
 cluster::execute(operations::document_view_request request,
                  utils::movable_function<void(operations::document_view_response)>&& handler) const
@@ -25,12 +25,19 @@
 
 #include <asio/io_context.hpp>
 #include <chrono>
+#include <memory>
 #include <optional>
 #include <utility>
+#include <vector>
 
 namespace couchbase
 {
 class cluster;
+
+namespace metrics
+{
+class meter;
+} // namespace metrics
 } // namespace couchbase
 
 namespace couchbase::core
@@ -38,6 +45,11 @@ namespace couchbase::core
 class crud_component;
 class cluster_impl;
 
+namespace impl
+{
+class observe_engine;
+} // namespace impl
+
 namespace mcbp
 {
 class queue_request;
@@ -55,6 +67,13 @@ public:
 
   [[nodiscard]] auto io_context() const -> asio::io_context&;
 
+  [[nodiscard]] auto observe_engine() const -> impl::observe_engine;
+
+  /**
+   * @return the meter of the cluster, or nullptr until the cluster has been opened
+   */
+  [[nodiscard]] auto meter() const -> std::shared_ptr<couchbase::metrics::meter>;
+
   [[nodiscard]] auto origin() const -> std::pair<std::error_code, core::origin>;
 
   void open(core::origin origin, utils::movable_function<void(std::error_code)>&& handler) const;
@@ -83,6 +102,8 @@ public:
                mf<void(o::get_and_touch_response)>&& handler) const;
   void execute(o::get_any_replica_request request,
                mf<void(o::get_any_replica_response)>&& handler) const;
+  void execute(o::get_hedged_request request,
+               mf<void(o::get_any_replica_response)>&& handler) const;
   void execute(o::get_projected_request request,
                mf<void(o::get_projected_response)>&& handler) const;
   void execute(o::increment_request request, mf<void(o::increment_response)>&& handler) const;
@@ -92,6 +113,8 @@ public:
                mf<void(o::lookup_in_any_replica_response)>&& handler) const;
   void execute(o::lookup_in_all_replicas_request request,
                mf<void(o::lookup_in_all_replicas_response)>&& handler) const;
+  void execute(o::lookup_in_hedged_request request,
+               mf<void(o::lookup_in_any_replica_response)>&& handler) const;
   void execute(o::mutate_in_request request, mf<void(o::mutate_in_response)>&& handler) const;
   void execute(o::prepend_request request, mf<void(o::prepend_response)>&& handler) const;
   void execute(o::query_request request, mf<void(o::query_response)>&& handler) const;
@@ -120,6 +143,18 @@ public:
   void execute(o::replace_request_with_legacy_durability request,
                mf<void(o::replace_response)>&& handler) const;
 
+  /**
+   * Batched variants of the KV operations. All requests must target the same bucket, the packets
+   * are grouped by node and written together, and the handler receives responses in the order of
+   * the requests.
+   */
+  void execute(std::vector<o::get_request> requests,
+               mf<void(std::vector<o::get_response>)>&& handler) const;
+  void execute(std::vector<o::upsert_request> requests,
+               mf<void(std::vector<o::upsert_response>)>&& handler) const;
+  void execute(std::vector<o::remove_request> requests,
+               mf<void(std::vector<o::remove_response>)>&& handler) const;
+
   void execute(o::document_view_request request,
                mf<void(o::document_view_response)>&& handler) const;
   void execute(o::http_noop_request request, mf<void(o::http_noop_response)>&& handler) const;
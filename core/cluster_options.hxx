@@ -19,7 +19,9 @@
 
 #include "core/io/dns_config.hxx"
 #include "core/io/ip_protocol.hxx"
+#include "core/metrics/exporting_meter_options.hxx"
 #include "core/metrics/logging_meter_options.hxx"
+#include "core/tracing/exporting_tracer_options.hxx"
 #include "core/tracing/threshold_logging_options.hxx"
 #include "service_type.hxx"
 #include "timeout_defaults.hxx"
@@ -45,6 +47,11 @@ public:
   std::chrono::milliseconds bootstrap_timeout = timeout_defaults::bootstrap_timeout;
   std::chrono::milliseconds resolve_timeout = timeout_defaults::resolve_timeout;
   std::chrono::milliseconds connect_timeout = timeout_defaults::connect_timeout;
+  /**
+   * Delay before the next resolved address of the node is tried in parallel with the previous
+   * ones, when the connection to the previous address has neither succeeded nor failed yet.
+   */
+  std::chrono::milliseconds connection_attempt_delay = timeout_defaults::connection_attempt_delay;
   std::chrono::milliseconds key_value_timeout = timeout_defaults::key_value_timeout;
   std::chrono::milliseconds key_value_durable_timeout = timeout_defaults::key_value_durable_timeout;
   std::chrono::milliseconds view_timeout = timeout_defaults::view_timeout;
@@ -72,6 +79,11 @@ public:
   std::string network{ "auto" };
   tracing::threshold_logging_options tracing_options{};
   metrics::logging_meter_options metrics_options{};
+  /**
+   * When the sink is set, spans and metrics are exported to it instead of being logged.
+   */
+  tracing::exporting_tracer_options tracing_exporter_options{};
+  metrics::exporting_meter_options metrics_exporter_options{};
   tls_verify_mode tls_verify{ tls_verify_mode::peer };
   std::shared_ptr<couchbase::tracing::request_tracer> tracer{ nullptr };
   std::shared_ptr<couchbase::metrics::meter> meter{ nullptr };
@@ -83,6 +95,32 @@ public:
   std::chrono::milliseconds config_idle_redial_timeout =
     timeout_defaults::config_idle_redial_timeout;
 
+  /**
+   * When not zero, KV requests issued within this window are gathered into a single write to the
+   * socket, trading a little latency for fewer syscalls under high concurrency. The write happens
+   * earlier, once write_coalescing_threshold bytes have been buffered.
+   */
+  std::chrono::microseconds write_coalescing_window = timeout_defaults::write_coalescing_window;
+  std::size_t write_coalescing_threshold{ 64 * 1024 };
+
+  /**
+   * Upper bound for the share of hedged reads that actually send the second request to a replica,
+   * so that a slow node cannot double the read load on the rest of the cluster.
+   */
+  double max_hedged_read_ratio{ 0.05 };
+
+  /**
+   * When enabled, every KV node gets an adaptive limit of requests in flight
+   * (utils::concurrency_limiter), that starts at kv_initial_concurrency_limit and never exceeds
+   * kv_max_concurrency_limit. Requests above the limit wait in a per-node queue of
+   * kv_max_queued_requests entries, and once the queue is full (or when it is zero) they are
+   * rejected right away and go through the retry strategy with retry_reason::circuit_breaker_open.
+   */
+  bool enable_kv_concurrency_limit{ false };
+  std::size_t kv_initial_concurrency_limit{ 512 };
+  std::size_t kv_max_concurrency_limit{ 8'192 };
+  std::size_t kv_max_queued_requests{ 4'096 };
+
   std::size_t max_http_connections{ 0 };
   std::chrono::milliseconds idle_http_connection_timeout =
     timeout_defaults::idle_http_connection_timeout;
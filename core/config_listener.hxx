@@ -18,6 +18,9 @@
 #pragma once
 
 #include "topology/configuration.hxx"
+#include "topology/configuration_delta.hxx"
+
+#include <memory>
 
 namespace couchbase::core
 {
@@ -27,5 +30,19 @@ public:
   virtual ~config_listener() = default;
 
   virtual void update_config(topology::configuration config) = 0;
+
+  /**
+   * Receives configuration accepted by the bucket along with its changes against the previous
+   * revision. Both objects are shared between all listeners and must not be modified, listeners
+   * should keep the snapshot rather than copy it (see http_session_manager).
+   *
+   * The default only exists for listeners that are fed by update_config() and never subscribe to
+   * the bucket (sessions, buckets), so the copy below is not made on the configuration path.
+   */
+  virtual void apply_config_delta(std::shared_ptr<const topology::configuration> config,
+                                  std::shared_ptr<const topology::configuration_delta> /* delta */)
+  {
+    update_config(*config);
+  }
 };
 } // namespace couchbase::core
@@ -20,6 +20,7 @@
 #include "service_type.hxx"
 
 #include <chrono>
+#include <cstddef>
 #include <map>
 #include <optional>
 #include <string>
@@ -57,6 +58,9 @@ struct endpoint_diag_info {
   /** serialized as "namespace" */
   std::optional<std::string> bucket{};
   std::optional<std::string> details{};
+  /** adaptive limit of requests in flight, KV only */
+  std::optional<std::size_t> concurrency_limit{};
+  std::optional<std::size_t> queued_requests{};
 };
 
 struct diagnostics_result {
@@ -50,6 +50,12 @@ struct traits<couchbase::core::diag::diagnostics_result> {
         if (endpoint.details) {
           e["details"] = endpoint.details.value();
         }
+        if (endpoint.concurrency_limit) {
+          e["concurrency_limit"] = endpoint.concurrency_limit.value();
+        }
+        if (endpoint.queued_requests) {
+          e["queued_requests"] = endpoint.queued_requests.value();
+        }
         service.push_back(e);
       }
       services[fmt::format("{}", service_type)] = service;
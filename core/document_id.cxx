@@ -95,10 +95,12 @@ make_protocol_key(const document_id& id)
   std::vector<std::byte> key{};
   if (id.is_collection_resolved()) {
     utils::unsigned_leb128<std::uint32_t> encoded(id.collection_uid());
-    key.reserve(encoded.size());
+    // a single allocation for the collection prefix and the key
+    key.reserve(encoded.size() + id.key().size());
     key.insert(key.end(), encoded.begin(), encoded.end());
+  } else {
+    key.reserve(id.key().size());
   }
-  key.reserve(key.size() + id.key().size());
   couchbase::core::utils::to_binary(id.key(), std::back_insert_iterator(key));
   return key;
 }
@@ -57,10 +57,10 @@ make_key_value_error_context(std::error_code ec,
   auto retry_attempts = command->request.retries.retry_attempts();
   auto retry_reasons = command->request.retries.retry_reasons();
 
-  return { command->id_,
+  return { command->id(),
            ec,
-           command->last_dispatched_to_,
-           command->last_dispatched_from_,
+           command->last_dispatched_to(),
+           command->last_dispatched_from(),
            retry_attempts,
            std::move(retry_reasons),
            key,
@@ -16,11 +16,14 @@
  */
 
 #include <couchbase/binary_collection.hxx>
+#include <couchbase/codec/codec_flags.hxx>
+#include <couchbase/error_codes.hxx>
 
 #include "core/cluster.hxx"
 #include "core/impl/error.hxx"
 #include "core/operations/document_append.hxx"
 #include "core/operations/document_decrement.hxx"
+#include "core/operations/document_get.hxx"
 #include "core/operations/document_increment.hxx"
 #include "core/operations/document_insert.hxx"
 #include "core/operations/document_mutate_in.hxx"
@@ -28,6 +31,7 @@
 #include "core/operations/document_remove.hxx"
 #include "core/operations/document_replace.hxx"
 #include "core/operations/document_upsert.hxx"
+#include "internal_large_object.hxx"
 #include "observe_poll.hxx"
 
 #include <memory>
@@ -341,6 +345,49 @@ public:
       });
   }
 
+  [[nodiscard]] auto open_writer(std::string document_key,
+                                 large_object_options::built options) const -> large_object_writer
+  {
+    return large_object_writer{ std::make_shared<large_object_writer_impl>(
+      core_,
+      core::document_id{ bucket_name_, scope_name_, name_, std::move(document_key) },
+      std::move(options)) };
+  }
+
+  void open_reader(std::string document_key,
+                   large_object_options::built options,
+                   large_object_open_handler&& handler) const
+  {
+    auto id = core::document_id{
+      bucket_name_,
+      scope_name_,
+      name_,
+      std::move(document_key),
+    };
+    core::operations::get_request request{
+      id, {}, {}, options.timeout, { options.retry_strategy },
+    };
+    return core_.execute(
+      std::move(request),
+      [core = core_, id, options, handler = std::move(handler)](auto&& resp) mutable {
+        if (resp.ctx.ec()) {
+          return handler(core::impl::make_error(std::move(resp.ctx)), {});
+        }
+        std::optional<core::impl::large_object_manifest> manifest{};
+        if (codec::codec_flags::has_common_flags(resp.flags,
+                                                 codec::codec_flags::common_flags::json)) {
+          manifest = core::impl::decode_large_object_manifest(resp.value);
+        }
+        if (!manifest) {
+          return handler(
+            error(errc::common::decoding_failure, "document is not a large object manifest"), {});
+        }
+        return handler({},
+                       large_object_reader{ std::make_shared<large_object_reader_impl>(
+                         std::move(core), std::move(id), manifest.value(), std::move(options)) });
+      });
+  }
+
 private:
   core::cluster core_;
   std::string bucket_name_;
@@ -461,4 +508,31 @@ binary_collection::decrement(std::string document_id, const decrement_options& o
   });
   return future;
 }
+
+auto
+binary_collection::open_writer(std::string document_id, const large_object_options& options) const
+  -> large_object_writer
+{
+  return impl_->open_writer(std::move(document_id), options.build());
+}
+
+void
+binary_collection::open_reader(std::string document_id,
+                               const large_object_options& options,
+                               large_object_open_handler&& handler) const
+{
+  return impl_->open_reader(std::move(document_id), options.build(), std::move(handler));
+}
+
+auto
+binary_collection::open_reader(std::string document_id, const large_object_options& options) const
+  -> std::future<std::pair<error, large_object_reader>>
+{
+  auto barrier = std::make_shared<std::promise<std::pair<error, large_object_reader>>>();
+  auto future = barrier->get_future();
+  open_reader(std::move(document_id), options, [barrier](auto err, auto reader) {
+    barrier->set_value({ std::move(err), std::move(reader) });
+  });
+  return future;
+}
 } // namespace couchbase
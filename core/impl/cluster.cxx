@@ -116,6 +116,13 @@ options_to_origin(const std::string& connection_string,
   user_options.tcp_keep_alive_interval = opts.network.tcp_keep_alive_interval;
   user_options.config_poll_interval = opts.network.config_poll_interval;
   user_options.idle_http_connection_timeout = opts.network.idle_http_connection_timeout;
+  user_options.write_coalescing_window = opts.network.write_coalescing_window;
+  user_options.write_coalescing_threshold = opts.network.write_coalescing_threshold;
+  user_options.max_hedged_read_ratio = opts.network.max_hedged_read_ratio;
+  user_options.enable_kv_concurrency_limit = opts.network.enable_kv_concurrency_limit;
+  user_options.kv_initial_concurrency_limit = opts.network.kv_initial_concurrency_limit;
+  user_options.kv_max_concurrency_limit = opts.network.kv_max_concurrency_limit;
+  user_options.kv_max_queued_requests = opts.network.kv_max_queued_requests;
   if (opts.network.max_http_connections) {
     user_options.max_http_connections = opts.network.max_http_connections.value();
   }
@@ -26,12 +26,14 @@
 #include "core/operations/document_get_and_lock.hxx"
 #include "core/operations/document_get_and_touch.hxx"
 #include "core/operations/document_get_any_replica.hxx"
+#include "core/operations/document_get_hedged.hxx"
 #include "core/operations/document_get_projected.hxx"
 #include "core/operations/document_increment.hxx"
 #include "core/operations/document_insert.hxx"
 #include "core/operations/document_lookup_in.hxx"
 #include "core/operations/document_lookup_in_all_replicas.hxx"
 #include "core/operations/document_lookup_in_any_replica.hxx"
+#include "core/operations/document_lookup_in_hedged.hxx"
 #include "core/operations/document_mutate_in.hxx"
 #include "core/operations/document_prepend.hxx"
 #include "core/operations/document_remove.hxx"
@@ -53,10 +55,58 @@
 
 #include <couchbase/collection.hxx>
 
+#include <atomic>
 #include <memory>
 
 namespace couchbase
 {
+namespace
+{
+/**
+ * Collects results of the individual operations of a batch, and invokes the handler once the last
+ * one has been stored.
+ */
+template<typename Result>
+class multi_result_barrier
+{
+public:
+  multi_result_barrier(std::size_t size,
+                       std::function<void(std::vector<std::pair<error, Result>>)>&& handler)
+    : results_(size)
+    , remaining_(size)
+    , handler_(std::move(handler))
+  {
+  }
+
+  void set(std::size_t index, error err, Result result)
+  {
+    results_[index] = { std::move(err), std::move(result) };
+    if (remaining_.fetch_sub(1) == 1) {
+      auto handler = std::move(handler_);
+      handler(std::move(results_));
+    }
+  }
+
+private:
+  std::vector<std::pair<error, Result>> results_;
+  std::atomic_size_t remaining_;
+  std::function<void(std::vector<std::pair<error, Result>>)> handler_;
+};
+
+auto
+make_get_result(core::operations::get_response& resp) -> get_result
+{
+  if (resp.buffer) {
+    const auto* data = resp.buffer->data() + resp.value_offset;
+    const auto size = resp.buffer->size() - resp.value_offset;
+    return {
+      resp.cas, codec::encoded_value_view{ std::move(resp.buffer), data, size, resp.flags }, {}
+    };
+  }
+  return { resp.cas, codec::encoded_value{ std::move(resp.value), resp.flags }, {} };
+}
+} // namespace
+
 class collection_impl : public std::enable_shared_from_this<collection_impl>
 {
 public:
@@ -93,6 +143,19 @@ public:
 
   void get(std::string document_key, get_options::built options, get_handler&& handler) const
   {
+    if (options.hedged_read && !options.with_expiry && options.projections.empty()) {
+      return core_.execute(
+        core::operations::get_hedged_request{
+          core::document_id{ bucket_name_, scope_name_, name_, std::move(document_key) },
+          options.timeout,
+          options.retry_strategy,
+          options.hedged_read_preference,
+        },
+        [handler = std::move(handler)](auto resp) mutable {
+          get_result result{ resp.cas, { std::move(resp.value), resp.flags }, resp.replica };
+          return handler(core::impl::make_error(std::move(resp.ctx)), std::move(result));
+        });
+    }
     if (!options.with_expiry && options.projections.empty()) {
       return core_.execute(
         core::operations::get_request{
@@ -101,10 +164,12 @@ public:
           {},
           options.timeout,
           { options.retry_strategy },
+          {},
+          options.zero_copy,
         },
         [handler = std::move(handler)](auto resp) mutable {
-          return handler(core::impl::make_error(std::move(resp.ctx)),
-                         get_result{ resp.cas, { std::move(resp.value), resp.flags }, {} });
+          auto result = make_get_result(resp);
+          return handler(core::impl::make_error(std::move(resp.ctx)), std::move(result));
         });
     }
     return core_.execute(
@@ -129,6 +194,51 @@ public:
       });
   }
 
+  void get_multi(std::vector<std::string> document_keys,
+                 get_options::built options,
+                 get_multi_handler&& handler) const
+  {
+    if (document_keys.empty()) {
+      return handler({});
+    }
+    if (options.hedged_read || options.with_expiry || !options.projections.empty()) {
+      // hedged reads race their own replica read, and projected reads are subdocument lookups,
+      // so they go through the regular path one by one
+      auto barrier = std::make_shared<multi_result_barrier<get_result>>(document_keys.size(),
+                                                                        std::move(handler));
+      for (std::size_t index = 0; index < document_keys.size(); ++index) {
+        get(std::move(document_keys[index]), options, [barrier, index](auto err, auto result) {
+          barrier->set(index, std::move(err), std::move(result));
+        });
+      }
+      return;
+    }
+    std::vector<core::operations::get_request> requests{};
+    requests.reserve(document_keys.size());
+    for (auto& document_key : document_keys) {
+      requests.emplace_back(core::operations::get_request{
+        core::document_id{ bucket_name_, scope_name_, name_, std::move(document_key) },
+        {},
+        {},
+        options.timeout,
+        { options.retry_strategy },
+        {},
+        options.zero_copy,
+      });
+    }
+    return core_.execute(
+      std::move(requests),
+      [handler = std::move(handler)](std::vector<core::operations::get_response> responses) {
+        std::vector<std::pair<error, get_result>> results{};
+        results.reserve(responses.size());
+        for (auto& resp : responses) {
+          auto result = make_get_result(resp);
+          results.emplace_back(core::impl::make_error(std::move(resp.ctx)), std::move(result));
+        }
+        handler(std::move(results));
+      });
+  }
+
   void get_and_touch(std::string document_key,
                      std::uint32_t expiry,
                      get_and_touch_options::built options,
@@ -211,6 +321,54 @@ public:
       });
   }
 
+  void remove_multi(std::vector<std::string> document_keys,
+                    remove_options::built options,
+                    remove_multi_handler&& handler) const
+  {
+    if (document_keys.empty()) {
+      return handler({});
+    }
+    if (options.persist_to != persist_to::none || options.replicate_to != replicate_to::none) {
+      // legacy durability polls every document with observe, use the regular path
+      auto barrier = std::make_shared<multi_result_barrier<mutation_result>>(document_keys.size(),
+                                                                             std::move(handler));
+      for (std::size_t index = 0; index < document_keys.size(); ++index) {
+        remove(std::move(document_keys[index]), options, [barrier, index](auto err, auto result) {
+          barrier->set(index, std::move(err), std::move(result));
+        });
+      }
+      return;
+    }
+    std::vector<core::operations::remove_request> requests{};
+    requests.reserve(document_keys.size());
+    for (auto& document_key : document_keys) {
+      requests.emplace_back(core::operations::remove_request{
+        core::document_id{ bucket_name_, scope_name_, name_, std::move(document_key) },
+        {},
+        {},
+        options.cas,
+        options.durability_level,
+        options.timeout,
+        { options.retry_strategy },
+      });
+    }
+    return core_.execute(
+      std::move(requests),
+      [handler = std::move(handler)](std::vector<core::operations::remove_response> responses) {
+        std::vector<std::pair<error, mutation_result>> results{};
+        results.reserve(responses.size());
+        for (auto& resp : responses) {
+          if (resp.ctx.ec()) {
+            results.emplace_back(core::impl::make_error(std::move(resp.ctx)), mutation_result{});
+          } else {
+            results.emplace_back(core::impl::make_error(std::move(resp.ctx)),
+                                 mutation_result{ resp.cas, std::move(resp.token) });
+          }
+        }
+        handler(std::move(results));
+      });
+  }
+
   void remove(std::string document_key,
               remove_options::built options,
               remove_handler&& handler) const
@@ -333,6 +491,35 @@ public:
                  lookup_in_options::built options,
                  lookup_in_handler&& handler) const
   {
+    if (options.hedged_read && !options.access_deleted) {
+      return core_.execute(
+        core::operations::lookup_in_hedged_request{
+          core::document_id{ bucket_name_, scope_name_, name_, std::move(document_key) },
+          specs,
+          options.timeout,
+          options.retry_strategy,
+          {},
+          options.hedged_read_preference,
+        },
+        [handler = std::move(handler)](auto resp) mutable {
+          if (resp.ctx.ec()) {
+            return handler(core::impl::make_error(std::move(resp.ctx)), lookup_in_result{});
+          }
+          std::vector<lookup_in_result::entry> entries{};
+          entries.reserve(resp.fields.size());
+          for (auto& entry : resp.fields) {
+            entries.emplace_back(lookup_in_result::entry{
+              std::move(entry.path),
+              std::move(entry.value),
+              entry.original_index,
+              entry.exists,
+              entry.ec,
+            });
+          }
+          return handler(core::impl::make_error(std::move(resp.ctx)),
+                         lookup_in_result{ resp.cas, std::move(entries), resp.deleted });
+        });
+    }
     return core_.execute(
       core::operations::lookup_in_request{
         core::document_id{
@@ -537,6 +724,56 @@ public:
       });
   }
 
+  void upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                    upsert_options::built options,
+                    upsert_multi_handler&& handler) const
+  {
+    if (documents.empty()) {
+      return handler({});
+    }
+    if (options.persist_to != persist_to::none || options.replicate_to != replicate_to::none) {
+      // legacy durability polls every document with observe, use the regular path
+      auto barrier = std::make_shared<multi_result_barrier<mutation_result>>(documents.size(),
+                                                                             std::move(handler));
+      for (std::size_t index = 0; index < documents.size(); ++index) {
+        upsert(std::move(documents[index].first),
+               std::move(documents[index].second),
+               options,
+               [barrier, index](auto err, auto result) {
+                 barrier->set(index, std::move(err), std::move(result));
+               });
+      }
+      return;
+    }
+    std::vector<core::operations::upsert_request> requests{};
+    requests.reserve(documents.size());
+    for (auto& [document_key, value] : documents) {
+      requests.emplace_back(core::operations::upsert_request{
+        core::document_id{ bucket_name_, scope_name_, name_, std::move(document_key) },
+        std::move(value.data),
+        {},
+        {},
+        value.flags,
+        options.expiry,
+        options.durability_level,
+        options.timeout,
+        { options.retry_strategy },
+        options.preserve_expiry,
+      });
+    }
+    return core_.execute(
+      std::move(requests),
+      [handler = std::move(handler)](std::vector<core::operations::upsert_response> responses) {
+        std::vector<std::pair<error, mutation_result>> results{};
+        results.reserve(responses.size());
+        for (auto& resp : responses) {
+          results.emplace_back(core::impl::make_error(std::move(resp.ctx)),
+                               mutation_result{ resp.cas, std::move(resp.token) });
+        }
+        handler(std::move(results));
+      });
+  }
+
   void upsert(std::string document_key,
               codec::encoded_value encoded,
               upsert_options::built options,
@@ -932,6 +1169,26 @@ collection::get(std::string document_id,
   return future;
 }
 
+void
+collection::get_multi(std::vector<std::string> document_ids,
+                      const get_options& options,
+                      get_multi_handler&& handler) const
+{
+  return impl_->get_multi(std::move(document_ids), options.build(), std::move(handler));
+}
+
+auto
+collection::get_multi(std::vector<std::string> document_ids, const get_options& options) const
+  -> std::future<std::vector<std::pair<error, get_result>>>
+{
+  auto barrier = std::make_shared<std::promise<std::vector<std::pair<error, get_result>>>>();
+  auto future = barrier->get_future();
+  get_multi(std::move(document_ids), options, [barrier](auto results) {
+    barrier->set_value(std::move(results));
+  });
+  return future;
+}
+
 void
 collection::get_and_touch(std::string document_id,
                           std::chrono::seconds duration,
@@ -1094,6 +1351,27 @@ collection::remove(std::string document_id, const remove_options& options) const
   return future;
 }
 
+void
+collection::remove_multi(std::vector<std::string> document_ids,
+                         const remove_options& options,
+                         remove_multi_handler&& handler) const
+{
+  return impl_->remove_multi(std::move(document_ids), options.build(), std::move(handler));
+}
+
+auto
+collection::remove_multi(std::vector<std::string> document_ids,
+                         const remove_options& options) const
+  -> std::future<std::vector<std::pair<error, mutation_result>>>
+{
+  auto barrier = std::make_shared<std::promise<std::vector<std::pair<error, mutation_result>>>>();
+  auto future = barrier->get_future();
+  remove_multi(std::move(document_ids), options, [barrier](auto results) {
+    barrier->set_value(std::move(results));
+  });
+  return future;
+}
+
 void
 collection::mutate_in(std::string document_id,
                       const mutate_in_specs& specs,
@@ -1280,6 +1558,27 @@ collection::upsert(std::string document_id,
   return future;
 }
 
+void
+collection::upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                         const upsert_options& options,
+                         upsert_multi_handler&& handler) const
+{
+  return impl_->upsert_multi(std::move(documents), options.build(), std::move(handler));
+}
+
+auto
+collection::upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                         const upsert_options& options) const
+  -> std::future<std::vector<std::pair<error, mutation_result>>>
+{
+  auto barrier = std::make_shared<std::promise<std::vector<std::pair<error, mutation_result>>>>();
+  auto future = barrier->get_future();
+  upsert_multi(std::move(documents), options, [barrier](auto results) {
+    barrier->set_value(std::move(results));
+  });
+  return future;
+}
+
 void
 collection::insert(std::string document_id,
                    codec::encoded_value document,
@@ -0,0 +1,113 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include "core/utils/movable_function.hxx"
+
+#include <asio/error.hpp>
+#include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace couchbase::core::impl
+{
+/**
+ * Shared state of a hedged read: the read goes to the active node first, and only if it does not
+ * answer within the hedge delay, the same read is sent to a replica. The first successful
+ * response wins. A failed replica response is ignored, so that the error reported to the caller
+ * always comes from the active node, as it would for the regular read.
+ */
+template<typename Response>
+class hedged_read_context : public std::enable_shared_from_this<hedged_read_context<Response>>
+{
+public:
+  using handler_type = utils::movable_function<void(Response)>;
+
+  hedged_read_context(asio::io_context& io, handler_type&& handler)
+    : timer_{ io }
+    , handler_{ std::move(handler) }
+  {
+  }
+
+  /**
+   * Schedules send_hedge to run after the delay, unless the active node answers first.
+   */
+  void arm(std::chrono::microseconds delay, utils::movable_function<void()>&& send_hedge)
+  {
+    std::scoped_lock lock(mutex_);
+    if (done_) {
+      return;
+    }
+    timer_.expires_after(delay);
+    timer_.async_wait([self = this->shared_from_this(), send_hedge = std::move(send_hedge)](
+                        std::error_code ec) mutable {
+      if (ec == asio::error::operation_aborted) {
+        return;
+      }
+      {
+        std::scoped_lock lock(self->mutex_);
+        if (self->done_) {
+          return;
+        }
+      }
+      send_hedge();
+    });
+  }
+
+  void on_active_response(Response&& response)
+  {
+    finish(std::move(response));
+  }
+
+  void on_replica_response(Response&& response)
+  {
+    if (response.ctx.ec()) {
+      return;
+    }
+    finish(std::move(response));
+  }
+
+private:
+  void finish(Response&& response)
+  {
+    handler_type handler{};
+    {
+      std::scoped_lock lock(mutex_);
+      if (done_) {
+        return;
+      }
+      done_ = true;
+      timer_.cancel();
+      std::swap(handler, handler_);
+    }
+    if (handler) {
+      handler(std::move(response));
+    }
+  }
+
+  asio::steady_timer timer_;
+  handler_type handler_;
+  bool done_{ false };
+  std::mutex mutex_{};
+};
+} // namespace couchbase::core::impl
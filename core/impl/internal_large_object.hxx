@@ -0,0 +1,111 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include <couchbase/large_object_options.hxx>
+#include <couchbase/large_object_reader.hxx>
+#include <couchbase/large_object_writer.hxx>
+
+#include "core/cluster.hxx"
+#include "core/document_id.hxx"
+#include "large_object.hxx"
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace couchbase
+{
+class large_object_writer_impl : public std::enable_shared_from_this<large_object_writer_impl>
+{
+public:
+  large_object_writer_impl(core::cluster core,
+                           core::document_id id,
+                           large_object_options::built options);
+
+  void write(std::vector<std::byte> data, large_object_write_handler&& handler);
+  void close(large_object_close_handler&& handler);
+
+private:
+  using queued_chunk = std::pair<std::size_t, std::vector<std::byte>>;
+
+  /* must be called with the mutex held, takes the queued chunks that fit into the window */
+  auto next_uploads() -> std::vector<queued_chunk>;
+  void upload(std::size_t index, std::vector<std::byte> chunk);
+  void store_manifest(large_object_close_handler&& handler);
+  void publish_manifest(core::impl::large_object_manifest manifest,
+                        std::optional<core::impl::large_object_manifest> previous,
+                        large_object_close_handler&& handler);
+  void expire_chunk(std::shared_ptr<const core::impl::large_object_manifest> manifest,
+                    std::size_t index);
+
+  core::cluster core_;
+  core::document_id id_;
+  large_object_options::built options_;
+  const std::string generation_;
+
+  std::mutex mutex_{};
+  core::impl::large_object_chunker chunker_;
+  std::size_t number_of_chunks_{ 0 };
+  std::size_t in_flight_{ 0 };
+  std::deque<queued_chunk> queued_chunks_{};
+  std::deque<large_object_write_handler> waiting_writes_{};
+  std::optional<large_object_close_handler> close_handler_{};
+  std::optional<error> failure_{};
+  bool closed_{ false };
+};
+
+class large_object_reader_impl : public std::enable_shared_from_this<large_object_reader_impl>
+{
+public:
+  large_object_reader_impl(core::cluster core,
+                           core::document_id id,
+                           core::impl::large_object_manifest manifest,
+                           large_object_options::built options);
+
+  [[nodiscard]] auto size() const -> std::uint64_t;
+  void read(large_object_read_handler&& handler);
+
+private:
+  using chunk_result = std::pair<error, std::vector<std::byte>>;
+
+  void fetch(std::size_t index);
+  void on_chunk(std::size_t index, chunk_result result);
+  /* must be called with the mutex held, returns the chunks to fetch and the handlers to call */
+  auto advance() -> std::pair<std::vector<std::size_t>, std::vector<std::function<void()>>>;
+  [[nodiscard]] auto expected_chunk_size(std::size_t index) const -> std::size_t;
+
+  core::cluster core_;
+  core::document_id id_;
+  core::impl::large_object_manifest manifest_;
+  large_object_options::built options_;
+
+  std::mutex mutex_{};
+  std::size_t next_to_fetch_{ 0 };
+  std::size_t next_to_deliver_{ 0 };
+  std::size_t in_flight_{ 0 };
+  std::map<std::size_t, chunk_result> fetched_{};
+  std::deque<large_object_read_handler> waiting_reads_{};
+  std::optional<error> failure_{};
+};
+} // namespace couchbase
@@ -0,0 +1,140 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "large_object.hxx"
+
+#include "core/utils/json.hxx"
+
+#include <tao/json/value.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+
+namespace couchbase::core::impl
+{
+auto
+encode_large_object_manifest(const large_object_manifest& manifest) -> std::vector<std::byte>
+{
+  return utils::json::generate_binary({
+    { "size", manifest.size },
+    { "chunk_size", manifest.chunk_size },
+    { "chunks", manifest.number_of_chunks },
+    { "generation", manifest.generation },
+  });
+}
+
+auto
+decode_large_object_manifest(const std::vector<std::byte>& document)
+  -> std::optional<large_object_manifest>
+{
+  tao::json::value root;
+  try {
+    root = utils::json::parse_binary(document);
+  } catch (const std::exception&) {
+    return {};
+  }
+  if (!root.is_object()) {
+    return {};
+  }
+  const auto* size = root.find("size");
+  const auto* chunk_size = root.find("chunk_size");
+  const auto* chunks = root.find("chunks");
+  const auto* generation = root.find("generation");
+  if (size == nullptr || !size->is_integer() || chunk_size == nullptr ||
+      !chunk_size->is_integer() || chunks == nullptr || !chunks->is_integer() ||
+      generation == nullptr || !generation->is_string()) {
+    return {};
+  }
+
+  large_object_manifest manifest{
+    size->as<std::uint64_t>(),
+    chunk_size->as<std::size_t>(),
+    chunks->as<std::size_t>(),
+    generation->get_string(),
+  };
+  if (manifest.chunk_size == 0 || manifest.generation.empty()) {
+    return {};
+  }
+  auto expected_chunks = manifest.size / manifest.chunk_size;
+  if (manifest.size % manifest.chunk_size != 0) {
+    ++expected_chunks;
+  }
+  if (expected_chunks != manifest.number_of_chunks) {
+    return {};
+  }
+  return manifest;
+}
+
+auto
+large_object_chunk_key(const std::string& key, const std::string& generation, std::size_t index)
+  -> std::string
+{
+  return key + "::chunk::" + generation + "::" + std::to_string(index);
+}
+
+large_object_chunker::large_object_chunker(std::size_t chunk_size)
+  : chunk_size_{ chunk_size }
+{
+}
+
+auto
+large_object_chunker::feed(std::vector<std::byte>&& data) -> std::vector<std::vector<std::byte>>
+{
+  total_size_ += data.size();
+
+  std::vector<std::vector<std::byte>> chunks{};
+  if (pending_.empty() && data.size() == chunk_size_) {
+    chunks.emplace_back(std::move(data));
+    return chunks;
+  }
+
+  auto begin = data.begin();
+  while (begin != data.end()) {
+    if (pending_.empty()) {
+      pending_.reserve(chunk_size_);
+    }
+    auto available = static_cast<std::ptrdiff_t>(chunk_size_ - pending_.size());
+    auto end = std::next(begin, std::min(available, std::distance(begin, data.end())));
+    pending_.insert(pending_.end(), begin, end);
+    begin = end;
+    if (pending_.size() == chunk_size_) {
+      chunks.emplace_back(std::move(pending_));
+      pending_ = {};
+    }
+  }
+  return chunks;
+}
+
+auto
+large_object_chunker::flush() -> std::optional<std::vector<std::byte>>
+{
+  if (pending_.empty()) {
+    return {};
+  }
+  auto chunk = std::move(pending_);
+  pending_ = {};
+  return chunk;
+}
+
+auto
+large_object_chunker::total_size() const -> std::uint64_t
+{
+  return total_size_;
+}
+} // namespace couchbase::core::impl
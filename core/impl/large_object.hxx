@@ -0,0 +1,86 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace couchbase::core::impl
+{
+/* the server refuses documents larger than this */
+constexpr std::size_t max_large_object_chunk_size{ 20 * 1024 * 1024 };
+
+/**
+ * Describes how a large object has been split. The manifest is stored as JSON under the key of
+ * the object itself, while the chunks live in separate documents (see large_object_chunk_key()),
+ * so that they hash to different partitions and are spread across the nodes.
+ *
+ * Every upload picks a new generation and uses it in the keys of its chunks, so that rewriting
+ * the object never touches the chunks the currently published manifest refers to.
+ */
+struct large_object_manifest {
+  std::uint64_t size{};
+  std::size_t chunk_size{};
+  std::size_t number_of_chunks{};
+  std::string generation{};
+};
+
+auto
+encode_large_object_manifest(const large_object_manifest& manifest) -> std::vector<std::byte>;
+
+/**
+ * Returns empty optional if the document does not look like a manifest, or when the numbers in
+ * it contradict each other.
+ */
+auto
+decode_large_object_manifest(const std::vector<std::byte>& document)
+  -> std::optional<large_object_manifest>;
+
+auto
+large_object_chunk_key(const std::string& key, const std::string& generation, std::size_t index)
+  -> std::string;
+
+/**
+ * Cuts the stream of application buffers into chunks of fixed size. Only the tail that does not
+ * fill a chunk yet is kept, and a buffer that is exactly one chunk and arrives on a chunk
+ * boundary is passed through without copying.
+ */
+class large_object_chunker
+{
+public:
+  explicit large_object_chunker(std::size_t chunk_size);
+
+  [[nodiscard]] auto feed(std::vector<std::byte>&& data) -> std::vector<std::vector<std::byte>>;
+
+  /**
+   * Returns the remaining incomplete chunk, if any.
+   */
+  [[nodiscard]] auto flush() -> std::optional<std::vector<std::byte>>;
+
+  [[nodiscard]] auto total_size() const -> std::uint64_t;
+
+private:
+  std::size_t chunk_size_;
+  std::vector<std::byte> pending_{};
+  std::uint64_t total_size_{ 0 };
+};
+} // namespace couchbase::core::impl
@@ -0,0 +1,211 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include <couchbase/error_codes.hxx>
+#include <couchbase/large_object_reader.hxx>
+
+#include "core/impl/error.hxx"
+#include "core/operations/document_get.hxx"
+#include "internal_large_object.hxx"
+
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace couchbase
+{
+large_object_reader_impl::large_object_reader_impl(core::cluster core,
+                                                   core::document_id id,
+                                                   core::impl::large_object_manifest manifest,
+                                                   large_object_options::built options)
+  : core_{ std::move(core) }
+  , id_{ std::move(id) }
+  , manifest_{ manifest }
+  , options_{ std::move(options) }
+{
+}
+
+auto
+large_object_reader_impl::size() const -> std::uint64_t
+{
+  return manifest_.size;
+}
+
+void
+large_object_reader_impl::read(large_object_read_handler&& handler)
+{
+  std::vector<std::size_t> to_fetch{};
+  std::vector<std::function<void()>> deliveries{};
+  {
+    std::scoped_lock lock(mutex_);
+    waiting_reads_.emplace_back(std::move(handler));
+    std::tie(to_fetch, deliveries) = advance();
+  }
+  for (auto index : to_fetch) {
+    fetch(index);
+  }
+  for (auto& deliver : deliveries) {
+    deliver();
+  }
+}
+
+auto
+large_object_reader_impl::advance()
+  -> std::pair<std::vector<std::size_t>, std::vector<std::function<void()>>>
+{
+  std::vector<std::function<void()>> deliveries{};
+  while (!waiting_reads_.empty()) {
+    auto it = fetched_.find(next_to_deliver_);
+    if (!failure_ && next_to_deliver_ < manifest_.number_of_chunks && it == fetched_.end()) {
+      break;
+    }
+    auto handler = std::move(waiting_reads_.front());
+    waiting_reads_.pop_front();
+
+    if (failure_) {
+      deliveries.emplace_back([handler = std::move(handler), err = failure_.value()]() mutable {
+        handler(std::move(err), {});
+      });
+    } else if (next_to_deliver_ == manifest_.number_of_chunks) {
+      deliveries.emplace_back([handler = std::move(handler)]() mutable {
+        handler({}, {});
+      });
+    } else {
+      auto result = std::move(it->second);
+      fetched_.erase(it);
+      ++next_to_deliver_;
+      if (result.first) {
+        failure_ = result.first;
+      }
+      deliveries.emplace_back([handler = std::move(handler), result = std::move(result)]() mutable {
+        if (result.first) {
+          return handler(std::move(result.first), {});
+        }
+        handler({}, std::move(result.second));
+      });
+    }
+  }
+
+  std::vector<std::size_t> to_fetch{};
+  if (!failure_) {
+    const auto limit = std::max<std::size_t>(options_.max_in_flight_chunks, 1);
+    while (next_to_fetch_ < manifest_.number_of_chunks && in_flight_ + fetched_.size() < limit) {
+      to_fetch.emplace_back(next_to_fetch_++);
+      ++in_flight_;
+    }
+  }
+  return { std::move(to_fetch), std::move(deliveries) };
+}
+
+auto
+large_object_reader_impl::expected_chunk_size(std::size_t index) const -> std::size_t
+{
+  if (index + 1 < manifest_.number_of_chunks) {
+    return manifest_.chunk_size;
+  }
+  return static_cast<std::size_t>(manifest_.size - index * manifest_.chunk_size);
+}
+
+void
+large_object_reader_impl::fetch(std::size_t index)
+{
+  core_.execute(
+    core::operations::get_request{
+      { id_.bucket(),
+        id_.scope(),
+        id_.collection(),
+        core::impl::large_object_chunk_key(id_.key(), manifest_.generation, index) },
+      {},
+      {},
+      options_.timeout,
+      { options_.retry_strategy },
+    },
+    [self = shared_from_this(), index](auto&& resp) {
+      if (resp.ctx.ec()) {
+        return self->on_chunk(index, { core::impl::make_error(resp.ctx), {} });
+      }
+      if (resp.value.size() != self->expected_chunk_size(index)) {
+        return self->on_chunk(
+          index,
+          { error(errc::common::decoding_failure,
+                  "chunk #" + std::to_string(index) + " does not match large object manifest"),
+            {} });
+      }
+      self->on_chunk(index, { {}, std::move(resp.value) });
+    });
+}
+
+void
+large_object_reader_impl::on_chunk(std::size_t index, chunk_result result)
+{
+  std::vector<std::size_t> to_fetch{};
+  std::vector<std::function<void()>> deliveries{};
+  {
+    std::scoped_lock lock(mutex_);
+    --in_flight_;
+    fetched_.try_emplace(index, std::move(result));
+    std::tie(to_fetch, deliveries) = advance();
+  }
+  for (auto fetch_index : to_fetch) {
+    fetch(fetch_index);
+  }
+  for (auto& deliver : deliveries) {
+    deliver();
+  }
+}
+
+large_object_reader::large_object_reader(std::shared_ptr<large_object_reader_impl> impl)
+  : impl_{ std::move(impl) }
+{
+}
+
+auto
+large_object_reader::size() const -> std::uint64_t
+{
+  if (!impl_) {
+    return 0;
+  }
+  return impl_->size();
+}
+
+void
+large_object_reader::read(large_object_read_handler&& handler) const
+{
+  if (!impl_) {
+    return handler({}, {});
+  }
+  return impl_->read(std::move(handler));
+}
+
+auto
+large_object_reader::read() const
+  -> std::future<std::pair<error, std::optional<std::vector<std::byte>>>>
+{
+  auto barrier =
+    std::make_shared<std::promise<std::pair<error, std::optional<std::vector<std::byte>>>>>();
+  auto future = barrier->get_future();
+  read([barrier](auto err, auto chunk) {
+    barrier->set_value({ std::move(err), std::move(chunk) });
+  });
+  return future;
+}
+} // namespace couchbase
@@ -0,0 +1,344 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include <couchbase/codec/codec_flags.hxx>
+#include <couchbase/error_codes.hxx>
+#include <couchbase/large_object_writer.hxx>
+
+#include "core/impl/error.hxx"
+#include "core/operations/document_get.hxx"
+#include "core/operations/document_touch.hxx"
+#include "core/operations/document_upsert.hxx"
+#include "core/platform/uuid.h"
+#include "internal_large_object.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <utility>
+
+namespace couchbase
+{
+namespace
+{
+auto
+validate(const large_object_options::built& options) -> std::optional<error>
+{
+  if (options.chunk_size == 0 || options.chunk_size > core::impl::max_large_object_chunk_size) {
+    return error(errc::common::invalid_argument,
+                 "chunk size of large object must be positive and not exceed 20 MiB");
+  }
+  return {};
+}
+} // namespace
+
+large_object_writer_impl::large_object_writer_impl(core::cluster core,
+                                                   core::document_id id,
+                                                   large_object_options::built options)
+  : core_{ std::move(core) }
+  , id_{ std::move(id) }
+  , options_{ std::move(options) }
+  , generation_{ core::uuid::to_string(core::uuid::random()) }
+  , chunker_{ options_.chunk_size }
+  , failure_{ validate(options_) }
+{
+}
+
+void
+large_object_writer_impl::write(std::vector<std::byte> data, large_object_write_handler&& handler)
+{
+  std::vector<queued_chunk> uploads{};
+  std::optional<error> rejection{};
+  bool deferred{ false };
+  {
+    std::scoped_lock lock(mutex_);
+    if (closed_) {
+      rejection = error(errc::common::request_canceled, "large object writer has been closed");
+    } else if (failure_) {
+      rejection = failure_;
+    } else {
+      for (auto& data_chunk : chunker_.feed(std::move(data))) {
+        queued_chunks_.emplace_back(number_of_chunks_++, std::move(data_chunk));
+      }
+      uploads = next_uploads();
+      if (!queued_chunks_.empty()) {
+        waiting_writes_.emplace_back(std::move(handler));
+        deferred = true;
+      }
+    }
+  }
+
+  for (auto& [index, data_chunk] : uploads) {
+    upload(index, std::move(data_chunk));
+  }
+  if (rejection) {
+    return handler(std::move(rejection.value()));
+  }
+  if (!deferred) {
+    handler({});
+  }
+}
+
+void
+large_object_writer_impl::close(large_object_close_handler&& handler)
+{
+  std::vector<queued_chunk> uploads{};
+  bool deferred{ false };
+  {
+    std::scoped_lock lock(mutex_);
+    if (closed_) {
+      return handler(error(errc::common::request_canceled, "large object writer has been closed"),
+                     {});
+    }
+    closed_ = true;
+    if (!failure_) {
+      if (auto tail = chunker_.flush(); tail) {
+        queued_chunks_.emplace_back(number_of_chunks_++, std::move(tail.value()));
+      }
+    }
+    uploads = next_uploads();
+    if (in_flight_ > 0 || !queued_chunks_.empty()) {
+      close_handler_.emplace(std::move(handler));
+      deferred = true;
+    }
+  }
+
+  for (auto& [index, data_chunk] : uploads) {
+    upload(index, std::move(data_chunk));
+  }
+  if (!deferred) {
+    store_manifest(std::move(handler));
+  }
+}
+
+auto
+large_object_writer_impl::next_uploads() -> std::vector<queued_chunk>
+{
+  std::vector<queued_chunk> uploads{};
+  if (failure_) {
+    queued_chunks_.clear();
+    return uploads;
+  }
+  const auto limit = std::max<std::size_t>(options_.max_in_flight_chunks, 1);
+  while (!queued_chunks_.empty() && in_flight_ < limit) {
+    uploads.emplace_back(std::move(queued_chunks_.front()));
+    queued_chunks_.pop_front();
+    ++in_flight_;
+  }
+  return uploads;
+}
+
+void
+large_object_writer_impl::upload(std::size_t index, std::vector<std::byte> chunk)
+{
+  core_.execute(
+    core::operations::upsert_request{
+      { id_.bucket(),
+        id_.scope(),
+        id_.collection(),
+        core::impl::large_object_chunk_key(id_.key(), generation_, index) },
+      std::move(chunk),
+      {},
+      {},
+      codec::codec_flags::binary_common_flags,
+      0,
+      options_.durability_level,
+      options_.timeout,
+      { options_.retry_strategy },
+    },
+    [self = shared_from_this()](auto&& resp) {
+      std::vector<queued_chunk> uploads{};
+      std::vector<large_object_write_handler> resumed{};
+      std::optional<large_object_close_handler> close_handler{};
+      error status{};
+      {
+        std::scoped_lock lock(self->mutex_);
+        --self->in_flight_;
+        if (resp.ctx.ec() && !self->failure_) {
+          self->failure_ = core::impl::make_error(resp.ctx);
+        }
+        uploads = self->next_uploads();
+        if (self->queued_chunks_.empty()) {
+          while (!self->waiting_writes_.empty()) {
+            resumed.emplace_back(std::move(self->waiting_writes_.front()));
+            self->waiting_writes_.pop_front();
+          }
+        }
+        if (self->in_flight_ == 0 && self->queued_chunks_.empty() && self->close_handler_) {
+          close_handler = std::move(self->close_handler_);
+          self->close_handler_.reset();
+        }
+        if (self->failure_) {
+          status = self->failure_.value();
+        }
+      }
+
+      for (auto& [next_index, next_chunk] : uploads) {
+        self->upload(next_index, std::move(next_chunk));
+      }
+      for (auto& handler : resumed) {
+        handler(status);
+      }
+      if (close_handler) {
+        self->store_manifest(std::move(close_handler.value()));
+      }
+    });
+}
+
+void
+large_object_writer_impl::store_manifest(large_object_close_handler&& handler)
+{
+  core::impl::large_object_manifest manifest{};
+  {
+    std::scoped_lock lock(mutex_);
+    if (failure_) {
+      return handler(failure_.value(), {});
+    }
+    manifest = { chunker_.total_size(), options_.chunk_size, number_of_chunks_, generation_ };
+  }
+
+  /* look up the manifest that is about to be replaced, to clean up its chunks afterwards */
+  core_.execute(
+    core::operations::get_request{
+      id_,
+      {},
+      {},
+      options_.timeout,
+      { options_.retry_strategy },
+    },
+    [self = shared_from_this(), manifest = std::move(manifest), handler = std::move(handler)](
+      auto&& resp) mutable {
+      std::optional<core::impl::large_object_manifest> previous{};
+      if (!resp.ctx.ec()) {
+        previous = core::impl::decode_large_object_manifest(resp.value);
+      }
+      self->publish_manifest(std::move(manifest), std::move(previous), std::move(handler));
+    });
+}
+
+void
+large_object_writer_impl::publish_manifest(
+  core::impl::large_object_manifest manifest,
+  std::optional<core::impl::large_object_manifest> previous,
+  large_object_close_handler&& handler)
+{
+  core_.execute(
+    core::operations::upsert_request{
+      id_,
+      core::impl::encode_large_object_manifest(manifest),
+      {},
+      {},
+      codec::codec_flags::json_common_flags,
+      0,
+      options_.durability_level,
+      options_.timeout,
+      { options_.retry_strategy },
+    },
+    [self = shared_from_this(), previous = std::move(previous), handler = std::move(handler)](
+      auto&& resp) mutable {
+      if (resp.ctx.ec()) {
+        return handler(core::impl::make_error(std::move(resp.ctx)), mutation_result{});
+      }
+      handler(core::impl::make_error(std::move(resp.ctx)),
+              mutation_result{ resp.cas, std::move(resp.token) });
+
+      if (!previous || previous->generation == self->generation_) {
+        return;
+      }
+      /*
+       * the replaced chunks are garbage for new readers, but readers that opened the old manifest
+       * might still fetch them, so they expire after the grace period instead of being removed
+       */
+      auto replaced = std::make_shared<const core::impl::large_object_manifest>(
+        std::move(previous.value()));
+      const auto lanes = std::min(std::max<std::size_t>(self->options_.max_in_flight_chunks, 1),
+                                  replaced->number_of_chunks);
+      for (std::size_t index = 0; index < lanes; ++index) {
+        self->expire_chunk(replaced, index);
+      }
+    });
+}
+
+void
+large_object_writer_impl::expire_chunk(
+  std::shared_ptr<const core::impl::large_object_manifest> manifest,
+  std::size_t index)
+{
+  /* relative expiry must not exceed 30 days, larger values are treated as absolute timestamps */
+  const auto grace_period = std::clamp<std::chrono::seconds>(options_.replaced_chunks_grace_period,
+                                                             std::chrono::seconds{ 1 },
+                                                             std::chrono::hours{ 24 * 30 });
+  auto key = core::impl::large_object_chunk_key(id_.key(), manifest->generation, index);
+  core_.execute(
+    core::operations::touch_request{
+      { id_.bucket(), id_.scope(), id_.collection(), std::move(key) },
+      {},
+      {},
+      static_cast<std::uint32_t>(grace_period.count()),
+      options_.timeout,
+      { options_.retry_strategy },
+    },
+    [self = shared_from_this(), manifest = std::move(manifest), index](auto&& /* resp */) mutable {
+      /* every lane walks over the chunks with the stride of the window */
+      const auto next = index + std::max<std::size_t>(self->options_.max_in_flight_chunks, 1);
+      if (next < manifest->number_of_chunks) {
+        self->expire_chunk(std::move(manifest), next);
+      }
+    });
+}
+
+large_object_writer::large_object_writer(std::shared_ptr<large_object_writer_impl> impl)
+  : impl_{ std::move(impl) }
+{
+}
+
+void
+large_object_writer::write(std::vector<std::byte> data, large_object_write_handler&& handler) const
+{
+  return impl_->write(std::move(data), std::move(handler));
+}
+
+auto
+large_object_writer::write(std::vector<std::byte> data) const -> std::future<error>
+{
+  auto barrier = std::make_shared<std::promise<error>>();
+  auto future = barrier->get_future();
+  write(std::move(data), [barrier](auto err) {
+    barrier->set_value(std::move(err));
+  });
+  return future;
+}
+
+void
+large_object_writer::close(large_object_close_handler&& handler) const
+{
+  return impl_->close(std::move(handler));
+}
+
+auto
+large_object_writer::close() const -> std::future<std::pair<error, mutation_result>>
+{
+  auto barrier = std::make_shared<std::promise<std::pair<error, mutation_result>>>();
+  auto future = barrier->get_future();
+  close([barrier](auto err, auto result) {
+    barrier->set_value({ std::move(err), std::move(result) });
+  });
+  return future;
+}
+} // namespace couchbase
@@ -24,8 +24,15 @@
 
 #include <asio/steady_timer.hpp>
 
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <tuple>
+#include <vector>
 
 namespace couchbase::core::impl
 {
@@ -117,11 +124,23 @@ validate_replicas(const topology::configuration& config,
   return { {}, 0 };
 }
 
-class observe_status
+constexpr std::chrono::milliseconds min_poll_interval{ 1 };
+constexpr std::chrono::milliseconds max_poll_interval{ 500 };
+constexpr std::chrono::milliseconds poll_deadline_interval{ 5'000 };
+
+class observe_waiter
 {
 public:
-  explicit observe_status(mutation_token token)
-    : token_(std::move(token))
+  observe_waiter(asio::io_context& io,
+                 mutation_token token,
+                 couchbase::persist_to persist_to,
+                 couchbase::replicate_to replicate_to,
+                 observe_handler&& handler)
+    : deadline_{ io }
+    , token_{ std::move(token) }
+    , persist_to_{ persist_to }
+    , replicate_to_{ replicate_to }
+    , handler_{ std::move(handler) }
   {
   }
 
@@ -130,232 +149,360 @@ public:
     return token_;
   }
 
-  void reset()
+  [[nodiscard]] auto persist_to() const -> couchbase::persist_to
   {
-    std::scoped_lock lock(mutex_);
-    replicated_ = 0;
-    persisted_ = 0;
-    persisted_on_active_ = false;
+    return persist_to_;
   }
 
-  void examine(const observe_seqno_response& response)
+  [[nodiscard]] auto replicate_to() const -> couchbase::replicate_to
   {
-    std::scoped_lock lock(mutex_);
-    bool replicated = response.current_sequence_number >= token_.sequence_number();
-    bool persisted = response.last_persisted_sequence_number >= token_.sequence_number();
-
-    replicated_ += (replicated && !response.active) ? 1 : 0;
-    persisted_ += persisted ? 1 : 0;
-    persisted_on_active_ |= (response.active && persisted);
+    return replicate_to_;
   }
 
-  [[nodiscard]] auto meets_condition(couchbase::persist_to persist_to,
-                                     couchbase::replicate_to replicate_to) const -> bool
+  [[nodiscard]] auto deadline() -> asio::steady_timer&
   {
-    auto persistence_condition = (persist_to == persist_to::active && persisted_on_active_) ||
-                                 (persisted_ >= number_of_replica_nodes_required(persist_to));
-    auto replication_condition = replicated_ >= number_of_replica_nodes_required(replicate_to);
-    return persistence_condition && replication_condition;
+    return deadline_;
   }
 
-private:
-  mutation_token token_;
-  std::size_t replicated_{ 0 };
-  std::size_t persisted_{ 0 };
-  bool persisted_on_active_{ false };
-  mutable std::mutex mutex_{};
-};
-
-class observe_context;
-void
-observe_poll(cluster core, std::shared_ptr<observe_context> ctx);
-
-class observe_context : public std::enable_shared_from_this<observe_context>
-{
-public:
-  observe_context(asio::io_context& io,
-                  document_id id,
-                  mutation_token token,
-                  std::optional<std::chrono::milliseconds> timeout,
-                  couchbase::persist_to persist_to,
-                  couchbase::replicate_to replicate_to,
-                  observe_handler&& handler)
-    : poll_deadline_{ io }
-    , poll_backoff_{ io }
-    , id_{ std::move(id) }
-    , status_{ std::move(token) }
-    , timeout_{ timeout }
-    , persist_to_{ persist_to }
-    , replicate_to_{ replicate_to }
-    , handler_{ std::move(handler) }
+  [[nodiscard]] auto registered_at() const -> std::chrono::steady_clock::time_point
   {
+    return registered_at_;
   }
 
-  void start()
+  /**
+   * Sequence numbers only grow (until failover), so the state of every node is remembered across
+   * the poll rounds.
+   */
+  void examine(std::uint32_t node_index, const observe_seqno_response& response)
   {
-    poll_deadline_.expires_after(poll_deadline_interval_);
-    poll_deadline_.async_wait([ctx = shared_from_this()](std::error_code ec) {
-      if (ec == asio::error::operation_aborted) {
-        return;
-      }
-      ctx->finish(errc::common::ambiguous_timeout);
-    });
+    if (response.current_sequence_number >= token_.sequence_number() && !response.active) {
+      replicated_.set(node_index);
+    }
+    if (response.last_persisted_sequence_number >= token_.sequence_number()) {
+      persisted_.set(node_index);
+      persisted_on_active_ |= response.active;
+    }
   }
 
-  [[nodiscard]] auto id() const -> const document_id&
+  [[nodiscard]] auto meets_condition() const -> bool
   {
-    return id_;
+    auto persistence_condition =
+      (persist_to_ == persist_to::active && persisted_on_active_) ||
+      (persisted_.count() >= number_of_replica_nodes_required(persist_to_));
+    auto replication_condition =
+      replicated_.count() >= number_of_replica_nodes_required(replicate_to_);
+    return persistence_condition && replication_condition;
   }
 
-  [[nodiscard]] auto bucket_name() const -> const std::string&
+  [[nodiscard]] auto finished() const -> bool
   {
-    return id_.bucket();
+    std::scoped_lock lock(handler_mutex_);
+    return !handler_;
   }
 
-  [[nodiscard]] auto partition_uuid() const -> std::uint64_t
+  void finish(std::error_code ec)
   {
-    return status_.token().partition_uuid();
+    deadline_.cancel();
+    observe_handler handler{};
+    {
+      std::scoped_lock lock(handler_mutex_);
+      std::swap(handler_, handler);
+    }
+    if (handler) {
+      handler(ec);
+    }
   }
 
-  [[nodiscard]] auto timeout() const -> const std::optional<std::chrono::milliseconds>&
-  {
-    return timeout_;
-  }
+private:
+  asio::steady_timer deadline_;
+  const mutation_token token_;
+  const couchbase::persist_to persist_to_;
+  const couchbase::replicate_to replicate_to_;
+  const std::chrono::steady_clock::time_point registered_at_{ std::chrono::steady_clock::now() };
+  /* indexed by node index, where zero is the active node */
+  std::bitset<4> replicated_{};
+  std::bitset<4> persisted_{};
+  bool persisted_on_active_{ false };
+  mutable std::mutex handler_mutex_{};
+  observe_handler handler_;
+};
 
-  [[nodiscard]] auto persist_to() const -> couchbase::persist_to
+/* bucket name, partition, partition UUID, number of replicas and timeout of the requests */
+using observe_group_key = std::tuple<std::string,
+                                     std::uint16_t,
+                                     std::uint64_t,
+                                     std::uint32_t,
+                                     std::optional<std::chrono::milliseconds>>;
+
+/**
+ * Waiters for the same partition (and partition UUID) of the bucket. The number of polled replicas
+ * and the timeout of the requests are fixed when the group is created, so they are part of the
+ * key, and waiters with different values poll in separate groups.
+ */
+struct observe_group {
+  observe_group(asio::io_context& io,
+                observe_group_key key,
+                document_id id,
+                std::uint64_t partition_uuid,
+                std::uint32_t number_of_replicas,
+                std::optional<std::chrono::milliseconds> timeout)
+    : backoff{ io }
+    , key{ std::move(key) }
+    , id{ std::move(id) }
+    , partition_uuid{ partition_uuid }
+    , number_of_replicas{ number_of_replicas }
+    , timeout{ timeout }
   {
-    return persist_to_;
   }
 
-  [[nodiscard]] auto replicate_to() const -> couchbase::replicate_to
+  asio::steady_timer backoff;
+  const observe_group_key key;
+  /* any document of the partition, used to route the requests */
+  const document_id id;
+  const std::uint64_t partition_uuid;
+  const std::uint32_t number_of_replicas;
+  const std::optional<std::chrono::milliseconds> timeout;
+  std::vector<std::shared_ptr<observe_waiter>> waiters{};
+  std::size_t pending_responses{ 0 };
+  bool completed_in_round{ false };
+  bool closed{ false };
+  std::chrono::nanoseconds backoff_interval{ min_poll_interval };
+};
+} // namespace
+
+class observe_engine_impl : public std::enable_shared_from_this<observe_engine_impl>
+{
+public:
+  explicit observe_engine_impl(asio::io_context& io)
+    : io_{ io }
   {
-    return replicate_to_;
   }
 
-  void add_request(observe_seqno_request&& request)
+  void observe(cluster core,
+               document_id id,
+               mutation_token token,
+               std::optional<std::chrono::milliseconds> timeout,
+               couchbase::persist_to persist_to,
+               couchbase::replicate_to replicate_to,
+               observe_handler&& handler)
   {
-    requests_.emplace_back(std::move(request));
+    auto waiter = std::make_shared<observe_waiter>(
+      io_, std::move(token), persist_to, replicate_to, std::move(handler));
+    waiter->deadline().expires_after(poll_deadline_interval);
+    waiter->deadline().async_wait([waiter](std::error_code ec) {
+      if (ec == asio::error::operation_aborted) {
+        return;
+      }
+      // the group drops finished waiters when it examines the next response
+      waiter->finish(errc::common::ambiguous_timeout);
+    });
+
+    const std::string bucket_name = id.bucket();
+    core.with_bucket_configuration(
+      bucket_name,
+      [self = shared_from_this(), core, id = std::move(id), timeout, waiter](
+        std::error_code ec, const topology::configuration& config) mutable {
+        if (ec) {
+          return waiter->finish(ec);
+        }
+        auto [err, number_of_replicas] =
+          validate_replicas(config, waiter->persist_to(), waiter->replicate_to());
+        if (err) {
+          return waiter->finish(err);
+        }
+        if (waiter->meets_condition()) {
+          return waiter->finish({});
+        }
+        self->enqueue(std::move(core), std::move(id), timeout, number_of_replicas, waiter);
+      });
   }
 
-  void handle_response(observe_seqno_response&& response)
+private:
+  void enqueue(cluster core,
+               document_id id,
+               std::optional<std::chrono::milliseconds> timeout,
+               std::uint32_t number_of_replicas,
+               std::shared_ptr<observe_waiter> waiter)
   {
-    --expect_number_of_responses_;
-    auto r = std::move(response);
-    status_.examine(r);
-    maybe_finish();
+    std::shared_ptr<observe_group> group{};
+    {
+      std::scoped_lock lock(mutex_);
+      const auto& token = waiter->token();
+      observe_group_key key{
+        id.bucket(), token.partition_id(), token.partition_uuid(), number_of_replicas, timeout,
+      };
+      auto& entry = groups_[key];
+      if (entry) {
+        // the next round of the group will include this waiter
+        entry->waiters.emplace_back(std::move(waiter));
+        return;
+      }
+      entry = std::make_shared<observe_group>(
+        io_, std::move(key), std::move(id), token.partition_uuid(), number_of_replicas, timeout);
+      entry->waiters.emplace_back(std::move(waiter));
+      group = entry;
+    }
+    poll(std::move(core), std::move(group));
   }
 
-  void finish(std::error_code ec)
+  void poll(cluster core, std::shared_ptr<observe_group> group)
   {
-    poll_backoff_.cancel();
-    poll_deadline_.cancel();
-    observe_handler handler{};
+    std::vector<std::pair<std::uint32_t, observe_seqno_request>> requests{};
     {
-      std::scoped_lock lock(handler_mutex_);
-      std::swap(handler_, handler);
+      std::scoped_lock lock(mutex_);
+      if (group->closed) {
+        return;
+      }
+      bool observe_active = false;
+      bool observe_replicas = false;
+      for (const auto& waiter : group->waiters) {
+        observe_active |= waiter->persist_to() != persist_to::none;
+        observe_replicas |= touches_replica(waiter->persist_to(), waiter->replicate_to());
+      }
+      if (observe_active) {
+        requests.emplace_back(
+          0, observe_seqno_request{ group->id, true, group->partition_uuid, group->timeout });
+      }
+      if (observe_replicas) {
+        for (std::uint32_t replica_index = 1; replica_index <= group->number_of_replicas;
+             ++replica_index) {
+          auto replica_id = group->id;
+          replica_id.node_index(replica_index);
+          requests.emplace_back(
+            replica_index,
+            observe_seqno_request{ replica_id, false, group->partition_uuid, group->timeout });
+        }
+      }
+      if (requests.empty()) {
+        return close(group);
+      }
+      group->pending_responses = requests.size();
+      group->completed_in_round = false;
     }
-    if (handler) {
-      handler(ec);
+    for (auto& [node_index, request] : requests) {
+      core.execute(std::move(request),
+                   [self = shared_from_this(), core, group, node_index = node_index](
+                     observe_seqno_response&& response) mutable {
+                     self->handle_response(std::move(core), group, node_index, response);
+                   });
     }
   }
 
-  void maybe_finish()
+  void handle_response(cluster core,
+                       const std::shared_ptr<observe_group>& group,
+                       std::uint32_t node_index,
+                       const observe_seqno_response& response)
   {
-    observe_handler handler{};
+    std::vector<std::shared_ptr<observe_waiter>> satisfied{};
     {
-      std::scoped_lock lock(handler_mutex_);
-      if (!handler_) {
-        return;
+      std::scoped_lock lock(mutex_);
+      const auto now = std::chrono::steady_clock::now();
+      auto& waiters = group->waiters;
+      for (auto it = waiters.begin(); it != waiters.end();) {
+        auto& waiter = *it;
+        if (!response.ctx.ec()) {
+          waiter->examine(node_index, response);
+        }
+        if (waiter->finished()) {
+          it = waiters.erase(it);
+        } else if (waiter->meets_condition()) {
+          record_lag(now - waiter->registered_at());
+          group->completed_in_round = true;
+          satisfied.emplace_back(std::move(waiter));
+          it = waiters.erase(it);
+        } else {
+          ++it;
+        }
       }
-      if (status_.meets_condition(persist_to_, replicate_to_)) {
-        std::swap(handler_, handler);
-      } else if (expect_number_of_responses_ == 0 && on_last_response_) {
-        poll_backoff_.expires_after(poll_backoff_interval_);
-        return poll_backoff_.async_wait(std::move(on_last_response_));
+
+      if (--group->pending_responses == 0) {
+        if (waiters.empty()) {
+          close(group);
+        } else {
+          group->backoff.expires_after(next_interval(*group));
+          group->backoff.async_wait(
+            [self = shared_from_this(), core = std::move(core), group](std::error_code ec) mutable {
+              if (ec == asio::error::operation_aborted) {
+                return;
+              }
+              self->poll(std::move(core), std::move(group));
+            });
+        }
       }
     }
-    if (handler) {
-      handler({});
+    for (const auto& waiter : satisfied) {
+      waiter->finish({});
     }
   }
 
-  void on_last_response(std::size_t expected_number_of_responses,
-                        utils::movable_function<void(std::error_code)> handler)
+  /* must be called with mutex_ locked */
+  void close(const std::shared_ptr<observe_group>& group)
   {
-    expect_number_of_responses_ = expected_number_of_responses;
-    on_last_response_ = std::move(handler);
+    group->closed = true;
+    group->backoff.cancel();
+    if (auto it = groups_.find(group->key); it != groups_.end() && it->second == group) {
+      groups_.erase(it);
+    }
   }
 
-  void execute(cluster core)
+  /**
+   * The replication lag is measured as the time between registration of the waiter and the
+   * response that satisfied it. The exponentially weighted average of the lag sets the pace of
+   * the rounds, while the groups that make no progress back off exponentially up to the limit.
+   *
+   * Must be called with mutex_ locked.
+   */
+  void record_lag(std::chrono::steady_clock::duration lag)
   {
-    auto requests = std::move(requests_);
-    status_.reset();
-    on_last_response(requests.size(), [core, ctx = shared_from_this()](std::error_code ec) mutable {
-      if (ec == asio::error::operation_aborted) {
-        return;
-      }
-      observe_poll(std::move(core), std::move(ctx));
-    });
-    for (auto&& request : requests) {
-      core.execute(std::move(request),
-                   [ctx = shared_from_this()](observe_seqno_response&& response) {
-                     ctx->handle_response(std::move(response));
-                   });
+    if (lag_estimate_ == std::chrono::nanoseconds::zero()) {
+      lag_estimate_ = lag;
+    } else {
+      lag_estimate_ = (lag_estimate_ * 7 + lag) / 8;
     }
   }
 
-private:
-  asio::steady_timer poll_deadline_;
-  asio::steady_timer poll_backoff_;
-  const document_id id_;
-  observe_status status_;
-  std::optional<std::chrono::milliseconds> timeout_;
-  couchbase::persist_to persist_to_;
-  couchbase::replicate_to replicate_to_;
-  std::vector<observe_seqno_request> requests_{};
-  std::atomic_size_t expect_number_of_responses_{};
-  std::mutex handler_mutex_{};
-  observe_handler handler_{};
-  utils::movable_function<void(std::error_code)> on_last_response_{};
-  std::chrono::milliseconds poll_backoff_interval_{ 500 };
-  std::chrono::milliseconds poll_deadline_interval_{ 5'000 };
+  /* must be called with mutex_ locked */
+  auto next_interval(observe_group& group) const -> std::chrono::nanoseconds
+  {
+    const auto derived = std::clamp<std::chrono::nanoseconds>(
+      lag_estimate_ / 2, min_poll_interval, max_poll_interval);
+    if (group.completed_in_round) {
+      group.backoff_interval = derived;
+    } else {
+      group.backoff_interval = std::clamp<std::chrono::nanoseconds>(
+        std::max(group.backoff_interval * 2, derived), min_poll_interval, max_poll_interval);
+    }
+    return group.backoff_interval;
+  }
+
+  asio::io_context& io_;
+  std::mutex mutex_{};
+  std::map<observe_group_key, std::shared_ptr<observe_group>> groups_{};
+  std::chrono::nanoseconds lag_estimate_{ 0 };
 };
 
-void
-observe_poll(cluster core, std::shared_ptr<observe_context> ctx)
+observe_engine::observe_engine(asio::io_context& io)
+  : impl_{ std::make_shared<observe_engine_impl>(io) }
 {
-  const std::string bucket_name = ctx->bucket_name();
-  core.with_bucket_configuration(
-    bucket_name,
-    [core, ctx = std::move(ctx)](std::error_code ec,
-                                 const core::topology::configuration& config) mutable {
-      if (ec) {
-        return ctx->finish(ec);
-      }
-      auto [err, number_of_replicas] =
-        validate_replicas(config, ctx->persist_to(), ctx->replicate_to());
-      if (err) {
-        return ctx->finish(err);
-      }
-
-      if (ctx->persist_to() != persist_to::none) {
-        ctx->add_request(
-          observe_seqno_request{ ctx->id(), true, ctx->partition_uuid(), ctx->timeout() });
-      }
+}
 
-      if (touches_replica(ctx->persist_to(), ctx->replicate_to())) {
-        for (std::uint32_t replica_index = 1; replica_index <= number_of_replicas;
-             ++replica_index) {
-          auto replica_id = ctx->id();
-          replica_id.node_index(replica_index);
-          ctx->add_request(
-            observe_seqno_request{ replica_id, false, ctx->partition_uuid(), ctx->timeout() });
-        }
-      }
-      ctx->execute(core);
-    });
+void
+observe_engine::observe(cluster core,
+                        document_id id,
+                        mutation_token token,
+                        std::optional<std::chrono::milliseconds> timeout,
+                        couchbase::persist_to persist_to,
+                        couchbase::replicate_to replicate_to,
+                        observe_handler&& handler) const
+{
+  return impl_->observe(std::move(core),
+                        std::move(id),
+                        std::move(token),
+                        timeout,
+                        persist_to,
+                        replicate_to,
+                        std::move(handler));
 }
-} // namespace
 
 void
 initiate_observe_poll(cluster core,
@@ -366,14 +513,13 @@ initiate_observe_poll(cluster core,
                       couchbase::replicate_to replicate_to,
                       observe_handler&& handler)
 {
-  auto ctx = std::make_shared<observe_context>(core.io_context(),
-                                               std::move(id),
-                                               std::move(token),
-                                               timeout,
-                                               persist_to,
-                                               replicate_to,
-                                               std::move(handler));
-  ctx->start();
-  return observe_poll(std::move(core), std::move(ctx));
+  auto engine = core.observe_engine();
+  return engine.observe(std::move(core),
+                        std::move(id),
+                        std::move(token),
+                        timeout,
+                        persist_to,
+                        replicate_to,
+                        std::move(handler));
 }
 } // namespace couchbase::core::impl
@@ -29,6 +29,11 @@
 #include <functional>
 #include <memory>
 
+namespace asio
+{
+class io_context;
+} // namespace asio
+
 namespace couchbase::core
 {
 class cluster;
@@ -37,6 +42,33 @@ namespace impl
 {
 using observe_handler = utils::movable_function<void(std::error_code)>;
 
+class observe_engine_impl;
+
+/**
+ * Polls the nodes for the legacy durability requirements (persist_to/replicate_to).
+ *
+ * The mutations waiting for the same partition share observe_seqno requests, so each poll
+ * round costs one request per node involved, regardless of the number of waiters. Every waiter
+ * completes as soon as a response satisfies its sequence number, and the delay between rounds
+ * follows the replication lag observed for the previous mutations.
+ */
+class observe_engine
+{
+public:
+  explicit observe_engine(asio::io_context& io);
+
+  void observe(cluster core,
+               document_id id,
+               mutation_token token,
+               std::optional<std::chrono::milliseconds> timeout,
+               couchbase::persist_to persist_to,
+               couchbase::replicate_to replicate_to,
+               observe_handler&& handler) const;
+
+private:
+  std::shared_ptr<observe_engine_impl> impl_;
+};
+
 void
 initiate_observe_poll(cluster core,
                       document_id id,
@@ -63,4 +63,29 @@ effective_nodes(const document_id& id,
   }
   return available_nodes;
 }
+
+auto
+hedge_replica(const document_id& id,
+              const topology::configuration& config,
+              const read_preference& preference,
+              const std::string& preferred_server_group) -> std::optional<document_id>
+{
+  std::optional<document_id> fallback{};
+  for (const auto& node : effective_nodes(id, config, preference, preferred_server_group)) {
+    if (!node.is_replica) {
+      continue;
+    }
+    document_id replica_id{ id };
+    replica_id.node_index(node.index);
+    auto [vbid, server] = config.map_key(id.key(), node.index);
+    if (preferred_server_group.empty() ||
+        config.nodes[server.value()].server_group == preferred_server_group) {
+      return replica_id;
+    }
+    if (!fallback) {
+      fallback = std::move(replica_id);
+    }
+  }
+  return fallback;
+}
 } // namespace couchbase::core::impl
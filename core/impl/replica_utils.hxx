@@ -23,6 +23,7 @@
 
 #include "couchbase/read_preference.hxx"
 
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -45,4 +46,17 @@ effective_nodes(const document_id& id,
                 const topology::configuration& config,
                 const read_preference& preference,
                 const std::string& preferred_server_group) -> std::vector<readable_node>;
+
+/**
+ * Picks the replica for the second request of a hedged read among the effective nodes. Replicas
+ * in the preferred server group win over the others, so that the hedge does not cross zones when
+ * it does not have to.
+ *
+ * Returns empty optional when no replica is allowed by the read preference.
+ */
+auto
+hedge_replica(const document_id& id,
+              const topology::configuration& config,
+              const read_preference& preference,
+              const std::string& preferred_server_group) -> std::optional<document_id>;
 } // namespace couchbase::core::impl
@@ -0,0 +1,256 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "splice_projections.hxx"
+
+#include <charconv>
+#include <map>
+#include <variant>
+
+namespace couchbase::core::impl::subdoc
+{
+namespace
+{
+using path_component = std::variant<std::string_view, std::int64_t>;
+
+auto
+parse_path(std::string_view path) -> std::optional<std::vector<path_component>>
+{
+  std::vector<path_component> components{};
+  std::size_t offset = 0;
+  while (offset < path.size()) {
+    if (path[offset] == '[') {
+      const auto close = path.find(']', offset);
+      if (close == std::string_view::npos) {
+        return {};
+      }
+      std::int64_t index{};
+      const auto* first = path.data() + offset + 1;
+      const auto* last = path.data() + close;
+      if (auto [ptr, ec] = std::from_chars(first, last, index); ec != std::errc{} || ptr != last) {
+        return {};
+      }
+      components.emplace_back(index);
+      offset = close + 1;
+      if (offset < path.size() && path[offset] == '.') {
+        ++offset;
+      }
+    } else {
+      const auto end = path.find_first_of(".[", offset);
+      components.emplace_back(path.substr(offset, end - offset));
+      if (end == std::string_view::npos) {
+        break;
+      }
+      offset = path[end] == '.' ? end + 1 : end;
+    }
+  }
+  if (components.empty()) {
+    return {};
+  }
+  return components;
+}
+
+enum class node_type {
+  null,
+  object,
+  array,
+  fragment,
+};
+
+struct node {
+  node_type type{ node_type::null };
+  std::string_view fragment{};
+  std::map<std::string_view, std::size_t> members{};
+  std::vector<std::size_t> elements{};
+};
+
+/*
+ * Nodes refer to each other by index in the arena, so that growing the arena does not invalidate
+ * them.
+ */
+class document_builder
+{
+public:
+  explicit document_builder(bool preserve_array_indexes)
+    : preserve_array_indexes_{ preserve_array_indexes }
+  {
+    nodes_.push_back({ node_type::object });
+  }
+
+  auto insert(const std::vector<path_component>& components, std::string_view fragment) -> bool
+  {
+    std::size_t current = 0;
+    for (std::size_t i = 0; i < components.size(); ++i) {
+      const bool last = i + 1 == components.size();
+      const auto type = last ? node_type::fragment
+                             : (std::holds_alternative<std::string_view>(components[i + 1])
+                                  ? node_type::object
+                                  : node_type::array);
+      std::size_t child{};
+      if (const auto* key = std::get_if<std::string_view>(&components[i]); key != nullptr) {
+        if (nodes_[current].type != node_type::object) {
+          return false;
+        }
+        if (auto it = nodes_[current].members.find(*key); it != nodes_[current].members.end()) {
+          child = it->second;
+        } else {
+          child = make_node(node_type::null);
+          nodes_[current].members.emplace(*key, child);
+        }
+      } else {
+        if (nodes_[current].type != node_type::array) {
+          return false;
+        }
+        const auto index = std::get<std::int64_t>(components[i]);
+        if (preserve_array_indexes_ && index >= 0) {
+          const auto position = static_cast<std::size_t>(index);
+          while (nodes_[current].elements.size() <= position) {
+            auto filler = make_node(node_type::null);
+            nodes_[current].elements.push_back(filler);
+          }
+          child = nodes_[current].elements[position];
+        } else {
+          // negative index, or indexes are not preserved, just append
+          child = make_node(node_type::null);
+          nodes_[current].elements.push_back(child);
+        }
+      }
+
+      if (last) {
+        nodes_[child] = { node_type::fragment, fragment };
+      } else if (nodes_[child].type == node_type::null) {
+        nodes_[child].type = type;
+      } else if (nodes_[child].type != type) {
+        return false;
+      }
+      current = child;
+    }
+    return true;
+  }
+
+  [[nodiscard]] auto build(std::size_t size_hint) const -> std::vector<std::byte>
+  {
+    std::vector<std::byte> output{};
+    output.reserve(size_hint);
+    write(0, output);
+    return output;
+  }
+
+private:
+  auto make_node(node_type type) -> std::size_t
+  {
+    nodes_.push_back({ type });
+    return nodes_.size() - 1;
+  }
+
+  static void append(std::vector<std::byte>& output, std::string_view text)
+  {
+    const auto* data = reinterpret_cast<const std::byte*>(text.data());
+    output.insert(output.end(), data, data + text.size());
+  }
+
+  static void append_key(std::vector<std::byte>& output, std::string_view key)
+  {
+    static constexpr std::string_view hex{ "0123456789abcdef" };
+    output.push_back(std::byte{ '"' });
+    for (const auto ch : key) {
+      if (ch == '"' || ch == '\\') {
+        output.push_back(std::byte{ '\\' });
+        output.push_back(static_cast<std::byte>(ch));
+      } else if (static_cast<unsigned char>(ch) < 0x20) {
+        const auto code = static_cast<unsigned char>(ch);
+        append(output, "\\u00");
+        output.push_back(static_cast<std::byte>(hex[code >> 4U]));
+        output.push_back(static_cast<std::byte>(hex[code & 0x0fU]));
+      } else {
+        output.push_back(static_cast<std::byte>(ch));
+      }
+    }
+    output.push_back(std::byte{ '"' });
+  }
+
+  void write(std::size_t index, std::vector<std::byte>& output) const
+  {
+    const auto& current = nodes_[index];
+    switch (current.type) {
+      case node_type::null:
+        append(output, "null");
+        break;
+
+      case node_type::fragment:
+        append(output, current.fragment);
+        break;
+
+      case node_type::object: {
+        output.push_back(std::byte{ '{' });
+        bool first = true;
+        for (const auto& [key, child] : current.members) {
+          if (!first) {
+            output.push_back(std::byte{ ',' });
+          }
+          first = false;
+          append_key(output, key);
+          output.push_back(std::byte{ ':' });
+          write(child, output);
+        }
+        output.push_back(std::byte{ '}' });
+      } break;
+
+      case node_type::array: {
+        output.push_back(std::byte{ '[' });
+        bool first = true;
+        for (const auto child : current.elements) {
+          if (!first) {
+            output.push_back(std::byte{ ',' });
+          }
+          first = false;
+          write(child, output);
+        }
+        output.push_back(std::byte{ ']' });
+      } break;
+    }
+  }
+
+  const bool preserve_array_indexes_;
+  std::vector<node> nodes_{};
+};
+} // namespace
+
+auto
+splice_projections(const std::vector<std::string>& paths,
+                   const std::vector<std::optional<std::string_view>>& fragments,
+                   bool preserve_array_indexes) -> std::optional<std::vector<std::byte>>
+{
+  if (paths.size() != fragments.size()) {
+    return {};
+  }
+  document_builder builder{ preserve_array_indexes };
+  std::size_t size_hint = 2;
+  for (std::size_t i = 0; i < paths.size(); ++i) {
+    if (!fragments[i]) {
+      continue;
+    }
+    auto components = parse_path(paths[i]);
+    if (!components || !builder.insert(components.value(), fragments[i].value())) {
+      return {};
+    }
+    size_hint += paths[i].size() + fragments[i]->size() + 4;
+  }
+  return builder.build(size_hint);
+}
+} // namespace couchbase::core::impl::subdoc
@@ -0,0 +1,44 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace couchbase::core::impl::subdoc
+{
+/**
+ * Builds the JSON document that holds only the projected paths. The server returns each path as
+ * a JSON fragment, and the fragments are copied to the output verbatim, so they never have to be
+ * parsed and generated again.
+ *
+ * Paths with empty fragment (not found in the document) are skipped. Object keys are written in
+ * sorted order, the same as the DOM based projection would do.
+ *
+ * @return empty optional when the paths cannot be combined by splicing, for example when one path
+ * descends into the fragment of another path. The caller should project using DOM in this case.
+ */
+auto
+splice_projections(const std::vector<std::string>& paths,
+                   const std::vector<std::optional<std::string_view>>& fragments,
+                   bool preserve_array_indexes) -> std::optional<std::vector<std::byte>>;
+} // namespace couchbase::core::impl::subdoc
@@ -0,0 +1,134 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "collection_uid_cache.hxx"
+
+#include "core/topology/collections_manifest.hxx"
+
+#include <functional>
+#include <mutex>
+
+namespace couchbase::core::io
+{
+namespace
+{
+const std::string default_collection_path{ "_default._default" };
+} // namespace
+
+auto
+collection_uid_cache::shard_for(const std::string& path) const -> shard&
+{
+  return shards_[std::hash<std::string>{}(path) % number_of_shards];
+}
+
+auto
+collection_uid_cache::get(const std::string& path) const -> std::optional<std::uint32_t>
+{
+  if (path == default_collection_path) {
+    return 0;
+  }
+  auto& target = shard_for(path);
+  std::shared_lock lock(target.mutex);
+  if (auto entry = target.entries.find(path); entry != target.entries.end()) {
+    return entry->second;
+  }
+  return {};
+}
+
+void
+collection_uid_cache::update(const std::string& path,
+                             std::uint32_t uid,
+                             std::uint64_t manifest_uid)
+{
+  /*
+   * The manifest lock is held in shared mode, so that the entry learned from the manifest, which
+   * is older than the known one, will not appear in the cache after invalidation.
+   */
+  std::shared_lock manifest_lock(manifest_mutex_);
+  if (manifest_uid < manifest_uid_) {
+    return;
+  }
+  auto& target = shard_for(path);
+  std::scoped_lock lock(target.mutex);
+  target.entries.insert_or_assign(path, uid);
+}
+
+void
+collection_uid_cache::populate(const topology::collections_manifest& manifest)
+{
+  std::scoped_lock manifest_lock(manifest_mutex_);
+  if (manifest.uid < manifest_uid_) {
+    return;
+  }
+  manifest_uid_ = manifest.uid;
+  for (auto& target : shards_) {
+    std::scoped_lock lock(target.mutex);
+    target.entries.clear();
+  }
+  for (const auto& scope : manifest.scopes) {
+    for (const auto& collection : scope.collections) {
+      auto path = scope.name + "." + collection.name;
+      auto& target = shard_for(path);
+      std::scoped_lock lock(target.mutex);
+      target.entries.insert_or_assign(std::move(path),
+                                      static_cast<std::uint32_t>(collection.uid));
+    }
+  }
+}
+
+auto
+collection_uid_cache::invalidate(std::uint64_t manifest_uid) -> bool
+{
+  std::scoped_lock manifest_lock(manifest_mutex_);
+  if (manifest_uid <= manifest_uid_) {
+    return false;
+  }
+  manifest_uid_ = manifest_uid;
+  for (auto& target : shards_) {
+    std::scoped_lock lock(target.mutex);
+    target.entries.clear();
+  }
+  return true;
+}
+
+void
+collection_uid_cache::remove(const std::string& path)
+{
+  auto& target = shard_for(path);
+  std::scoped_lock lock(target.mutex);
+  target.entries.erase(path);
+}
+
+auto
+collection_uid_cache::manifest_uid() const -> std::uint64_t
+{
+  std::shared_lock manifest_lock(manifest_mutex_);
+  return manifest_uid_;
+}
+
+auto
+collection_uid_cache::size() const -> std::size_t
+{
+  std::size_t result = 0;
+  for (const auto& target : shards_) {
+    std::shared_lock lock(target.mutex);
+    result += target.entries.size();
+  }
+  return result;
+}
+} // namespace couchbase::core::io
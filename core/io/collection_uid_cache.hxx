@@ -0,0 +1,85 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace couchbase::core::topology
+{
+struct collections_manifest;
+} // namespace couchbase::core::topology
+
+namespace couchbase::core::io
+{
+/**
+ * Collection identifiers of the bucket, shared by all KV sessions.
+ *
+ * The entries are spread over the shards by hash of the "scope.collection" path, so concurrent
+ * lookups only contend on the shared lock of a single shard. The cache remembers the uid of the
+ * newest manifest it has seen (entries do not carry their own), ignores updates learned from
+ * older manifests, and drops all entries when the bucket configuration announces newer manifest.
+ */
+class collection_uid_cache
+{
+public:
+  static constexpr std::size_t number_of_shards{ 16 };
+
+  [[nodiscard]] auto get(const std::string& path) const -> std::optional<std::uint32_t>;
+
+  void update(const std::string& path, std::uint32_t uid, std::uint64_t manifest_uid);
+
+  /**
+   * Replaces the content of the cache with all collections of the manifest.
+   */
+  void populate(const topology::collections_manifest& manifest);
+
+  /**
+   * Drops all entries, if the manifest_uid is newer than the one known to the cache.
+   *
+   * @return true if the cache has been invalidated, and the manifest should be fetched again
+   */
+  auto invalidate(std::uint64_t manifest_uid) -> bool;
+
+  /**
+   * Drops the entry, when the server no longer knows its identifier (unknown_collection status).
+   */
+  void remove(const std::string& path);
+
+  [[nodiscard]] auto manifest_uid() const -> std::uint64_t;
+
+  [[nodiscard]] auto size() const -> std::size_t;
+
+private:
+  struct shard {
+    mutable std::shared_mutex mutex{};
+    std::unordered_map<std::string, std::uint32_t> entries{};
+  };
+
+  [[nodiscard]] auto shard_for(const std::string& path) const -> shard&;
+
+  mutable std::array<shard, number_of_shards> shards_{};
+  mutable std::shared_mutex manifest_mutex_{};
+  std::uint64_t manifest_uid_{ 0 };
+};
+} // namespace couchbase::core::io
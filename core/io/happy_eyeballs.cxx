@@ -0,0 +1,157 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "happy_eyeballs.hxx"
+
+#include <asio/post.hpp>
+
+namespace couchbase::core::io
+{
+auto
+interleave_address_families(std::vector<asio::ip::tcp::endpoint> endpoints)
+  -> std::vector<asio::ip::tcp::endpoint>
+{
+  if (endpoints.size() < 2) {
+    return endpoints;
+  }
+  const bool first_is_v6 = endpoints.front().address().is_v6();
+  std::vector<asio::ip::tcp::endpoint> preferred{};
+  std::vector<asio::ip::tcp::endpoint> other{};
+  for (auto& endpoint : endpoints) {
+    (endpoint.address().is_v6() == first_is_v6 ? preferred : other).push_back(endpoint);
+  }
+
+  std::vector<asio::ip::tcp::endpoint> result{};
+  result.reserve(endpoints.size());
+  std::size_t i = 0;
+  std::size_t j = 0;
+  while (i < preferred.size() || j < other.size()) {
+    if (i < preferred.size()) {
+      result.push_back(preferred[i++]);
+    }
+    if (j < other.size()) {
+      result.push_back(other[j++]);
+    }
+  }
+  return result;
+}
+
+happy_eyeballs_connector::happy_eyeballs_connector(executor_type executor,
+                                                   std::vector<asio::ip::tcp::endpoint> endpoints,
+                                                   std::chrono::milliseconds attempt_delay)
+  : executor_(std::move(executor))
+  , endpoints_(std::move(endpoints))
+  , attempt_delay_(attempt_delay)
+  , attempt_timer_(executor_)
+{
+  sockets_.reserve(endpoints_.size());
+}
+
+void
+happy_eyeballs_connector::async_connect(handler_type&& handler)
+{
+  asio::post(executor_, [self = shared_from_this(), handler = std::move(handler)]() mutable {
+    if (self->completed_) {
+      // cancelled before the first attempt has been started
+      return handler(asio::error::operation_aborted, asio::ip::tcp::socket(self->executor_), {});
+    }
+    self->handler_ = std::move(handler);
+    if (self->endpoints_.empty()) {
+      return self->complete(asio::error::host_not_found, 0);
+    }
+    self->start_next_attempt();
+  });
+}
+
+void
+happy_eyeballs_connector::cancel()
+{
+  asio::post(executor_, [self = shared_from_this()]() {
+    if (!self->completed_) {
+      self->complete(asio::error::operation_aborted, 0);
+    }
+  });
+}
+
+void
+happy_eyeballs_connector::start_next_attempt()
+{
+  if (completed_ || sockets_.size() == endpoints_.size()) {
+    return;
+  }
+  const std::size_t index = sockets_.size();
+  auto& socket = sockets_.emplace_back(std::make_unique<asio::ip::tcp::socket>(executor_));
+  ++running_attempts_;
+  socket->async_connect(endpoints_[index],
+                        [self = shared_from_this(), index](std::error_code ec) {
+                          self->on_attempt_completed(index, ec);
+                        });
+  if (sockets_.size() < endpoints_.size()) {
+    attempt_timer_.expires_after(attempt_delay_);
+    attempt_timer_.async_wait([self = shared_from_this()](std::error_code ec) {
+      if (ec == asio::error::operation_aborted) {
+        return;
+      }
+      self->start_next_attempt();
+    });
+  }
+}
+
+void
+happy_eyeballs_connector::on_attempt_completed(std::size_t index, std::error_code ec)
+{
+  --running_attempts_;
+  if (completed_) {
+    return;
+  }
+  if (!ec) {
+    return complete({}, index);
+  }
+  last_error_ = ec;
+  if (sockets_.size() < endpoints_.size()) {
+    // do not wait for the attempt delay, the failed attempt does not compete anymore
+    attempt_timer_.cancel();
+    return start_next_attempt();
+  }
+  if (running_attempts_ == 0) {
+    complete(last_error_, index);
+  }
+}
+
+void
+happy_eyeballs_connector::complete(std::error_code ec, std::size_t winner)
+{
+  completed_ = true;
+  attempt_timer_.cancel();
+  asio::ip::tcp::socket socket(executor_);
+  asio::ip::tcp::endpoint endpoint{};
+  if (!ec) {
+    socket = std::move(*sockets_[winner]);
+    endpoint = endpoints_[winner];
+  }
+  for (const auto& attempt : sockets_) {
+    if (attempt->is_open()) {
+      std::error_code ignored{};
+      attempt->close(ignored);
+    }
+  }
+  if (auto handler = std::move(handler_); handler) {
+    handler(ec, std::move(socket), endpoint);
+  }
+}
+} // namespace couchbase::core::io
@@ -0,0 +1,86 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include "core/utils/movable_function.hxx"
+
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/steady_timer.hpp>
+#include <asio/strand.hpp>
+
+#include <chrono>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+namespace couchbase::core::io
+{
+/**
+ * Orders endpoints as RFC 8305 (section 4) suggests: the address family of the first endpoint
+ * goes first, and the rest of the list alternates between IPv6 and IPv4 addresses. The relative
+ * order of the endpoints of the same family is preserved.
+ */
+auto
+interleave_address_families(std::vector<asio::ip::tcp::endpoint> endpoints)
+  -> std::vector<asio::ip::tcp::endpoint>;
+
+/**
+ * Races TCP connection attempts to the list of endpoints (RFC 8305 "Happy Eyeballs").
+ *
+ * The next attempt starts when all running attempts have failed, or when attempt_delay has
+ * passed since the previous attempt was started, whatever comes first. The first established
+ * connection wins, and all other attempts are cancelled. The handler is invoked exactly once, on
+ * the executor of the connector, which is also used for the sockets.
+ */
+class happy_eyeballs_connector : public std::enable_shared_from_this<happy_eyeballs_connector>
+{
+public:
+  using executor_type = asio::strand<asio::io_context::executor_type>;
+  using handler_type = utils::movable_function<
+    void(std::error_code, asio::ip::tcp::socket, asio::ip::tcp::endpoint)>;
+
+  happy_eyeballs_connector(executor_type executor,
+                           std::vector<asio::ip::tcp::endpoint> endpoints,
+                           std::chrono::milliseconds attempt_delay);
+
+  void async_connect(handler_type&& handler);
+
+  /**
+   * Cancels all running attempts. The handler will receive asio::error::operation_aborted,
+   * unless the connection has been already established.
+   */
+  void cancel();
+
+private:
+  void start_next_attempt();
+  void on_attempt_completed(std::size_t index, std::error_code ec);
+  void complete(std::error_code ec, std::size_t winner);
+
+  executor_type executor_;
+  std::vector<asio::ip::tcp::endpoint> endpoints_;
+  std::chrono::milliseconds attempt_delay_;
+  asio::steady_timer attempt_timer_;
+  std::vector<std::unique_ptr<asio::ip::tcp::socket>> sockets_{};
+  std::size_t running_attempts_{ 0 };
+  std::error_code last_error_{};
+  handler_type handler_{};
+  bool completed_{ false };
+};
+} // namespace couchbase::core::io
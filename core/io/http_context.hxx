@@ -21,10 +21,15 @@
 #include "core/topology/configuration.hxx"
 #include "query_cache.hxx"
 
+#include <memory>
+
 namespace couchbase::core
 {
 struct http_context {
-  const topology::configuration& config;
+  /**
+   * Snapshot of the configuration, refreshed every time the session is checked out.
+   */
+  std::shared_ptr<const topology::configuration> config;
   const cluster_options& options;
   query_cache& cache;
   std::string hostname;
@@ -61,21 +61,26 @@ public:
   auto configuration_capabilities() const -> configuration_capabilities
   {
     std::scoped_lock config_lock(config_mutex_);
-    return config_.capabilities;
+    return config_->capabilities;
   }
 
   void update_config(topology::configuration config) override
   {
+    auto snapshot = std::make_shared<const topology::configuration>(std::move(config));
     std::scoped_lock config_lock(config_mutex_, sessions_mutex_);
+    config_ = std::move(snapshot);
+    drop_idle_sessions_of_unknown_nodes();
+  }
+
+  void apply_config_delta(std::shared_ptr<const topology::configuration> config,
+                          std::shared_ptr<const topology::configuration_delta> delta) override
+  {
+    std::scoped_lock config_lock(config_mutex_, sessions_mutex_);
+    // the snapshot is shared with the bucket and the other listeners, nothing is copied here
     config_ = std::move(config);
-    for (auto& [type, sessions] : idle_sessions_) {
-      sessions.remove_if([&opts = options_, &cfg = config_](const auto& session) {
-        return session && !cfg.has_node(opts.network,
-                                        session->type(),
-                                        opts.enable_tls,
-                                        session->hostname(),
-                                        session->port());
-      });
+    // idle sessions could only become stale if some node left or changed its services
+    if (!delta->removed_nodes.empty() || !delta->changed_nodes.empty()) {
+      drop_idle_sessions_of_unknown_nodes();
     }
   }
 
@@ -88,10 +93,11 @@ public:
       std::uniform_int_distribution<std::size_t> dis(0, config.nodes.size() - 1);
       next_index = dis(gen);
     }
+    auto snapshot = std::make_shared<const topology::configuration>(config);
     std::scoped_lock lock(config_mutex_, next_index_mutex_);
     options_ = options;
     next_index_ = next_index;
-    config_ = config;
+    config_ = std::move(snapshot);
   }
 
   void export_diag_info(diag::diagnostics_result& res)
@@ -124,12 +130,8 @@ public:
       service_type::query, service_type::analytics, service_type::search,
       service_type::view,  service_type::eventing,  service_type::management,
     };
-    std::vector<topology::configuration::node> nodes{};
-    {
-      std::scoped_lock lock(config_mutex_);
-      nodes = config_.nodes;
-    }
-    for (const auto& node : nodes) {
+    auto config = config_snapshot();
+    for (const auto& node : config->nodes) {
       for (auto type : known_types) {
         if (services.find(type) == services.end()) {
           continue;
@@ -137,7 +139,7 @@ public:
         std::uint16_t port = node.port_or(options_.network, type, options_.enable_tls, 0);
         if (port != 0) {
           const auto& hostname = node.hostname_for(options_.network);
-          auto session = create_session(type, credentials, hostname, port);
+          auto session = create_session(type, credentials, hostname, port, config);
           if (session->is_connected()) {
             std::scoped_lock lock(sessions_mutex_);
             busy_sessions_[type].push_back(session);
@@ -200,6 +202,7 @@ public:
                  const std::string& preferred_node)
     -> std::pair<std::error_code, std::shared_ptr<http_session>>
   {
+    auto config = config_snapshot();
     std::scoped_lock lock(sessions_mutex_);
     idle_sessions_[type].remove_if([](const auto& s) {
       return !s;
@@ -229,7 +232,7 @@ public:
           }
         } else {
           auto [hostname, port] = split_host_port(preferred_node);
-          session = create_session(type, credentials, hostname, port);
+          session = create_session(type, credentials, hostname, port, config);
           break;
         }
       }
@@ -246,8 +249,10 @@ public:
       if (port == 0) {
         return { errc::common::service_not_available, nullptr };
       }
-      session = create_session(type, credentials, hostname, port);
+      session = create_session(type, credentials, hostname, port, config);
     }
+    // the session belongs to this caller until it is checked in, so the snapshot can be replaced
+    session->http_context().config = std::move(config);
     if (session->is_connected()) {
       busy_sessions_[type].push_back(session);
     }
@@ -262,7 +267,7 @@ public:
     }
     {
       std::scoped_lock lock(config_mutex_);
-      if (!session->keep_alive() || !config_.has_node(options_.network,
+      if (!session->keep_alive() || !config_->has_node(options_.network,
                                                       session->type(),
                                                       options_.enable_tls,
                                                       session->hostname(),
@@ -347,6 +352,20 @@ public:
   }
 
 private:
+  /* must be invoked with config_mutex_ and sessions_mutex_ held */
+  void drop_idle_sessions_of_unknown_nodes()
+  {
+    for (auto& [type, sessions] : idle_sessions_) {
+      sessions.remove_if([&opts = options_, &cfg = *config_](const auto& session) {
+        return session && !cfg.has_node(opts.network,
+                                        session->type(),
+                                        opts.enable_tls,
+                                        session->hostname(),
+                                        session->port());
+      });
+    }
+  }
+
   template<typename Request>
   void connect_then_send(std::shared_ptr<http_session> session,
                          std::shared_ptr<operations::http_command<Request>> cmd,
@@ -376,7 +395,11 @@ private:
           return;
         }
         auto new_session =
-          self->create_session(session->type(), session->credentials(), hostname, port);
+          self->create_session(session->type(),
+                               session->credentials(),
+                               hostname,
+                               port,
+                               self->config_snapshot());
         cmd->set_command_session(new_session);
         if (new_session->is_connected()) {
           std::scoped_lock inner_lock(self->sessions_mutex_);
@@ -396,7 +419,9 @@ private:
   auto create_session(service_type type,
                       const couchbase::core::cluster_credentials& credentials,
                       const std::string& hostname,
-                      std::uint16_t port) -> std::shared_ptr<http_session>
+                      std::uint16_t port,
+                      std::shared_ptr<const topology::configuration> config)
+    -> std::shared_ptr<http_session>
   {
     std::shared_ptr<http_session> session;
     if (options_.enable_tls) {
@@ -408,7 +433,7 @@ private:
         credentials,
         hostname,
         std::to_string(port),
-        http_context{ config_, options_, query_cache_, hostname, port });
+        http_context{ config, options_, query_cache_, hostname, port });
     } else {
       session = std::make_shared<http_session>(
         type,
@@ -417,7 +442,7 @@ private:
         credentials,
         hostname,
         std::to_string(port),
-        http_context{ config_, options_, query_cache_, hostname, port });
+        http_context{ config, options_, query_cache_, hostname, port });
     }
 
     session->on_stop([type, id = session->id(), self = this->shared_from_this()]() {
@@ -432,15 +457,21 @@ private:
     return session;
   }
 
+  auto config_snapshot() const -> std::shared_ptr<const topology::configuration>
+  {
+    std::scoped_lock lock(config_mutex_);
+    return config_;
+  }
+
   auto next_node(service_type type) -> std::pair<std::string, std::uint16_t>
   {
     std::scoped_lock lock(config_mutex_);
-    auto candidates = config_.nodes.size();
+    auto candidates = config_->nodes.size();
     while (candidates > 0) {
       --candidates;
       std::scoped_lock index_lock(next_index_mutex_);
-      const auto& node = config_.nodes[next_index_];
-      next_index_ = (next_index_ + 1) % config_.nodes.size();
+      const auto& node = config_->nodes[next_index_];
+      next_index_ = (next_index_ + 1) % config_->nodes.size();
       std::uint16_t port = node.port_or(options_.network, type, options_.enable_tls, 0);
       if (port != 0) {
         return { node.hostname_for(options_.network), port };
@@ -465,8 +496,8 @@ private:
   {
     std::scoped_lock lock(config_mutex_);
     auto [hostname, port] = split_host_port(preferred_node);
-    if (std::none_of(config_.nodes.begin(),
-                     config_.nodes.end(),
+    if (std::none_of(config_->nodes.begin(),
+                     config_->nodes.end(),
                      [this, type, &h = hostname, &p = port](const auto& node) {
                        return node.hostname_for(options_.network) == h &&
                               node.port_or(options_.network, type, options_.enable_tls, 0) == p;
@@ -483,7 +514,9 @@ private:
   std::shared_ptr<couchbase::metrics::meter> meter_{ nullptr };
   cluster_options options_{};
 
-  topology::configuration config_{};
+  std::shared_ptr<const topology::configuration> config_{
+    std::make_shared<const topology::configuration>()
+  };
   mutable std::mutex config_mutex_{};
   std::map<service_type, std::list<std::shared_ptr<http_session>>> busy_sessions_{};
   std::map<service_type, std::list<std::shared_ptr<http_session>>> idle_sessions_{};
@@ -29,12 +29,13 @@
 #include "mcbp_session.hxx"
 #include "mcbp_traits.hxx"
 #include "retry_orchestrator.hxx"
+#include "timer_wheel.hxx"
 
 #include "core/error_context/key_value_error_map_info.hxx"
+#include "core/metrics/operation_recorders.hxx"
 #include <couchbase/durability_level.hxx>
 #include <couchbase/error_codes.hxx>
 
-#include <asio/steady_timer.hpp>
 #include <fmt/chrono.h>
 
 #include <functional>
@@ -46,37 +47,38 @@ namespace couchbase::core::operations
 using mcbp_command_handler =
   utils::movable_function<void(std::error_code, std::optional<io::mcbp_message>&&)>;
 
-template<typename Manager, typename Request>
-struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager, Request>> {
+/**
+ * The session is a template parameter only to let unit tests drive the command against a fake
+ * session, the library always uses io::mcbp_session.
+ */
+template<typename Manager, typename Request, typename Session = io::mcbp_session>
+struct mcbp_command
+  : public std::enable_shared_from_this<mcbp_command<Manager, Request, Session>> {
   static constexpr std::chrono::milliseconds durability_timeout_floor{ 1'500 };
 
   using encoded_request_type = typename Request::encoded_request_type;
   using encoded_response_type = typename Request::encoded_response_type;
-  asio::steady_timer deadline;
-  asio::steady_timer retry_backoff;
+  std::chrono::steady_clock::time_point deadline{};
+  io::timer_wheel_entry deadline_entry{};
+  io::timer_wheel_entry retry_backoff{};
+  std::shared_ptr<io::timer_wheel> timer_wheel_{};
   Request request;
   encoded_request_type encoded;
   std::optional<std::uint32_t> opaque_{};
-  std::optional<io::mcbp_session> session_{};
+  std::optional<Session> session_{};
   mcbp_command_handler handler_{};
   std::shared_ptr<Manager> manager_{};
   std::chrono::milliseconds timeout_{};
-  std::string id_{ fmt::format("{:02x}/{}",
-                               static_cast<std::uint8_t>(encoded_request_type::body_type::opcode),
-                               uuid::to_string(uuid::random())) };
+  uuid::uuid_t uuid_{ uuid::random() };
   std::shared_ptr<couchbase::tracing::request_span> span_{ nullptr };
   std::shared_ptr<couchbase::tracing::request_span> parent_span{ nullptr };
-  std::optional<std::string> last_dispatched_from_{};
-  std::optional<std::string> last_dispatched_to_{};
+  bool flush_{ true };
 
-  mcbp_command(asio::io_context& ctx,
-               std::shared_ptr<Manager> manager,
+  mcbp_command(std::shared_ptr<Manager> manager,
                Request req,
                std::chrono::milliseconds default_timeout)
-    : deadline(ctx)
-    , retry_backoff(ctx)
-    , request(req)
-    , manager_(manager)
+    : request(std::move(req))
+    , manager_(std::move(manager))
     , timeout_(request.timeout.value_or(default_timeout))
   {
     if constexpr (io::mcbp_traits::supports_durability_v<Request>) {
@@ -87,7 +89,7 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
           request.id,
           timeout_.count(),
           durability_timeout_floor.count(),
-          id_);
+          id());
         timeout_ = durability_timeout_floor;
       }
     }
@@ -96,6 +98,37 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
     }
   }
 
+  /**
+   * The identifier is only needed for logging and error contexts, so it is formatted on demand
+   * instead of being allocated for every command.
+   */
+  [[nodiscard]] auto id() const -> std::string
+  {
+    return fmt::format("{:02x}/{}",
+                       static_cast<std::uint8_t>(encoded_request_type::body_type::opcode),
+                       uuid::to_string(uuid_));
+  }
+
+  /**
+   * Dispatch addresses are taken from the session the command has been sent to, and only
+   * formatted when an error context needs them.
+   */
+  [[nodiscard]] auto last_dispatched_from() const -> std::optional<std::string>
+  {
+    if (!session_) {
+      return {};
+    }
+    return session_->local_address();
+  }
+
+  [[nodiscard]] auto last_dispatched_to() const -> std::optional<std::string>
+  {
+    if (!session_) {
+      return {};
+    }
+    return session_->bootstrap_address();
+  }
+
   void start(mcbp_command_handler&& handler)
   {
     span_ = manager_->tracer()->start_span(
@@ -106,13 +139,16 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
       span_->add_tag(tracing::attributes::instance, request.id.bucket());
 
     handler_ = std::move(handler);
-    deadline.expires_after(timeout_);
-    deadline.async_wait([self = this->shared_from_this()](std::error_code ec) {
-      if (ec == asio::error::operation_aborted) {
-        return;
-      }
-      self->cancel(retry_reason::do_not_retry);
-    });
+    timer_wheel_ = manager_->timer_wheel();
+    deadline = std::chrono::steady_clock::now() + timeout_;
+    timer_wheel_->schedule(
+      deadline_entry, deadline, [self = this->shared_from_this()](std::error_code ec) {
+        if (ec) {
+          // the bucket has been closed, the wheel releases the reference to the command
+          return self->invoke_handler(ec);
+        }
+        self->cancel(retry_reason::do_not_retry);
+      });
   }
 
   void cancel(retry_reason reason)
@@ -131,8 +167,10 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
 
   void invoke_handler(std::error_code ec, std::optional<io::mcbp_message>&& msg = {})
   {
-    retry_backoff.cancel();
-    deadline.cancel();
+    if (timer_wheel_) {
+      timer_wheel_->cancel(retry_backoff);
+      timer_wheel_->cancel(deadline_entry);
+    }
     mcbp_command_handler handler{};
     std::swap(handler, handler_);
     if (span_ != nullptr) {
@@ -146,10 +184,10 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
     }
     if (handler) {
       if (ec == errc::common::unambiguous_timeout || ec == errc::common::ambiguous_timeout) {
-        auto time_left = deadline.expiry() - std::chrono::steady_clock::now();
+        auto time_left = deadline - std::chrono::steady_clock::now();
         CB_LOG_TRACE(R"([{}] timeout operation id="{}", {}, key="{}", partition={}, time_left={})",
                      session_ ? session_->log_prefix() : manager_->log_prefix(),
-                     id_,
+                     id(),
                      encoded_request_type::body_type::opcode,
                      request.id,
                      request.partition,
@@ -189,8 +227,11 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
         }
         protocol::client_response<protocol::get_collection_id_response_body> resp(std::move(msg));
         self->session_->update_collection_uid(self->request.id.collection_path(),
-                                              resp.body().collection_uid());
+                                              resp.body().collection_uid(),
+                                              resp.body().manifest_uid());
         self->request.id.collection_uid(resp.body().collection_uid());
+        // the batch that deferred the flush has been written already
+        self->flush_ = true;
         return self->send();
       });
   }
@@ -198,25 +239,25 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
   void handle_unknown_collection()
   {
     auto backoff = std::chrono::milliseconds(500);
-    auto time_left = deadline.expiry() - std::chrono::steady_clock::now();
+    auto time_left = deadline - std::chrono::steady_clock::now();
     CB_LOG_DEBUG(R"({} unknown collection response for "{}", time_left={}ms, id="{}")",
                  session_->log_prefix(),
                  request.id,
                  std::chrono::duration_cast<std::chrono::milliseconds>(time_left).count(),
-                 id_);
+                 id());
     request.retries.add_reason(retry_reason::key_value_collection_outdated);
     if (time_left < backoff) {
       return invoke_handler(make_error_code(request.retries.idempotent()
                                               ? errc::common::unambiguous_timeout
                                               : errc::common::ambiguous_timeout));
     }
-    retry_backoff.expires_after(backoff);
-    retry_backoff.async_wait([self = this->shared_from_this()](std::error_code ec) mutable {
-      if (ec == asio::error::operation_aborted) {
-        return;
-      }
-      self->request_collection_id();
-    });
+    timer_wheel_->schedule_after(
+      retry_backoff, backoff, [self = this->shared_from_this()](std::error_code ec) {
+        if (ec) {
+          return self->invoke_handler(ec);
+        }
+        self->request_collection_id();
+      });
   }
 
   void send()
@@ -224,7 +265,7 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
     opaque_ = session_->next_opaque();
     request.opaque = *opaque_;
     if (span_->uses_tags())
-      span_->add_tag(tracing::attributes::operation_id, fmt::format("0x{:x}", request.opaque));
+      span_->add_operation_id(request.opaque);
     if (request.id.use_collections() && !request.id.is_collection_resolved()) {
       if (session_->supports_feature(protocol::hello_feature::collections)) {
         auto collection_id = session_->get_collection_uid(request.id.collection_path());
@@ -236,7 +277,7 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
             session_->log_prefix(),
             request.id,
             timeout_.count(),
-            id_);
+            id());
           return request_collection_id();
         }
       } else {
@@ -257,7 +298,7 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
       }
     }
 
-    session_->write_and_subscribe(
+    session_->write_and_subscribe_limited(
       request.opaque,
       encoded.data(session_->supports_feature(protocol::hello_feature::snappy)),
       [self = this->shared_from_this(), start = std::chrono::steady_clock::now()](
@@ -265,18 +306,10 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
         retry_reason reason,
         io::mcbp_message&& msg,
         std::optional<key_value_error_map_info> /* error_info */) mutable {
-        static std::string meter_name = "db.couchbase.operations";
-        static std::map<std::string, std::string> tags = {
-          { "db.couchbase.service", "kv" },
-          { "db.operation", fmt::format("{}", encoded_request_type::body_type::opcode) },
-        };
-        self->manager_->meter()
-          ->get_value_recorder(meter_name, tags)
-          ->record_value(std::chrono::duration_cast<std::chrono::microseconds>(
-                           std::chrono::steady_clock::now() - start)
-                           .count());
+        self->manager_->operation_recorders().record_latency(
+          encoded_request_type::body_type::opcode, start);
 
-        self->retry_backoff.cancel();
+        self->timer_wheel_->cancel(self->retry_backoff);
         if (ec == asio::error::operation_aborted) {
           if (self->span_->uses_tags())
             self->span_->add_tag(tracing::attributes::orphan, "aborted");
@@ -292,6 +325,11 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
           }
           return io::retry_orchestrator::maybe_retry(self->manager_, self, reason, ec);
         }
+        if constexpr (encoded_request_type::body_type::opcode == protocol::client_opcode::get) {
+          // the histogram drives the hedged read delay, so only plain reads are recorded
+          self->session_->record_latency(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start));
+        }
         key_value_status_code status = key_value_status_code::invalid;
         std::optional<key_value_error_map_info> error_code{};
         if (protocol::is_valid_status(msg.header.status())) {
@@ -304,6 +342,8 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
             self->manager_, self, retry_reason::key_value_not_my_vbucket, ec);
         }
         if (status == key_value_status_code::unknown_collection) {
+          // the cached identifier is stale, do not let other commands use it
+          self->session_->remove_collection_uid(self->request.id.collection_path());
           return self->handle_unknown_collection();
         }
         if (status == key_value_status_code::config_only) {
@@ -350,15 +390,21 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
         } else {
           io::retry_orchestrator::maybe_retry(self->manager_, self, reason, ec);
         }
-      });
+      },
+      flush_);
   }
 
-  void send_to(io::mcbp_session session)
+  /**
+   * With flush set to false, the packet is left in the output buffer of the session, and the
+   * caller is responsible for flushing it (see bucket::execute_multi).
+   */
+  void send_to(Session session, bool flush = true)
   {
     if (!handler_ || !span_) {
       return;
     }
     session_ = std::move(session);
+    flush_ = flush;
     if (span_->uses_tags())
       span_->add_tag(tracing::attributes::remote_socket, session_->remote_address());
     if (span_->uses_tags())
@@ -17,6 +17,7 @@
 
 #include "mcbp_session.hxx"
 
+#include "collection_uid_cache.hxx"
 #include "core/config_listener.hxx"
 #include "core/diagnostics.hxx"
 #include "core/impl/bootstrap_state_listener.hxx"
@@ -43,21 +44,31 @@
 #include "core/sasl/client.h"
 #include "core/sasl/error_fmt.h"
 #include "core/topology/capabilities_fmt.hxx"
+#include "core/topology/config_revision.hxx"
 #include "core/topology/configuration_fmt.hxx"
+#include "core/utils/concurrency_limiter.hxx"
+#include "core/utils/latency_histogram.hxx"
+#include "happy_eyeballs.hxx"
 #include "mcbp_context.hxx"
 #include "mcbp_message.hxx"
 #include "mcbp_parser.hxx"
 #include "retry_orchestrator.hxx"
 #include "streams.hxx"
+#include "write_coalescer.hxx"
 
 #include <couchbase/build_config.hxx>
 #include <couchbase/error_codes.hxx>
 #include <couchbase/fmt/retry_reason.hxx>
+#include <couchbase/metrics/meter.hxx>
 
 #include <asio.hpp>
 #include <spdlog/fmt/bin_to_hex.h>
 
+#include <algorithm>
 #include <cstring>
+#include <list>
+#include <map>
+#include <unordered_map>
 #include <utility>
 
 namespace
@@ -176,34 +187,6 @@ struct connection_endpoints {
   std::string local_address_with_port{};
 };
 
-class collection_cache
-{
-private:
-  std::map<std::string, std::uint32_t> cid_map_{ { "_default._default", 0 } };
-
-public:
-  [[nodiscard]] auto get(const std::string& path) -> std::optional<std::uint32_t>
-  {
-    Expects(!path.empty());
-    if (auto ptr = cid_map_.find(path); ptr != cid_map_.end()) {
-      return ptr->second;
-    }
-    return std::nullopt;
-  }
-
-  void update(const std::string& path, std::uint32_t id)
-  {
-    Expects(!path.empty());
-    cid_map_[path] = id;
-  }
-
-  void reset()
-  {
-    cid_map_.clear();
-    cid_map_["_default._default"] = 0;
-  }
-};
-
 class mcbp_session_impl
   : public std::enable_shared_from_this<mcbp_session_impl>
   , public operation_map
@@ -790,6 +773,7 @@ public:
     , connection_deadline_(ctx_)
     , retry_backoff_(ctx_)
     , ping_deadline_(ctx_)
+    , write_coalescer_(std::make_shared<write_coalescer>(ctx_))
     , origin_{ std::move(origin) }
     , bucket_name_{ std::move(bucket_name) }
     , supported_features_{ std::move(known_features) }
@@ -799,6 +783,7 @@ public:
   {
     log_prefix_ = fmt::format(
       "[{}/{}/{}/{}]", client_id_, id_, stream_->log_prefix(), bucket_name_.value_or("-"));
+    init_concurrency_limiter();
   }
 
   mcbp_session_impl(std::string_view client_id,
@@ -816,6 +801,7 @@ public:
     , connection_deadline_(ctx_)
     , retry_backoff_(ctx_)
     , ping_deadline_(ctx_)
+    , write_coalescer_(std::make_shared<write_coalescer>(ctx_))
     , origin_(std::move(origin))
     , bucket_name_(std::move(bucket_name))
     , supported_features_(std::move(known_features))
@@ -825,6 +811,7 @@ public:
   {
     log_prefix_ = fmt::format(
       "[{}/{}/{}/{}]", client_id_, id_, stream_->log_prefix(), bucket_name_.value_or("-"));
+    init_concurrency_limiter();
   }
 
   ~mcbp_session_impl()
@@ -859,7 +846,56 @@ public:
              remote_address(),
              local_address(),
              state_,
-             bucket_name_ };
+             bucket_name_,
+             details(),
+             concurrency_limit(),
+             queued_requests() };
+  }
+
+  [[nodiscard]] auto details() const -> std::optional<std::string>
+  {
+    auto bootstrap = bootstrap_details();
+    if (!concurrency_limiter_) {
+      return bootstrap;
+    }
+    std::scoped_lock lock(limiter_mutex_);
+    auto limiter = fmt::format("concurrency_limit={},in_flight={},queued={}",
+                               concurrency_limiter_->limit(),
+                               concurrency_limiter_->in_flight(),
+                               queued_requests_.size());
+    if (!bootstrap) {
+      return limiter;
+    }
+    return fmt::format("{},{}", bootstrap.value(), limiter);
+  }
+
+  [[nodiscard]] auto concurrency_limit() const -> std::optional<std::size_t>
+  {
+    if (!concurrency_limiter_) {
+      return {};
+    }
+    std::scoped_lock lock(limiter_mutex_);
+    return concurrency_limiter_->limit();
+  }
+
+  [[nodiscard]] auto queued_requests() const -> std::optional<std::size_t>
+  {
+    if (!concurrency_limiter_) {
+      return {};
+    }
+    std::scoped_lock lock(limiter_mutex_);
+    return queued_requests_.size();
+  }
+
+  [[nodiscard]] auto bootstrap_details() const -> std::optional<std::string>
+  {
+    const auto bootstrap_duration = bootstrap_duration_.load();
+    if (bootstrap_duration == std::chrono::microseconds::zero()) {
+      return {};
+    }
+    return fmt::format("connect_us={},bootstrap_us={}",
+                       connect_duration_.load().count(),
+                       bootstrap_duration.count());
   }
 
   void ping(std::shared_ptr<diag::ping_reporter> handler,
@@ -933,6 +969,7 @@ public:
   {
     retry_bootstrap_on_bucket_not_found_ = retry_on_bucket_not_found;
     bootstrap_callback_ = std::move(callback);
+    bootstrap_started_at_ = std::chrono::steady_clock::now();
     bootstrap_deadline_.expires_after(origin_.options().bootstrap_timeout);
     bootstrap_deadline_.async_wait([self = shared_from_this()](std::error_code ec) {
       if (ec == asio::error::operation_aborted || self->stopped_) {
@@ -1002,6 +1039,18 @@ public:
                               bootstrap_address_);
     CB_LOG_DEBUG("{} attempt to establish MCBP connection", log_prefix_);
 
+    connection_deadline_.expires_after(origin_.options().resolve_timeout);
+    connection_deadline_.async_wait([self = shared_from_this()](const auto timer_ec) {
+      if (timer_ec == asio::error::operation_aborted || self->stopped_) {
+        return;
+      }
+      CB_LOG_DEBUG("{} unable to resolve \"{}:{}\" in time, reconnecting",
+                   self->log_prefix_,
+                   self->bootstrap_hostname_,
+                   self->bootstrap_port_);
+      self->resolver_.cancel();
+      self->initiate_bootstrap();
+    });
     async_resolve(origin_.options().use_ip_protocol,
                   resolver_,
                   bootstrap_hostname_,
@@ -1044,7 +1093,11 @@ public:
     connection_deadline_.cancel();
     retry_backoff_.cancel();
     ping_deadline_.cancel();
+    write_coalescer_->cancel();
     resolver_.cancel();
+    if (auto connector = std::move(connector_); connector) {
+      connector->cancel();
+    }
     stream_->close([](std::error_code) {
     });
     if (auto h = std::move(bootstrap_handler_); h) {
@@ -1102,6 +1155,7 @@ public:
     }
     CB_LOG_TRACE("{} MCBP send {}", log_prefix_, mcbp_header_view(buf));
     std::scoped_lock lock(output_buffer_mutex_);
+    output_buffer_bytes_ += buf.size();
     output_buffer_.emplace_back(std::move(buf));
   }
 
@@ -1110,6 +1164,22 @@ public:
     if (stopped_) {
       return;
     }
+    if (const auto window = origin_.options().write_coalescing_window;
+        window > std::chrono::microseconds::zero()) {
+      bool below_threshold{};
+      {
+        std::scoped_lock lock(output_buffer_mutex_);
+        below_threshold = output_buffer_bytes_ < origin_.options().write_coalescing_threshold;
+      }
+      if (below_threshold) {
+        return write_coalescer_->schedule(window, [self = shared_from_this()]() {
+          if (self->stopped_) {
+            return;
+          }
+          self->do_write();
+        });
+      }
+    }
     asio::post(asio::bind_executor(ctx_, [self = shared_from_this()]() {
       self->do_write();
     }));
@@ -1231,7 +1301,8 @@ public:
 
   void write_and_subscribe(std::uint32_t opaque,
                            std::vector<std::byte>&& data,
-                           command_handler&& handler)
+                           command_handler&& handler,
+                           bool flush_now = true)
   {
     if (stopped_) {
       CB_LOG_WARNING("{} MCBP cancel operation, while trying to write to closed session, opaque={}",
@@ -1244,8 +1315,73 @@ public:
       std::scoped_lock lock(command_handlers_mutex_);
       command_handlers_.try_emplace(opaque, std::move(handler));
     }
+    write_packet(opaque, std::move(data), flush_now);
+  }
+
+  void write_and_subscribe_limited(std::uint32_t opaque,
+                                   std::vector<std::byte>&& data,
+                                   command_handler&& handler,
+                                   bool flush_now = true)
+  {
+    if (!concurrency_limiter_) {
+      return write_and_subscribe(opaque, std::move(data), std::move(handler), flush_now);
+    }
+    if (stopped_) {
+      CB_LOG_WARNING("{} MCBP cancel operation, while trying to write to closed session, opaque={}",
+                     log_prefix_,
+                     opaque);
+      handler(errc::common::request_canceled, retry_reason::socket_closed_while_in_flight, {}, {});
+      return;
+    }
+    {
+      /* the handler is registered even for the queued request, so that it can time out */
+      std::scoped_lock lock(command_handlers_mutex_);
+      command_handlers_.try_emplace(
+        opaque,
+        [self = shared_from_this(), opaque, handler = std::move(handler)](
+          std::error_code ec,
+          retry_reason reason,
+          io::mcbp_message&& msg,
+          std::optional<key_value_error_map_info> error_info) mutable {
+          self->release_admission(opaque, ec);
+          handler(ec, reason, std::move(msg), std::move(error_info));
+        });
+    }
+
+    bool admitted{ false };
+    bool rejected{ false };
+    {
+      std::scoped_lock lock(limiter_mutex_);
+      if (queued_requests_.empty() && concurrency_limiter_->try_acquire()) {
+        admitted_requests_.try_emplace(opaque, std::chrono::steady_clock::now());
+        admitted = true;
+      } else if (queued_requests_.size() < origin_.options().kv_max_queued_requests) {
+        queued_index_.try_emplace(
+          opaque, queued_requests_.emplace(queued_requests_.end(), opaque, std::move(data)));
+      } else {
+        rejected = true;
+      }
+    }
+    if (admitted) {
+      return write_packet(opaque, std::move(data), flush_now);
+    }
+    if (rejected) {
+      CB_LOG_TRACE("{} MCBP reject operation, concurrency limit reached, opaque={}",
+                   log_prefix_,
+                   opaque);
+      static_cast<void>(
+        cancel(opaque, errc::common::request_canceled, retry_reason::circuit_breaker_open));
+    }
+  }
+
+  void write_packet(std::uint32_t opaque, std::vector<std::byte>&& data, bool flush_now)
+  {
     if (bootstrapped_ && stream_->is_open()) {
-      write_and_flush(std::move(data));
+      if (flush_now) {
+        write_and_flush(std::move(data));
+      } else {
+        write(std::move(data));
+      }
     } else {
       CB_LOG_DEBUG("{} the stream is not ready yet, put the message into pending buffer, opaque={}",
                    log_prefix_,
@@ -1259,6 +1395,45 @@ public:
     }
   }
 
+  /**
+   * Feeds the outcome of the request into the limiter, and sends the queued requests that fit
+   * into the limit now.
+   */
+  void release_admission(std::uint32_t opaque, std::error_code ec)
+  {
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<std::pair<std::uint32_t, std::vector<std::byte>>> ready{};
+    {
+      std::scoped_lock lock(limiter_mutex_);
+      if (auto admitted = admitted_requests_.find(opaque); admitted != admitted_requests_.end()) {
+        if (ec == asio::error::operation_aborted || ec == errc::common::temporary_failure) {
+          concurrency_limiter_->on_dropped();
+        } else if (ec == errc::common::request_canceled) {
+          concurrency_limiter_->on_ignored();
+        } else {
+          concurrency_limiter_->on_success(
+            std::chrono::duration_cast<std::chrono::microseconds>(now - admitted->second));
+        }
+        admitted_requests_.erase(admitted);
+      } else if (auto queued = queued_index_.find(opaque); queued != queued_index_.end()) {
+        queued_requests_.erase(queued->second);
+        queued_index_.erase(queued);
+      }
+      while (!stopped_ && !queued_requests_.empty() && concurrency_limiter_->try_acquire()) {
+        auto& [next_opaque, data] = queued_requests_.front();
+        admitted_requests_.try_emplace(next_opaque, now);
+        queued_index_.erase(next_opaque);
+        ready.emplace_back(next_opaque, std::move(data));
+        queued_requests_.pop_front();
+      }
+    }
+    /* the callers that deferred the flush of the queued packets have flushed already, so the
+     * released packets are buffered together and flushed once, after the last of them */
+    for (std::size_t i = 0; i < ready.size(); ++i) {
+      write_packet(ready[i].first, std::move(ready[i].second), i + 1 == ready.size());
+    }
+  }
+
   [[nodiscard]] auto cancel(std::uint32_t opaque, std::error_code ec, retry_reason reason) -> bool
   {
     if (stopped_) {
@@ -1363,10 +1538,14 @@ public:
     config_listeners_.emplace_back(std::move(handler));
   }
 
-  void update_configuration(topology::configuration&& config)
+  /**
+   * Returns false if the configuration has been rejected, and the session still uses the
+   * previous one.
+   */
+  auto update_configuration(topology::configuration&& config) -> bool
   {
     if (stopped_) {
-      return;
+      return false;
     }
     std::scoped_lock lock(config_mutex_);
     // MB-60405 fixes this for 7.6.2, but for earlier versions we need to protect against using a
@@ -1375,13 +1554,13 @@ public:
     // successfully unless we have a config w/ a non-empty vbucket map).
     if (config.vbmap && config.vbmap->size() == 0) {
       CB_LOG_DEBUG("{} received a configuration with an empty vbucket map, ignoring", log_prefix_);
-      return;
+      return false;
     }
     if (config_) {
       if (config_->vbmap && config.vbmap && config_->vbmap->size() != config.vbmap->size()) {
         CB_LOG_DEBUG("{} received a configuration with a different number of vbuckets, ignoring",
                      log_prefix_);
-        return;
+        return false;
       }
       if (config == config_) {
         CB_LOG_TRACE(
@@ -1389,14 +1568,14 @@ public:
           log_prefix_,
           config.rev_str(),
           config_->rev_str());
-        return;
+        return false;
       }
       if (config < config_) {
         CB_LOG_DEBUG("{} received a configuration with older revision (new={}, old={}), ignoring",
                      log_prefix_,
                      config.rev_str(),
                      config_->rev_str());
-        return;
+        return false;
       }
     }
     bool this_node_found = false;
@@ -1420,6 +1599,10 @@ public:
         }
       }
     }
+    if (topology::config_revision revision{ config.epoch, config.rev };
+        !newest_config_revision_ || newest_config_revision_ < revision) {
+      newest_config_revision_ = revision;
+    }
     config_.reset();
     config_.emplace(std::move(config));
     configured_ = true;
@@ -1428,6 +1611,7 @@ public:
         return listener->update_config(std::move(c));
       }));
     }
+    return true;
   }
 
   void handle_not_my_vbucket(const io::mcbp_message& msg)
@@ -1461,33 +1645,151 @@ public:
             bootstrap_port_number_,
             config_text);
         }
-        auto config =
-          protocol::parse_config(config_text, bootstrap_hostname_, bootstrap_port_number_);
+        auto start = std::chrono::steady_clock::now();
+        // Every operation rejected during rebalance carries the same map, so the revision is
+        // checked before the full parse, and only one of the identical maps gets parsed.
+        auto revision = topology::scan_config_revision(config_text);
+        if (revision && !claim_config_revision(revision.value())) {
+          CB_LOG_TRACE("{} received not_my_vbucket status for {}, opaque={} with config rev={}:{} "
+                       "in the payload, which is not newer, skipping parse",
+                       log_prefix_,
+                       protocol::client_opcode(msg.header.opcode),
+                       utils::byte_swap(msg.header.opaque),
+                       revision->epoch.value_or(0),
+                       revision->rev.value_or(0));
+          record_config_parse(config_skip_recorder_, start);
+          return;
+        }
+        topology::configuration config;
+        try {
+          config =
+            protocol::parse_config(config_text, bootstrap_hostname_, bootstrap_port_number_);
+        } catch (const std::exception& e) {
+          CB_LOG_WARNING("{} unable to parse configuration from not_my_vbucket response: {}",
+                         log_prefix_,
+                         e.what());
+          if (revision) {
+            release_config_revision(revision.value());
+          }
+          return;
+        }
+        record_config_parse(config_parse_recorder_, start);
         CB_LOG_DEBUG(
           "{} received not_my_vbucket status for {}, opaque={} with config rev={} in the payload",
           log_prefix_,
           protocol::client_opcode(msg.header.opcode),
           utils::byte_swap(msg.header.opaque),
           config.rev_str());
-        update_configuration(std::move(config));
+        if (!update_configuration(std::move(config)) && revision) {
+          release_config_revision(revision.value());
+        }
       }
     }
   }
 
+  void set_config_parse_recorders(
+    std::shared_ptr<couchbase::metrics::value_recorder> parse_recorder,
+    std::shared_ptr<couchbase::metrics::value_recorder> skip_recorder)
+  {
+    config_parse_recorder_ = std::move(parse_recorder);
+    config_skip_recorder_ = std::move(skip_recorder);
+  }
+
+  void set_write_recorders(std::shared_ptr<couchbase::metrics::value_recorder> packets_recorder,
+                           std::shared_ptr<couchbase::metrics::value_recorder> bytes_recorder)
+  {
+    packets_per_write_recorder_ = std::move(packets_recorder);
+    bytes_per_write_recorder_ = std::move(bytes_recorder);
+  }
+
+  void init_concurrency_limiter()
+  {
+    if (origin_.options().enable_kv_concurrency_limit) {
+      utils::concurrency_limiter::options config{};
+      config.initial_limit = origin_.options().kv_initial_concurrency_limit;
+      config.max_limit = origin_.options().kv_max_concurrency_limit;
+      concurrency_limiter_.emplace(config);
+    }
+  }
+
+  void record_latency(std::chrono::microseconds latency)
+  {
+    latency_histogram_.record(latency);
+  }
+
+  [[nodiscard]] auto latency_histogram() const -> const utils::latency_histogram&
+  {
+    return latency_histogram_;
+  }
+
+  void set_collection_uid_cache(std::shared_ptr<collection_uid_cache> cache)
+  {
+    collection_cache_ = std::move(cache);
+  }
+
   auto get_collection_uid(const std::string& collection_path) -> std::optional<std::uint32_t>
   {
-    return collection_cache_.get(collection_path);
+    Expects(!collection_path.empty());
+    return collection_cache_->get(collection_path);
   }
 
-  void update_collection_uid(const std::string& path, std::uint32_t uid)
+  void update_collection_uid(const std::string& path,
+                             std::uint32_t uid,
+                             std::uint64_t manifest_uid)
   {
     if (stopped_) {
       return;
     }
-    collection_cache_.update(path, uid);
+    Expects(!path.empty());
+    collection_cache_->update(path, uid, manifest_uid);
+  }
+
+  void remove_collection_uid(const std::string& path)
+  {
+    if (path.empty()) {
+      return;
+    }
+    collection_cache_->remove(path);
   }
 
 private:
+  auto claim_config_revision(const topology::config_revision& revision) -> bool
+  {
+    std::scoped_lock lock(config_mutex_);
+    if (newest_config_revision_ && !(newest_config_revision_.value() < revision)) {
+      return false;
+    }
+    newest_config_revision_ = revision;
+    return true;
+  }
+
+  /**
+   * Gives up the claim when the configuration could not be parsed or has been rejected, unless a
+   * newer revision has been claimed in the meantime.
+   */
+  void release_config_revision(const topology::config_revision& revision)
+  {
+    std::scoped_lock lock(config_mutex_);
+    if (newest_config_revision_ != revision) {
+      return;
+    }
+    newest_config_revision_.reset();
+    if (config_) {
+      newest_config_revision_ = topology::config_revision{ config_->epoch, config_->rev };
+    }
+  }
+
+  static void record_config_parse(
+    const std::shared_ptr<couchbase::metrics::value_recorder>& recorder,
+    std::chrono::steady_clock::time_point start)
+  {
+    if (recorder) {
+      recorder->record_value(std::chrono::duration_cast<std::chrono::microseconds>(
+                               std::chrono::steady_clock::now() - start)
+                               .count());
+    }
+  }
+
   void invoke_bootstrap_handler(std::error_code ec)
   {
     retry_backoff_.cancel();
@@ -1515,6 +1817,10 @@ private:
 
     if (!bootstrapped_ && bootstrap_callback_) {
       bootstrap_deadline_.cancel();
+      if (!ec) {
+        bootstrap_duration_ = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - bootstrap_started_at_);
+      }
       if (config_ && state_listener_) {
         std::vector<std::string> endpoints;
         endpoints.reserve(config_.value().nodes.size());
@@ -1558,60 +1864,27 @@ private:
       CB_LOG_ERROR("{} error on resolve: {} ({})", log_prefix_, ec.value(), ec.message());
       return initiate_bootstrap();
     }
-    endpoints_ = endpoints;
+    std::vector<asio::ip::tcp::endpoint> resolved{};
+    resolved.reserve(endpoints.size());
+    for (const auto& entry : endpoints) {
+      resolved.emplace_back(entry.endpoint());
+    }
+    endpoints_ = interleave_address_families(std::move(resolved));
     CB_LOG_TRACE("{} resolved \"{}:{}\" to {} endpoint(s)",
                  log_prefix_,
                  bootstrap_hostname_,
                  bootstrap_port_,
                  endpoints_.size());
-    do_connect(endpoints_.begin());
-    connection_deadline_.expires_after(origin_.options().resolve_timeout);
-    connection_deadline_.async_wait([self = shared_from_this()](const auto timer_ec) {
-      if (timer_ec == asio::error::operation_aborted || self->stopped_) {
-        return;
-      }
-      return self->stream_->close([self](std::error_code) {
-        self->initiate_bootstrap();
-      });
-    });
+    do_connect();
   }
 
-  void do_connect(asio::ip::tcp::resolver::results_type::iterator it)
+  void do_connect()
   {
     if (stopped_) {
       return;
     }
     last_active_ = std::chrono::steady_clock::now();
-    if (it != endpoints_.end()) {
-      auto hostname = it->endpoint().address().to_string();
-      auto port = it->endpoint().port();
-      CB_LOG_DEBUG("{} connecting to {}:{} (\"{}:{}\"), timeout={}ms",
-                   log_prefix_,
-                   hostname,
-                   port,
-                   bootstrap_hostname_,
-                   bootstrap_port_,
-                   origin_.options().connect_timeout.count());
-      connection_deadline_.expires_after(origin_.options().connect_timeout);
-      connection_deadline_.async_wait(
-        [self = shared_from_this(), hostname, port](const auto timer_ec) {
-          if (timer_ec == asio::error::operation_aborted || self->stopped_) {
-            return;
-          }
-          CB_LOG_DEBUG("{} unable to connect to {}:{} (\"{}:{}\") in time, reconnecting",
-                       self->log_prefix_,
-                       hostname,
-                       port,
-                       self->bootstrap_hostname_,
-                       self->bootstrap_port_);
-          return self->stream_->close([self](std::error_code) {
-            self->initiate_bootstrap();
-          });
-        });
-      stream_->async_connect(
-        it->endpoint(),
-        std::bind(&mcbp_session_impl::on_connect, shared_from_this(), std::placeholders::_1, it));
-    } else {
+    if (endpoints_.empty()) {
       CB_LOG_ERROR("{} no more endpoints left to connect to \"{}:{}\", will try another address",
                    log_prefix_,
                    bootstrap_hostname_,
@@ -1623,9 +1896,62 @@ private:
       }
       return initiate_bootstrap();
     }
+    CB_LOG_DEBUG("{} connecting to {} endpoint(s) of \"{}:{}\", attempt_delay={}ms, timeout={}ms",
+                 log_prefix_,
+                 endpoints_.size(),
+                 bootstrap_hostname_,
+                 bootstrap_port_,
+                 origin_.options().connection_attempt_delay.count(),
+                 origin_.options().connect_timeout.count());
+    connect_started_at_ = std::chrono::steady_clock::now();
+    connection_deadline_.expires_after(origin_.options().connect_timeout);
+    connection_deadline_.async_wait([self = shared_from_this()](const auto timer_ec) {
+      if (timer_ec == asio::error::operation_aborted || self->stopped_) {
+        return;
+      }
+      CB_LOG_DEBUG("{} unable to connect to \"{}:{}\" in time, reconnecting",
+                   self->log_prefix_,
+                   self->bootstrap_hostname_,
+                   self->bootstrap_port_);
+      if (auto connector = std::move(self->connector_); connector) {
+        connector->cancel();
+      }
+      return self->stream_->close([self](std::error_code) {
+        self->initiate_bootstrap();
+      });
+    });
+    connector_ = std::make_shared<happy_eyeballs_connector>(
+      stream_->get_executor(), endpoints_, origin_.options().connection_attempt_delay);
+    connector_->async_connect([self = shared_from_this()](
+                                std::error_code ec,
+                                asio::ip::tcp::socket socket,
+                                asio::ip::tcp::endpoint endpoint) mutable {
+      if (ec == asio::error::operation_aborted || self->stopped_) {
+        return;
+      }
+      self->connector_.reset();
+      if (ec) {
+        CB_LOG_WARNING("{} unable to connect to any of {} endpoint(s) of \"{}:{}\": {} ({}){}",
+                       self->log_prefix_,
+                       self->endpoints_.size(),
+                       self->bootstrap_hostname_,
+                       self->bootstrap_port_,
+                       ec.value(),
+                       ec.message(),
+                       (ec == asio::error::connection_refused)
+                         ? ", check server ports and cluster encryption setting"
+                         : "");
+        self->endpoints_.clear();
+        return self->do_connect();
+      }
+      self->stream_->async_attach(
+        std::move(socket), endpoint, [self, endpoint](std::error_code attach_ec) {
+          self->on_connect(attach_ec, endpoint);
+        });
+    });
   }
 
-  void on_connect(const std::error_code& ec, asio::ip::tcp::resolver::results_type::iterator it)
+  void on_connect(const std::error_code& ec, const asio::ip::tcp::endpoint& endpoint)
   {
     if (ec == asio::error::operation_aborted || stopped_) {
       return;
@@ -1643,26 +1969,35 @@ private:
 #endif
       CB_LOG_WARNING("{} unable to connect to {}:{}: {} ({}){}. is_open={}",
                      log_prefix_,
-                     it->endpoint().address().to_string(),
-                     it->endpoint().port(),
+                     endpoint.address().to_string(),
+                     endpoint.port(),
                      ec.value(),
                      error_message,
                      (ec == asio::error::connection_refused)
                        ? ", check server ports and cluster encryption setting"
                        : "",
                      stream_->is_open());
+      // the TCP connection has been established, but the stream failed to start on top of it, so
+      // race the remaining endpoints
+      endpoints_.erase(std::remove(endpoints_.begin(), endpoints_.end(), endpoint),
+                       endpoints_.end());
       if (stream_->is_open()) {
-        stream_->close(std::bind(&mcbp_session_impl::do_connect, shared_from_this(), ++it));
+        stream_->close([self = shared_from_this()](std::error_code) {
+          self->do_connect();
+        });
       } else {
-        do_connect(++it);
+        do_connect();
       }
     } else {
       stream_->set_options();
-      connection_endpoints_ = { it->endpoint(), stream_->local_endpoint() };
-      CB_LOG_DEBUG("{} connected to {}:{}",
+      connect_duration_ = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - connect_started_at_);
+      connection_endpoints_ = { endpoint, stream_->local_endpoint() };
+      CB_LOG_DEBUG("{} connected to {}:{} in {}us",
                    log_prefix_,
                    connection_endpoints_.remote_address,
-                   connection_endpoints_.remote.port());
+                   connection_endpoints_.remote.port(),
+                   connect_duration_.load().count());
       log_prefix_ = fmt::format("[{}/{}/{}/{}] <{}/{}:{}>",
                                 client_id_,
                                 id_,
@@ -1781,6 +2116,13 @@ private:
       return;
     }
     std::swap(writing_buffer_, output_buffer_);
+    if (packets_per_write_recorder_) {
+      packets_per_write_recorder_->record_value(static_cast<std::int64_t>(writing_buffer_.size()));
+    }
+    if (bytes_per_write_recorder_) {
+      bytes_per_write_recorder_->record_value(static_cast<std::int64_t>(output_buffer_bytes_));
+    }
+    output_buffer_bytes_ = 0;
     std::vector<asio::const_buffer> buffers;
     buffers.reserve(writing_buffer_.size());
     for (auto& buf : writing_buffer_) {
@@ -1831,6 +2173,7 @@ private:
   asio::steady_timer connection_deadline_;
   asio::steady_timer retry_backoff_;
   asio::steady_timer ping_deadline_;
+  std::shared_ptr<write_coalescer> write_coalescer_;
   couchbase::core::origin origin_;
   std::optional<std::string> bucket_name_;
   mcbp_parser parser_;
@@ -1855,6 +2198,8 @@ private:
 
   std::array<std::byte, 16384> input_buffer_{};
   std::vector<std::vector<std::byte>> output_buffer_{};
+  /* size of output_buffer_ in bytes, guarded by output_buffer_mutex_ */
+  std::size_t output_buffer_bytes_{ 0 };
   std::vector<std::vector<std::byte>> pending_buffer_{};
   std::vector<std::vector<std::byte>> writing_buffer_{};
   std::mutex output_buffer_mutex_{};
@@ -1865,13 +2210,37 @@ private:
   std::string bootstrap_address_{};
   std::uint16_t bootstrap_port_number_{};
   connection_endpoints connection_endpoints_{ {}, {} };
-  asio::ip::tcp::resolver::results_type endpoints_;
+  std::vector<asio::ip::tcp::endpoint> endpoints_{};
+  std::shared_ptr<happy_eyeballs_connector> connector_{};
+  std::chrono::steady_clock::time_point connect_started_at_{};
+  std::chrono::steady_clock::time_point bootstrap_started_at_{};
+  /* startup measurements of the last bootstrap, reported in diagnostics */
+  std::atomic<std::chrono::microseconds> connect_duration_{ std::chrono::microseconds::zero() };
+  std::atomic<std::chrono::microseconds> bootstrap_duration_{ std::chrono::microseconds::zero() };
   std::vector<protocol::hello_feature> supported_features_;
   std::optional<topology::configuration> config_;
+  /* the newest revision that has been applied, or that is being parsed right now */
+  std::optional<topology::config_revision> newest_config_revision_{};
   mutable std::mutex config_mutex_{};
+  std::shared_ptr<couchbase::metrics::value_recorder> config_parse_recorder_{};
+  std::shared_ptr<couchbase::metrics::value_recorder> config_skip_recorder_{};
+  std::shared_ptr<couchbase::metrics::value_recorder> packets_per_write_recorder_{};
+  std::shared_ptr<couchbase::metrics::value_recorder> bytes_per_write_recorder_{};
+  /* round trip times of the KV operations served by this node */
+  utils::latency_histogram latency_histogram_{};
+  /* adaptive limit of the KV requests in flight, see write_and_subscribe_limited() */
+  mutable std::mutex limiter_mutex_{};
+  std::optional<utils::concurrency_limiter> concurrency_limiter_{};
+  std::map<std::uint32_t, std::chrono::steady_clock::time_point> admitted_requests_{};
+  using queued_request_list = std::list<std::pair<std::uint32_t, std::vector<std::byte>>>;
+  queued_request_list queued_requests_{};
+  /* position of the queued request by opaque, so that cancelled requests leave the queue in O(1) */
+  std::unordered_map<std::uint32_t, queued_request_list::iterator> queued_index_{};
   std::atomic_bool configured_{ false };
   std::optional<error_map> error_map_;
-  collection_cache collection_cache_;
+  std::shared_ptr<collection_uid_cache> collection_cache_{
+    std::make_shared<collection_uid_cache>()
+  };
 
   const bool is_tls_;
   std::shared_ptr<impl::bootstrap_state_listener> state_listener_{ nullptr };
@@ -2014,9 +2383,20 @@ mcbp_session::bootstrap_port_number() const -> std::uint16_t
 void
 mcbp_session::write_and_subscribe(std::uint32_t opaque,
                                   std::vector<std::byte>&& data,
-                                  command_handler&& handler)
+                                  command_handler&& handler,
+                                  bool flush_now)
 {
-  return impl_->write_and_subscribe(opaque, std::move(data), std::move(handler));
+  return impl_->write_and_subscribe(opaque, std::move(data), std::move(handler), flush_now);
+}
+
+void
+mcbp_session::write_and_subscribe_limited(std::uint32_t opaque,
+                                          std::vector<std::byte>&& data,
+                                          command_handler&& handler,
+                                          bool flush_now)
+{
+  return impl_->write_and_subscribe_limited(
+    opaque, std::move(data), std::move(handler), flush_now);
 }
 
 void
@@ -2101,9 +2481,51 @@ mcbp_session::handle_not_my_vbucket(const mcbp_message& msg) const
 }
 
 void
-mcbp_session::update_collection_uid(const std::string& path, std::uint32_t uid)
+mcbp_session::update_collection_uid(const std::string& path,
+                                    std::uint32_t uid,
+                                    std::uint64_t manifest_uid)
 {
-  return impl_->update_collection_uid(path, uid);
+  return impl_->update_collection_uid(path, uid, manifest_uid);
+}
+
+void
+mcbp_session::remove_collection_uid(const std::string& path)
+{
+  return impl_->remove_collection_uid(path);
+}
+
+void
+mcbp_session::set_collection_uid_cache(std::shared_ptr<collection_uid_cache> cache)
+{
+  return impl_->set_collection_uid_cache(std::move(cache));
+}
+
+void
+mcbp_session::set_write_recorders(
+  std::shared_ptr<couchbase::metrics::value_recorder> packets_recorder,
+  std::shared_ptr<couchbase::metrics::value_recorder> bytes_recorder)
+{
+  return impl_->set_write_recorders(std::move(packets_recorder), std::move(bytes_recorder));
+}
+
+void
+mcbp_session::record_latency(std::chrono::microseconds latency)
+{
+  return impl_->record_latency(latency);
+}
+
+auto
+mcbp_session::latency_histogram() const -> const utils::latency_histogram&
+{
+  return impl_->latency_histogram();
+}
+
+void
+mcbp_session::set_config_parse_recorders(
+  std::shared_ptr<couchbase::metrics::value_recorder> parse_recorder,
+  std::shared_ptr<couchbase::metrics::value_recorder> skip_recorder)
+{
+  return impl_->set_config_parse_recorders(std::move(parse_recorder), std::move(skip_recorder));
 }
 
 void
@@ -2119,4 +2541,10 @@ mcbp_session::write_and_flush(std::vector<std::byte>&& buffer)
   return impl_->write_and_flush(std::move(buffer));
 }
 
+void
+mcbp_session::flush()
+{
+  return impl_->flush();
+}
+
 } // namespace couchbase::core::io
@@ -41,6 +41,11 @@ class context;
 } // namespace ssl
 } // namespace asio
 
+namespace couchbase::metrics
+{
+class value_recorder;
+} // namespace couchbase::metrics
+
 namespace couchbase::core
 {
 struct origin;
@@ -51,6 +56,11 @@ namespace topology
 struct configuration;
 } // namespace topology
 
+namespace utils
+{
+class latency_histogram;
+} // namespace utils
+
 namespace diag
 {
 class ping_reporter;
@@ -65,6 +75,7 @@ class bootstrap_state_listener;
 namespace io
 {
 class mcbp_session_impl;
+class collection_uid_cache;
 
 using command_handler = utils::movable_function<
   void(std::error_code, retry_reason, io::mcbp_message&&, std::optional<key_value_error_map_info>)>;
@@ -112,11 +123,28 @@ public:
   [[nodiscard]] auto bootstrap_port() const -> const std::string&;
   [[nodiscard]] auto bootstrap_port_number() const -> std::uint16_t;
   void write_and_flush(std::vector<std::byte>&& buffer);
+  void flush();
   void write_and_subscribe(std::shared_ptr<mcbp::queue_request>,
                            std::shared_ptr<response_handler> handler);
+  /**
+   * When flush_now is false, the packet stays in the output buffer until the next flush(), so
+   * that the caller can write several packets to the socket at once.
+   */
   void write_and_subscribe(std::uint32_t opaque,
                            std::vector<std::byte>&& data,
-                           command_handler&& handler);
+                           command_handler&& handler,
+                           bool flush_now = true);
+  /**
+   * Same as write_and_subscribe(), but the request has to fit into the adaptive concurrency limit
+   * of the node. Otherwise it waits in the queue of the session, or, when the queue is full, the
+   * handler is invoked with errc::common::request_canceled and retry_reason::circuit_breaker_open.
+   * flush_now has the same meaning as for write_and_subscribe() while the request fits into the
+   * limit. Queued requests are flushed when the session releases them.
+   */
+  void write_and_subscribe_limited(std::uint32_t opaque,
+                                   std::vector<std::byte>&& data,
+                                   command_handler&& handler,
+                                   bool flush_now = true);
   void bootstrap(utils::movable_function<void(std::error_code, topology::configuration)>&& handler,
                  bool retry_on_bucket_not_found = false);
   void on_stop(utils::movable_function<void()> handler);
@@ -132,7 +160,18 @@ public:
   [[nodiscard]] auto decode_error_code(std::uint16_t code)
     -> std::optional<key_value_error_map_info>;
   void handle_not_my_vbucket(const io::mcbp_message& msg) const;
-  void update_collection_uid(const std::string& path, std::uint32_t uid);
+  void update_collection_uid(const std::string& path,
+                             std::uint32_t uid,
+                             std::uint64_t manifest_uid);
+  void remove_collection_uid(const std::string& path);
+  void set_collection_uid_cache(std::shared_ptr<collection_uid_cache> cache);
+  void set_config_parse_recorders(
+    std::shared_ptr<couchbase::metrics::value_recorder> parse_recorder,
+    std::shared_ptr<couchbase::metrics::value_recorder> skip_recorder);
+  void set_write_recorders(std::shared_ptr<couchbase::metrics::value_recorder> packets_recorder,
+                           std::shared_ptr<couchbase::metrics::value_recorder> bytes_recorder);
+  void record_latency(std::chrono::microseconds latency);
+  [[nodiscard]] auto latency_histogram() const -> const utils::latency_histogram&;
 
 private:
   std::shared_ptr<mcbp_session_impl> impl_{ nullptr };
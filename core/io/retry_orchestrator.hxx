@@ -37,7 +37,7 @@ cap_duration(std::chrono::milliseconds uncapped,
              std::shared_ptr<Command> command) -> std::chrono::milliseconds
 {
   auto theoretical_deadline = std::chrono::steady_clock::now() + uncapped;
-  auto absolute_deadline = command->deadline.expiry();
+  auto absolute_deadline = command->deadline;
   if (auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(theoretical_deadline -
                                                                          absolute_deadline);
       delta.count() > 0) {
@@ -63,7 +63,7 @@ retry_with_duration(std::shared_ptr<Manager> manager,
     manager->log_prefix(),
     decltype(command->request)::encoded_request_type::body_type::opcode,
     duration.count(),
-    command->id_,
+    command->id(),
     command->request.partition,
     reason,
     command->request.retries.retry_attempts(),
@@ -98,7 +98,7 @@ maybe_retry(std::shared_ptr<Manager> manager,
   CB_LOG_TRACE(R"({} not retrying operation {} (id="{}", reason={}, attempts={}, ec={} ({})))",
                manager->log_prefix(),
                decltype(command->request)::encoded_request_type::body_type::opcode,
-               command->id_,
+               command->id(),
                reason,
                command->request.retries.retry_attempts(),
                ec.value(),
@@ -18,10 +18,13 @@
 #pragma once
 
 #include "ip_protocol.hxx"
+#include "tls_session_cache.hxx"
 
 #include <asio.hpp>
 #include <asio/ssl.hpp>
+#include <fmt/core.h>
 
+#include <chrono>
 #include <functional>
 
 namespace couchbase::core::io
@@ -101,6 +104,16 @@ public:
   virtual void async_connect(const asio::ip::tcp::resolver::results_type::endpoint_type& endpoint,
                              std::function<void(std::error_code)>&& handler) = 0;
 
+  /**
+   * Takes over the socket that has been already connected to the endpoint (for example by
+   * happy_eyeballs_connector), and completes the connection as async_connect would do.
+   *
+   * The socket must use the executor of this stream.
+   */
+  virtual void async_attach(asio::ip::tcp::socket&& socket,
+                            const asio::ip::tcp::endpoint& endpoint,
+                            std::function<void(std::error_code)>&& handler) = 0;
+
   virtual void async_write(std::vector<asio::const_buffer>& buffers,
                            std::function<void(std::error_code, std::size_t)>&& handler) = 0;
 
@@ -168,6 +181,17 @@ public:
     });
   }
 
+  void async_attach(asio::ip::tcp::socket&& socket,
+                    const asio::ip::tcp::endpoint& /* endpoint */,
+                    std::function<void(std::error_code)>&& handler) override
+  {
+    stream_ = std::make_shared<asio::ip::tcp::socket>(std::move(socket));
+    open_ = stream_->is_open();
+    return asio::post(strand_, [h = std::move(handler)]() {
+      h({});
+    });
+  }
+
   void async_write(std::vector<asio::const_buffer>& buffers,
                    std::function<void(std::error_code, std::size_t)>&& handler) override
   {
@@ -211,6 +235,12 @@ public:
   {
     open_ = false;
     return asio::post(strand_, [stream = stream_, h = std::move(handler)]() {
+      // OpenSSL marks the session of the connection that has not been shut down as not
+      // resumable, so the established connection that is being closed on purpose is marked as
+      // shut down to keep its session in the tls_session_cache usable.
+      if (SSL_is_init_finished(stream->native_handle()) == 1) {
+        SSL_set_shutdown(stream->native_handle(), SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+      }
       asio::error_code ec{};
       stream->lowest_layer().shutdown(asio::socket_base::shutdown_both, ec);
       stream->lowest_layer().close(ec);
@@ -241,7 +271,7 @@ public:
                      std::function<void(std::error_code)>&& handler) override
   {
     return stream_->lowest_layer().async_connect(
-      endpoint, [this, handler](std::error_code ec_connect) mutable {
+      endpoint, [this, endpoint, handler](std::error_code ec_connect) mutable {
         if (ec_connect == asio::error::operation_aborted) {
           return;
         }
@@ -249,16 +279,19 @@ public:
           return handler(ec_connect);
         }
         open_ = stream_->lowest_layer().is_open();
-        stream_->async_handshake(asio::ssl::stream_base::client,
-                                 [handler](std::error_code ec_handshake) mutable {
-                                   if (ec_handshake == asio::error::operation_aborted) {
-                                     return;
-                                   }
-                                   return handler(ec_handshake);
-                                 });
+        handshake(endpoint, std::move(handler));
       });
   }
 
+  void async_attach(asio::ip::tcp::socket&& socket,
+                    const asio::ip::tcp::endpoint& endpoint,
+                    std::function<void(std::error_code)>&& handler) override
+  {
+    stream_ = std::make_shared<asio::ssl::stream<asio::ip::tcp::socket>>(std::move(socket), tls_);
+    open_ = stream_->lowest_layer().is_open();
+    handshake(endpoint, std::move(handler));
+  }
+
   void async_write(std::vector<asio::const_buffer>& buffers,
                    std::function<void(std::error_code, std::size_t)>&& handler) override
   {
@@ -270,6 +303,33 @@ public:
   {
     return stream_->async_read_some(buffer, std::move(handler));
   }
+
+private:
+  void handshake(const asio::ip::tcp::endpoint& endpoint,
+                 std::function<void(std::error_code)>&& handler)
+  {
+    auto* session_cache = tls_session_cache::from_context(tls_.native_handle());
+    if (session_cache != nullptr) {
+      session_cache->prepare(
+        stream_->native_handle(),
+        fmt::format("{}:{}", endpoint.address().to_string(), endpoint.port()));
+    }
+    stream_->async_handshake(
+      asio::ssl::stream_base::client,
+      [stream = stream_,
+       session_cache,
+       start = std::chrono::steady_clock::now(),
+       handler = std::move(handler)](std::error_code ec_handshake) mutable {
+        if (ec_handshake == asio::error::operation_aborted) {
+          return;
+        }
+        if (!ec_handshake && session_cache != nullptr) {
+          session_cache->record_handshake(stream->native_handle(),
+                                          std::chrono::steady_clock::now() - start);
+        }
+        return handler(ec_handshake);
+      });
+  }
 };
 
 } // namespace couchbase::core::io
@@ -0,0 +1,283 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "timer_wheel.hxx"
+
+#include <asio/error.hpp>
+
+#include <algorithm>
+
+namespace couchbase::core::io
+{
+timer_wheel::timer_wheel(asio::io_context& ctx, std::chrono::milliseconds tick)
+  : tick_{ std::max(tick, std::chrono::milliseconds{ 1 }) }
+  , timer_{ ctx }
+{
+}
+
+timer_wheel::~timer_wheel()
+{
+  cancel_all();
+}
+
+void
+timer_wheel::schedule(timer_wheel_entry& entry,
+                      std::chrono::steady_clock::time_point expiry,
+                      timer_wheel_handler&& handler)
+{
+  timer_wheel_handler previous{};
+  {
+    std::scoped_lock lock(mutex_);
+    if (entry.linked_) {
+      unlink_locked(entry);
+      --size_;
+      previous = std::move(entry.handler_);
+    }
+    if (size_ == 0 && !armed_) {
+      // the wheel was idle, catch up with the clock before computing the position
+      current_tick_ = std::max(current_tick_, ticks_at(std::chrono::steady_clock::now()));
+    }
+    auto deadline = std::chrono::ceil<std::chrono::milliseconds>(expiry - start_);
+    std::uint64_t tick = 0;
+    if (deadline.count() > 0) {
+      // round up, so that the handler is never invoked before the expiry
+      tick = static_cast<std::uint64_t>((deadline + tick_ - std::chrono::milliseconds{ 1 }) / tick_);
+    }
+    entry.tick_ = std::max(tick, current_tick_ + 1);
+    entry.handler_ = std::move(handler);
+    place_locked(entry);
+    ++size_;
+    if (!armed_) {
+      arm_locked();
+    }
+  }
+}
+
+auto
+timer_wheel::cancel(timer_wheel_entry& entry) -> bool
+{
+  timer_wheel_handler handler{};
+  {
+    std::scoped_lock lock(mutex_);
+    if (!entry.linked_) {
+      return false;
+    }
+    unlink_locked(entry);
+    --size_;
+    handler = std::move(entry.handler_);
+  }
+  // the handler might hold the last reference to the owner of the entry, so it has to be
+  // destroyed outside of the lock
+  return true;
+}
+
+void
+timer_wheel::cancel_all()
+{
+  std::vector<timer_wheel_handler> handlers{};
+  {
+    std::scoped_lock lock(mutex_);
+    handlers.reserve(size_);
+    for (auto& level : levels_) {
+      for (auto& slot : level) {
+        while (slot != nullptr) {
+          auto* entry = slot;
+          unlink_locked(*entry);
+          handlers.emplace_back(std::move(entry->handler_));
+        }
+      }
+    }
+    size_ = 0;
+  }
+}
+
+void
+timer_wheel::expire_all(std::error_code ec)
+{
+  std::vector<timer_wheel_handler> handlers{};
+  {
+    std::scoped_lock lock(mutex_);
+    handlers.reserve(size_);
+    for (auto& level : levels_) {
+      for (auto& slot : level) {
+        while (slot != nullptr) {
+          auto* entry = slot;
+          unlink_locked(*entry);
+          handlers.emplace_back(std::move(entry->handler_));
+        }
+      }
+    }
+    size_ = 0;
+  }
+  // the handlers might schedule or cancel other entries, so they are invoked outside of the lock
+  for (auto& handler : handlers) {
+    if (handler) {
+      handler(ec);
+    }
+  }
+}
+
+auto
+timer_wheel::size() const -> std::size_t
+{
+  std::scoped_lock lock(mutex_);
+  return size_;
+}
+
+auto
+timer_wheel::tick() const -> std::chrono::milliseconds
+{
+  return tick_;
+}
+
+auto
+timer_wheel::ticks_at(std::chrono::steady_clock::time_point time_point) const -> std::uint64_t
+{
+  if (time_point <= start_) {
+    return 0;
+  }
+  return static_cast<std::uint64_t>(
+    std::chrono::duration_cast<std::chrono::milliseconds>(time_point - start_) / tick_);
+}
+
+void
+timer_wheel::place_locked(timer_wheel_entry& entry)
+{
+  auto tick = std::max(entry.tick_, current_tick_);
+  auto delta = tick - current_tick_;
+  for (std::size_t level = 0; level < number_of_levels; ++level) {
+    if (delta < (std::uint64_t{ 1 } << (slot_bits * (level + 1)))) {
+      return link_locked(entry, level, (tick >> (slot_bits * level)) & slot_mask);
+    }
+  }
+  // too far in the future, park it at the farthest slot, it will be re-evaluated on cascade
+  constexpr std::size_t top_level = number_of_levels - 1;
+  auto farthest = current_tick_ + (std::uint64_t{ 1 } << (slot_bits * number_of_levels)) - 1;
+  link_locked(entry, top_level, (farthest >> (slot_bits * top_level)) & slot_mask);
+}
+
+void
+timer_wheel::link_locked(timer_wheel_entry& entry, std::size_t level, std::size_t slot)
+{
+  auto& head = levels_[level][slot];
+  entry.level_ = level;
+  entry.slot_ = slot;
+  entry.prev_ = nullptr;
+  entry.next_ = head;
+  if (head != nullptr) {
+    head->prev_ = &entry;
+  }
+  head = &entry;
+  entry.linked_ = true;
+}
+
+void
+timer_wheel::unlink_locked(timer_wheel_entry& entry)
+{
+  if (entry.prev_ != nullptr) {
+    entry.prev_->next_ = entry.next_;
+  } else {
+    levels_[entry.level_][entry.slot_] = entry.next_;
+  }
+  if (entry.next_ != nullptr) {
+    entry.next_->prev_ = entry.prev_;
+  }
+  entry.prev_ = nullptr;
+  entry.next_ = nullptr;
+  entry.linked_ = false;
+}
+
+void
+timer_wheel::advance_locked(std::uint64_t now_tick,
+                            std::vector<timer_wheel_handler>& expired)
+{
+  while (current_tick_ < now_tick && size_ > 0) {
+    ++current_tick_;
+
+    // move entries of the higher levels closer to the level zero, when their turn comes
+    for (std::size_t level = 1; level < number_of_levels; ++level) {
+      if ((current_tick_ & ((std::uint64_t{ 1 } << (slot_bits * level)) - 1)) != 0) {
+        break;
+      }
+      auto& head = levels_[level][(current_tick_ >> (slot_bits * level)) & slot_mask];
+      auto* entry = head;
+      head = nullptr;
+      while (entry != nullptr) {
+        auto* next = entry->next_;
+        place_locked(*entry);
+        entry = next;
+      }
+    }
+
+    auto& head = levels_[0][current_tick_ & slot_mask];
+    auto* entry = head;
+    head = nullptr;
+    while (entry != nullptr) {
+      auto* next = entry->next_;
+      if (entry->tick_ <= current_tick_) {
+        entry->prev_ = nullptr;
+        entry->next_ = nullptr;
+        entry->linked_ = false;
+        --size_;
+        expired.emplace_back(std::move(entry->handler_));
+      } else {
+        place_locked(*entry);
+      }
+      entry = next;
+    }
+  }
+  if (size_ == 0) {
+    current_tick_ = std::max(current_tick_, now_tick);
+  }
+}
+
+void
+timer_wheel::arm_locked()
+{
+  armed_ = true;
+  timer_.expires_at(start_ +
+                    tick_ * static_cast<std::chrono::milliseconds::rep>(current_tick_ + 1));
+  timer_.async_wait([self = shared_from_this()](std::error_code ec) {
+    self->on_tick(ec);
+  });
+}
+
+void
+timer_wheel::on_tick(std::error_code ec)
+{
+  if (ec == asio::error::operation_aborted) {
+    std::scoped_lock lock(mutex_);
+    armed_ = false;
+    return;
+  }
+  std::vector<timer_wheel_handler> expired{};
+  {
+    std::scoped_lock lock(mutex_);
+    advance_locked(ticks_at(std::chrono::steady_clock::now()), expired);
+    if (size_ > 0) {
+      arm_locked();
+    } else {
+      armed_ = false;
+    }
+  }
+  for (auto& handler : expired) {
+    if (handler) {
+      handler({});
+    }
+  }
+}
+} // namespace couchbase::core::io
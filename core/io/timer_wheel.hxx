@@ -0,0 +1,154 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/utils/movable_function.hxx"
+
+#include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <vector>
+
+namespace couchbase::core::io
+{
+class timer_wheel;
+
+/**
+ * Invoked with an empty error code when the timeout expires, or with the error passed to
+ * timer_wheel::expire_all() when the owner of the wheel shuts down.
+ */
+using timer_wheel_handler = utils::movable_function<void(std::error_code)>;
+
+/**
+ * Intrusive handle of a single timeout registered in the timer_wheel. It is usually embedded in
+ * the object that owns the timeout, so that arming it does not allocate.
+ *
+ * The entry must outlive its registration. The handler typically keeps its owner alive, which
+ * guarantees that. As the owner usually keeps the wheel alive too, the owner of the wheel has to
+ * release pending handlers with timer_wheel::expire_all() when it shuts down.
+ */
+class timer_wheel_entry
+{
+public:
+  timer_wheel_entry() = default;
+  timer_wheel_entry(const timer_wheel_entry&) = delete;
+  timer_wheel_entry(timer_wheel_entry&&) = delete;
+  auto operator=(const timer_wheel_entry&) -> timer_wheel_entry& = delete;
+  auto operator=(timer_wheel_entry&&) -> timer_wheel_entry& = delete;
+  ~timer_wheel_entry() = default;
+
+private:
+  friend class timer_wheel;
+
+  timer_wheel_entry* prev_{ nullptr };
+  timer_wheel_entry* next_{ nullptr };
+  std::uint64_t tick_{ 0 };
+  std::size_t level_{ 0 };
+  std::size_t slot_{ 0 };
+  bool linked_{ false };
+  timer_wheel_handler handler_{};
+};
+
+/**
+ * Hierarchical timing wheel, which tracks operation deadlines and retry backoffs with O(1)
+ * insertion and cancellation, and a single asio::steady_timer for all of them.
+ *
+ * Timeouts are rounded up to the tick, so a handler might be invoked up to one tick late, but
+ * never early. Cancelled handlers are destroyed without being invoked.
+ */
+class timer_wheel : public std::enable_shared_from_this<timer_wheel>
+{
+public:
+  static constexpr std::chrono::milliseconds default_tick{ 5 };
+
+  timer_wheel(asio::io_context& ctx, std::chrono::milliseconds tick = default_tick);
+  timer_wheel(const timer_wheel&) = delete;
+  timer_wheel(timer_wheel&&) = delete;
+  auto operator=(const timer_wheel&) -> timer_wheel& = delete;
+  auto operator=(timer_wheel&&) -> timer_wheel& = delete;
+  ~timer_wheel();
+
+  /**
+   * Registers the handler to be invoked at (or shortly after) the given time. If the entry was
+   * already registered, the previous handler is cancelled.
+   */
+  void schedule(timer_wheel_entry& entry,
+                std::chrono::steady_clock::time_point expiry,
+                timer_wheel_handler&& handler);
+
+  void schedule_after(timer_wheel_entry& entry,
+                      std::chrono::steady_clock::duration timeout,
+                      timer_wheel_handler&& handler)
+  {
+    schedule(entry, std::chrono::steady_clock::now() + timeout, std::move(handler));
+  }
+
+  /**
+   * Removes the entry from the wheel and destroys its handler.
+   *
+   * @return false if the entry was not registered (or has expired already)
+   */
+  auto cancel(timer_wheel_entry& entry) -> bool;
+
+  /**
+   * Destroys all pending handlers without invoking them.
+   */
+  void cancel_all();
+
+  /**
+   * Removes all entries and invokes their handlers immediately with the given error.
+   */
+  void expire_all(std::error_code ec);
+
+  [[nodiscard]] auto size() const -> std::size_t;
+  [[nodiscard]] auto tick() const -> std::chrono::milliseconds;
+
+private:
+  static constexpr std::size_t slot_bits{ 6 };
+  static constexpr std::size_t slots_per_level{ 1U << slot_bits };
+  static constexpr std::size_t slot_mask{ slots_per_level - 1 };
+  static constexpr std::size_t number_of_levels{ 4 };
+
+  using level_type = std::array<timer_wheel_entry*, slots_per_level>;
+
+  [[nodiscard]] auto ticks_at(std::chrono::steady_clock::time_point time_point) const
+    -> std::uint64_t;
+  void place_locked(timer_wheel_entry& entry);
+  void link_locked(timer_wheel_entry& entry, std::size_t level, std::size_t slot);
+  void unlink_locked(timer_wheel_entry& entry);
+  void advance_locked(std::uint64_t now_tick,
+                      std::vector<timer_wheel_handler>& expired);
+  void arm_locked();
+  void on_tick(std::error_code ec);
+
+  std::chrono::milliseconds tick_;
+  std::chrono::steady_clock::time_point start_{ std::chrono::steady_clock::now() };
+  asio::steady_timer timer_;
+  mutable std::mutex mutex_{};
+  std::array<level_type, number_of_levels> levels_{};
+  std::uint64_t current_tick_{ 0 };
+  std::size_t size_{ 0 };
+  bool armed_{ false };
+};
+} // namespace couchbase::core::io
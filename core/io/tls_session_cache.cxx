@@ -0,0 +1,168 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "tls_session_cache.hxx"
+
+#include <couchbase/metrics/meter.hxx>
+
+namespace couchbase::core::io
+{
+namespace
+{
+void
+free_endpoint(void* /* parent */,
+              void* ptr,
+              CRYPTO_EX_DATA* /* ad */,
+              int /* index */,
+              long /* argl */,
+              void* /* argp */)
+{
+  delete static_cast<std::string*>(ptr);
+}
+
+auto
+context_index() -> int
+{
+  static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  return index;
+}
+
+auto
+endpoint_index() -> int
+{
+  static const int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, free_endpoint);
+  return index;
+}
+} // namespace
+
+void
+tls_session_cache::session_deleter::operator()(SSL_SESSION* session) const
+{
+  SSL_SESSION_free(session);
+}
+
+tls_session_cache::tls_session_cache(std::size_t max_entries)
+  : max_entries_{ max_entries }
+{
+}
+
+tls_session_cache::~tls_session_cache() = default;
+
+void
+tls_session_cache::install(SSL_CTX* ctx)
+{
+  SSL_CTX_set_ex_data(ctx, context_index(), this);
+  SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+  SSL_CTX_sess_set_new_cb(ctx, &tls_session_cache::on_new_session);
+}
+
+auto
+tls_session_cache::from_context(SSL_CTX* ctx) -> tls_session_cache*
+{
+  return static_cast<tls_session_cache*>(SSL_CTX_get_ex_data(ctx, context_index()));
+}
+
+void
+tls_session_cache::prepare(SSL* ssl, const std::string& endpoint)
+{
+  auto* previous = static_cast<std::string*>(SSL_get_ex_data(ssl, endpoint_index()));
+  SSL_set_ex_data(ssl, endpoint_index(), new std::string(endpoint));
+  delete previous;
+
+  std::scoped_lock lock(mutex_);
+  if (auto entry = sessions_.find(endpoint); entry != sessions_.end()) {
+    if (SSL_SESSION_is_resumable(entry->second.get()) == 1) {
+      SSL_set_session(ssl, entry->second.get());
+    } else {
+      sessions_.erase(entry);
+    }
+  }
+}
+
+void
+tls_session_cache::record_handshake(SSL* ssl, std::chrono::steady_clock::duration elapsed)
+{
+  auto duration = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+  if (SSL_session_reused(ssl) == 1) {
+    ++resumed_handshakes_;
+    if (resumed_recorder_) {
+      resumed_recorder_->record_value(duration);
+    }
+  } else {
+    ++full_handshakes_;
+    if (full_recorder_) {
+      full_recorder_->record_value(duration);
+    }
+  }
+}
+
+void
+tls_session_cache::set_recorders(std::shared_ptr<couchbase::metrics::value_recorder> resumed,
+                                 std::shared_ptr<couchbase::metrics::value_recorder> full)
+{
+  resumed_recorder_ = std::move(resumed);
+  full_recorder_ = std::move(full);
+}
+
+auto
+tls_session_cache::resumed_handshakes() const -> std::uint64_t
+{
+  return resumed_handshakes_;
+}
+
+auto
+tls_session_cache::full_handshakes() const -> std::uint64_t
+{
+  return full_handshakes_;
+}
+
+auto
+tls_session_cache::size() const -> std::size_t
+{
+  std::scoped_lock lock(mutex_);
+  return sessions_.size();
+}
+
+auto
+tls_session_cache::on_new_session(SSL* ssl, SSL_SESSION* session) -> int
+{
+  auto* cache = from_context(SSL_get_SSL_CTX(ssl));
+  const auto* endpoint = static_cast<const std::string*>(SSL_get_ex_data(ssl, endpoint_index()));
+  if (cache == nullptr || endpoint == nullptr) {
+    return 0;
+  }
+  cache->store(*endpoint, session);
+  /* the cache took the ownership of the session */
+  return 1;
+}
+
+void
+tls_session_cache::store(const std::string& endpoint, SSL_SESSION* session)
+{
+  session_ptr entry{ session };
+  std::scoped_lock lock(mutex_);
+  if (auto existing = sessions_.find(endpoint); existing != sessions_.end()) {
+    existing->second = std::move(entry);
+    return;
+  }
+  if (sessions_.size() >= max_entries_) {
+    sessions_.erase(sessions_.begin());
+  }
+  sessions_.try_emplace(endpoint, std::move(entry));
+}
+} // namespace couchbase::core::io
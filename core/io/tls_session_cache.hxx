@@ -0,0 +1,99 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include <openssl/ssl.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace couchbase::metrics
+{
+class value_recorder;
+} // namespace couchbase::metrics
+
+namespace couchbase::core::io
+{
+/**
+ * Client-side cache of TLS sessions, keyed by the remote endpoint.
+ *
+ * The cache is attached to the SSL_CTX, so every KV and HTTP session that uses the context offers
+ * the last session (or session ticket) received from the same endpoint, and the server could
+ * resume it with abbreviated handshake instead of the full one.
+ */
+class tls_session_cache
+{
+public:
+  explicit tls_session_cache(std::size_t max_entries = 1024);
+  tls_session_cache(const tls_session_cache&) = delete;
+  tls_session_cache(tls_session_cache&&) = delete;
+  auto operator=(const tls_session_cache&) -> tls_session_cache& = delete;
+  auto operator=(tls_session_cache&&) -> tls_session_cache& = delete;
+  ~tls_session_cache();
+
+  /**
+   * Enables client session caching on the context, and routes new sessions to this cache.
+   * The cache must outlive the context.
+   */
+  void install(SSL_CTX* ctx);
+
+  /**
+   * @return cache installed into the context, or nullptr
+   */
+  static auto from_context(SSL_CTX* ctx) -> tls_session_cache*;
+
+  /**
+   * Must be invoked before the handshake. Remembers the endpoint of the connection, and offers
+   * cached session if there is one.
+   */
+  void prepare(SSL* ssl, const std::string& endpoint);
+
+  void record_handshake(SSL* ssl, std::chrono::steady_clock::duration elapsed);
+
+  void set_recorders(std::shared_ptr<couchbase::metrics::value_recorder> resumed,
+                     std::shared_ptr<couchbase::metrics::value_recorder> full);
+
+  [[nodiscard]] auto resumed_handshakes() const -> std::uint64_t;
+  [[nodiscard]] auto full_handshakes() const -> std::uint64_t;
+  [[nodiscard]] auto size() const -> std::size_t;
+
+private:
+  struct session_deleter {
+    void operator()(SSL_SESSION* session) const;
+  };
+  using session_ptr = std::unique_ptr<SSL_SESSION, session_deleter>;
+
+  static auto on_new_session(SSL* ssl, SSL_SESSION* session) -> int;
+  void store(const std::string& endpoint, SSL_SESSION* session);
+
+  std::size_t max_entries_;
+  mutable std::mutex mutex_{};
+  std::map<std::string, session_ptr> sessions_{};
+  std::atomic_uint64_t resumed_handshakes_{ 0 };
+  std::atomic_uint64_t full_handshakes_{ 0 };
+  std::shared_ptr<couchbase::metrics::value_recorder> resumed_recorder_{};
+  std::shared_ptr<couchbase::metrics::value_recorder> full_recorder_{};
+};
+} // namespace couchbase::core::io
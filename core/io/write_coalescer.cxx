@@ -0,0 +1,72 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "write_coalescer.hxx"
+
+#include <asio/error.hpp>
+#include <asio/post.hpp>
+
+namespace couchbase::core::io
+{
+write_coalescer::write_coalescer(asio::io_context& ctx)
+  : strand_{ asio::make_strand(ctx) }
+  , timer_{ strand_ }
+{
+}
+
+void
+write_coalescer::schedule(std::chrono::microseconds window,
+                          utils::movable_function<void()>&& handler)
+{
+  if (cancelled_ || scheduled_.exchange(true)) {
+    // the buffer will be written when the current window closes
+    return;
+  }
+  asio::post(strand_,
+             [self = shared_from_this(), window, handler = std::move(handler)]() mutable {
+               if (self->cancelled_) {
+                 return;
+               }
+               self->timer_.expires_after(window);
+               self->timer_.async_wait(
+                 [self, handler = std::move(handler)](std::error_code ec) mutable {
+                   // reset before the handler, so that writes submitted while it runs open a new
+                   // window
+                   self->scheduled_ = false;
+                   if (ec == asio::error::operation_aborted || self->cancelled_) {
+                     return;
+                   }
+                   handler();
+                 });
+             });
+}
+
+void
+write_coalescer::cancel()
+{
+  cancelled_ = true;
+  asio::post(strand_, [self = shared_from_this()]() {
+    self->timer_.cancel();
+  });
+}
+
+auto
+write_coalescer::is_scheduled() const -> bool
+{
+  return scheduled_;
+}
+} // namespace couchbase::core::io
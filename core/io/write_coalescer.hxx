@@ -0,0 +1,63 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/utils/movable_function.hxx"
+
+#include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+#include <asio/strand.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+namespace couchbase::core::io
+{
+/**
+ * Delays the write of small batches, so that the packets submitted within the window leave in a
+ * single socket write.
+ *
+ * Callers may request the flush from any thread. The timer is armed, fired and cancelled only on
+ * the strand of the coalescer, so it is never touched concurrently.
+ */
+class write_coalescer : public std::enable_shared_from_this<write_coalescer>
+{
+public:
+  explicit write_coalescer(asio::io_context& ctx);
+
+  /**
+   * Invokes the handler once the window closes. Requests made while the window is open are
+   * merged into the pending one, and their handlers are dropped.
+   */
+  void schedule(std::chrono::microseconds window, utils::movable_function<void()>&& handler);
+
+  /**
+   * The pending handler, if any, is released without being invoked. Later requests are ignored.
+   */
+  void cancel();
+
+  [[nodiscard]] auto is_scheduled() const -> bool;
+
+private:
+  asio::strand<asio::io_context::executor_type> strand_;
+  asio::steady_timer timer_;
+  std::atomic_bool scheduled_{ false };
+  std::atomic_bool cancelled_{ false };
+};
+} // namespace couchbase::core::io
@@ -0,0 +1,325 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "exporting_meter.hxx"
+
+#include "core/logger/logger.hxx"
+#include "core/meta/version.hxx"
+#include "core/utils/json.hxx"
+#include "thread_shard.hxx"
+
+#include <fmt/core.h>
+#include <tao/json/value.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+
+namespace couchbase::core::metrics
+{
+namespace
+{
+auto
+unix_nanos(std::chrono::system_clock::time_point time_point) -> std::string
+{
+  return std::to_string(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(time_point.time_since_epoch()).count());
+}
+
+auto
+prometheus_name(const std::string& name) -> std::string
+{
+  std::string result = name;
+  for (auto& c : result) {
+    if ((c < 'a' || c > 'z') && (c < 'A' || c > 'Z') && (c < '0' || c > '9') && c != '_') {
+      c = '_';
+    }
+  }
+  return result;
+}
+
+auto
+prometheus_label_value(const std::string& value) -> std::string
+{
+  std::string result;
+  result.reserve(value.size());
+  for (auto c : value) {
+    switch (c) {
+      case '\\':
+        result += "\\\\";
+        break;
+      case '"':
+        result += "\\\"";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      default:
+        result += c;
+    }
+  }
+  return result;
+}
+
+auto
+otlp_attributes(const std::map<std::string, std::string>& tags) -> tao::json::value
+{
+  tao::json::value attributes = tao::json::empty_array;
+  for (const auto& [key, value] : tags) {
+    attributes.emplace_back(tao::json::value{
+      { "key", key },
+      { "value", { { "stringValue", value } } },
+    });
+  }
+  return attributes;
+}
+} // namespace
+
+/**
+ * Fixed-bucket histogram, with counters sharded between threads.
+ */
+class exporting_value_recorder : public couchbase::metrics::value_recorder
+{
+public:
+  struct snapshot {
+    std::vector<std::uint64_t> bucket_counts{};
+    std::uint64_t count{ 0 };
+    std::uint64_t sum{ 0 };
+  };
+
+  explicit exporting_value_recorder(std::vector<std::uint64_t> boundaries)
+    : boundaries_{ std::move(boundaries) }
+  {
+    for (auto& shard : shards_) {
+      shard.counts = std::make_unique<std::atomic_uint64_t[]>(boundaries_.size() + 1);
+      for (std::size_t i = 0; i <= boundaries_.size(); ++i) {
+        shard.counts[i].store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void record_value(std::int64_t value) override
+  {
+    auto unsigned_value = value < 0 ? std::uint64_t{ 0 } : static_cast<std::uint64_t>(value);
+    auto bucket = static_cast<std::size_t>(
+      std::lower_bound(boundaries_.begin(), boundaries_.end(), unsigned_value) -
+      boundaries_.begin());
+    auto& shard = shards_[thread_shard_index()];
+    shard.counts[bucket].fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(unsigned_value, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto take_snapshot() const -> snapshot
+  {
+    snapshot result{ std::vector<std::uint64_t>(boundaries_.size() + 1, 0) };
+    for (const auto& shard : shards_) {
+      for (std::size_t i = 0; i <= boundaries_.size(); ++i) {
+        auto count = shard.counts[i].load(std::memory_order_relaxed);
+        result.bucket_counts[i] += count;
+        result.count += count;
+      }
+      result.sum += shard.sum.load(std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  [[nodiscard]] auto boundaries() const -> const std::vector<std::uint64_t>&
+  {
+    return boundaries_;
+  }
+
+private:
+  struct alignas(64) shard_type {
+    std::unique_ptr<std::atomic_uint64_t[]> counts{};
+    std::atomic_uint64_t sum{ 0 };
+  };
+
+  const std::vector<std::uint64_t> boundaries_;
+  std::array<shard_type, number_of_thread_shards> shards_{};
+};
+
+exporting_meter::exporting_meter(asio::io_context& ctx, exporting_meter_options options)
+  : emit_report_(ctx)
+  , options_(std::move(options))
+{
+}
+
+exporting_meter::~exporting_meter()
+{
+  emit_report_.cancel();
+}
+
+void
+exporting_meter::start()
+{
+  rearm_reporter();
+}
+
+void
+exporting_meter::stop()
+{
+  emit_report_.cancel();
+  flush();
+}
+
+void
+exporting_meter::rearm_reporter()
+{
+  emit_report_.expires_after(options_.emit_interval);
+  emit_report_.async_wait([self = shared_from_this()](std::error_code ec) {
+    if (ec == asio::error::operation_aborted) {
+      return;
+    }
+    self->flush();
+    self->rearm_reporter();
+  });
+}
+
+auto
+exporting_meter::get_value_recorder(const std::string& name,
+                                    const std::map<std::string, std::string>& tags)
+  -> std::shared_ptr<couchbase::metrics::value_recorder>
+{
+  std::scoped_lock lock(recorders_mutex_);
+  auto& recorders = recorders_[name];
+  if (auto recorder = recorders.find(tags); recorder != recorders.end()) {
+    return recorder->second;
+  }
+  return recorders
+    .try_emplace(tags, std::make_shared<exporting_value_recorder>(options_.bucket_boundaries_us))
+    .first->second;
+}
+
+void
+exporting_meter::flush()
+{
+  if (options_.sink == nullptr) {
+    return;
+  }
+  utils::telemetry_batch batch{ utils::telemetry_signal::metrics, options_.format };
+  switch (options_.format) {
+    case utils::telemetry_format::otlp_json:
+      batch.payload = build_otlp_json();
+      break;
+    case utils::telemetry_format::prometheus_text:
+      batch.payload = build_prometheus_text();
+      break;
+  }
+  if (batch.payload.empty()) {
+    return;
+  }
+  options_.sink->write(std::move(batch));
+}
+
+auto
+exporting_meter::build_otlp_json() const -> std::string
+{
+  auto now = unix_nanos(std::chrono::system_clock::now());
+  auto start = unix_nanos(start_time_);
+
+  tao::json::value metrics = tao::json::empty_array;
+  {
+    std::scoped_lock lock(recorders_mutex_);
+    for (const auto& [name, recorders] : recorders_) {
+      tao::json::value data_points = tao::json::empty_array;
+      for (const auto& [tags, recorder] : recorders) {
+        auto snapshot = recorder->take_snapshot();
+        tao::json::value bucket_counts = tao::json::empty_array;
+        for (auto count : snapshot.bucket_counts) {
+          bucket_counts.emplace_back(std::to_string(count));
+        }
+        tao::json::value explicit_bounds = tao::json::empty_array;
+        for (auto bound : recorder->boundaries()) {
+          explicit_bounds.emplace_back(bound);
+        }
+        data_points.emplace_back(tao::json::value{
+          { "attributes", otlp_attributes(tags) },
+          { "startTimeUnixNano", start },
+          { "timeUnixNano", now },
+          { "count", std::to_string(snapshot.count) },
+          { "sum", snapshot.sum },
+          { "bucketCounts", bucket_counts },
+          { "explicitBounds", explicit_bounds },
+        });
+      }
+      metrics.emplace_back(tao::json::value{
+        { "name", name },
+        { "unit", "us" },
+        { "histogram",
+          {
+            { "aggregationTemporality", 2 /* AGGREGATION_TEMPORALITY_CUMULATIVE */ },
+            { "dataPoints", data_points },
+          } },
+      });
+    }
+  }
+  if (metrics.get_array().empty()) {
+    return {};
+  }
+
+  tao::json::value scope_metrics{
+    { "scope",
+      {
+        { "name", meta::sdk_id() },
+        { "version", meta::sdk_semver() },
+      } },
+    { "metrics", metrics },
+  };
+  tao::json::value resource_metrics{
+    { "resource",
+      { { "attributes", otlp_attributes({ { "service.name", "couchbase-cxx-client" } }) } } },
+    { "scopeMetrics", tao::json::empty_array },
+  };
+  resource_metrics["scopeMetrics"].emplace_back(std::move(scope_metrics));
+  tao::json::value payload{ { "resourceMetrics", tao::json::empty_array } };
+  payload["resourceMetrics"].emplace_back(std::move(resource_metrics));
+  return utils::json::generate(payload);
+}
+
+auto
+exporting_meter::build_prometheus_text() const -> std::string
+{
+  std::string output;
+  std::scoped_lock lock(recorders_mutex_);
+  for (const auto& [name, recorders] : recorders_) {
+    auto metric = prometheus_name(name);
+    output += fmt::format("# TYPE {} histogram\n", metric);
+    for (const auto& [tags, recorder] : recorders) {
+      std::string labels;
+      for (const auto& [key, value] : tags) {
+        labels += fmt::format("{}=\"{}\",", prometheus_name(key), prometheus_label_value(value));
+      }
+      auto snapshot = recorder->take_snapshot();
+      const auto& boundaries = recorder->boundaries();
+      std::uint64_t cumulative_count = 0;
+      for (std::size_t i = 0; i < boundaries.size(); ++i) {
+        cumulative_count += snapshot.bucket_counts[i];
+        output += fmt::format(
+          "{}_bucket{{{}le=\"{}\"}} {}\n", metric, labels, boundaries[i], cumulative_count);
+      }
+      output += fmt::format("{}_bucket{{{}le=\"+Inf\"}} {}\n", metric, labels, snapshot.count);
+      if (!labels.empty()) {
+        labels.pop_back();
+      }
+      output += fmt::format("{}_sum{{{}}} {}\n", metric, labels, snapshot.sum);
+      output += fmt::format("{}_count{{{}}} {}\n", metric, labels, snapshot.count);
+    }
+  }
+  return output;
+}
+} // namespace couchbase::core::metrics
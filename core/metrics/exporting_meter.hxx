@@ -0,0 +1,83 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "exporting_meter_options.hxx"
+
+#include <couchbase/metrics/meter.hxx>
+
+#include <asio/steady_timer.hpp>
+
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace couchbase::core::metrics
+{
+class exporting_value_recorder;
+
+/**
+ * Meter, which aggregates values into fixed-bucket histograms and periodically sends them to the
+ * telemetry sink as OTLP/HTTP JSON or Prometheus text. The histograms are cumulative.
+ *
+ * Recording a value only increments per-thread counters, the lock is taken when a recorder is
+ * resolved, and when the batch is built.
+ */
+class exporting_meter
+  : public couchbase::metrics::meter
+  , public std::enable_shared_from_this<exporting_meter>
+{
+public:
+  exporting_meter(asio::io_context& ctx, exporting_meter_options options);
+  exporting_meter(const exporting_meter&) = delete;
+  exporting_meter(exporting_meter&&) = delete;
+  auto operator=(const exporting_meter&) -> exporting_meter& = delete;
+  auto operator=(exporting_meter&&) -> exporting_meter& = delete;
+  ~exporting_meter() override;
+
+  void start() override;
+
+  /**
+   * Stops the reporter and hands the last batch to the sink. The destructor does not flush, so
+   * the values recorded after stop() are dropped.
+   */
+  void stop() override;
+
+  auto get_value_recorder(const std::string& name, const std::map<std::string, std::string>& tags)
+    -> std::shared_ptr<couchbase::metrics::value_recorder> override;
+
+  /**
+   * Builds the batch from the current state of the histograms and writes it to the sink.
+   */
+  void flush();
+
+private:
+  void rearm_reporter();
+  [[nodiscard]] auto build_otlp_json() const -> std::string;
+  [[nodiscard]] auto build_prometheus_text() const -> std::string;
+
+  asio::steady_timer emit_report_;
+  const exporting_meter_options options_;
+  const std::chrono::system_clock::time_point start_time_{ std::chrono::system_clock::now() };
+  mutable std::mutex recorders_mutex_{};
+  // metric name -> tags -> recorder
+  std::map<std::string,
+           std::map<std::map<std::string, std::string>, std::shared_ptr<exporting_value_recorder>>>
+    recorders_{};
+};
+} // namespace couchbase::core::metrics
@@ -0,0 +1,44 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/utils/telemetry_sink.hxx"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace couchbase::core::metrics
+{
+struct exporting_meter_options {
+  std::chrono::milliseconds emit_interval{ std::chrono::seconds{ 60 } };
+  utils::telemetry_format format{ utils::telemetry_format::otlp_json };
+  /**
+   * When not set, the exporting meter is not used.
+   */
+  std::shared_ptr<utils::telemetry_sink> sink{ nullptr };
+  /**
+   * Upper bounds of the histogram buckets (inclusive), in microseconds.
+   */
+  std::vector<std::uint64_t> bucket_boundaries_us{
+    100,     250,     500,       1'000,     2'500,     5'000,     10'000,     25'000,
+    50'000,  100'000, 250'000,   500'000,   1'000'000, 2'500'000, 5'000'000, 10'000'000,
+  };
+};
+} // namespace couchbase::core::metrics
@@ -22,106 +22,190 @@
 #include "core/logger/logger.hxx"
 #include "core/utils/json.hxx"
 #include "noop_meter.hxx"
+#include "thread_shard.hxx"
 
 #include <hdr/hdr_histogram.h>
 
 #include <gsl/assert>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
 #include <memory>
+#include <thread>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 namespace couchbase::core::metrics
 {
-class logging_value_recorder : public couchbase::metrics::value_recorder
+namespace
 {
-private:
-  std::string name_;
-  std::map<std::string, std::string> tags_;
-  hdr_histogram* histogram_{ nullptr };
-
-  void initialize_histogram()
-  {
-    histogram_ = nullptr;
-    hdr_init(/* minimum - 1 ns*/ 1,
-             /* maximum - 30 s*/ 30'000'000'000LL,
-             /* significant figures */ 3,
-             /* pointer */ &histogram_);
-    Expects(histogram_ != nullptr);
-  }
+/* 30 seconds, larger latencies are recorded as this value */
+constexpr std::int64_t max_trackable_value_us{ 30'000'000LL };
 
-public:
-  logging_value_recorder(std::string name, std::map<std::string, std::string> tags)
-    : value_recorder()
-    , name_(std::move(name))
-    , tags_(std::move(tags))
-  {
-    initialize_histogram();
-  }
+auto
+make_histogram() -> hdr_histogram*
+{
+  // the recorders receive latencies in microseconds, and the report only needs two significant
+  // figures, which keeps every histogram at about 20KB instead of several hundred
+  hdr_histogram* histogram{ nullptr };
+  hdr_init(/* minimum - 1 us*/ 1,
+           /* maximum - 30 s*/ max_trackable_value_us,
+           /* significant figures */ 2,
+           /* pointer */ &histogram);
+  Expects(histogram != nullptr);
+  return histogram;
+}
 
-  logging_value_recorder(const logging_value_recorder& other)
-    : value_recorder()
-    , name_(other.name_)
-    , tags_(other.tags_)
+/**
+ * Pair of histograms, where writers record into the active one, and the reporter swaps them to
+ * read the values. The swap uses the writer/reader phaser scheme of HdrHistogram: writers only
+ * increment counters, and the reporter waits until all writers of the previous phase are gone.
+ */
+struct alignas(64) histogram_shard {
+  std::atomic<std::int64_t> start_epoch{ 0 };
+  std::atomic<std::int64_t> even_end_epoch{ 0 };
+  std::atomic<std::int64_t> odd_end_epoch{ std::numeric_limits<std::int64_t>::min() };
+  std::atomic<hdr_histogram*> active{ nullptr };
+  hdr_histogram* inactive{ nullptr };
+
+  histogram_shard() = default;
+  histogram_shard(const histogram_shard&) = delete;
+  histogram_shard(histogram_shard&&) = delete;
+  auto operator=(const histogram_shard&) -> histogram_shard& = delete;
+  auto operator=(histogram_shard&&) -> histogram_shard& = delete;
+
+  ~histogram_shard()
   {
-    initialize_histogram();
+    if (auto* histogram = active.load(); histogram != nullptr) {
+      hdr_close(histogram);
+    }
+    if (inactive != nullptr) {
+      hdr_close(inactive);
+    }
   }
 
-  logging_value_recorder(logging_value_recorder&& other) noexcept
-    : value_recorder()
-    , name_(std::move(other.name_))
-    , tags_(std::move(other.tags_))
+  void record_value(std::int64_t value)
   {
-    initialize_histogram();
+    auto epoch = start_epoch.fetch_add(1);
+    auto* histogram = active.load();
+    if (histogram == nullptr) {
+      // the histogram is allocated on the first use of the shard
+      auto* fresh = make_histogram();
+      if (active.compare_exchange_strong(histogram, fresh)) {
+        histogram = fresh;
+      } else {
+        hdr_close(fresh);
+      }
+    }
+    // hdr_histogram drops the values out of its range, but slow operations must still show up
+    // in the highest percentiles
+    hdr_record_value_atomic(histogram, std::clamp<std::int64_t>(value, 0, max_trackable_value_us));
+    if (epoch < 0) {
+      odd_end_epoch.fetch_add(1);
+    } else {
+      even_end_epoch.fetch_add(1);
+    }
   }
 
-  auto operator=(const logging_value_recorder& other) -> logging_value_recorder&
+  /**
+   * Must not be called concurrently with itself.
+   */
+  void drain_into(hdr_histogram* aggregate)
   {
-    if (this == &other) {
-      return *this;
+    auto* previous = active.load();
+    if (previous == nullptr) {
+      return;
     }
-    name_ = other.name_;
-    tags_ = other.tags_;
-    initialize_histogram();
-    return *this;
+    if (inactive == nullptr) {
+      inactive = make_histogram();
+    }
+    active.store(inactive);
+
+    bool next_phase_is_even = start_epoch.load() < 0;
+    std::int64_t initial_epoch = next_phase_is_even ? 0 : std::numeric_limits<std::int64_t>::min();
+    if (next_phase_is_even) {
+      even_end_epoch.store(initial_epoch);
+    } else {
+      odd_end_epoch.store(initial_epoch);
+    }
+    auto start_value_at_flip = start_epoch.exchange(initial_epoch);
+    auto& end_epoch = next_phase_is_even ? odd_end_epoch : even_end_epoch;
+    // writers leave the phase after a single increment, so yield first, and only sleep if one
+    // of them has been preempted in the middle of recording
+    for (std::size_t attempt = 0; end_epoch.load() != start_value_at_flip; ++attempt) {
+      if (attempt < 64) {
+        std::this_thread::yield();
+      } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+      }
+    }
+
+    hdr_add(aggregate, previous);
+    hdr_reset(previous);
+    inactive = previous;
   }
+};
+} // namespace
 
-  auto operator=(logging_value_recorder&& other) noexcept -> logging_value_recorder&
+/**
+ * Latency histogram, sharded between threads, so that recording a value does not contend on
+ * the same counters. The shards are merged when the report is emitted.
+ */
+class logging_value_recorder : public couchbase::metrics::value_recorder
+{
+private:
+  std::string name_;
+  std::map<std::string, std::string> tags_;
+  std::array<histogram_shard, number_of_thread_shards> shards_{};
+  hdr_histogram* aggregate_{ make_histogram() };
+
+public:
+  logging_value_recorder(std::string name, std::map<std::string, std::string> tags)
+    : value_recorder()
+    , name_(std::move(name))
+    , tags_(std::move(tags))
   {
-    if (this == &other) {
-      return *this;
-    }
-    name_ = std::move(other.name_);
-    tags_ = std::move(other.tags_);
-    initialize_histogram();
-    return *this;
   }
 
+  logging_value_recorder(const logging_value_recorder& other) = delete;
+  logging_value_recorder(logging_value_recorder&& other) = delete;
+  auto operator=(const logging_value_recorder& other) -> logging_value_recorder& = delete;
+  auto operator=(logging_value_recorder&& other) -> logging_value_recorder& = delete;
+
   ~logging_value_recorder() override
   {
-    if (histogram_ != nullptr) {
-      hdr_close(histogram_);
-      histogram_ = nullptr;
+    if (aggregate_ != nullptr) {
+      hdr_close(aggregate_);
+      aggregate_ = nullptr;
     }
   }
 
   void record_value(std::int64_t value) override
   {
-    if (histogram_ == nullptr) {
-      return;
-    }
-    hdr_record_value_atomic(histogram_, value);
+    shards_[thread_shard_index()].record_value(value);
   }
 
-  [[nodiscard]] auto emit() const -> tao::json::value
+  /**
+   * Must not be called concurrently with itself, the meter serializes reports.
+   */
+  [[nodiscard]] auto emit() -> tao::json::value
   {
-    auto total_count = histogram_->total_count;
-    auto val_50_0 = hdr_value_at_percentile(histogram_, 50.0);
-    auto val_90_0 = hdr_value_at_percentile(histogram_, 90.0);
-    auto val_99_0 = hdr_value_at_percentile(histogram_, 99.0);
-    auto val_99_9 = hdr_value_at_percentile(histogram_, 99.9);
-    auto val_100_0 = hdr_value_at_percentile(histogram_, 100.0);
+    for (auto& shard : shards_) {
+      shard.drain_into(aggregate_);
+    }
 
-    hdr_reset(histogram_);
+    auto total_count = aggregate_->total_count;
+    auto val_50_0 = hdr_value_at_percentile(aggregate_, 50.0);
+    auto val_90_0 = hdr_value_at_percentile(aggregate_, 90.0);
+    auto val_99_0 = hdr_value_at_percentile(aggregate_, 99.0);
+    auto val_99_9 = hdr_value_at_percentile(aggregate_, 99.9);
+    auto val_100_0 = hdr_value_at_percentile(aggregate_, 100.0);
+
+    hdr_reset(aggregate_);
 
     return {
       { "total_count", total_count },
@@ -153,11 +237,21 @@ logging_meter::log_report() const
       },
     },
   };
-  for (const auto& [service, operations] : recorders_) {
-    for (const auto& [operation, recorder] : operations) {
-      report["operations"][service][operation] = recorder->emit();
+  std::scoped_lock report_lock(report_mutex_);
+  std::vector<std::tuple<std::string, std::string, std::shared_ptr<logging_value_recorder>>>
+    recorders{};
+  {
+    // draining waits for the writers of the shards, so it must not block get_value_recorder()
+    std::scoped_lock lock(recorders_mutex_);
+    for (const auto& [service, operations] : recorders_) {
+      for (const auto& [operation, recorder] : operations) {
+        recorders.emplace_back(service, operation, recorder);
+      }
     }
   }
+  for (const auto& [service, operation, recorder] : recorders) {
+    report["operations"][service][operation] = recorder->emit();
+  }
   if (report.find("operations") != nullptr) {
     CB_LOG_INFO("Metrics: {}", utils::json::generate(report));
   }
@@ -36,7 +36,9 @@ class logging_meter
 private:
   asio::steady_timer emit_report_;
   logging_meter_options options_;
-  std::mutex recorders_mutex_{};
+  // serializes reports, so that the recorders are drained by one thread at a time
+  mutable std::mutex report_mutex_{};
+  mutable std::mutex recorders_mutex_{};
   // service name -> operation name -> recorder
   std::map<std::string, std::map<std::string, std::shared_ptr<logging_value_recorder>>>
     recorders_{};
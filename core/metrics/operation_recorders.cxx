@@ -0,0 +1,64 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "operation_recorders.hxx"
+
+#include "core/protocol/client_opcode_fmt.hxx"
+
+#include <fmt/core.h>
+
+#include <map>
+#include <string>
+
+namespace couchbase::core::metrics
+{
+operation_recorders::operation_recorders(std::shared_ptr<couchbase::metrics::meter> meter)
+  : meter_{ std::move(meter) }
+  , config_parse_recorder_{ meter_->get_value_recorder(
+      "db.couchbase.config_parse",
+      { { "db.couchbase.service", "kv" }, { "outcome", "parsed" } }) }
+  , config_skip_recorder_{ meter_->get_value_recorder(
+      "db.couchbase.config_parse",
+      { { "db.couchbase.service", "kv" }, { "outcome", "skipped" } }) }
+  , packets_per_write_recorder_{ meter_->get_value_recorder(
+      "db.couchbase.network.packets_per_write",
+      { { "db.couchbase.service", "kv" } }) }
+  , bytes_per_write_recorder_{ meter_->get_value_recorder(
+      "db.couchbase.network.bytes_per_write",
+      { { "db.couchbase.service", "kv" } }) }
+{
+}
+
+auto
+operation_recorders::resolve(protocol::client_opcode opcode) -> couchbase::metrics::value_recorder*
+{
+  static const std::string meter_name = "db.couchbase.operations";
+
+  std::scoped_lock lock(mutex_);
+  auto& slot = recorders_[static_cast<std::uint8_t>(opcode)];
+  if (auto* cached = slot.load(std::memory_order_acquire); cached != nullptr) {
+    return cached;
+  }
+  const std::map<std::string, std::string> tags = {
+    { "db.couchbase.service", "kv" },
+    { "db.operation", fmt::format("{}", opcode) },
+  };
+  auto& recorder = resolved_.emplace_back(meter_->get_value_recorder(meter_name, tags));
+  slot.store(recorder.get(), std::memory_order_release);
+  return recorder.get();
+}
+} // namespace couchbase::core::metrics
@@ -0,0 +1,100 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/protocol/client_opcode.hxx"
+
+#include <couchbase/metrics/meter.hxx>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace couchbase::core::metrics
+{
+/**
+ * Latency recorders of the KV operations, resolved in the meter once per opcode.
+ *
+ * Looking up the recorder of the operation that has been seen before is a single atomic load,
+ * the meter is only consulted (under the lock) for the first operation with the given opcode.
+ */
+class operation_recorders
+{
+public:
+  explicit operation_recorders(std::shared_ptr<couchbase::metrics::meter> meter);
+
+  [[nodiscard]] auto recorder(protocol::client_opcode opcode) -> couchbase::metrics::value_recorder*
+  {
+    auto* cached = recorders_[static_cast<std::uint8_t>(opcode)].load(std::memory_order_acquire);
+    if (cached != nullptr) {
+      return cached;
+    }
+    return resolve(opcode);
+  }
+
+  void record_latency(protocol::client_opcode opcode, std::chrono::steady_clock::time_point start)
+  {
+    recorder(opcode)->record_value(std::chrono::duration_cast<std::chrono::microseconds>(
+                                     std::chrono::steady_clock::now() - start)
+                                     .count());
+  }
+
+  /* time spent on parsing cluster maps, received with not_my_vbucket responses */
+  [[nodiscard]] auto config_parse_recorder() const
+    -> const std::shared_ptr<couchbase::metrics::value_recorder>&
+  {
+    return config_parse_recorder_;
+  }
+
+  /* time spent on cluster maps, which have been skipped because their revision is not newer */
+  [[nodiscard]] auto config_skip_recorder() const
+    -> const std::shared_ptr<couchbase::metrics::value_recorder>&
+  {
+    return config_skip_recorder_;
+  }
+
+  /* number of MCBP packets, gathered into one write to the KV socket */
+  [[nodiscard]] auto packets_per_write_recorder() const
+    -> const std::shared_ptr<couchbase::metrics::value_recorder>&
+  {
+    return packets_per_write_recorder_;
+  }
+
+  /* number of bytes, sent to the KV socket with one write */
+  [[nodiscard]] auto bytes_per_write_recorder() const
+    -> const std::shared_ptr<couchbase::metrics::value_recorder>&
+  {
+    return bytes_per_write_recorder_;
+  }
+
+private:
+  auto resolve(protocol::client_opcode opcode) -> couchbase::metrics::value_recorder*;
+
+  std::shared_ptr<couchbase::metrics::meter> meter_;
+  std::shared_ptr<couchbase::metrics::value_recorder> config_parse_recorder_;
+  std::shared_ptr<couchbase::metrics::value_recorder> config_skip_recorder_;
+  std::shared_ptr<couchbase::metrics::value_recorder> packets_per_write_recorder_;
+  std::shared_ptr<couchbase::metrics::value_recorder> bytes_per_write_recorder_;
+  std::array<std::atomic<couchbase::metrics::value_recorder*>, 256> recorders_{};
+  std::mutex mutex_{};
+  std::vector<std::shared_ptr<couchbase::metrics::value_recorder>> resolved_{};
+};
+} // namespace couchbase::core::metrics
@@ -0,0 +1,38 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace couchbase::core::metrics
+{
+constexpr std::size_t number_of_thread_shards{ 8 };
+
+/**
+ * Index of the shard used by the current thread. Threads are spread over the shards round-robin,
+ * so that recorders shared by all threads do not contend on the same counters.
+ */
+inline auto
+thread_shard_index() -> std::size_t
+{
+  static std::atomic_size_t next_index{ 0 };
+  static thread_local std::size_t index{ next_index++ % number_of_thread_shards };
+  return index;
+}
+} // namespace couchbase::core::metrics
@@ -26,12 +26,14 @@
 #include "core/operations/document_get_and_lock.hxx"
 #include "core/operations/document_get_and_touch.hxx"
 #include "core/operations/document_get_any_replica.hxx"
+#include "core/operations/document_get_hedged.hxx"
 #include "core/operations/document_get_projected.hxx"
 #include "core/operations/document_increment.hxx"
 #include "core/operations/document_insert.hxx"
 #include "core/operations/document_lookup_in.hxx"
 #include "core/operations/document_lookup_in_all_replicas.hxx"
 #include "core/operations/document_lookup_in_any_replica.hxx"
+#include "core/operations/document_lookup_in_hedged.hxx"
 #include "core/operations/document_mutate_in.hxx"
 #include "core/operations/document_prepend.hxx"
 #include "core/operations/document_query.hxx"
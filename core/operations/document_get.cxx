@@ -33,13 +33,22 @@ get_request::encode_to(get_request::encoded_request_type& encoded,
 
 auto
 get_request::make_response(key_value_error_context&& ctx,
-                           const encoded_response_type& encoded) const -> get_response
+                           encoded_response_type&& encoded) const -> get_response
 {
   get_response response{ std::move(ctx) };
   if (!response.ctx.ec()) {
-    response.value = encoded.body().value();
     response.cas = encoded.cas();
     response.flags = encoded.body().flags();
+    const auto offset = static_cast<std::ptrdiff_t>(encoded.body().value_offset());
+    auto data = encoded.release_data();
+    if (share_buffer) {
+      response.value_offset = static_cast<std::size_t>(offset);
+      response.buffer = std::make_shared<const std::vector<std::byte>>(std::move(data));
+    } else {
+      // reuse the allocation of the body, and only shift the value over the extras and the key
+      data.erase(data.begin(), data.begin() + offset);
+      response.value = std::move(data);
+    }
   }
   return response;
 }
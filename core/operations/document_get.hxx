@@ -34,6 +34,10 @@ struct get_response {
   std::vector<std::byte> value{};
   couchbase::cas cas{};
   std::uint32_t flags{};
+  /* when get_request::share_buffer is set, the value is left empty, and the document occupies
+   * the tail of this buffer starting at value_offset */
+  std::shared_ptr<const std::vector<std::byte>> buffer{};
+  std::size_t value_offset{};
 };
 
 struct get_request {
@@ -47,12 +51,13 @@ struct get_request {
   std::optional<std::chrono::milliseconds> timeout{};
   io::retry_context<true> retries{};
   std::shared_ptr<couchbase::tracing::request_span> parent_span{ nullptr };
+  bool share_buffer{ false };
 
   [[nodiscard]] auto encode_to(encoded_request_type& encoded,
                                mcbp_context&& context) const -> std::error_code;
 
   [[nodiscard]] auto make_response(key_value_error_context&& ctx,
-                                   const encoded_response_type& encoded) const -> get_response;
+                                   encoded_response_type&& encoded) const -> get_response;
 };
 } // namespace couchbase::core::operations
 
@@ -0,0 +1,100 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include "core/error_context/key_value.hxx"
+#include "core/impl/get_replica.hxx"
+#include "core/impl/hedged_read.hxx"
+#include "core/impl/replica_utils.hxx"
+#include "core/operations/document_get.hxx"
+#include "core/operations/document_get_any_replica.hxx"
+#include "core/operations/operation_traits.hxx"
+#include "couchbase/read_preference.hxx"
+#include "couchbase/retry_strategy.hxx"
+
+#include <memory>
+
+namespace couchbase::core::operations
+{
+/**
+ * Reads the document from the active node, and if the node does not respond within its usual
+ * latency (see bucket::hedged_read_delay), also from one replica, taking the first successful
+ * response. The response reports in the replica field which of the copies has been returned.
+ */
+struct get_hedged_request {
+  using response_type = get_any_replica_response;
+
+  core::document_id id;
+  std::optional<std::chrono::milliseconds> timeout{};
+  std::shared_ptr<couchbase::retry_strategy> retry_strategy{ nullptr };
+  couchbase::read_preference read_preference{ couchbase::read_preference::no_preference };
+
+  template<typename Core, typename Handler>
+  void execute(Core core, Handler handler)
+  {
+    core->with_bucket_configuration(
+      id.bucket(),
+      [core,
+       id = id,
+       timeout = timeout,
+       retry_strategy = retry_strategy,
+       read_preference = read_preference,
+       h = std::forward<Handler>(handler)](std::error_code ec,
+                                           const topology::configuration& config) mutable {
+        if (ec) {
+          return h(response_type{ make_key_value_error_context(ec, id) });
+        }
+        std::optional<document_id> replica_id{};
+        if (const auto [e, origin] = core->origin(); !e) {
+          replica_id =
+            impl::hedge_replica(id, config, read_preference, origin.options().server_group);
+        }
+
+        auto ctx = std::make_shared<impl::hedged_read_context<response_type>>(core->io_context(),
+                                                                              std::move(h));
+        core->execute(
+          get_request{ id, {}, {}, timeout, { retry_strategy } }, [ctx](auto&& resp) {
+            ctx->on_active_response(response_type{
+              std::move(resp.ctx), std::move(resp.value), resp.cas, resp.flags, false });
+          });
+        if (!replica_id) {
+          return;
+        }
+        ctx->arm(core->hedged_read_delay(id),
+                 [core, ctx, timeout, replica_id = std::move(replica_id.value())]() mutable {
+                   if (!core->acquire_hedge(replica_id.bucket())) {
+                     return;
+                   }
+                   core->execute(impl::get_replica_request{ std::move(replica_id), timeout },
+                                 [ctx](auto&& resp) {
+                                   ctx->on_replica_response(response_type{ std::move(resp.ctx),
+                                                                           std::move(resp.value),
+                                                                           resp.cas,
+                                                                           resp.flags,
+                                                                           true });
+                                 });
+                 });
+      });
+  }
+};
+
+template<>
+struct is_compound_operation<get_hedged_request> : public std::true_type {
+};
+} // namespace couchbase::core::operations
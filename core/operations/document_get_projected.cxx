@@ -18,11 +18,14 @@
 #include "document_get_projected.hxx"
 
 #include "core/impl/subdoc/command_bundle.hxx"
+#include "core/impl/subdoc/splice_projections.hxx"
 #include "core/utils/json.hxx"
 
 #include <couchbase/error_codes.hxx>
 #include <couchbase/lookup_in_specs.hxx>
 
+#include <algorithm>
+
 namespace couchbase::core::operations
 {
 
@@ -140,6 +143,74 @@ subdoc_apply_projection(tao::json::value& root,
   }
 }
 
+auto
+merge_projected_fragments(const std::vector<std::string>& projections,
+                          const std::vector<std::optional<std::string_view>>& fragments,
+                          bool preserve_array_indexes)
+  -> std::pair<std::error_code, std::vector<std::byte>>
+{
+  if (auto document =
+        impl::subdoc::splice_projections(projections, fragments, preserve_array_indexes);
+      document) {
+    return { {}, std::move(document.value()) };
+  }
+
+  tao::json::value new_doc = tao::json::empty_object;
+  for (std::size_t i = 0; i < projections.size() && i < fragments.size(); ++i) {
+    if (!fragments[i]) {
+      continue;
+    }
+    tao::json::value value_to_apply{};
+    try {
+      value_to_apply = utils::json::parse(fragments[i].value());
+    } catch (const tao::pegtl::parse_error&) {
+      return { errc::common::parsing_failure, {} };
+    }
+    subdoc_apply_projection(new_doc, projections[i], value_to_apply, preserve_array_indexes);
+  }
+  return { {}, utils::json::generate_binary(new_doc) };
+}
+
+auto
+get_projected_request::needs_split() const -> bool
+{
+  if (projections.empty()) {
+    return false;
+  }
+  // one spec is always used for the flags
+  return projections.size() + 1 + (with_expiry ? 1 : 0) > max_lookup_specs;
+}
+
+auto
+get_projected_request::split() const -> std::vector<get_projected_request>
+{
+  std::vector<get_projected_request> chunks{};
+  std::size_t offset = 0;
+  while (offset < projections.size()) {
+    const bool first = chunks.empty();
+    const std::size_t capacity = max_lookup_specs - 1 - (first && with_expiry ? 1 : 0);
+    const auto end = std::min(projections.size(), offset + capacity);
+
+    std::vector<std::string> paths(projections.begin() + static_cast<std::ptrdiff_t>(offset),
+                                   projections.begin() + static_cast<std::ptrdiff_t>(end));
+    chunks.push_back({
+      id,
+      {},
+      {},
+      std::move(paths),
+      first && with_expiry,
+      {},
+      preserve_array_indexes,
+      timeout,
+      { retries.strategy() },
+      parent_span,
+      true,
+    });
+    offset = end;
+  }
+  return chunks;
+}
+
 auto
 get_projected_request::encode_to(get_projected_request::encoded_request_type& encoded,
                                  mcbp_context&& /* context */) -> std::error_code
@@ -218,28 +289,33 @@ get_projected_request::make_response(key_value_error_context&& ctx,
         response.value = utils::json::generate_binary(new_doc);
       }
     } else {
-      tao::json::value new_doc = tao::json::empty_object;
+      std::vector<std::optional<std::string_view>> fragments{};
+      fragments.reserve(projections.size());
       std::size_t offset = with_expiry ? 2 : 1;
-      for (const auto& projection : projections) {
+      for (std::size_t i = 0; i < projections.size(); ++i) {
         const auto& field = encoded.body().fields()[offset];
         ++offset;
         if (field.status == key_value_status_code::success && !field.value.empty()) {
-          tao::json::value value_to_apply{};
-          try {
-            value_to_apply = utils::json::parse(field.value);
-          } catch (const tao::pegtl::parse_error&) {
-            response.ctx.override_ec(errc::common::parsing_failure);
-            return response;
-          }
-          subdoc_apply_projection(new_doc, projection, value_to_apply, preserve_array_indexes);
-        } else if (field.status != key_value_status_code::subdoc_path_not_found) {
+          fragments.emplace_back(field.value);
+        } else if (field.status == key_value_status_code::subdoc_path_not_found) {
+          fragments.emplace_back();
+        } else {
           response.ctx.override_ec(
             protocol::map_status_code(protocol::client_opcode::subdoc_multi_lookup,
                                       static_cast<std::uint16_t>(field.status)));
           return response;
         }
       }
-      response.value = utils::json::generate_binary(new_doc);
+      if (raw_fragments) {
+        response.fragments.assign(fragments.begin(), fragments.end());
+        return response;
+      }
+      auto [ec, value] = merge_projected_fragments(projections, fragments, preserve_array_indexes);
+      if (ec) {
+        response.ctx.override_ec(ec);
+        return response;
+      }
+      response.value = std::move(value);
     }
   }
   return response;
@@ -18,6 +18,8 @@
 #pragma once
 
 #include "core/error_context/key_value.hxx"
+#include "core/operations/operation_traits.hxx"
+#include "core/utils/movable_function.hxx"
 #include "core/io/mcbp_context.hxx"
 #include "core/io/mcbp_traits.hxx"
 #include "core/io/retry_context.hxx"
@@ -26,6 +28,11 @@
 #include "core/public_fwd.hxx"
 #include "core/timeout_defaults.hxx"
 
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+
 namespace couchbase::core::operations
 {
 
@@ -35,8 +42,22 @@ struct get_projected_response {
   couchbase::cas cas{};
   std::uint32_t flags{};
   std::optional<std::uint32_t> expiry{};
+  /* when get_projected_request::raw_fragments is set, the value is left empty, and the fragments
+   * returned for the projections are stored here in the same order */
+  std::vector<std::optional<std::string>> fragments{};
 };
 
+/**
+ * Combines the fragments returned for the projected paths into a single JSON document. The
+ * fragments are spliced into the output as they are, and only when the paths overlap, they are
+ * parsed and merged as DOM.
+ */
+auto
+merge_projected_fragments(const std::vector<std::string>& projections,
+                          const std::vector<std::optional<std::string_view>>& fragments,
+                          bool preserve_array_indexes)
+  -> std::pair<std::error_code, std::vector<std::byte>>;
+
 struct get_projected_request {
   using response_type = get_projected_response;
   using encoded_request_type = protocol::client_request<protocol::lookup_in_request_body>;
@@ -52,6 +73,23 @@ struct get_projected_request {
   std::optional<std::chrono::milliseconds> timeout{};
   io::retry_context<true> retries{};
   std::shared_ptr<couchbase::tracing::request_span> parent_span{ nullptr };
+  bool raw_fragments{ false };
+
+  /* the server does not accept more specs in a single lookup */
+  static constexpr std::size_t max_lookup_specs{ 16 };
+
+  /**
+   * Whether the projections (together with the flags and expiry) exceed the number of specs of a
+   * single lookup. Such request is split by get_projected_split_request into several lookups,
+   * instead of fetching the whole document.
+   */
+  [[nodiscard]] auto needs_split() const -> bool;
+
+  /**
+   * Slices the projections into requests, that fit into a single lookup each. The first one also
+   * fetches the expiry, and all of them return raw fragments.
+   */
+  [[nodiscard]] auto split() const -> std::vector<get_projected_request>;
 
   [[nodiscard]] auto encode_to(encoded_request_type& encoded,
                                mcbp_context&& context) -> std::error_code;
@@ -61,6 +99,88 @@ struct get_projected_request {
     -> get_projected_response;
 };
 
+/**
+ * Sends the lookups of get_projected_request::split() at once, and splices their fragments into
+ * the projected document. If the document has been modified between the lookups, so that they
+ * return different CAS values, the original request is sent instead, and the projection is taken
+ * from the full document.
+ */
+struct get_projected_split_request {
+  using response_type = get_projected_response;
+
+  get_projected_request request;
+
+  template<typename Core, typename Handler>
+  void execute(Core core, Handler handler)
+  {
+    using handler_type = utils::movable_function<void(response_type)>;
+
+    struct split_context {
+      split_context(get_projected_request&& request, handler_type&& handler, std::size_t chunks)
+        : request_(std::move(request))
+        , handler_(std::move(handler))
+        , responses_(chunks)
+        , remaining_(chunks)
+      {
+      }
+
+      get_projected_request request_;
+      handler_type handler_;
+      std::vector<response_type> responses_;
+      std::size_t remaining_;
+      std::mutex mutex_{};
+    };
+
+    auto chunks = request.split();
+    auto ctx = std::make_shared<split_context>(
+      std::move(request), std::forward<Handler>(handler), chunks.size());
+    for (std::size_t index = 0; index < chunks.size(); ++index) {
+      core->execute(std::move(chunks[index]), [core, ctx, index](auto&& resp) mutable {
+        {
+          std::scoped_lock lock(ctx->mutex_);
+          ctx->responses_[index] = std::move(resp);
+          if (--ctx->remaining_ > 0) {
+            return;
+          }
+        }
+
+        auto& responses = ctx->responses_;
+        for (auto& response : responses) {
+          if (response.ctx.ec()) {
+            return ctx->handler_(std::move(response));
+          }
+        }
+        for (const auto& response : responses) {
+          if (response.cas != responses.front().cas) {
+            return core->execute(std::move(ctx->request_), std::move(ctx->handler_));
+          }
+        }
+
+        std::vector<std::optional<std::string_view>> fragments{};
+        fragments.reserve(ctx->request_.projections.size());
+        for (const auto& response : responses) {
+          for (const auto& fragment : response.fragments) {
+            fragments.emplace_back(fragment);
+          }
+        }
+        auto [ec, value] = merge_projected_fragments(
+          ctx->request_.projections, fragments, ctx->request_.preserve_array_indexes);
+
+        auto result = std::move(responses.front());
+        result.fragments.clear();
+        result.value = std::move(value);
+        if (ec) {
+          result.ctx.override_ec(ec);
+        }
+        return ctx->handler_(std::move(result));
+      });
+    }
+  }
+};
+
+template<>
+struct is_compound_operation<get_projected_split_request> : public std::true_type {
+};
 } // namespace couchbase::core::operations
 
 namespace couchbase::core::io::mcbp_traits
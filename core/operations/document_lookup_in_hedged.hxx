@@ -0,0 +1,129 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include "core/error_context/key_value.hxx"
+#include "core/impl/hedged_read.hxx"
+#include "core/impl/lookup_in_replica.hxx"
+#include "core/impl/replica_utils.hxx"
+#include "core/impl/subdoc/command.hxx"
+#include "core/operations/document_lookup_in.hxx"
+#include "core/operations/document_lookup_in_any_replica.hxx"
+#include "core/operations/operation_traits.hxx"
+#include "couchbase/read_preference.hxx"
+#include "couchbase/retry_strategy.hxx"
+
+#include <memory>
+
+namespace couchbase::core::operations
+{
+/**
+ * Subdocument counterpart of get_hedged_request. The replica is only asked when the cluster
+ * supports subdocument reads from replicas.
+ */
+struct lookup_in_hedged_request {
+  using response_type = lookup_in_any_replica_response;
+
+  core::document_id id;
+  std::vector<couchbase::core::impl::subdoc::command> specs{};
+  std::optional<std::chrono::milliseconds> timeout{};
+  std::shared_ptr<couchbase::retry_strategy> retry_strategy{ nullptr };
+  std::shared_ptr<couchbase::tracing::request_span> parent_span{ nullptr };
+  couchbase::read_preference read_preference{ couchbase::read_preference::no_preference };
+
+  template<typename Response>
+  static auto make_response(Response&& resp, bool is_replica) -> response_type
+  {
+    response_type res{};
+    res.ctx = std::move(resp.ctx);
+    res.cas = resp.cas;
+    res.deleted = resp.deleted;
+    res.is_replica = is_replica;
+    res.fields.reserve(resp.fields.size());
+    for (auto& field : resp.fields) {
+      auto lookup_in_entry = response_type::entry{};
+      lookup_in_entry.path = std::move(field.path);
+      lookup_in_entry.value = std::move(field.value);
+      lookup_in_entry.status = field.status;
+      lookup_in_entry.ec = field.ec;
+      lookup_in_entry.exists = field.exists;
+      lookup_in_entry.original_index = field.original_index;
+      lookup_in_entry.opcode = field.opcode;
+      res.fields.emplace_back(std::move(lookup_in_entry));
+    }
+    return res;
+  }
+
+  template<typename Core, typename Handler>
+  void execute(Core core, Handler handler)
+  {
+    core->with_bucket_configuration(
+      id.bucket(),
+      [core,
+       id = id,
+       specs = specs,
+       timeout = timeout,
+       retry_strategy = retry_strategy,
+       parent_span = parent_span,
+       read_preference = read_preference,
+       h = std::forward<Handler>(handler)](std::error_code ec,
+                                           const topology::configuration& config) mutable {
+        if (ec) {
+          return h(response_type{ make_subdocument_error_context(
+            make_key_value_error_context(ec, id), ec, {}, {}, false) });
+        }
+        std::optional<document_id> replica_id{};
+        if (const auto [e, origin] = core->origin();
+            !e && config.capabilities.supports_subdoc_read_replica()) {
+          replica_id =
+            impl::hedge_replica(id, config, read_preference, origin.options().server_group);
+        }
+
+        auto ctx = std::make_shared<impl::hedged_read_context<response_type>>(core->io_context(),
+                                                                              std::move(h));
+        core->execute(
+          lookup_in_request{ id, {}, {}, false, specs, timeout, { retry_strategy }, parent_span },
+          [ctx](auto&& resp) {
+            ctx->on_active_response(make_response(std::move(resp), false));
+          });
+        if (!replica_id) {
+          return;
+        }
+        ctx->arm(
+          core->hedged_read_delay(id),
+          [core, ctx, specs, timeout, parent_span, replica_id = std::move(replica_id.value())]()
+            mutable {
+              if (!core->acquire_hedge(replica_id.bucket())) {
+                return;
+              }
+              core->execute(
+                impl::lookup_in_replica_request{
+                  std::move(replica_id), std::move(specs), timeout, parent_span },
+                [ctx](auto&& resp) {
+                  ctx->on_replica_response(make_response(std::move(resp), true));
+                });
+            });
+      });
+  }
+};
+
+template<>
+struct is_compound_operation<lookup_in_hedged_request> : public std::true_type {
+};
+} // namespace couchbase::core::operations
@@ -58,6 +58,7 @@ struct get_and_touch_request;
 struct get_and_touch_response;
 struct get_any_replica_request;
 struct get_any_replica_response;
+struct get_hedged_request;
 struct get_projected_request;
 struct get_projected_response;
 struct increment_request;
@@ -70,6 +71,7 @@ struct lookup_in_any_replica_request;
 struct lookup_in_any_replica_response;
 struct lookup_in_all_replicas_request;
 struct lookup_in_all_replicas_response;
+struct lookup_in_hedged_request;
 struct mutate_in_request;
 struct mutate_in_response;
 struct prepend_request;
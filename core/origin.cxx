@@ -37,6 +37,15 @@ struct traits<std::chrono::milliseconds> {
   }
 };
 
+template<>
+struct traits<std::chrono::microseconds> {
+  template<template<typename...> class Traits>
+  static void assign(tao::json::basic_value<Traits>& v, const std::chrono::microseconds& o)
+  {
+    v = fmt::format("{}", o);
+  }
+};
+
 template<>
 struct traits<std::chrono::nanoseconds> {
   template<template<typename...> class Traits>
@@ -222,6 +231,7 @@ origin::to_json() const -> std::string
         { "bootstrap_timeout", options_.bootstrap_timeout },
         { "resolve_timeout", options_.resolve_timeout },
         { "connect_timeout", options_.connect_timeout },
+        { "connection_attempt_delay", options_.connection_attempt_delay },
         { "key_value_timeout", options_.key_value_timeout },
         { "key_value_durable_timeout", options_.key_value_durable_timeout },
         { "view_timeout", options_.view_timeout },
@@ -246,6 +256,13 @@ origin::to_json() const -> std::string
         { "config_poll_interval", options_.config_poll_interval },
         { "config_poll_floor", options_.config_poll_floor },
         { "config_idle_redial_timeout", options_.config_idle_redial_timeout },
+        { "write_coalescing_window", options_.write_coalescing_window },
+        { "write_coalescing_threshold", options_.write_coalescing_threshold },
+        { "max_hedged_read_ratio", options_.max_hedged_read_ratio },
+        { "enable_kv_concurrency_limit", options_.enable_kv_concurrency_limit },
+        { "kv_initial_concurrency_limit", options_.kv_initial_concurrency_limit },
+        { "kv_max_concurrency_limit", options_.kv_max_concurrency_limit },
+        { "kv_max_queued_requests", options_.kv_max_queued_requests },
         { "max_http_connections", options_.max_http_connections },
         { "idle_http_connection_timeout", options_.idle_http_connection_timeout },
         { "user_agent_extra", options_.user_agent_extra },
@@ -120,6 +120,14 @@ public:
     return header_;
   }
 
+  /**
+   * Hands over the body buffer, for the response bodies that refer to it instead of copying.
+   */
+  [[nodiscard]] auto release_data() -> std::vector<std::byte>
+  {
+    return std::move(data_);
+  }
+
   void verify_header()
   {
     Expects(header_[0] == static_cast<std::byte>(magic::alt_client_response) ||
@@ -20,6 +20,7 @@
 #include "core/utils/byteswap.hxx"
 #include "core/utils/unsigned_leb128.hxx"
 
+#include <algorithm>
 #include <cstring>
 #include <gsl/assert>
 
@@ -45,7 +46,7 @@ get_response_body::parse(key_value_status_code status,
       offset += extras_size;
     }
     offset += key_size;
-    value_.assign(body.begin() + offset, body.end());
+    value_offset_ = std::min(static_cast<std::size_t>(offset), body.size());
     return true;
   }
   return false;
@@ -33,12 +33,16 @@ public:
 
 private:
   std::uint32_t flags_{};
-  std::vector<std::byte> value_;
+  std::size_t value_offset_{};
 
 public:
-  [[nodiscard]] auto value() const -> const auto&
+  /**
+   * The value is not copied out of the response, it occupies the tail of the body starting at
+   * this offset.
+   */
+  [[nodiscard]] auto value_offset() const -> std::size_t
   {
-    return value_;
+    return value_offset_;
   }
 
   [[nodiscard]] auto flags() const -> std::uint32_t
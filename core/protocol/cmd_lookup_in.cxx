@@ -86,17 +86,18 @@ lookup_in_request_body::fill_extras()
 }
 
 void
-lookup_in_request_body::fill_value()
+lookup_in_request_body::specs(
+  const std::vector<couchbase::core::impl::subdoc::command>& specs)
 {
   size_t value_size = 0;
-  for (const auto& spec : specs_) {
+  for (const auto& spec : specs) {
     value_size +=
       sizeof(spec.opcode_) + sizeof(std::uint8_t) + sizeof(std::uint16_t) + spec.path_.size();
   }
   Expects(value_size > 0);
   value_.resize(value_size);
   std::vector<std::byte>::size_type offset = 0;
-  for (const auto& spec : specs_) {
+  for (const auto& spec : specs) {
     value_[offset] = static_cast<std::byte>(spec.opcode_);
     ++offset;
     value_[offset] = spec.flags_;
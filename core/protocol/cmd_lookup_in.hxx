@@ -74,7 +74,6 @@ private:
   std::vector<std::byte> value_{};
 
   std::uint8_t flags_{ 0 };
-  std::vector<couchbase::core::impl::subdoc::command> specs_;
 
 public:
   void id(const document_id& id);
@@ -88,10 +87,7 @@ public:
     }
   }
 
-  void specs(const std::vector<couchbase::core::impl::subdoc::command>& specs)
-  {
-    specs_ = specs;
-  }
+  void specs(const std::vector<couchbase::core::impl::subdoc::command>& specs);
 
   [[nodiscard]] auto key() const -> const auto&
   {
@@ -111,11 +107,8 @@ public:
     return extras_;
   }
 
-  [[nodiscard]] auto value() -> const auto&
+  [[nodiscard]] auto value() const -> const auto&
   {
-    if (value_.empty()) {
-      fill_value();
-    }
     return value_;
   }
 
@@ -124,16 +117,11 @@ public:
     if (extras_.empty()) {
       fill_extras();
     }
-    if (value_.empty()) {
-      fill_value();
-    }
     return key_.size() + extras_.size() + value_.size();
   }
 
 private:
   void fill_extras();
-
-  void fill_value();
 };
 
 } // namespace couchbase::core::protocol
@@ -117,7 +117,6 @@ private:
   std::optional<std::uint32_t> user_flags_{};
   std::uint32_t expiry_{ 0 };
   std::byte flags_{ 0 };
-  std::vector<couchbase::core::impl::subdoc::command> specs_;
   std::vector<std::byte> framing_extras_{};
 
 public:
@@ -169,10 +168,11 @@ public:
     }
   }
 
-  void specs(std::vector<couchbase::core::impl::subdoc::command> specs)
-  {
-    specs_ = std::move(specs);
-  }
+  /**
+   * Encodes the specs straight into the value of the request. The buffer is owned by the
+   * encoded request, so that re-encoding on retry reuses its capacity.
+   */
+  void specs(const std::vector<couchbase::core::impl::subdoc::command>& specs);
 
   void durability(durability_level level, std::optional<std::uint16_t> timeout);
 
@@ -196,11 +196,8 @@ public:
     return extras_;
   }
 
-  [[nodiscard]] auto value() -> const auto&
+  [[nodiscard]] auto value() const -> const auto&
   {
-    if (value_.empty()) {
-      fill_value();
-    }
     return value_;
   }
 
@@ -209,16 +206,11 @@ public:
     if (extras_.empty()) {
       fill_extras();
     }
-    if (value_.empty()) {
-      fill_value();
-    }
     return framing_extras_.size() + extras_.size() + key_.size() + value_.size();
   }
 
 private:
   void fill_extras();
-
-  void fill_value();
 };
 
 } // namespace couchbase::core::protocol
@@ -25,6 +25,8 @@ constexpr std::chrono::milliseconds bootstrap_timeout{ 10'000 };
 
 constexpr std::chrono::milliseconds resolve_timeout{ 2'000 };
 constexpr std::chrono::milliseconds connect_timeout{ 2'000 };
+/* RFC 8305 recommends 250ms as the default "Connection Attempt Delay" */
+constexpr std::chrono::milliseconds connection_attempt_delay{ 250 };
 constexpr std::chrono::milliseconds key_value_timeout{ 2'500 };
 constexpr std::chrono::milliseconds key_value_durable_timeout{ 10'000 };
 constexpr std::chrono::milliseconds key_value_scan_timeout{ 75'000 };
@@ -41,4 +43,8 @@ constexpr std::chrono::milliseconds config_poll_interval{ 2'500 };
 constexpr std::chrono::milliseconds config_poll_floor{ 50 };
 constexpr std::chrono::milliseconds config_idle_redial_timeout{ 5 * 60'000 };
 constexpr std::chrono::milliseconds idle_http_connection_timeout{ 1'000 };
+/* zero disables coalescing of KV writes, every request is flushed right away */
+constexpr std::chrono::microseconds write_coalescing_window{ 0 };
+/* used for hedged reads until the active node has served enough requests to measure it */
+constexpr std::chrono::milliseconds hedged_read_delay{ 10 };
 } // namespace couchbase::core::timeout_defaults
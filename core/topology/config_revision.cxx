@@ -0,0 +1,186 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "config_revision.hxx"
+
+#include <charconv>
+#include <cstddef>
+
+namespace couchbase::core::topology
+{
+namespace
+{
+class revision_scanner
+{
+public:
+  explicit revision_scanner(std::string_view input)
+    : input_{ input }
+  {
+  }
+
+  auto scan() -> std::optional<config_revision>
+  {
+    skip_whitespace();
+    if (!consume('{')) {
+      return {};
+    }
+    config_revision revision{};
+    skip_whitespace();
+    if (consume('}')) {
+      return {};
+    }
+    while (true) {
+      skip_whitespace();
+      std::string_view key{};
+      if (!read_string(key)) {
+        return {};
+      }
+      skip_whitespace();
+      if (!consume(':')) {
+        return {};
+      }
+      skip_whitespace();
+      if (key == "rev") {
+        if (!read_integer(revision.rev)) {
+          return {};
+        }
+      } else if (key == "revEpoch") {
+        if (!read_integer(revision.epoch)) {
+          return {};
+        }
+      } else if (!skip_value()) {
+        return {};
+      }
+      skip_whitespace();
+      if (consume('}')) {
+        break;
+      }
+      if (!consume(',')) {
+        return {};
+      }
+    }
+    if (!revision.rev) {
+      return {};
+    }
+    return revision;
+  }
+
+private:
+  [[nodiscard]] auto at_end() const -> bool
+  {
+    return position_ >= input_.size();
+  }
+
+  [[nodiscard]] auto peek() const -> char
+  {
+    return input_[position_];
+  }
+
+  auto consume(char expected) -> bool
+  {
+    if (!at_end() && peek() == expected) {
+      ++position_;
+      return true;
+    }
+    return false;
+  }
+
+  void skip_whitespace()
+  {
+    while (!at_end() &&
+           (peek() == ' ' || peek() == '\t' || peek() == '\n' || peek() == '\r')) {
+      ++position_;
+    }
+  }
+
+  /* the key is returned as is, escape sequences are not decoded */
+  auto read_string(std::string_view& result) -> bool
+  {
+    if (!consume('"')) {
+      return false;
+    }
+    auto start = position_;
+    while (!at_end()) {
+      auto c = peek();
+      if (c == '\\') {
+        position_ += 2;
+        continue;
+      }
+      if (c == '"') {
+        result = input_.substr(start, position_ - start);
+        ++position_;
+        return true;
+      }
+      ++position_;
+    }
+    return false;
+  }
+
+  auto read_integer(std::optional<std::int64_t>& result) -> bool
+  {
+    std::int64_t value{};
+    const auto* begin = input_.data() + position_;
+    const auto* end = input_.data() + input_.size();
+    auto [ptr, ec] = std::from_chars(begin, end, value);
+    if (ec != std::errc{}) {
+      return false;
+    }
+    position_ += static_cast<std::size_t>(ptr - begin);
+    result = value;
+    return true;
+  }
+
+  auto skip_value() -> bool
+  {
+    std::size_t depth = 0;
+    while (!at_end()) {
+      auto c = peek();
+      if (c == '"') {
+        std::string_view ignored{};
+        if (!read_string(ignored)) {
+          return false;
+        }
+      } else if (c == '{' || c == '[') {
+        ++depth;
+        ++position_;
+      } else if (c == '}' || c == ']') {
+        if (depth == 0) {
+          return true;
+        }
+        --depth;
+        ++position_;
+      } else if (c == ',' && depth == 0) {
+        return true;
+      } else {
+        ++position_;
+      }
+    }
+    return false;
+  }
+
+  std::string_view input_;
+  std::size_t position_{ 0 };
+};
+} // namespace
+
+auto
+scan_config_revision(std::string_view input) -> std::optional<config_revision>
+{
+  return revision_scanner(input).scan();
+}
+} // namespace couchbase::core::topology
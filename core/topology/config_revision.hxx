@@ -0,0 +1,60 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace couchbase::core::topology
+{
+/**
+ * Revision of the cluster map, ordered in the same way as configuration revisions.
+ */
+struct config_revision {
+  std::optional<std::int64_t> epoch{};
+  std::optional<std::int64_t> rev{};
+
+  auto operator==(const config_revision& other) const -> bool
+  {
+    return epoch == other.epoch && rev == other.rev;
+  }
+
+  auto operator!=(const config_revision& other) const -> bool
+  {
+    return !(*this == other);
+  }
+
+  auto operator<(const config_revision& other) const -> bool
+  {
+    return epoch < other.epoch || (epoch == other.epoch && rev < other.rev);
+  }
+};
+
+/**
+ * Extracts "rev" and "revEpoch" from the top level object of the cluster map JSON without
+ * building the document.
+ *
+ * Nested values are skipped byte by byte, so the scan does not allocate. Returns empty optional
+ * if the input is not an object or does not have "rev" field, in which case the caller should
+ * fall back to the full parse.
+ */
+auto
+scan_config_revision(std::string_view input) -> std::optional<config_revision>;
+} // namespace couchbase::core::topology
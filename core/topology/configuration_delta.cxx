@@ -0,0 +1,139 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "configuration_delta.hxx"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <tuple>
+
+namespace couchbase::core::topology
+{
+namespace
+{
+using node_key =
+  std::tuple<std::string, std::optional<std::uint16_t>, std::optional<std::uint16_t>>;
+
+auto
+key_of(const configuration::node& node) -> node_key
+{
+  return { node.hostname, node.services_plain.key_value, node.services_tls.key_value };
+}
+
+auto
+same_ports(const configuration::port_map& lhs, const configuration::port_map& rhs) -> bool
+{
+  return lhs.key_value == rhs.key_value && lhs.management == rhs.management &&
+         lhs.analytics == rhs.analytics && lhs.search == rhs.search && lhs.views == rhs.views &&
+         lhs.query == rhs.query && lhs.eventing == rhs.eventing;
+}
+
+auto
+same_services(const configuration::node& lhs, const configuration::node& rhs) -> bool
+{
+  if (!same_ports(lhs.services_plain, rhs.services_plain) ||
+      !same_ports(lhs.services_tls, rhs.services_tls) || lhs.alt.size() != rhs.alt.size() ||
+      lhs.server_group != rhs.server_group) {
+    return false;
+  }
+  return std::equal(lhs.alt.begin(),
+                    lhs.alt.end(),
+                    rhs.alt.begin(),
+                    [](const auto& left, const auto& right) {
+                      return left.first == right.first &&
+                             left.second.hostname == right.second.hostname &&
+                             same_ports(left.second.services_plain, right.second.services_plain) &&
+                             same_ports(left.second.services_tls, right.second.services_tls);
+                    });
+}
+
+void
+diff_nodes(const std::vector<configuration::node>& previous,
+           const std::vector<configuration::node>& next,
+           configuration_delta& delta)
+{
+  std::map<node_key, const configuration::node*> previous_nodes{};
+  for (const auto& node : previous) {
+    previous_nodes.try_emplace(key_of(node), &node);
+  }
+  for (const auto& node : next) {
+    auto it = previous_nodes.find(key_of(node));
+    if (it == previous_nodes.end()) {
+      delta.added_nodes.push_back(node);
+      continue;
+    }
+    if (!same_services(*it->second, node)) {
+      delta.changed_nodes.push_back(node);
+    }
+    if (it->second->index != node.index) {
+      delta.nodes_reordered = true;
+    }
+    previous_nodes.erase(it);
+  }
+  for (const auto& [key, node] : previous_nodes) {
+    delta.removed_nodes.push_back(*node);
+  }
+}
+
+void
+diff_vbuckets(const std::optional<configuration::vbucket_map>& previous,
+              const std::optional<configuration::vbucket_map>& next,
+              configuration_delta& delta)
+{
+  if (!previous || !next) {
+    delta.vbucket_map_resized = previous.has_value() != next.has_value();
+    return;
+  }
+  if (previous->size() != next->size()) {
+    delta.vbucket_map_resized = true;
+    return;
+  }
+  for (std::size_t vbucket = 0; vbucket < next->size(); ++vbucket) {
+    if ((*previous)[vbucket] != (*next)[vbucket]) {
+      delta.moved_vbuckets.push_back(static_cast<std::uint16_t>(vbucket));
+    }
+  }
+}
+} // namespace
+
+auto
+make_configuration_delta(const std::optional<configuration>& previous, const configuration& next)
+  -> configuration_delta
+{
+  configuration_delta delta{};
+  delta.revision = { next.epoch, next.rev };
+  if (!previous) {
+    delta.added_nodes = next.nodes;
+    delta.nodes_reordered = true;
+    delta.vbucket_map_resized = next.vbmap.has_value();
+    delta.capabilities_changed = true;
+    delta.collections_manifest_changed = next.collections_manifest_uid.has_value();
+    return delta;
+  }
+
+  delta.previous_revision = config_revision{ previous->epoch, previous->rev };
+  diff_nodes(previous->nodes, next.nodes, delta);
+  diff_vbuckets(previous->vbmap, next.vbmap, delta);
+  delta.capabilities_changed = previous->capabilities.bucket != next.capabilities.bucket ||
+                               previous->capabilities.cluster != next.capabilities.cluster;
+  delta.collections_manifest_changed =
+    previous->collections_manifest_uid != next.collections_manifest_uid;
+  return delta;
+}
+} // namespace couchbase::core::topology
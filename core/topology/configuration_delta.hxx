@@ -0,0 +1,75 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include "config_revision.hxx"
+#include "configuration.hxx"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace couchbase::core::topology
+{
+/**
+ * Changes between two accepted revisions of the cluster map.
+ *
+ * Computed once when the bucket accepts new configuration, and shared with all configuration
+ * listeners, so that they could apply only the changes instead of comparing full maps.
+ */
+struct configuration_delta {
+  std::optional<config_revision> previous_revision{};
+  config_revision revision{};
+
+  /* nodes are matched by hostname and KV ports, the same way as configuration::node::operator!= */
+  std::vector<configuration::node> added_nodes{};
+  std::vector<configuration::node> removed_nodes{};
+  /* the node is still in the map, but its services or alternate addresses have changed */
+  std::vector<configuration::node> changed_nodes{};
+  /* the same set of nodes, but some of them got different index */
+  bool nodes_reordered{ false };
+
+  /* partitions, where either active or replica nodes have been changed */
+  std::vector<std::uint16_t> moved_vbuckets{};
+  bool vbucket_map_resized{ false };
+
+  bool capabilities_changed{ false };
+  bool collections_manifest_changed{ false };
+
+  [[nodiscard]] auto nodes_changed() const -> bool
+  {
+    return !added_nodes.empty() || !removed_nodes.empty() || !changed_nodes.empty() ||
+           nodes_reordered;
+  }
+
+  [[nodiscard]] auto empty() const -> bool
+  {
+    return !nodes_changed() && moved_vbuckets.empty() && !vbucket_map_resized &&
+           !capabilities_changed && !collections_manifest_changed;
+  }
+};
+
+/**
+ * Computes changes from previous to next configuration. When there is no previous configuration,
+ * all nodes of the next one are reported as added.
+ */
+auto
+make_configuration_delta(const std::optional<configuration>& previous, const configuration& next)
+  -> configuration_delta;
+} // namespace couchbase::core::topology
@@ -0,0 +1,260 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "exporting_tracer.hxx"
+
+#include "core/meta/version.hxx"
+#include "core/utils/json.hxx"
+
+#include <fmt/core.h>
+#include <tao/json/value.hpp>
+
+#include <random>
+
+namespace couchbase::core::tracing
+{
+namespace
+{
+auto
+random_id() -> std::uint64_t
+{
+  static thread_local std::mt19937_64 generator{ std::random_device{}() };
+  std::uint64_t id{ 0 };
+  while (id == 0) {
+    id = generator();
+  }
+  return id;
+}
+
+auto
+unix_nanos(std::chrono::system_clock::time_point time_point) -> std::string
+{
+  return std::to_string(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(time_point.time_since_epoch()).count());
+}
+
+auto
+to_hex(std::uint64_t id) -> std::string
+{
+  return fmt::format("{:016x}", id);
+}
+
+auto
+to_hex(const std::array<std::uint8_t, 16>& id) -> std::string
+{
+  std::string result;
+  result.reserve(id.size() * 2);
+  for (auto byte : id) {
+    result += fmt::format("{:02x}", byte);
+  }
+  return result;
+}
+} // namespace
+
+class exporting_span : public couchbase::tracing::request_span
+{
+public:
+  exporting_span(std::string name,
+                 std::shared_ptr<exporting_tracer> tracer,
+                 std::shared_ptr<couchbase::tracing::request_span> parent)
+    : request_span(name, parent)
+    , tracer_{ std::move(tracer) }
+  {
+    span_.name = std::move(name);
+    span_.span_id = random_id();
+    span_.start = std::chrono::system_clock::now();
+    if (auto* exporting_parent = dynamic_cast<exporting_span*>(parent.get());
+        exporting_parent != nullptr) {
+      span_.trace_id = exporting_parent->span_.trace_id;
+      span_.parent_span_id = exporting_parent->span_.span_id;
+    } else {
+      auto high = random_id();
+      auto low = random_id();
+      for (std::size_t i = 0; i < 8; ++i) {
+        span_.trace_id[i] = static_cast<std::uint8_t>(high >> (56 - 8 * i));
+        span_.trace_id[8 + i] = static_cast<std::uint8_t>(low >> (56 - 8 * i));
+      }
+    }
+  }
+
+  void add_tag(const std::string& name, std::uint64_t value) override
+  {
+    span_.integer_tags.emplace_back(name, value);
+  }
+
+  void add_tag(const std::string& name, const std::string& value) override
+  {
+    span_.string_tags.emplace_back(name, value);
+  }
+
+  void end() override
+  {
+    if (ended_.exchange(true)) {
+      return;
+    }
+    span_.duration = std::chrono::steady_clock::now() - start_;
+    tracer_->enqueue(std::move(span_));
+  }
+
+private:
+  finished_span span_{};
+  std::chrono::steady_clock::time_point start_{ std::chrono::steady_clock::now() };
+  std::atomic_bool ended_{ false };
+  std::shared_ptr<exporting_tracer> tracer_;
+};
+
+exporting_tracer::exporting_tracer(asio::io_context& ctx, exporting_tracer_options options)
+  : emit_report_(ctx)
+  , options_(std::move(options))
+  , buffer_{ options_.buffer_capacity }
+{
+}
+
+exporting_tracer::~exporting_tracer()
+{
+  emit_report_.cancel();
+}
+
+auto
+exporting_tracer::start_span(std::string name,
+                             std::shared_ptr<couchbase::tracing::request_span> parent)
+  -> std::shared_ptr<couchbase::tracing::request_span>
+{
+  return std::make_shared<exporting_span>(std::move(name), shared_from_this(), std::move(parent));
+}
+
+void
+exporting_tracer::start()
+{
+  rearm_reporter();
+}
+
+void
+exporting_tracer::stop()
+{
+  emit_report_.cancel();
+  flush();
+}
+
+void
+exporting_tracer::enqueue(finished_span&& span)
+{
+  if (!buffer_.try_push(std::move(span))) {
+    dropped_spans_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+auto
+exporting_tracer::dropped_spans() const -> std::size_t
+{
+  return dropped_spans_.load(std::memory_order_relaxed);
+}
+
+void
+exporting_tracer::rearm_reporter()
+{
+  emit_report_.expires_after(options_.emit_interval);
+  emit_report_.async_wait([self = shared_from_this()](std::error_code ec) {
+    if (ec == asio::error::operation_aborted) {
+      return;
+    }
+    self->flush();
+    self->rearm_reporter();
+  });
+}
+
+void
+exporting_tracer::flush()
+{
+  if (options_.sink == nullptr) {
+    return;
+  }
+  while (true) {
+    std::vector<finished_span> spans{};
+    finished_span span{};
+    while (spans.size() < options_.max_batch_size && buffer_.try_pop(span)) {
+      spans.emplace_back(std::move(span));
+    }
+    if (spans.empty()) {
+      return;
+    }
+    options_.sink->write({
+      utils::telemetry_signal::traces,
+      utils::telemetry_format::otlp_json,
+      build_otlp_json(std::move(spans)),
+    });
+  }
+}
+
+auto
+exporting_tracer::build_otlp_json(std::vector<finished_span>&& spans) const -> std::string
+{
+  tao::json::value otlp_spans = tao::json::empty_array;
+  for (const auto& span : spans) {
+    tao::json::value attributes = tao::json::empty_array;
+    for (const auto& [key, value] : span.string_tags) {
+      attributes.emplace_back(tao::json::value{
+        { "key", key },
+        { "value", { { "stringValue", value } } },
+      });
+    }
+    for (const auto& [key, value] : span.integer_tags) {
+      attributes.emplace_back(tao::json::value{
+        { "key", key },
+        { "value", { { "intValue", std::to_string(value) } } },
+      });
+    }
+    tao::json::value entry{
+      { "traceId", to_hex(span.trace_id) },
+      { "spanId", to_hex(span.span_id) },
+      { "name", span.name },
+      { "kind", 3 /* SPAN_KIND_CLIENT */ },
+      { "startTimeUnixNano", unix_nanos(span.start) },
+      { "endTimeUnixNano",
+        unix_nanos(span.start +
+                   std::chrono::duration_cast<std::chrono::system_clock::duration>(span.duration)) },
+      { "attributes", attributes },
+    };
+    if (span.parent_span_id != 0) {
+      entry["parentSpanId"] = to_hex(span.parent_span_id);
+    }
+    otlp_spans.emplace_back(std::move(entry));
+  }
+
+  tao::json::value scope_spans{
+    { "scope",
+      {
+        { "name", meta::sdk_id() },
+        { "version", meta::sdk_semver() },
+      } },
+    { "spans", otlp_spans },
+  };
+  tao::json::value service_name{
+    { "key", "service.name" },
+    { "value", { { "stringValue", "couchbase-cxx-client" } } },
+  };
+  tao::json::value resource_spans{
+    { "resource", { { "attributes", tao::json::empty_array } } },
+    { "scopeSpans", tao::json::empty_array },
+  };
+  resource_spans["resource"]["attributes"].emplace_back(std::move(service_name));
+  resource_spans["scopeSpans"].emplace_back(std::move(scope_spans));
+  tao::json::value payload{ { "resourceSpans", tao::json::empty_array } };
+  payload["resourceSpans"].emplace_back(std::move(resource_spans));
+  return utils::json::generate(payload);
+}
+} // namespace couchbase::core::tracing
@@ -0,0 +1,93 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/utils/mpmc_ring_buffer.hxx"
+#include "exporting_tracer_options.hxx"
+
+#include <couchbase/tracing/request_tracer.hxx>
+
+#include <asio/steady_timer.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace couchbase::core::tracing
+{
+struct finished_span {
+  std::string name{};
+  std::array<std::uint8_t, 16> trace_id{};
+  std::uint64_t span_id{ 0 };
+  std::uint64_t parent_span_id{ 0 };
+  std::chrono::system_clock::time_point start{};
+  std::chrono::nanoseconds duration{};
+  std::vector<std::pair<std::string, std::string>> string_tags{};
+  std::vector<std::pair<std::string, std::uint64_t>> integer_tags{};
+};
+
+/**
+ * Tracer, which keeps finished spans in a lock-free ring buffer, and periodically sends them to
+ * the telemetry sink as OTLP/HTTP JSON.
+ */
+class exporting_tracer
+  : public couchbase::tracing::request_tracer
+  , public std::enable_shared_from_this<exporting_tracer>
+{
+public:
+  exporting_tracer(asio::io_context& ctx, exporting_tracer_options options);
+  exporting_tracer(const exporting_tracer&) = delete;
+  exporting_tracer(exporting_tracer&&) = delete;
+  auto operator=(const exporting_tracer&) -> exporting_tracer& = delete;
+  auto operator=(exporting_tracer&&) -> exporting_tracer& = delete;
+  ~exporting_tracer() override;
+
+  auto start_span(std::string name, std::shared_ptr<couchbase::tracing::request_span> parent)
+    -> std::shared_ptr<couchbase::tracing::request_span> override;
+  void start() override;
+
+  /**
+   * Stops the reporter and hands the last batch to the sink. The destructor does not flush, so
+   * the spans finished after stop() are dropped.
+   */
+  void stop() override;
+
+  void enqueue(finished_span&& span);
+
+  /**
+   * Sends all buffered spans to the sink.
+   */
+  void flush();
+
+  [[nodiscard]] auto dropped_spans() const -> std::size_t;
+
+private:
+  void rearm_reporter();
+  [[nodiscard]] auto build_otlp_json(std::vector<finished_span>&& spans) const -> std::string;
+
+  asio::steady_timer emit_report_;
+  const exporting_tracer_options options_;
+  utils::mpmc_ring_buffer<finished_span> buffer_;
+  std::atomic_size_t dropped_spans_{ 0 };
+};
+} // namespace couchbase::core::tracing
@@ -0,0 +1,40 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/utils/telemetry_sink.hxx"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+namespace couchbase::core::tracing
+{
+struct exporting_tracer_options {
+  std::chrono::milliseconds emit_interval{ std::chrono::seconds{ 5 } };
+  /**
+   * Finished spans waiting for the next flush. When the buffer is full, new spans are dropped.
+   */
+  std::size_t buffer_capacity{ 8'192 };
+  std::size_t max_batch_size{ 512 };
+  /**
+   * When not set, the exporting tracer is not used.
+   */
+  std::shared_ptr<utils::telemetry_sink> sink{ nullptr };
+};
+} // namespace couchbase::core::tracing
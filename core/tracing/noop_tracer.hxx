@@ -34,6 +34,11 @@ class noop_span : public couchbase::tracing::request_span
     /* do nothing */
   }
 
+  void add_operation_id(std::uint32_t /* opaque */) override
+  {
+    /* do nothing */
+  }
+
   void end() override
   {
     /* do nothing */
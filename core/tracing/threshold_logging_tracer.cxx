@@ -21,16 +21,16 @@
 
 #include "constants.hxx"
 #include "core/logger/logger.hxx"
-#include "core/meta/version.hxx"
-#include "core/platform/uuid.h"
 #include "core/service_type_fmt.hxx"
 #include "core/utils/json.hxx"
 
 #include <asio/steady_timer.hpp>
 #include <tao/json/value.hpp>
 
+#include <array>
 #include <chrono>
 #include <mutex>
+#include <optional>
 #include <queue>
 
 namespace couchbase::core::tracing
@@ -45,30 +45,81 @@ struct reported_span {
   }
 };
 
+/**
+ * The span is created for every operation, but only a small fraction of them end up in the
+ * reports. It keeps only the tags used by the reports, in fixed slots, and ignores the others.
+ */
 class threshold_logging_span
   : public couchbase::tracing::request_span
   , public std::enable_shared_from_this<threshold_logging_span>
 {
-private:
-  std::chrono::system_clock::time_point start_{ std::chrono::system_clock::now() };
-  std::string id_{ uuid::to_string(uuid::random()) };
-  std::map<std::string, std::uint64_t> integer_tags_{};
-  std::map<std::string, std::string> string_tags_{
-    { attributes::system, "couchbase" },
-    { attributes::span_kind, "client" },
-    { attributes::component, couchbase::core::meta::sdk_id() },
+public:
+  enum class reported_tag : std::size_t {
+    operation_id,
+    local_id,
+    local_socket,
+    remote_socket,
   };
+
+private:
+  static constexpr std::size_t number_of_reported_tags{ 4 };
+
+  std::chrono::steady_clock::time_point start_{ std::chrono::steady_clock::now() };
+  std::array<std::string, number_of_reported_tags> reported_tags_{};
+  std::optional<std::uint32_t> opaque_{};
+  std::optional<service_type> service_{};
+  bool orphan_{ false };
   std::chrono::microseconds duration_{ 0 };
   std::uint64_t last_server_duration_us_{ 0 };
   std::uint64_t total_server_duration_us_{ 0 };
 
   std::shared_ptr<threshold_logging_tracer> tracer_{};
 
+  static auto parse_service(const std::string& service_name) -> std::optional<service_type>
+  {
+    if (service_name == tracing::service::key_value) {
+      return service_type::key_value;
+    }
+    if (service_name == tracing::service::query) {
+      return service_type::query;
+    }
+    if (service_name == tracing::service::view) {
+      return service_type::view;
+    }
+    if (service_name == tracing::service::search) {
+      return service_type::search;
+    }
+    if (service_name == tracing::service::analytics) {
+      return service_type::analytics;
+    }
+    if (service_name == tracing::service::management) {
+      return service_type::management;
+    }
+    return {};
+  }
+
+  static auto reported_tag_for(const std::string& name) -> std::optional<reported_tag>
+  {
+    if (name == attributes::operation_id) {
+      return reported_tag::operation_id;
+    }
+    if (name == attributes::local_id) {
+      return reported_tag::local_id;
+    }
+    if (name == attributes::local_socket) {
+      return reported_tag::local_socket;
+    }
+    if (name == attributes::remote_socket) {
+      return reported_tag::remote_socket;
+    }
+    return {};
+  }
+
 public:
   threshold_logging_span(std::string name,
                          std::shared_ptr<threshold_logging_tracer> tracer,
                          std::shared_ptr<request_span> parent = nullptr)
-    : request_span(std::move(name), parent)
+    : request_span(std::move(name), std::move(parent))
     , tracer_{ std::move(tracer) }
   {
   }
@@ -79,19 +130,42 @@ public:
       last_server_duration_us_ = value;
       total_server_duration_us_ += value;
     }
-    integer_tags_.try_emplace(name, value);
   }
 
   void add_tag(const std::string& name, const std::string& value) override
   {
-    string_tags_.try_emplace(name, value);
+    if (name == tracing::attributes::service) {
+      if (!service_) {
+        service_ = parse_service(value);
+      }
+    } else if (name == tracing::attributes::orphan) {
+      orphan_ = true;
+    } else if (auto tag = reported_tag_for(name); tag) {
+      // keep the first value, like the other tags
+      if (auto& slot = reported_tags_[static_cast<std::size_t>(tag.value())]; slot.empty()) {
+        slot = value;
+      }
+    }
+  }
+
+  void add_operation_id(std::uint32_t opaque) override
+  {
+    // formatted by convert(), only if the span gets into the report
+    if (!opaque_) {
+      opaque_ = opaque;
+    }
   }
 
   void end() override;
 
-  [[nodiscard]] auto string_tags() const -> const auto&
+  [[nodiscard]] auto opaque() const -> std::optional<std::uint32_t>
+  {
+    return opaque_;
+  }
+
+  [[nodiscard]] auto reported_tag_value(reported_tag tag) const -> const std::string&
   {
-    return string_tags_;
+    return reported_tags_[static_cast<std::size_t>(tag)];
   }
 
   [[nodiscard]] auto duration() const -> std::chrono::microseconds
@@ -111,44 +185,17 @@ public:
 
   [[nodiscard]] auto orphan() const -> bool
   {
-    return string_tags_.find(tracing::attributes::orphan) != string_tags_.end();
+    return orphan_;
   }
 
   [[nodiscard]] auto is_key_value() const -> bool
   {
-    auto service_tag = string_tags_.find(tracing::attributes::service);
-    if (service_tag == string_tags_.end()) {
-      return false;
-    }
-    return service_tag->second == tracing::service::key_value;
+    return service_ == service_type::key_value;
   }
 
   [[nodiscard]] auto service() const -> std::optional<service_type>
   {
-    auto service_tag = string_tags_.find(tracing::attributes::service);
-    if (service_tag == string_tags_.end()) {
-      return {};
-    }
-    const auto& service_name = service_tag->second;
-    if (service_name == tracing::service::key_value) {
-      return service_type::key_value;
-    }
-    if (service_name == tracing::service::query) {
-      return service_type::query;
-    }
-    if (service_name == tracing::service::view) {
-      return service_type::view;
-    }
-    if (service_name == tracing::service::search) {
-      return service_type::search;
-    }
-    if (service_name == tracing::service::analytics) {
-      return service_type::analytics;
-    }
-    if (service_name == tracing::service::management) {
-      return service_type::management;
-    }
-    return {};
+    return service_;
   }
 };
 
@@ -235,25 +282,20 @@ convert(std::shared_ptr<threshold_logging_span> span) -> reported_span
     entry["total_server_duration_us"] = span->total_server_duration_us();
   }
 
-  const auto& tags = span->string_tags();
-  auto pair = tags.find(attributes::operation_id);
-  if (pair != tags.end()) {
-    entry["last_operation_id"] = pair->second;
+  using reported_tag = threshold_logging_span::reported_tag;
+  if (const auto& value = span->reported_tag_value(reported_tag::operation_id); !value.empty()) {
+    entry["last_operation_id"] = value;
+  } else if (auto opaque = span->opaque(); opaque) {
+    entry["last_operation_id"] = fmt::format("0x{:x}", opaque.value());
   }
-
-  pair = tags.find(attributes::local_id);
-  if (pair != tags.end()) {
-    entry["last_local_id"] = pair->second;
+  if (const auto& value = span->reported_tag_value(reported_tag::local_id); !value.empty()) {
+    entry["last_local_id"] = value;
   }
-
-  pair = tags.find(attributes::local_socket);
-  if (pair != tags.end()) {
-    entry["last_local_socket"] = pair->second;
+  if (const auto& value = span->reported_tag_value(reported_tag::local_socket); !value.empty()) {
+    entry["last_local_socket"] = value;
   }
-
-  pair = tags.find(attributes::remote_socket);
-  if (pair != tags.end()) {
-    entry["last_remote_socket"] = pair->second;
+  if (const auto& value = span->reported_tag_value(reported_tag::remote_socket); !value.empty()) {
+    entry["last_remote_socket"] = value;
   }
 
   return { span->duration(), std::move(entry) };
@@ -441,7 +483,7 @@ void
 threshold_logging_span::end()
 {
   duration_ = std::chrono::duration_cast<std::chrono::microseconds>(
-    std::chrono::system_clock::now() - start_);
+    std::chrono::steady_clock::now() - start_);
   tracer_->report(shared_from_this());
 }
 
@@ -52,6 +52,14 @@ namespace transactions
  */
 class transactions_cleanup;
 
+/** @internal
+ */
+class transaction_executor;
+
+/** @internal
+ */
+struct transaction_executor_stats;
+
 /** @brief Transaction logic should be contained in a lambda of this form */
 using logic = std::function<void(std::shared_ptr<attempt_context>)>;
 
@@ -263,6 +271,13 @@ public:
     return *cleanup_;
   }
 
+  /**
+   * @brief Return counters of the executor running asynchronous transactions.
+   *
+   * @return number of running and queued transactions, along with totals since creation.
+   */
+  [[nodiscard]] auto async_executor_stats() const -> transaction_executor_stats;
+
   /**
    * @brief Return a reference to the @ref core::cluster
    *
@@ -286,6 +301,7 @@ private:
   core::cluster cluster_;
   couchbase::transactions::transactions_config::built config_;
   std::unique_ptr<transactions_cleanup> cleanup_;
+  std::unique_ptr<transaction_executor> executor_;
   const std::size_t max_attempts_{ 1000 };
   const std::chrono::milliseconds min_retry_delay_{ 1 };
 };
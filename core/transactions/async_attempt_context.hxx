@@ -25,6 +25,7 @@
 #include <future>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace couchbase::core::transactions
 {
@@ -40,6 +41,8 @@ class async_attempt_context
 public:
   using Callback = std::function<void(std::exception_ptr, std::optional<transaction_get_result>)>;
   using VoidCallback = std::function<void(std::exception_ptr)>;
+  using MultiCallback =
+    std::function<void(std::exception_ptr, std::vector<std::optional<transaction_get_result>>)>;
   using QueryCallback =
     std::function<void(std::exception_ptr, std::optional<core::operations::query_response>)>;
   virtual ~async_attempt_context() = default;
@@ -63,6 +66,18 @@ public:
    */
   virtual void get_optional(const core::document_id& id, Callback&& cb) = 0;
 
+  /**
+   * Gets several documents at once.
+   *
+   * The lookups are sent in parallel, and the reads of the transaction records for documents
+   * staged by other transactions are shared between documents of the batch.
+   *
+   * @param ids the IDs of the documents
+   * @param cb callback function called once with the documents in the same order as the ids
+   * (std::nullopt for those which do not exist), or a @ref transaction_operation_failed.
+   */
+  virtual void get_multi(const std::vector<core::document_id>& ids, MultiCallback&& cb) = 0;
+
   /**
    * Get a document copy from the selected server group.
    *
@@ -93,7 +93,7 @@ atr_cleanup_entry::clean(transactions_cleanup_attempt* result)
   // get atr entry if needed
   atr_entry entry;
   if (nullptr == atr_entry_) {
-    auto atr = active_transaction_record::get_atr(cleanup_->cluster_ref(), atr_id_);
+    auto atr = cleanup_->atr_lookups_ref().get_atr(cleanup_->cluster_ref(), atr_id_);
     if (atr) {
       // now get the specific attempt
       auto it = std::find_if(atr->entries().begin(), atr->entries().end(), [&](const atr_entry& e) {
@@ -23,6 +23,7 @@
 
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace couchbase::core::transactions
 {
@@ -69,6 +70,21 @@ public:
   virtual auto get_optional(const core::document_id& id)
     -> std::optional<transaction_get_result> = 0;
 
+  /**
+   * Gets several documents at once.
+   *
+   * The lookups are sent in parallel, and the reads of the transaction records for documents
+   * staged by other transactions are shared between documents of the batch.
+   *
+   * @param ids the IDs of the documents
+   * @return the documents in the same order as the ids, std::nullopt for those which do not exist.
+   *
+   * @throws transaction_operation_failed which either should not be caught by
+   * the lambda, or rethrown if it is caught.
+   */
+  virtual auto get_multi(const std::vector<core::document_id>& ids)
+    -> std::vector<std::optional<transaction_get_result>> = 0;
+
   /**
    * Get a document copy from the selected server group.
    *
@@ -377,6 +377,68 @@ attempt_context_impl::get_optional(const core::document_id& id, Callback&& cb)
   });
 }
 
+auto
+attempt_context_impl::get_multi(const std::vector<core::document_id>& ids)
+  -> std::vector<std::optional<transaction_get_result>>
+{
+  auto barrier =
+    std::make_shared<std::promise<std::vector<std::optional<transaction_get_result>>>>();
+  auto f = barrier->get_future();
+  get_multi(ids,
+            [barrier](std::exception_ptr err,
+                      std::vector<std::optional<transaction_get_result>> results) {
+              if (err) {
+                return barrier->set_exception(std::move(err));
+              }
+              return barrier->set_value(std::move(results));
+            });
+  return f.get();
+}
+
+void
+attempt_context_impl::get_multi(const std::vector<core::document_id>& ids, MultiCallback&& cb)
+{
+  struct get_multi_state {
+    std::mutex mutex{};
+    std::vector<std::optional<transaction_get_result>> results{};
+    std::size_t remaining{};
+    std::exception_ptr error{};
+    MultiCallback cb{};
+  };
+
+  if (ids.empty()) {
+    return cb({}, {});
+  }
+  auto state = std::make_shared<get_multi_state>();
+  state->results.resize(ids.size());
+  state->remaining = ids.size();
+  state->cb = std::move(cb);
+
+  // every get is dispatched right away, so that lookups to different nodes overlap, and documents
+  // staged by the same transaction share the read of its ATR (see atr_lookup_coalescer)
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    get_optional(
+      ids[i], [state, i](std::exception_ptr err, std::optional<transaction_get_result> res) {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        if (err) {
+          if (!state->error) {
+            state->error = std::move(err);
+          }
+        } else {
+          state->results[i] = std::move(res);
+        }
+        if (--state->remaining > 0) {
+          return;
+        }
+        lock.unlock();
+        if (state->error) {
+          return state->cb(state->error, {});
+        }
+        return state->cb({}, std::move(state->results));
+      });
+  }
+}
+
 void
 attempt_context_impl::get_replica_from_preferred_server_group(
   const core::document_id& id,
@@ -1043,7 +1105,7 @@ attempt_context_impl::check_atr_entry_for_blocking_document(const transaction_ge
                                  doc.links().atr_scope_name().value(),
                                  doc.links().atr_collection_name().value(),
                                  doc.links().atr_id().value());
-        return active_transaction_record::get_atr(
+        return self->overall_->cleanup().atr_lookups_ref().get_atr(
           self->cluster_ref(),
           atr_id,
           [self, delay = std::move(delay), cb = std::move(cb), doc](
@@ -2295,111 +2357,154 @@ attempt_context_impl::atr_commit_ambiguity_resolution()
 }
 
 void
-attempt_context_impl::atr_complete()
+attempt_context_impl::atr_complete(VoidCallback&& cb)
 {
-  try {
-    result atr_res;
-    auto ec = wait_for_hook([self = shared_from_this()](auto handler) mutable {
-      return self->hooks_.before_atr_complete(self, std::move(handler));
-    });
-    if (ec) {
-      throw client_error(*ec, "before_atr_complete hook threw error");
-    }
-    // if we have expired (and not in overtime mode), just raise the final
-    // error.
-    ec = error_if_expired_and_not_in_overtime(STAGE_ATR_COMPLETE, {});
-    if (ec) {
-      throw client_error(*ec, "atr_complete threw error");
+  auto error_handler = [self = shared_from_this()](error_class ec,
+                                                   const std::string& message,
+                                                   VoidCallback&& cb) {
+    if (ec == FAIL_HARD) {
+      return cb(std::make_exception_ptr(
+        transaction_operation_failed(ec, message).no_rollback().failed_post_commit()));
     }
-    CB_ATTEMPT_CTX_LOG_DEBUG(this, "removing attempt {} from atr", atr_id_.value());
-    std::string prefix(ATR_FIELD_ATTEMPTS + "." + id());
-    core::operations::mutate_in_request req{ atr_id_.value() };
-    req.specs =
-      couchbase::mutate_in_specs{
-        couchbase::mutate_in_specs::remove(prefix).xattr(),
+    CB_ATTEMPT_CTX_LOG_INFO(self, "ignoring error in atr_complete {}", message);
+    return cb({});
+  };
+  hooks_.before_atr_complete(
+    shared_from_this(),
+    [self = shared_from_this(), cb = std::move(cb), error_handler](auto ec) mutable {
+      if (ec) {
+        return error_handler(*ec, "before_atr_complete hook threw error", std::move(cb));
       }
-        .specs();
-    wrap_durable_request(req, overall_->config());
-    auto barrier = std::make_shared<std::promise<result>>();
-    auto f = barrier->get_future();
-    overall_->cluster_ref().execute(req, [barrier](core::operations::mutate_in_response resp) {
-      barrier->set_value(result::create_from_subdoc_response(resp));
-    });
-    wrap_operation_future(f);
-    ec = wait_for_hook([self = shared_from_this()](auto handler) mutable {
-      return self->hooks_.after_atr_complete(self, std::move(handler));
+      // if we have expired (and not in overtime mode), just raise the final
+      // error.
+      ec = self->error_if_expired_and_not_in_overtime(STAGE_ATR_COMPLETE, {});
+      if (ec) {
+        return error_handler(*ec, "atr_complete threw error", std::move(cb));
+      }
+      CB_ATTEMPT_CTX_LOG_DEBUG(self, "removing attempt {} from atr", self->atr_id_.value());
+      std::string prefix(ATR_FIELD_ATTEMPTS + "." + self->id());
+      core::operations::mutate_in_request req{ self->atr_id_.value() };
+      req.specs =
+        couchbase::mutate_in_specs{
+          couchbase::mutate_in_specs::remove(prefix).xattr(),
+        }
+          .specs();
+      wrap_durable_request(req, self->overall_->config());
+      self->overall_->cluster_ref().execute(
+        req,
+        [self, cb = std::move(cb), error_handler](
+          core::operations::mutate_in_response resp) mutable {
+          if (auto ec = error_class_from_response(resp); ec) {
+            return error_handler(*ec, resp.ctx.ec().message(), std::move(cb));
+          }
+          self->hooks_.after_atr_complete(
+            self, [self, cb = std::move(cb), error_handler](auto ec) mutable {
+              if (ec) {
+                return error_handler(*ec, "after_atr_complete hook threw error", std::move(cb));
+              }
+              self->state(attempt_state::COMPLETED);
+              return cb({});
+            });
+        });
     });
-    if (ec) {
-      throw client_error(*ec, "after_atr_complete hook threw error");
-    }
-    state(attempt_state::COMPLETED);
-  } catch (const client_error& er) {
-    switch (error_class ec = er.ec(); ec) {
-      case FAIL_HARD:
-        throw transaction_operation_failed(ec, er.what()).no_rollback().failed_post_commit();
-      default:
-        CB_ATTEMPT_CTX_LOG_INFO(this, "ignoring error in atr_complete {}", er.what());
-    }
-  }
 }
+
 void
 attempt_context_impl::commit(VoidCallback&& cb)
 {
-  // for now, lets keep the blocking implementation
-  std::thread([cb = std::move(cb), self = shared_from_this()]() mutable {
-    try {
-      self->commit();
-      return cb({});
-    } catch (const transaction_operation_failed&) {
-      return cb(std::current_exception());
-    } catch (const std::exception& e) {
-      return cb(std::make_exception_ptr(transaction_operation_failed(FAIL_OTHER, e.what())));
-    }
-  }).detach();
+  // The phases up to the ATR commit block, so they are kept off the IO threads. Unstaging of the
+  // documents and the completion of the ATR entry run asynchronously.
+  overall_->run_blocking([self = shared_from_this(), cb = std::move(cb)]() mutable {
+    self->start_commit(std::move(cb));
+  });
 }
 
 void
-attempt_context_impl::commit()
+attempt_context_impl::start_commit(VoidCallback&& cb)
 {
-  CB_ATTEMPT_CTX_LOG_DEBUG(this, "waiting on ops to finish...");
-  op_list_.wait_and_block_ops();
-  existing_error(false);
-  CB_ATTEMPT_CTX_LOG_DEBUG(this, "commit {}", id());
-  if (op_list_.get_mode().is_query()) {
-    auto barrier = std::make_shared<std::promise<void>>();
-    auto f = barrier->get_future();
-    commit_with_query([barrier](std::exception_ptr err) {
-      if (err) {
-        barrier->set_exception(err);
-      } else {
-        barrier->set_value();
-      }
-    });
-    f.get();
-  } else {
-    if (check_expiry_pre_commit(STAGE_BEFORE_COMMIT, {})) {
-      throw transaction_operation_failed(FAIL_EXPIRY, "transaction expired").expired();
-    }
-    if (atr_id_ && !atr_id_->key().empty() && !is_done_) {
-      retry_op_exp<void>([self = shared_from_this()]() {
-        self->atr_commit(false);
-      });
-      staged_mutations_->commit(shared_from_this());
-      atr_complete();
-      is_done_ = true;
+  // the callback is invoked only outside of the try block, so that it runs exactly once
+  std::exception_ptr err{};
+  bool with_query{ false };
+  bool nothing_to_commit{ false };
+  try {
+    CB_ATTEMPT_CTX_LOG_DEBUG(this, "waiting on ops to finish...");
+    op_list_.wait_and_block_ops();
+    existing_error(false);
+    CB_ATTEMPT_CTX_LOG_DEBUG(this, "commit {}", id());
+    if (op_list_.get_mode().is_query()) {
+      with_query = true;
     } else {
-      // no mutation, no need to commit
-      if (!is_done_) {
+      if (check_expiry_pre_commit(STAGE_BEFORE_COMMIT, {})) {
+        throw transaction_operation_failed(FAIL_EXPIRY, "transaction expired").expired();
+      }
+      if (!atr_id_ || atr_id_->key().empty() || is_done_) {
+        // no mutation, no need to commit
+        if (is_done_) {
+          // do not rollback or retry
+          throw transaction_operation_failed(FAIL_OTHER,
+                                             "calling commit on attempt that is already completed")
+            .no_rollback();
+        }
         CB_ATTEMPT_CTX_LOG_DEBUG(this,
                                  "calling commit on attempt that has got no mutations, skipping");
         is_done_ = true;
-        return;
-      } // do not rollback or retry
-      throw transaction_operation_failed(FAIL_OTHER,
-                                         "calling commit on attempt that is already completed")
-        .no_rollback();
+        nothing_to_commit = true;
+      } else {
+        retry_op_exp<void>([self = shared_from_this()]() {
+          self->atr_commit(false);
+        });
+      }
     }
+  } catch (const transaction_operation_failed&) {
+    err = std::current_exception();
+  } catch (const std::exception& e) {
+    err = std::make_exception_ptr(transaction_operation_failed(FAIL_OTHER, e.what()));
+  }
+  if (err) {
+    return cb(std::move(err));
+  }
+  if (with_query) {
+    return commit_with_query(std::move(cb));
+  }
+  if (nothing_to_commit) {
+    return cb({});
   }
+  staged_mutations_->commit(
+    shared_from_this(), [self = shared_from_this(), cb = std::move(cb)](std::exception_ptr err) {
+      if (err) {
+        try {
+          std::rethrow_exception(err);
+        } catch (const transaction_operation_failed&) {
+          err = std::current_exception();
+        } catch (const std::exception& e) {
+          // the ATR entry is committed already, it is too late to roll back
+          err = std::make_exception_ptr(
+            transaction_operation_failed(FAIL_OTHER, e.what()).no_rollback().failed_post_commit());
+        }
+        return cb(std::move(err));
+      }
+      self->atr_complete([self, cb](std::exception_ptr err) {
+        if (!err) {
+          self->is_done_ = true;
+        }
+        return cb(err);
+      });
+    });
+}
+
+void
+attempt_context_impl::commit()
+{
+  auto barrier = std::make_shared<std::promise<void>>();
+  auto f = barrier->get_future();
+  commit([barrier](std::exception_ptr err) {
+    if (err) {
+      barrier->set_exception(err);
+    } else {
+      barrier->set_value();
+    }
+  });
+  f.get();
 }
 
 void
@@ -2483,142 +2588,101 @@ attempt_context_impl::atr_abort()
 }
 
 void
-attempt_context_impl::atr_rollback_complete()
+attempt_context_impl::atr_rollback_complete(std::size_t retries, VoidCallback&& cb)
 {
-  try {
-    auto ec = error_if_expired_and_not_in_overtime(STAGE_ATR_ROLLBACK_COMPLETE, std::nullopt);
-    if (ec) {
-      throw client_error(*ec, "atr_rollback_complete raised error");
-    }
-
-    ec = wait_for_hook([self = shared_from_this()](auto handler) mutable {
-      return self->hooks_.before_atr_rolled_back(self, std::move(handler));
-    });
-    if (ec) {
-      throw client_error(*ec, "before_atr_rolled_back hook threw error");
-    }
-    std::string prefix(ATR_FIELD_ATTEMPTS + "." + id());
-    core::operations::mutate_in_request req{ atr_id_.value() };
-    req.specs =
-      couchbase::mutate_in_specs{
-        couchbase::mutate_in_specs::remove(prefix).xattr(),
-      }
-        .specs();
-    wrap_durable_request(req, overall_->config());
-    auto barrier = std::make_shared<std::promise<result>>();
-    auto f = barrier->get_future();
-    overall_->cluster_ref().execute(req, [barrier](core::operations::mutate_in_response resp) {
-      barrier->set_value(result::create_from_subdoc_response(resp));
-    });
-    wrap_operation_future(f);
-    state(attempt_state::ROLLED_BACK);
-    ec = wait_for_hook([self = shared_from_this()](auto handler) mutable {
-      return self->hooks_.after_atr_rolled_back(self, std::move(handler));
-    });
-    if (ec) {
-      throw client_error(*ec, "after_atr_rolled_back hook threw error");
-    }
-    is_done_ = true;
-
-  } catch (const client_error& e) {
-    auto ec = e.ec();
-    if (expiry_overtime_mode_.load()) {
+  auto error_handler = [self = shared_from_this(), retries](error_class ec,
+                                                            const std::string& message,
+                                                            VoidCallback&& cb) {
+    if (self->expiry_overtime_mode_.load()) {
       CB_ATTEMPT_CTX_LOG_DEBUG(
-        this, "atr_rollback_complete error while in overtime mode {}", e.what());
-      throw transaction_operation_failed(
-        FAIL_EXPIRY, std::string("expired in atr_rollback_complete with {} ") + e.what())
-        .no_rollback()
-        .expired();
+        self, "atr_rollback_complete error while in overtime mode {}", message);
+      return cb(std::make_exception_ptr(
+        transaction_operation_failed(
+          FAIL_EXPIRY, std::string("expired in atr_rollback_complete with {} ") + message)
+          .no_rollback()
+          .expired()));
     }
-    CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr_rollback_complete got error {}", ec);
+    CB_ATTEMPT_CTX_LOG_DEBUG(self, "atr_rollback_complete got error {}", ec);
     switch (ec) {
       case FAIL_DOC_NOT_FOUND:
       case FAIL_PATH_NOT_FOUND:
-        CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr {} not found, ignoring", atr_id_->key());
-        is_done_ = true;
-        break;
+        CB_ATTEMPT_CTX_LOG_DEBUG(self, "atr {} not found, ignoring", self->atr_id_->key());
+        self->is_done_ = true;
+        return cb({});
       case FAIL_ATR_FULL:
-        CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr {} full!", atr_id_->key());
-        throw retry_operation(e.what());
+        CB_ATTEMPT_CTX_LOG_DEBUG(self, "atr {} full!", self->atr_id_->key());
+        break;
       case FAIL_HARD:
-        throw transaction_operation_failed(ec, e.what()).no_rollback();
+        return cb(
+          std::make_exception_ptr(transaction_operation_failed(ec, message).no_rollback()));
       case FAIL_EXPIRY:
-        CB_ATTEMPT_CTX_LOG_DEBUG(this, "timed out writing atr {}", atr_id_->key());
-        throw transaction_operation_failed(ec, e.what()).no_rollback().expired();
+        CB_ATTEMPT_CTX_LOG_DEBUG(self, "timed out writing atr {}", self->atr_id_->key());
+        return cb(std::make_exception_ptr(
+          transaction_operation_failed(ec, message).no_rollback().expired()));
       default:
-        CB_ATTEMPT_CTX_LOG_DEBUG(this, "retrying atr_rollback_complete");
-        throw retry_operation(e.what());
-    }
-  }
-}
-void
-attempt_context_impl::rollback(VoidCallback&& cb)
-{
-  // for now, lets keep the blocking implementation
-  std::thread([cb = std::move(cb), this]() mutable {
-    if (op_list_.get_mode().is_query()) {
-      return rollback_with_query(std::move(cb));
+        CB_ATTEMPT_CTX_LOG_DEBUG(self, "retrying atr_rollback_complete");
+        break;
     }
-    try {
-      rollback();
-      return cb({});
-    } catch (const transaction_operation_failed&) {
-      return cb(std::current_exception());
-    } catch (const std::exception& e) {
-      return cb(
-        std::make_exception_ptr(transaction_operation_failed(FAIL_OTHER, e.what()).no_rollback()));
-    } catch (...) {
+    if (retries >= DEFAULT_RETRY_OP_MAX_RETRIES) {
       return cb(std::make_exception_ptr(
-        transaction_operation_failed(FAIL_OTHER, "unexpected exception during rollback")));
+        transaction_operation_failed(FAIL_OTHER, "atr_rollback_complete hit max retries")
+          .no_rollback()));
     }
-  }).detach();
-}
-
-void
-attempt_context_impl::rollback()
-{
-  op_list_.wait_and_block_ops();
-  CB_ATTEMPT_CTX_LOG_DEBUG(this, "rolling back {}", id());
-  if (op_list_.get_mode().is_query()) {
-    auto barrier = std::make_shared<std::promise<void>>();
-    auto f = barrier->get_future();
-    rollback_with_query([barrier](std::exception_ptr err) {
-      if (err) {
-        barrier->set_exception(err);
-      } else {
-        barrier->set_value();
-      }
+    // same backoff as retry_op_exp, but without blocking the thread
+    auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(
+      DEFAULT_RETRY_OP_EXP_DELAY *
+      (jitter() * std::pow(2, std::fmin(DEFAULT_RETRY_OP_EXPONENT_CAP, retries))));
+    self->overall_->after_delay(delay, [self, retries, cb = std::move(cb)]() mutable {
+      self->atr_rollback_complete(retries + 1, std::move(cb));
     });
-    return f.get();
-  }
-  // check for expiry
-  check_expiry_during_commit_or_rollback(STAGE_ROLLBACK, std::nullopt);
-  if (!atr_id_ || atr_id_->key().empty() || state() == attempt_state::NOT_STARTED) {
-    // TODO: check this, but if we try to rollback an empty txn, we should
-    // prevent a subsequent commit
-    CB_ATTEMPT_CTX_LOG_DEBUG(this, "rollback called on txn with no mutations");
-    is_done_ = true;
-    return;
-  }
-  if (is_done()) {
-    std::string msg("Transaction already done, cannot rollback");
-    CB_ATTEMPT_CTX_LOG_ERROR(this, "{}", msg);
-    // need to raise a FAIL_OTHER which is not retryable or rollback-able
-    throw transaction_operation_failed(FAIL_OTHER, msg).no_rollback();
+  };
+
+  if (auto ec = error_if_expired_and_not_in_overtime(STAGE_ATR_ROLLBACK_COMPLETE, std::nullopt);
+      ec) {
+    return error_handler(*ec, "atr_rollback_complete raised error", std::move(cb));
   }
-  try {
-    // (1) atr_abort
-    retry_op_exp<void>([self = shared_from_this()]() {
-      self->atr_abort();
+  hooks_.before_atr_rolled_back(
+    shared_from_this(),
+    [self = shared_from_this(), cb = std::move(cb), error_handler](auto ec) mutable {
+      if (ec) {
+        return error_handler(*ec, "before_atr_rolled_back hook threw error", std::move(cb));
+      }
+      std::string prefix(ATR_FIELD_ATTEMPTS + "." + self->id());
+      core::operations::mutate_in_request req{ self->atr_id_.value() };
+      req.specs =
+        couchbase::mutate_in_specs{
+          couchbase::mutate_in_specs::remove(prefix).xattr(),
+        }
+          .specs();
+      wrap_durable_request(req, self->overall_->config());
+      self->overall_->cluster_ref().execute(
+        req,
+        [self, cb = std::move(cb), error_handler](
+          core::operations::mutate_in_response resp) mutable {
+          if (auto ec = error_class_from_response(resp); ec) {
+            return error_handler(*ec, resp.ctx.ec().message(), std::move(cb));
+          }
+          self->state(attempt_state::ROLLED_BACK);
+          self->hooks_.after_atr_rolled_back(
+            self, [self, cb = std::move(cb), error_handler](auto ec) mutable {
+              if (ec) {
+                return error_handler(
+                  *ec, "after_atr_rolled_back hook threw error", std::move(cb));
+              }
+              self->is_done_ = true;
+              return cb({});
+            });
+        });
     });
-    // (2) rollback staged mutations
-    staged_mutations_->rollback(shared_from_this());
-    CB_ATTEMPT_CTX_LOG_DEBUG(this, "rollback completed unstaging docs");
+}
 
-    // (3) atr_rollback
-    retry_op_exp<void>([self = shared_from_this()]() {
-      self->atr_rollback_complete();
-    });
+auto
+attempt_context_impl::rollback_error(std::exception_ptr err) -> std::exception_ptr
+{
+  try {
+    std::rethrow_exception(std::move(err));
+  } catch (const transaction_operation_failed&) {
+    return std::current_exception();
   } catch (const client_error& e) {
     error_class ec = e.ec();
     CB_ATTEMPT_CTX_LOG_ERROR(this,
@@ -2627,9 +2691,104 @@ attempt_context_impl::rollback()
                              id(),
                              e.what());
     if (ec == FAIL_HARD) {
-      throw transaction_operation_failed(ec, e.what()).no_rollback();
+      return std::make_exception_ptr(transaction_operation_failed(ec, e.what()).no_rollback());
+    }
+    return {};
+  } catch (const std::exception& e) {
+    return std::make_exception_ptr(
+      transaction_operation_failed(FAIL_OTHER, e.what()).no_rollback());
+  } catch (...) {
+    return std::make_exception_ptr(
+      transaction_operation_failed(FAIL_OTHER, "unexpected exception during rollback"));
+  }
+}
+
+void
+attempt_context_impl::rollback(VoidCallback&& cb)
+{
+  // The ATR abort blocks, so it is kept off the IO threads. Rollback of the documents and the
+  // removal of the ATR entry run asynchronously.
+  overall_->run_blocking([self = shared_from_this(), cb = std::move(cb)]() mutable {
+    self->start_rollback(std::move(cb));
+  });
+}
+
+void
+attempt_context_impl::start_rollback(VoidCallback&& cb)
+{
+  // the callback is invoked only outside of the try block, so that it runs exactly once
+  std::exception_ptr err{};
+  bool with_query{ false };
+  bool nothing_to_rollback{ false };
+  try {
+    op_list_.wait_and_block_ops();
+    CB_ATTEMPT_CTX_LOG_DEBUG(this, "rolling back {}", id());
+    if (op_list_.get_mode().is_query()) {
+      with_query = true;
+    } else {
+      // check for expiry
+      check_expiry_during_commit_or_rollback(STAGE_ROLLBACK, std::nullopt);
+      if (!atr_id_ || atr_id_->key().empty() || state() == attempt_state::NOT_STARTED) {
+        // TODO: check this, but if we try to rollback an empty txn, we should
+        // prevent a subsequent commit
+        CB_ATTEMPT_CTX_LOG_DEBUG(this, "rollback called on txn with no mutations");
+        is_done_ = true;
+        nothing_to_rollback = true;
+      } else {
+        if (is_done()) {
+          std::string msg("Transaction already done, cannot rollback");
+          CB_ATTEMPT_CTX_LOG_ERROR(this, "{}", msg);
+          // need to raise a FAIL_OTHER which is not retryable or rollback-able
+          throw transaction_operation_failed(FAIL_OTHER, msg).no_rollback();
+        }
+        // (1) atr_abort
+        retry_op_exp<void>([self = shared_from_this()]() {
+          self->atr_abort();
+        });
+      }
     }
+  } catch (...) {
+    err = std::current_exception();
+  }
+  if (err) {
+    return cb(rollback_error(std::move(err)));
   }
+  if (with_query) {
+    return rollback_with_query(std::move(cb));
+  }
+  if (nothing_to_rollback) {
+    return cb({});
+  }
+  // (2) rollback staged mutations
+  staged_mutations_->rollback(
+    shared_from_this(), [self = shared_from_this(), cb = std::move(cb)](std::exception_ptr err) {
+      if (err) {
+        return cb(self->rollback_error(std::move(err)));
+      }
+      CB_ATTEMPT_CTX_LOG_DEBUG(self, "rollback completed unstaging docs");
+      // (3) atr_rollback
+      self->atr_rollback_complete(0, [self, cb](std::exception_ptr err) {
+        if (err) {
+          return cb(self->rollback_error(std::move(err)));
+        }
+        return cb({});
+      });
+    });
+}
+
+void
+attempt_context_impl::rollback()
+{
+  auto barrier = std::make_shared<std::promise<void>>();
+  auto f = barrier->get_future();
+  rollback([barrier](std::exception_ptr err) {
+    if (err) {
+      barrier->set_exception(err);
+    } else {
+      barrier->set_value();
+    }
+  });
+  f.get();
 }
 
 auto
@@ -2962,7 +3121,7 @@ attempt_context_impl::do_get(const core::document_id& id,
                                               doc->links().atr_scope_name().value(),
                                               doc->links().atr_collection_name().value(),
                                               doc->links().atr_id().value() };
-                active_transaction_record::get_atr(
+                self->overall_->cleanup().atr_lookups_ref().get_atr(
                   self->cluster_ref(),
                   doc_atr_id,
                   [self, id, allow_replica, doc, cb = std::move(cb)](
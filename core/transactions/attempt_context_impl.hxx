@@ -38,6 +38,7 @@
 #include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 // implemented in core::impl::query, to take advantage of the statics over there
 namespace couchbase::core
@@ -312,6 +313,10 @@ public:
     const core::document_id& id,
     std::function<void(std::exception_ptr, std::optional<transaction_get_result>)>&& cb) override;
 
+  auto get_multi(const std::vector<core::document_id>& ids)
+    -> std::vector<std::optional<transaction_get_result>> override;
+  void get_multi(const std::vector<core::document_id>& ids, MultiCallback&& cb) override;
+
   auto get_replica_from_preferred_server_group(const core::document_id& id)
     -> std::optional<transaction_get_result> override;
   void get_replica_from_preferred_server_group(
@@ -443,15 +448,22 @@ private:
   template<typename Handler>
   void check_if_done(Handler& cb);
 
+  /* blocking part of commit()/rollback(): runs the ATR phase and starts the asynchronous rest */
+  void start_commit(VoidCallback&& cb);
+
+  void start_rollback(VoidCallback&& cb);
+
   void atr_commit(bool ambiguity_resolution_mode);
 
   void atr_commit_ambiguity_resolution();
 
-  void atr_complete();
+  void atr_complete(VoidCallback&& cb);
 
   void atr_abort();
 
-  void atr_rollback_complete();
+  void atr_rollback_complete(std::size_t retries, VoidCallback&& cb);
+
+  auto rollback_error(std::exception_ptr err) -> std::exception_ptr;
 
   void select_atr_if_needed_unlocked(
     const core::document_id& id,
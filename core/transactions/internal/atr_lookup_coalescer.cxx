@@ -0,0 +1,117 @@
+/*
+ *     Copyright 2021-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "atr_lookup_coalescer.hxx"
+
+#include "logging.hxx"
+
+#include <fmt/core.h>
+
+#include <future>
+#include <stdexcept>
+
+namespace couchbase::core::transactions
+{
+auto
+atr_lookup_coalescer::make_key(const core::document_id& atr_id) -> std::string
+{
+  return fmt::format(
+    "{}/{}/{}/{}", atr_id.bucket(), atr_id.scope(), atr_id.collection(), atr_id.key());
+}
+
+void
+atr_lookup_coalescer::get_atr(const core::document_id& atr_id,
+                              fetch_function&& fetch,
+                              callback&& cb)
+{
+  auto key = make_key(atr_id);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.lookups;
+    auto [it, inserted] = pending_.try_emplace(key);
+    it->second.push_back({ std::move(cb), std::chrono::steady_clock::now(), !inserted });
+    if (!inserted) {
+      ++stats_.coalesced;
+      CB_TXN_LOG_TRACE("joining in-flight lookup of ATR {}", key);
+      return;
+    }
+  }
+  fetch([this, key](std::error_code ec, std::optional<active_transaction_record> atr) {
+    std::vector<waiter> waiters;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (auto it = pending_.find(key); it != pending_.end()) {
+        waiters = std::move(it->second);
+        pending_.erase(it);
+      }
+    }
+    auto now = std::chrono::steady_clock::now();
+    for (auto& waiter : waiters) {
+      if (const auto& recorder = waiter.coalesced ? coalesced_recorder_ : fetched_recorder_;
+          recorder) {
+        recorder->record_value(
+          std::chrono::duration_cast<std::chrono::microseconds>(now - waiter.start).count());
+      }
+      waiter.cb(ec, atr);
+    }
+  });
+}
+
+void
+atr_lookup_coalescer::get_atr(const core::cluster& cluster,
+                              const core::document_id& atr_id,
+                              callback&& cb)
+{
+  get_atr(
+    atr_id,
+    [&cluster, atr_id](callback&& on_response) {
+      active_transaction_record::get_atr(cluster, atr_id, std::move(on_response));
+    },
+    std::move(cb));
+}
+
+auto
+atr_lookup_coalescer::get_atr(const core::cluster& cluster, const core::document_id& atr_id)
+  -> std::optional<active_transaction_record>
+{
+  auto barrier = std::promise<std::optional<active_transaction_record>>();
+  auto f = barrier.get_future();
+  get_atr(cluster, atr_id, [&](std::error_code ec, std::optional<active_transaction_record> atr) {
+    if (!ec) {
+      return barrier.set_value(std::move(atr));
+    }
+    return barrier.set_exception(std::make_exception_ptr(std::runtime_error(ec.message())));
+  });
+  return f.get();
+}
+
+void
+atr_lookup_coalescer::set_recorders(std::shared_ptr<couchbase::metrics::value_recorder> fetched,
+                                    std::shared_ptr<couchbase::metrics::value_recorder> coalesced)
+{
+  fetched_recorder_ = std::move(fetched);
+  coalesced_recorder_ = std::move(coalesced);
+}
+
+auto
+atr_lookup_coalescer::stats() const -> atr_lookup_stats
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto stats = stats_;
+  stats.in_flight = pending_.size();
+  return stats;
+}
+} // namespace couchbase::core::transactions
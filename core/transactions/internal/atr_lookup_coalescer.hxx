@@ -0,0 +1,101 @@
+/*
+ *     Copyright 2021-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/transactions/active_transaction_record.hxx"
+#include "core/utils/movable_function.hxx"
+
+#include <couchbase/metrics/meter.hxx>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+namespace couchbase::core
+{
+class cluster;
+
+namespace transactions
+{
+struct atr_lookup_stats {
+  std::uint64_t lookups{};
+  std::uint64_t coalesced{};
+  std::size_t in_flight{};
+};
+
+/**
+ * Coalesces concurrent reads of the same ATR, shared by all attempts and the cleanup of one
+ * transactions instance.
+ *
+ * Conflicting transactions tend to read the same ATRs at the same time, while resolving staged
+ * documents or waiting for a blocking transaction. A read which finds a lookup of the ATR in
+ * flight waits for its response instead of sending another request. Responses are never kept once
+ * delivered, every read issued after that goes to the server again, so that the state of an
+ * attempt is never taken from a lookup which completed before the read was issued.
+ *
+ * Every read records how long it took (in microseconds) with the recorder matching its outcome,
+ * so that the meter reports the share of reads served by a lookup in flight.
+ */
+class atr_lookup_coalescer
+{
+public:
+  using callback = std::function<void(std::error_code, std::optional<active_transaction_record>)>;
+  using fetch_function = utils::movable_function<void(callback&&)>;
+
+  void get_atr(const core::cluster& cluster, const core::document_id& atr_id, callback&& cb);
+  auto get_atr(const core::cluster& cluster, const core::document_id& atr_id)
+    -> std::optional<active_transaction_record>;
+
+  /**
+   * Invokes fetch, unless a lookup of the same ATR is in flight already. In the latter case cb
+   * receives the response of the lookup in flight.
+   */
+  void get_atr(const core::document_id& atr_id, fetch_function&& fetch, callback&& cb);
+
+  [[nodiscard]] auto stats() const -> atr_lookup_stats;
+
+  /**
+   * Must be called before the first read.
+   */
+  void set_recorders(std::shared_ptr<couchbase::metrics::value_recorder> fetched,
+                     std::shared_ptr<couchbase::metrics::value_recorder> coalesced);
+
+private:
+  struct waiter {
+    callback cb;
+    std::chrono::steady_clock::time_point start;
+    bool coalesced;
+  };
+
+  static auto make_key(const core::document_id& atr_id) -> std::string;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::vector<waiter>> pending_{};
+  atr_lookup_stats stats_{};
+  std::shared_ptr<couchbase::metrics::value_recorder> fetched_recorder_{};
+  std::shared_ptr<couchbase::metrics::value_recorder> coalesced_recorder_{};
+};
+} // namespace transactions
+} // namespace couchbase::core
@@ -97,6 +97,10 @@ public:
 
   void after_delay(std::chrono::milliseconds delay, std::function<void()> fn);
 
+  /* runs fn in place, unless called from an IO thread, where blocking would stall the operations
+   * fn waits for. In that case it runs on a thread of its own. */
+  void run_blocking(std::function<void()> fn);
+
   [[nodiscard]] std::chrono::time_point<std::chrono::steady_clock> start_time_client() const
   {
     return start_time_client_;
@@ -150,6 +154,9 @@ public:
 
   void get_optional(const core::document_id& id, async_attempt_context::Callback&& cb);
 
+  void get_multi(const std::vector<core::document_id>& ids,
+                 async_attempt_context::MultiCallback&& cb);
+
   void insert(const core::document_id& id,
               codec::encoded_value content,
               async_attempt_context::Callback&& cb);
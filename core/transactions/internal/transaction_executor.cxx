@@ -0,0 +1,200 @@
+/*
+ *     Copyright 2021-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "transaction_executor.hxx"
+
+#include "logging.hxx"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace couchbase::core::transactions
+{
+namespace
+{
+/* the executor whose worker runs on the current thread, used to detect nested submissions */
+thread_local const void* current_executor_state{ nullptr };
+} // namespace
+
+struct transaction_executor::state {
+  state(std::size_t max_workers, std::size_t max_queued)
+    : max_workers{ std::max<std::size_t>(max_workers, 1) }
+    , max_queued{ max_queued }
+  {
+  }
+
+  const std::size_t max_workers;
+  const std::size_t max_queued;
+
+  mutable std::mutex mutex{};
+  std::condition_variable cv{};
+  struct queued_task {
+    task fn;
+    task cancel;
+  };
+
+  std::deque<queued_task> queue{};
+  std::vector<std::thread> workers{};
+  std::size_t idle{ 0 };
+  std::size_t running{ 0 };
+  std::size_t peak_queued{ 0 };
+  std::uint64_t submitted{ 0 };
+  std::uint64_t completed{ 0 };
+  std::uint64_t rejected{ 0 };
+  std::uint64_t canceled{ 0 };
+  bool closed{ false };
+};
+
+transaction_executor::transaction_executor(std::size_t max_workers, std::size_t max_queued)
+  : state_{ std::make_shared<state>(max_workers, max_queued) }
+{
+}
+
+transaction_executor::~transaction_executor()
+{
+  close();
+}
+
+namespace
+{
+void
+run_task(transaction_executor::task& fn)
+{
+  try {
+    fn();
+  } catch (const std::exception& e) {
+    CB_TXN_LOG_ERROR("async transaction task raised unexpected exception: {}", e.what());
+  } catch (...) {
+    CB_TXN_LOG_ERROR("async transaction task raised unexpected exception");
+  }
+}
+} // namespace
+
+auto
+transaction_executor::submit(task&& fn, task&& cancel) -> bool
+{
+  // a task may destroy the executor as soon as it is queued, keep the state alive until returning
+  auto state = state_;
+  std::unique_lock<std::mutex> lock(state->mutex);
+  if (state->closed) {
+    ++state->rejected;
+    return false;
+  }
+  if (current_executor_state == state.get()) {
+    // nested transaction, the worker would otherwise wait for a task queued behind itself
+    ++state->submitted;
+    lock.unlock();
+    run_task(fn);
+    lock.lock();
+    ++state->completed;
+    return true;
+  }
+  // free worker slots admit tasks on top of the queue limit
+  if (state->queue.size() >= state->max_queued + (state->max_workers - state->running)) {
+    ++state->rejected;
+    CB_TXN_LOG_DEBUG("rejecting async transaction: {} running, {} queued (limit {})",
+                     state->running,
+                     state->queue.size(),
+                     state->max_queued);
+    return false;
+  }
+  ++state->submitted;
+  state->queue.push_back({ std::move(fn), std::move(cancel) });
+  if (state->idle < state->queue.size() && state->workers.size() < state->max_workers) {
+    state->workers.emplace_back([state]() {
+      worker_loop(state);
+    });
+  }
+  state->peak_queued = std::max(state->peak_queued, state->queue.size());
+  lock.unlock();
+  state->cv.notify_one();
+  return true;
+}
+
+void
+transaction_executor::worker_loop(const std::shared_ptr<state>& state)
+{
+  current_executor_state = state.get();
+  std::unique_lock<std::mutex> lock(state->mutex);
+  while (true) {
+    ++state->idle;
+    state->cv.wait(lock, [&state]() {
+      return state->closed || !state->queue.empty();
+    });
+    --state->idle;
+    if (state->queue.empty()) {
+      // closed, the queued tasks have been canceled
+      current_executor_state = nullptr;
+      return;
+    }
+    auto fn = std::move(state->queue.front().fn);
+    state->queue.pop_front();
+    ++state->running;
+    lock.unlock();
+    run_task(fn);
+    lock.lock();
+    --state->running;
+    ++state->completed;
+  }
+}
+
+void
+transaction_executor::close()
+{
+  std::vector<std::thread> workers;
+  std::deque<state::queued_task> queued;
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->closed = true;
+    std::swap(workers, state_->workers);
+    std::swap(queued, state_->queue);
+    state_->canceled += queued.size();
+  }
+  state_->cv.notify_all();
+  if (!queued.empty()) {
+    CB_TXN_LOG_DEBUG("canceling {} queued async transactions", queued.size());
+  }
+  for (auto& item : queued) {
+    run_task(item.cancel);
+  }
+  for (auto& worker : workers) {
+    if (worker.joinable()) {
+      if (worker.get_id() == std::this_thread::get_id()) {
+        // closed from within a transaction callback, the worker keeps the state alive on its own
+        // and exits once the queue is drained
+        worker.detach();
+      } else {
+        worker.join();
+      }
+    }
+  }
+}
+
+auto
+transaction_executor::stats() const -> transaction_executor_stats
+{
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  return {
+    state_->max_workers, state_->workers.size(), state_->running,   state_->queue.size(),
+    state_->peak_queued, state_->submitted,      state_->completed, state_->rejected,
+    state_->canceled,
+  };
+}
+} // namespace couchbase::core::transactions
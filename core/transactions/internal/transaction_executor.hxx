@@ -0,0 +1,87 @@
+/*
+ *     Copyright 2021-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/utils/movable_function.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace couchbase::core::transactions
+{
+struct transaction_executor_stats {
+  std::size_t max_workers{};
+  std::size_t workers{};
+  std::size_t running{};
+  std::size_t queued{};
+  std::size_t peak_queued{};
+  std::uint64_t submitted{};
+  std::uint64_t completed{};
+  std::uint64_t rejected{};
+  std::uint64_t canceled{};
+};
+
+/**
+ * Bounded executor which drives asynchronous transactions.
+ *
+ * At most max_workers transactions run at any time; workers are spawned lazily as demand grows and
+ * are reused afterwards. Transactions which cannot run immediately are queued up to max_queued,
+ * beyond that submit() refuses them, so that the caller can fail fast instead of growing without
+ * bounds.
+ *
+ * A task submitted from one of the workers (a transaction which starts another one and waits for
+ * it) runs inline on that worker, as queueing it could leave every worker waiting for a task that
+ * no worker is free to run.
+ */
+class transaction_executor
+{
+public:
+  using task = utils::movable_function<void()>;
+
+  transaction_executor(std::size_t max_workers, std::size_t max_queued);
+  transaction_executor(const transaction_executor&) = delete;
+  transaction_executor(transaction_executor&&) = delete;
+  auto operator=(const transaction_executor&) -> transaction_executor& = delete;
+  auto operator=(transaction_executor&&) -> transaction_executor& = delete;
+  ~transaction_executor();
+
+  /**
+   * @param fn the task to run
+   * @param cancel invoked instead of the task, if the executor is closed while it is still queued
+   * @return false if the executor has been closed or the queue is full, the task is dropped then.
+   */
+  [[nodiscard]] auto submit(task&& fn, task&& cancel) -> bool;
+
+  /**
+   * Stops accepting new tasks, cancels the queued ones, waits for running tasks to complete and
+   * joins workers.
+   */
+  void close();
+
+  [[nodiscard]] auto stats() const -> transaction_executor_stats;
+
+private:
+  /* owned jointly by the executor and its workers, so that a worker detached by close() from
+   * within a task never touches the executor after it has been destroyed */
+  struct state;
+
+  static void worker_loop(const std::shared_ptr<state>& state);
+
+  std::shared_ptr<state> state_;
+};
+} // namespace couchbase::core::transactions
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "atr_lookup_coalescer.hxx"
 #include "atr_cleanup_entry.hxx"
 #include "client_record.hxx"
 #include "couchbase/transactions/transactions_config.hxx"
@@ -105,6 +106,12 @@ public:
     return config_;
   };
 
+  // reads of ATRs while resolving conflicts, shared by all attempts of the transactions instance
+  [[nodiscard]] atr_lookup_coalescer& atr_lookups_ref() const
+  {
+    return atr_lookups_;
+  }
+
   // Add an attempt cleanup later.
   void add_attempt(std::shared_ptr<attempt_context> ctx);
 
@@ -139,6 +146,7 @@ private:
   core::cluster cluster_;
   couchbase::transactions::transactions_config::built config_;
   const std::chrono::milliseconds cleanup_loop_delay_{ 100 };
+  mutable atr_lookup_coalescer atr_lookups_{};
 
   std::thread cleanup_thr_;
   atr_cleanup_queue atr_queue_;
@@ -33,37 +33,23 @@
 namespace couchbase::core::transactions
 {
 auto
-unstaging_state::wait_until_unstage_possible() -> bool
-{
-  std::unique_lock lock(mutex_);
-  auto success = cv_.wait_for(lock, ctx_->overall()->remaining(), [this] {
-    return (in_flight_count_ < MAX_PARALLELISM) || abort_;
-  });
-  if (!abort_) {
-    if (success) {
-      in_flight_count_++;
-    } else {
-      abort_ = true;
-    }
-  }
-  return !abort_;
-}
-
-void
-unstaging_state::notify_unstage_complete()
+staged_mutation_queue::document_id_ptr_hash::operator()(const core::document_id* id) const
+  -> std::size_t
 {
-  std::lock_guard lock(mutex_);
-  in_flight_count_--;
-  cv_.notify_one();
+  std::hash<std::string> hasher{};
+  auto seed = hasher(id->key());
+  for (const auto* part : { &id->collection(), &id->scope(), &id->bucket() }) {
+    seed ^= hasher(*part) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+  return seed;
 }
 
-void
-unstaging_state::notify_unstage_error()
+auto
+staged_mutation_queue::document_id_ptr_equal::operator()(const core::document_id* lhs,
+                                                         const core::document_id* rhs) const
+  -> bool
 {
-  std::lock_guard lock(mutex_);
-  abort_ = true;
-  in_flight_count_--;
-  cv_.notify_all();
+  return document_ids_equal(*lhs, *rhs);
 }
 
 auto
@@ -78,13 +64,9 @@ staged_mutation_queue::add(const staged_mutation& mutation)
 {
   std::lock_guard<std::mutex> lock(mutex_);
   // Can only have one staged mutation per document.
-  queue_.erase(std::remove_if(queue_.begin(),
-                              queue_.end(),
-                              [&mutation](const staged_mutation& item) {
-                                return document_ids_equal(item.id(), mutation.id());
-                              }),
-               queue_.end());
-  queue_.push_back(mutation);
+  remove_locked(mutation.id());
+  auto it = queue_.insert(queue_.end(), mutation);
+  index_.emplace(&it->id(), it);
 }
 
 void
@@ -132,63 +114,70 @@ staged_mutation_queue::extract_to(const std::string& prefix,
   req.specs.insert(req.specs.end(), specs.begin(), specs.end());
 }
 
+void
+staged_mutation_queue::remove_locked(const core::document_id& id)
+{
+  if (auto it = index_.find(&id); it != index_.end()) {
+    auto item = it->second;
+    index_.erase(it);
+    queue_.erase(item);
+  }
+}
+
+auto
+staged_mutation_queue::find_locked(const core::document_id& id) -> staged_mutation*
+{
+  if (auto it = index_.find(&id); it != index_.end()) {
+    return &*it->second;
+  }
+  return nullptr;
+}
+
+auto
+staged_mutation_queue::find_locked(const core::document_id& id, staged_mutation_type type)
+  -> staged_mutation*
+{
+  if (auto* item = find_locked(id); item != nullptr && item->type() == type) {
+    return item;
+  }
+  return nullptr;
+}
+
 void
 staged_mutation_queue::remove_any(const core::document_id& id)
 {
   const std::lock_guard<std::mutex> lock(mutex_);
-  auto new_end = std::remove_if(queue_.begin(), queue_.end(), [&id](const staged_mutation& item) {
-    return document_ids_equal(item.id(), id);
-  });
-  queue_.erase(new_end, queue_.end());
+  remove_locked(id);
 }
 
 auto
 staged_mutation_queue::find_any(const core::document_id& id) -> staged_mutation*
 {
   const std::lock_guard<std::mutex> lock(mutex_);
-  for (auto& item : queue_) {
-    if (document_ids_equal(item.doc().id(), id)) {
-      return &item;
-    }
-  }
-  return nullptr;
+  return find_locked(id);
 }
 
 auto
 staged_mutation_queue::find_replace(const core::document_id& id) -> staged_mutation*
 {
   std::lock_guard<std::mutex> lock(mutex_);
-  for (auto& item : queue_) {
-    if (item.type() == staged_mutation_type::REPLACE && document_ids_equal(item.doc().id(), id)) {
-      return &item;
-    }
-  }
-  return nullptr;
+  return find_locked(id, staged_mutation_type::REPLACE);
 }
 
 auto
 staged_mutation_queue::find_insert(const core::document_id& id) -> staged_mutation*
 {
   std::lock_guard<std::mutex> lock(mutex_);
-  for (auto& item : queue_) {
-    if (item.type() == staged_mutation_type::INSERT && document_ids_equal(item.doc().id(), id)) {
-      return &item;
-    }
-  }
-  return nullptr;
+  return find_locked(id, staged_mutation_type::INSERT);
 }
 
 auto
 staged_mutation_queue::find_remove(const core::document_id& id) -> staged_mutation*
 {
   std::lock_guard<std::mutex> lock(mutex_);
-  for (auto& item : queue_) {
-    if (item.type() == staged_mutation_type::REMOVE && document_ids_equal(item.doc().id(), id)) {
-      return &item;
-    }
-  }
-  return nullptr;
+  return find_locked(id, staged_mutation_type::REMOVE);
 }
+
 void
 staged_mutation_queue::iterate(std::function<void(staged_mutation&)> op)
 {
@@ -199,175 +188,153 @@ staged_mutation_queue::iterate(std::function<void(staged_mutation&)> op)
 }
 
 void
-staged_mutation_queue::commit(std::shared_ptr<attempt_context_impl> ctx)
+staged_mutation_queue::unstage_next(std::shared_ptr<unstaging_state> state)
 {
-  CB_ATTEMPT_CTX_LOG_TRACE(ctx, "committing staged mutations...");
-  std::lock_guard<std::mutex> lock(mutex_);
-
-  unstaging_state state{ ctx };
-  std::vector<std::future<void>> futures{};
-  futures.reserve(queue_.size());
-
-  bool aborted = false;
-
-  for (auto& item : queue_) {
-    aborted = !state.wait_until_unstage_possible();
-    if (aborted) {
-      // Do not commit any more mutations
+  std::unique_lock<std::mutex> lock(state->mutex_);
+  while (!state->abort_ && state->in_flight_ < state->window_ &&
+         state->next_ < state->items_.size()) {
+    if (state->next_ >= state->window_ && state->expired_()) {
+      // this mutation had to wait for a slot, and the transaction has expired meanwhile
+      CB_TXN_LOG_DEBUG("transaction expired while unstaging, {} of {} mutations not started",
+                       state->items_.size() - state->next_,
+                       state->items_.size());
+      state->abort_ = true;
       break;
     }
-
-    auto barrier = std::make_shared<std::promise<void>>();
-    auto future = barrier->get_future();
-
+    auto* item = state->items_[state->next_++];
+    ++state->in_flight_;
+    lock.unlock();
     try {
-      auto timer = std::make_shared<asio::steady_timer>(ctx->cluster_ref().io_context());
-      async_constant_delay delay(timer);
-
-      switch (item.type()) {
-        case staged_mutation_type::REMOVE:
-          remove_doc(ctx, item, delay, [&state, barrier](const std::exception_ptr& exc) {
-            if (exc) {
-              state.notify_unstage_error();
-              barrier->set_exception(exc);
-            } else {
-              state.notify_unstage_complete();
-              barrier->set_value();
-            }
-          });
-          break;
-        case staged_mutation_type::INSERT:
-        case staged_mutation_type::REPLACE:
-          commit_doc(ctx, item, delay, [&state, barrier](const std::exception_ptr& exc) {
-            if (exc) {
-              state.notify_unstage_error();
-              barrier->set_exception(exc);
-            } else {
-              state.notify_unstage_complete();
-              barrier->set_value();
-            }
-          });
-          break;
-      }
+      state->start_(*item, [this, state](std::exception_ptr exc) {
+        on_unstage_complete(state, std::move(exc));
+      });
     } catch (...) {
       // This should not happen, but catching it to ensure that we wait for in-flight operations
-      CB_ATTEMPT_CTX_LOG_ERROR(ctx,
-                               "caught exception while trying to initiate commit for {}. Aborting "
-                               "rest of commit and waiting for "
-                               "in-flight rollback operations to finish",
-                               item.doc().id());
-      aborted = true;
+      CB_TXN_LOG_ERROR("caught exception while trying to initiate unstaging for {}. Aborting "
+                       "rest of unstaging and waiting for in-flight operations to finish",
+                       item->doc().id());
+      lock.lock();
+      state->abort_ = true;
+      --state->in_flight_;
       break;
     }
-
-    futures.push_back(std::move(future));
+    lock.lock();
+  }
+  if (state->in_flight_ > 0 || state->done_ ||
+      (!state->abort_ && state->next_ < state->items_.size())) {
+    return;
   }
+  state->done_ = true;
+  std::exception_ptr exc = state->error_;
+  if (!exc && state->abort_) {
+    // no exception was raised from the operations, but unstaging has been aborted
+    exc = state->abort_error_;
+  }
+  auto callback = std::move(state->callback_);
+  lock.unlock();
+  callback(exc);
+}
 
-  std::exception_ptr exc{};
-  for (auto& future : futures) {
-    try {
-      future.get();
-    } catch (...) {
-      if (!exc) {
-        exc = std::current_exception();
+void
+staged_mutation_queue::on_unstage_complete(const std::shared_ptr<unstaging_state>& state,
+                                           std::exception_ptr exc)
+{
+  {
+    std::lock_guard<std::mutex> lock(state->mutex_);
+    --state->in_flight_;
+    if (exc) {
+      state->abort_ = true;
+      if (!state->error_) {
+        state->error_ = std::move(exc);
       }
     }
   }
-  if (exc) {
-    rethrow_exception(exc);
-  }
-  if (aborted) {
-    // Commit was aborted but no exception was raised from the futures (possibly timeout during
-    // wait_until_unstage_possible())
-    throw transaction_operation_failed(FAIL_OTHER, "commit aborted")
-      .no_rollback()
-      .failed_post_commit();
-  }
+  unstage_next(state);
 }
 
 void
-staged_mutation_queue::rollback(std::shared_ptr<attempt_context_impl> ctx)
+staged_mutation_queue::unstage(std::size_t window,
+                               unstaging_state::start_function&& start,
+                               utils::movable_function<bool()>&& expired,
+                               std::exception_ptr abort_error,
+                               utils::movable_function<void(std::exception_ptr)>&& cb)
 {
-  CB_ATTEMPT_CTX_LOG_TRACE(ctx, "rolling back staged mutations...");
-  std::lock_guard<std::mutex> lock(mutex_);
-
-  unstaging_state state{ ctx };
-  std::vector<std::future<void>> futures{};
-  futures.reserve(queue_.size());
-
-  bool aborted = false;
-
-  for (auto& item : queue_) {
-    aborted = !state.wait_until_unstage_possible();
-    if (aborted) {
-      // Do not roll back any more mutations
-      break;
+  auto state = std::make_shared<unstaging_state>();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    state->items_.reserve(queue_.size());
+    for (auto& item : queue_) {
+      state->items_.push_back(&item);
     }
+  }
+  state->window_ = std::max<std::size_t>(window, 1);
+  state->start_ = std::move(start);
+  state->expired_ = std::move(expired);
+  state->abort_error_ = std::move(abort_error);
+  state->callback_ = std::move(cb);
+  unstage_next(std::move(state));
+}
 
-    auto barrier = std::make_shared<std::promise<void>>();
-    auto future = barrier->get_future();
-
-    try {
-      auto timer = std::make_shared<asio::steady_timer>(ctx->cluster_ref().io_context());
-      async_exp_delay delay(timer);
-
-      switch (item.type()) {
-        case staged_mutation_type::INSERT:
-          rollback_insert(ctx, item, delay, [&state, barrier](const std::exception_ptr& exc) {
-            if (exc) {
-              state.notify_unstage_error();
-              barrier->set_exception(exc);
-            } else {
-              state.notify_unstage_complete();
-              barrier->set_value();
-            }
-          });
-          break;
-        case staged_mutation_type::REMOVE:
-        case staged_mutation_type::REPLACE:
-          rollback_remove_or_replace(ctx, item, delay, [&state, barrier](std::exception_ptr exc) {
-            if (exc) {
-              state.notify_unstage_error();
-              barrier->set_exception(exc);
-            } else {
-              state.notify_unstage_complete();
-              barrier->set_value();
-            }
-          });
-          break;
-      }
-    } catch (...) {
-      // This should not happen, but catching it to ensure that we wait for in-flight operations
-      CB_ATTEMPT_CTX_LOG_ERROR(ctx,
-                               "caught exception while trying to initiate rollback for {}. "
-                               "Aborting rollback and waiting for "
-                               "in-flight rollback operations to finish",
-                               item.doc().id());
-      aborted = true;
-      break;
+void
+staged_mutation_queue::commit(std::shared_ptr<attempt_context_impl> ctx,
+                              utils::movable_function<void(std::exception_ptr)>&& cb)
+{
+  CB_ATTEMPT_CTX_LOG_TRACE(ctx, "committing staged mutations...");
+  auto abort_error = std::make_exception_ptr(
+    transaction_operation_failed(FAIL_OTHER, "commit aborted").no_rollback().failed_post_commit());
+  auto start = [this, ctx](staged_mutation& item,
+                           utils::movable_function<void(std::exception_ptr)>&& callback) {
+    auto timer = std::make_shared<asio::steady_timer>(ctx->cluster_ref().io_context());
+    async_constant_delay delay(timer);
+
+    switch (item.type()) {
+      case staged_mutation_type::REMOVE:
+        return remove_doc(ctx, item, delay, std::move(callback));
+      case staged_mutation_type::INSERT:
+      case staged_mutation_type::REPLACE:
+        return commit_doc(ctx, item, delay, std::move(callback));
     }
+  };
+  auto window = ctx->overall()->config().max_parallel_unstaging;
+  unstage(
+    window,
+    std::move(start),
+    [ctx]() {
+      return ctx->overall()->has_expired_client_side();
+    },
+    std::move(abort_error),
+    std::move(cb));
+}
 
-    futures.push_back(std::move(future));
-  }
-
-  std::exception_ptr exc{};
-  for (auto& future : futures) {
-    try {
-      future.get();
-    } catch (...) {
-      if (!exc) {
-        exc = std::current_exception();
-      }
+void
+staged_mutation_queue::rollback(std::shared_ptr<attempt_context_impl> ctx,
+                                utils::movable_function<void(std::exception_ptr)>&& cb)
+{
+  CB_ATTEMPT_CTX_LOG_TRACE(ctx, "rolling back staged mutations...");
+  auto abort_error = std::make_exception_ptr(
+    transaction_operation_failed(FAIL_OTHER, "rollback aborted").no_rollback());
+  auto start = [this, ctx](staged_mutation& item,
+                           utils::movable_function<void(std::exception_ptr)>&& callback) {
+    auto timer = std::make_shared<asio::steady_timer>(ctx->cluster_ref().io_context());
+    async_exp_delay delay(timer);
+
+    switch (item.type()) {
+      case staged_mutation_type::INSERT:
+        return rollback_insert(ctx, item, delay, std::move(callback));
+      case staged_mutation_type::REMOVE:
+      case staged_mutation_type::REPLACE:
+        return rollback_remove_or_replace(ctx, item, delay, std::move(callback));
     }
-  }
-  if (exc) {
-    rethrow_exception(exc);
-  }
-  if (aborted) {
-    // Rollback was aborted but no exception was raised from the futures (possibly timeout during
-    // wait_until_unstage_possible())
-    throw transaction_operation_failed(FAIL_OTHER, "rollback aborted").no_rollback();
-  }
+  };
+  auto window = ctx->overall()->config().max_parallel_unstaging;
+  unstage(
+    window,
+    std::move(start),
+    [ctx]() {
+      return ctx->overall()->has_expired_client_side();
+    },
+    std::move(abort_error),
+    std::move(cb));
 }
 
 void
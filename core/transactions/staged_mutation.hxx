@@ -23,8 +23,10 @@
 #include "transaction_get_result.hxx"
 #include "uid_generator.hxx"
 
+#include <list>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace couchbase::core::transactions
@@ -124,25 +126,59 @@ public:
   }
 };
 
+/**
+ * State of commit or rollback of the staged mutations.
+ *
+ * Mutations are unstaged in the staging order, at most window_ of them are in flight. Every
+ * completion starts the next mutation, so no thread is blocked while unstaging. Mutations which
+ * had to wait for a free slot are not started once the transaction has expired.
+ */
 struct unstaging_state {
-  static const size_t MAX_PARALLELISM = 1000;
+  using start_function = utils::movable_function<void(
+    staged_mutation&, utils::movable_function<void(std::exception_ptr)>&&)>;
+
+  std::vector<staged_mutation*> items_{};
+  std::size_t window_{ 1 };
+  start_function start_{};
+  utils::movable_function<bool()> expired_{};
+  utils::movable_function<void(std::exception_ptr)> callback_{};
+  std::exception_ptr abort_error_{};
 
-  std::shared_ptr<attempt_context_impl> ctx_;
   std::mutex mutex_{};
-  std::condition_variable cv_{};
-  std::atomic_size_t in_flight_count_{ 0 };
+  std::size_t next_{ 0 };
+  std::size_t in_flight_{ 0 };
   bool abort_{ false };
-
-  auto wait_until_unstage_possible() -> bool;
-  void notify_unstage_complete();
-  void notify_unstage_error();
+  bool done_{ false };
+  std::exception_ptr error_{};
 };
 
 class staged_mutation_queue
 {
 private:
+  struct document_id_ptr_hash {
+    auto operator()(const core::document_id* id) const -> std::size_t;
+  };
+  struct document_id_ptr_equal {
+    auto operator()(const core::document_id* lhs, const core::document_id* rhs) const -> bool;
+  };
+
   std::mutex mutex_;
-  std::vector<staged_mutation> queue_;
+  // list keeps the order in which mutations have been staged (and have to be unstaged), while the
+  // index allows lookups of own writes without scanning the whole transaction. Keys point to ids of
+  // the list elements, which are stable.
+  std::list<staged_mutation> queue_;
+  std::unordered_map<const core::document_id*,
+                     std::list<staged_mutation>::iterator,
+                     document_id_ptr_hash,
+                     document_id_ptr_equal>
+    index_;
+
+  auto find_locked(const core::document_id& id) -> staged_mutation*;
+  auto find_locked(const core::document_id& id, staged_mutation_type type) -> staged_mutation*;
+  void remove_locked(const core::document_id& id);
+
+  void unstage_next(std::shared_ptr<unstaging_state> state);
+  void on_unstage_complete(const std::shared_ptr<unstaging_state>& state, std::exception_ptr exc);
 
   using client_error_handler = utils::movable_function<void(const std::optional<client_error>&)>;
 
@@ -210,8 +246,22 @@ public:
   auto empty() -> bool;
   void add(const staged_mutation& mutation);
   void extract_to(const std::string& prefix, core::operations::mutate_in_request& req);
-  void commit(std::shared_ptr<attempt_context_impl> ctx);
-  void rollback(std::shared_ptr<attempt_context_impl> ctx);
+  void commit(std::shared_ptr<attempt_context_impl> ctx,
+              utils::movable_function<void(std::exception_ptr)>&& cb);
+  void rollback(std::shared_ptr<attempt_context_impl> ctx,
+                utils::movable_function<void(std::exception_ptr)>&& cb);
+  /**
+   * Starts every staged mutation with @p start, keeping at most @p window of them in flight.
+   *
+   * Once @p expired returns true, mutations waiting for a free slot are not started and
+   * unstaging is aborted with @p abort_error. @p cb is invoked after all started mutations have
+   * completed, with the first error if there was one.
+   */
+  void unstage(std::size_t window,
+               unstaging_state::start_function&& start,
+               utils::movable_function<bool()>&& expired,
+               std::exception_ptr abort_error,
+               utils::movable_function<void(std::exception_ptr)>&& cb);
   void iterate(std::function<void(staged_mutation&)>);
   void remove_any(const core::document_id&);
 
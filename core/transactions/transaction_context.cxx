@@ -25,6 +25,8 @@
 #include <asio/post.hpp>
 #include <asio/steady_timer.hpp>
 
+#include <thread>
+
 namespace couchbase::core::transactions
 {
 
@@ -122,6 +124,16 @@ transaction_context::after_delay(std::chrono::milliseconds delay, std::function<
   });
 }
 
+void
+transaction_context::run_blocking(std::function<void()> fn)
+{
+  if (transactions_.cluster_ref().io_context().get_executor().running_in_this_thread()) {
+    std::thread(std::move(fn)).detach();
+    return;
+  }
+  fn();
+}
+
 void
 transaction_context::new_attempt_context(async_attempt_context::VoidCallback&& cb)
 {
@@ -168,6 +180,16 @@ transaction_context::get_optional(const core::document_id& id, async_attempt_con
   throw transaction_operation_failed(FAIL_OTHER, "no current attempt context");
 }
 
+void
+transaction_context::get_multi(const std::vector<core::document_id>& ids,
+                               async_attempt_context::MultiCallback&& cb)
+{
+  if (current_attempt_context_) {
+    return current_attempt_context_->get_multi(ids, std::move(cb));
+  }
+  throw transaction_operation_failed(FAIL_OTHER, "no current attempt context");
+}
+
 void
 transaction_context::insert(const core::document_id& id,
                             codec::encoded_value content,
@@ -346,7 +368,10 @@ transaction_context::finalize(txn_complete_callback&& cb)
     }
     commit([self = shared_from_this(), cb = std::move(cb)](std::exception_ptr err) mutable {
       if (err) {
-        return self->handle_error(std::move(err), std::move(cb));
+        // the commit completes on an IO thread, and handling the error may roll back synchronously
+        return self->run_blocking([self, err = std::move(err), cb = std::move(cb)]() mutable {
+          self->handle_error(std::move(err), std::move(cb));
+        });
       }
       cb(std::nullopt, self->get_transaction_result());
     });
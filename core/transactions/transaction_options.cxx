@@ -36,7 +36,10 @@ transaction_options::apply(const transactions_config::built& conf) const
            cleanup_hooks_ ? cleanup_hooks_ : conf.cleanup_hooks,
            metadata_collection_ ? metadata_collection_ : conf.metadata_collection,
            query_config,
-           conf.cleanup_config };
+           conf.cleanup_config,
+           conf.max_concurrent_async_transactions,
+           conf.max_queued_async_transactions,
+           conf.max_parallel_unstaging };
 }
 
 auto
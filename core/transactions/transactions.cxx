@@ -24,6 +24,7 @@
 #include "internal/exceptions_internal.hxx"
 #include "internal/logging.hxx"
 #include "internal/transaction_context.hxx"
+#include "internal/transaction_executor.hxx"
 #include "internal/transactions_cleanup.hxx"
 #include "internal/utils.hxx"
 
@@ -44,6 +45,8 @@ transactions::transactions(core::cluster cluster,
   : cluster_(std::move(cluster))
   , config_(config)
   , cleanup_(new transactions_cleanup(cluster_, config_))
+  , executor_(new transaction_executor(config_.max_concurrent_async_transactions,
+                                       config_.max_queued_async_transactions))
 {
 }
 
@@ -207,34 +210,72 @@ transactions::run(couchbase::transactions::txn_logic&& code,
   }
 }
 
+namespace
+{
+auto
+executor_rejected_exception(transactions& txns,
+                            const couchbase::transactions::transaction_options& config,
+                            const std::string& reason = "too many queued asynchronous transactions")
+  -> transaction_exception
+{
+  auto overall = transaction_context::create(txns, config);
+  return *transaction_operation_failed(FAIL_OTHER, reason).no_rollback().get_final_exception(
+    *overall);
+}
+
+constexpr auto executor_closed_reason{ "transactions closed before the transaction could start" };
+} // namespace
+
 void
 transactions::run(const couchbase::transactions::transaction_options& config,
                   async_logic&& code,
                   txn_complete_callback&& cb)
 {
-  std::thread([this, config, code = std::move(code), cb = std::move(cb)]() {
-    try {
-      auto result = wrap_run(*this, config, max_attempts_, std::move(code));
-      return cb({}, result);
-    } catch (const transaction_exception& e) {
-      return cb(e, std::nullopt);
-    }
-  }).detach();
+  auto shared_cb = std::make_shared<txn_complete_callback>(std::move(cb));
+  auto submitted = executor_->submit(
+    [this, config, code = std::move(code), shared_cb]() mutable {
+      try {
+        auto result = wrap_run(*this, config, max_attempts_, std::move(code));
+        return (*shared_cb)({}, result);
+      } catch (const transaction_exception& e) {
+        return (*shared_cb)(e, std::nullopt);
+      }
+    },
+    [this, config, shared_cb]() {
+      return (*shared_cb)(executor_rejected_exception(*this, config, executor_closed_reason),
+                          std::nullopt);
+    });
+  if (!submitted) {
+    return (*shared_cb)(executor_rejected_exception(*this, config), std::nullopt);
+  }
 }
+
 void
 transactions::run(couchbase::transactions::async_txn_logic&& code,
                   couchbase::transactions::async_txn_complete_logic&& cb,
                   const couchbase::transactions::transaction_options& config)
 {
-  std::thread([this, config, code = std::move(code), cb = std::move(cb)]() {
-    try {
-      auto result = wrap_public_api_run(*this, config, max_attempts_, std::move(code));
-      return cb({}, result);
-    } catch (const transaction_exception& e) {
-      auto [ctx, res] = e.get_transaction_result();
-      return cb(core::impl::make_error(ctx), res);
-    }
-  }).detach();
+  auto shared_cb =
+    std::make_shared<couchbase::transactions::async_txn_complete_logic>(std::move(cb));
+  auto submitted = executor_->submit(
+    [this, config, code = std::move(code), shared_cb]() mutable {
+      try {
+        auto result = wrap_public_api_run(*this, config, max_attempts_, std::move(code));
+        return (*shared_cb)({}, result);
+      } catch (const transaction_exception& e) {
+        auto [ctx, res] = e.get_transaction_result();
+        return (*shared_cb)(core::impl::make_error(ctx), res);
+      }
+    },
+    [this, config, shared_cb]() {
+      auto [ctx, res] =
+        executor_rejected_exception(*this, config, executor_closed_reason).get_transaction_result();
+      return (*shared_cb)(core::impl::make_error(ctx), res);
+    });
+  if (!submitted) {
+    auto [ctx, res] = executor_rejected_exception(*this, config).get_transaction_result();
+    return (*shared_cb)(core::impl::make_error(ctx), res);
+  }
 }
 
 void
@@ -254,10 +295,17 @@ transactions::notify_fork(fork_event event)
   }
 }
 
+auto
+transactions::async_executor_stats() const -> transaction_executor_stats
+{
+  return executor_->stats();
+}
+
 void
 transactions::close()
 {
   CB_TXN_LOG_DEBUG("closing transactions");
+  executor_->close();
   cleanup_->close();
   CB_TXN_LOG_DEBUG("transactions closed");
 }
@@ -49,6 +49,11 @@ transactions_cleanup::transactions_cleanup(
   , config_(config)
   , client_uuid_(uid_generator::next())
 {
+  if (auto meter = cluster_.meter(); meter) {
+    const std::string name{ "db.couchbase.transactions.atr_lookup" };
+    atr_lookups_.set_recorders(meter->get_value_recorder(name, { { "outcome", "fetched" } }),
+                               meter->get_value_recorder(name, { { "outcome", "coalesced" } }));
+  }
   start();
 }
 
@@ -652,6 +657,10 @@ transactions_cleanup::close()
   stop();
   CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("all lost attempt cleanup threads closed");
   remove_client_record_from_all_buckets(client_uuid_);
+  auto stats = atr_lookups_.stats();
+  CB_TXN_LOG_DEBUG("ATR lookups: {}, coalesced with lookups in flight: {}",
+                   stats.lookups,
+                   stats.coalesced);
 }
 
 transactions_cleanup::~transactions_cleanup()
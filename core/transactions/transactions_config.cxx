@@ -42,6 +42,9 @@ transactions_config::transactions_config(transactions_config&& c) noexcept
   , metadata_collection_(std::move(c.metadata_collection_))
   , query_config_(c.query_config_)
   , cleanup_config_(std::move(c.cleanup_config_))
+  , max_concurrent_async_transactions_(c.max_concurrent_async_transactions_)
+  , max_queued_async_transactions_(c.max_queued_async_transactions_)
+  , max_parallel_unstaging_(c.max_parallel_unstaging_)
 {
 }
 
@@ -55,6 +58,9 @@ transactions_config::transactions_config(const transactions_config& config)
   , metadata_collection_(config.metadata_collection())
   , query_config_(config.query_config())
   , cleanup_config_(config.cleanup_config())
+  , max_concurrent_async_transactions_(config.max_concurrent_async_transactions())
+  , max_queued_async_transactions_(config.max_queued_async_transactions())
+  , max_parallel_unstaging_(config.max_parallel_unstaging())
 {
 }
 
@@ -69,6 +75,9 @@ transactions_config::operator=(const transactions_config& c) -> transactions_con
     query_config_ = c.query_config_;
     metadata_collection_ = c.metadata_collection_;
     cleanup_config_ = c.cleanup_config_;
+    max_concurrent_async_transactions_ = c.max_concurrent_async_transactions_;
+    max_queued_async_transactions_ = c.max_queued_async_transactions_;
+    max_parallel_unstaging_ = c.max_parallel_unstaging_;
   }
   return *this;
 }
@@ -82,7 +91,10 @@ transactions_config::build() const -> transactions_config::built
            cleanup_hooks_,
            metadata_collection_,
            query_config_.build(),
-           cleanup_config_.build() };
+           cleanup_config_.build(),
+           max_concurrent_async_transactions_,
+           max_queued_async_transactions_,
+           max_parallel_unstaging_ };
 }
 
 } // namespace couchbase::transactions
@@ -0,0 +1,105 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "concurrency_limiter.hxx"
+
+#include <algorithm>
+
+namespace couchbase::core::utils
+{
+concurrency_limiter::concurrency_limiter(options config)
+  : options_{ config }
+{
+  options_.min_limit = std::max<std::size_t>(options_.min_limit, 1);
+  options_.max_limit = std::max(options_.max_limit, options_.min_limit);
+  limit_ = static_cast<double>(
+    std::clamp(options_.initial_limit, options_.min_limit, options_.max_limit));
+}
+
+auto
+concurrency_limiter::try_acquire() -> bool
+{
+  if (in_flight_ >= limit()) {
+    return false;
+  }
+  ++in_flight_;
+  return true;
+}
+
+void
+concurrency_limiter::on_success(std::chrono::microseconds latency)
+{
+  const auto utilized = 2 * in_flight_ >= limit();
+  on_ignored();
+  ++samples_since_decrease_;
+
+  const auto sample = static_cast<double>(latency.count());
+  if (long_latency_ == 0) {
+    short_latency_ = sample;
+    long_latency_ = sample;
+  } else {
+    short_latency_ += (sample - short_latency_) / short_window;
+    long_latency_ += (sample - long_latency_) / long_window;
+  }
+
+  if (short_latency_ > options_.latency_tolerance * long_latency_) {
+    return decrease();
+  }
+  if (utilized) {
+    limit_ = std::min(limit_ + 1, static_cast<double>(options_.max_limit));
+  }
+}
+
+void
+concurrency_limiter::on_dropped()
+{
+  on_ignored();
+  ++samples_since_decrease_;
+  decrease();
+}
+
+void
+concurrency_limiter::on_ignored()
+{
+  if (in_flight_ > 0) {
+    --in_flight_;
+  }
+}
+
+void
+concurrency_limiter::decrease()
+{
+  if (static_cast<double>(samples_since_decrease_) < limit_) {
+    return;
+  }
+  samples_since_decrease_ = 0;
+  limit_ = std::max(limit_ * options_.backoff_ratio, static_cast<double>(options_.min_limit));
+}
+
+auto
+concurrency_limiter::limit() const -> std::size_t
+{
+  return static_cast<std::size_t>(limit_);
+}
+
+auto
+concurrency_limiter::in_flight() const -> std::size_t
+{
+  return in_flight_;
+}
+} // namespace couchbase::core::utils
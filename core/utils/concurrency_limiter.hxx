@@ -0,0 +1,85 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace couchbase::core::utils
+{
+/**
+ * Adaptive limit of requests in flight to a single node (additive increase, multiplicative
+ * decrease).
+ *
+ * While the limit is actually used, every successful response raises it by one. It shrinks by
+ * backoff_ratio when a request times out or the server reports a temporary failure, or when the
+ * short-term average latency exceeds latency_tolerance times the long-term one. The limit
+ * shrinks at most once per window of `limit` completions, so a burst of slow responses, that
+ * were all sent before the node slowed down, counts as a single signal.
+ *
+ * The limiter is not thread-safe, the owner is expected to serialize access to it.
+ */
+class concurrency_limiter
+{
+public:
+  struct options {
+    std::size_t initial_limit{ 512 };
+    std::size_t min_limit{ 16 };
+    std::size_t max_limit{ 8'192 };
+    double latency_tolerance{ 2.0 };
+    double backoff_ratio{ 0.9 };
+  };
+
+  explicit concurrency_limiter(options config);
+
+  /**
+   * @return true if the request may be sent, and then one of on_success(), on_dropped() or
+   * on_ignored() must be called once it completes
+   */
+  [[nodiscard]] auto try_acquire() -> bool;
+
+  void on_success(std::chrono::microseconds latency);
+
+  /**
+   * The request has timed out or has been rejected by the overloaded node.
+   */
+  void on_dropped();
+
+  /**
+   * The request did not reach the node or was canceled, so it says nothing about the node.
+   */
+  void on_ignored();
+
+  [[nodiscard]] auto limit() const -> std::size_t;
+  [[nodiscard]] auto in_flight() const -> std::size_t;
+
+private:
+  void decrease();
+
+  static constexpr double short_window{ 16 };
+  static constexpr double long_window{ 512 };
+
+  options options_;
+  double limit_;
+  std::size_t in_flight_{ 0 };
+  std::size_t samples_since_decrease_{ 0 };
+  double short_latency_{ 0 };
+  double long_latency_{ 0 };
+};
+} // namespace couchbase::core::utils
@@ -320,6 +320,33 @@ parse_option(std::chrono::milliseconds& receiver,
   }
 }
 
+void
+parse_option(std::chrono::microseconds& receiver,
+             const std::string& name,
+             const std::string& value,
+             std::vector<std::string>& warnings)
+{
+  try {
+    receiver = std::chrono::duration_cast<std::chrono::microseconds>(parse_duration(value));
+  } catch (const duration_parse_error&) {
+    try {
+      receiver = std::chrono::microseconds(std::stoull(value, nullptr, 10));
+    } catch (const std::invalid_argument& ex1) {
+      warnings.push_back(fmt::format(
+        R"(unable to parse "{}" parameter in connection string (value "{}" is not a number): {})",
+        name,
+        value,
+        ex1.what()));
+    } catch (const std::out_of_range& ex2) {
+      warnings.push_back(fmt::format(
+        R"(unable to parse "{}" parameter in connection string (value "{}" is out of range): {})",
+        name,
+        value,
+        ex2.what()));
+    }
+  }
+}
+
 static void
 extract_options(connection_string& connstr)
 {
@@ -420,6 +447,38 @@ extract_options(connection_string& connstr)
        * The period of time an HTTP connection can be idle before it is forcefully disconnected.
        */
       parse_option(connstr.options.idle_http_connection_timeout, name, value, connstr.warnings);
+    } else if (name == "write_coalescing_window") {
+      /**
+       * The period of time KV requests are gathered into a single socket write (plain numbers are
+       * microseconds). Zero disables coalescing.
+       */
+      parse_option(connstr.options.write_coalescing_window, name, value, connstr.warnings);
+    } else if (name == "write_coalescing_threshold") {
+      /**
+       * The number of buffered bytes that triggers the write before the coalescing window closes.
+       */
+      parse_option(connstr.options.write_coalescing_threshold, name, value, connstr.warnings);
+    } else if (name == "enable_kv_concurrency_limit") {
+      /**
+       * Whether to adapt the number of KV requests in flight to every node to its latency.
+       */
+      parse_option(connstr.options.enable_kv_concurrency_limit, name, value, connstr.warnings);
+    } else if (name == "kv_initial_concurrency_limit") {
+      /**
+       * The number of KV requests in flight to a node, that the adaptive limit starts from.
+       */
+      parse_option(connstr.options.kv_initial_concurrency_limit, name, value, connstr.warnings);
+    } else if (name == "kv_max_concurrency_limit") {
+      /**
+       * The number of KV requests in flight to a node, that the adaptive limit never exceeds.
+       */
+      parse_option(connstr.options.kv_max_concurrency_limit, name, value, connstr.warnings);
+    } else if (name == "kv_max_queued_requests") {
+      /**
+       * The number of KV requests waiting for the node, when it has reached its limit. Zero
+       * rejects such requests immediately.
+       */
+      parse_option(connstr.options.kv_max_queued_requests, name, value, connstr.warnings);
     } else if (name == "bootstrap_timeout") {
       /**
        * The period of time allocated to complete bootstrap
@@ -0,0 +1,74 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace couchbase::core::utils
+{
+/**
+ * Limits the share of hedged reads that are allowed to send the second request.
+ *
+ * Both counters are halved once the number of reads reaches the window, so the budget follows
+ * the recent traffic and the hedges spent during an old spike do not block new ones forever.
+ */
+class hedge_budget
+{
+public:
+  static constexpr std::uint64_t window{ 1'024 };
+
+  explicit hedge_budget(double max_ratio)
+    : max_ratio_{ max_ratio }
+  {
+  }
+
+  void record_read()
+  {
+    if (reads_.fetch_add(1, std::memory_order_relaxed) + 1 < window) {
+      return;
+    }
+    auto reads = reads_.load(std::memory_order_relaxed);
+    if (reads >= window &&
+        reads_.compare_exchange_strong(reads, reads / 2, std::memory_order_relaxed)) {
+      hedges_.store(hedges_.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+    }
+  }
+
+  [[nodiscard]] auto try_acquire() -> bool
+  {
+    if (max_ratio_ <= 0) {
+      return false;
+    }
+    const auto allowed = max_ratio_ * static_cast<double>(reads_.load(std::memory_order_relaxed));
+    auto hedges = hedges_.load(std::memory_order_relaxed);
+    do {
+      if (static_cast<double>(hedges) > allowed) {
+        return false;
+      }
+    } while (!hedges_.compare_exchange_weak(hedges, hedges + 1, std::memory_order_relaxed));
+    return true;
+  }
+
+private:
+  const double max_ratio_;
+  std::atomic_uint64_t reads_{ 0 };
+  std::atomic_uint64_t hedges_{ 0 };
+};
+} // namespace couchbase::core::utils
@@ -17,11 +17,17 @@
 
 #include "json.hxx"
 
+#include <couchbase/codec/tao_json_streaming_serializer.hxx>
+
 #include <tao/json.hpp>
 #include <tao/json/contrib/traits.hpp>
 
 #include <gsl/span>
 
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
 namespace couchbase::core::utils::json
 {
 /**
@@ -86,208 +92,217 @@ generate(const tao::json::value& object) -> std::string
   return tao::json::to_string(object);
 }
 
-class to_byte_vector
+to_byte_vector::to_byte_vector(std::vector<std::byte>& output) noexcept
+  : buffer_(output)
 {
-private:
-  std::vector<std::byte>& buffer_;
-  bool first_{ true };
-
-  void next()
-  {
-    if (!first_) {
-      buffer_.emplace_back(std::byte{ ',' });
-    }
-  }
+}
 
-  void write(tao::binary_view data)
-  {
-    buffer_.reserve(buffer_.size() + data.size());
-    buffer_.insert(buffer_.end(), data.begin(), data.end());
+void
+to_byte_vector::next()
+{
+  if (!first_) {
+    buffer_.emplace_back(std::byte{ ',' });
   }
+}
 
-  void write(std::string_view data)
-  {
-    buffer_.reserve(buffer_.size() + data.size());
-    const auto* begin = reinterpret_cast<const std::byte*>(data.data());
-    buffer_.insert(buffer_.end(), begin, begin + data.size());
-  }
+void
+to_byte_vector::write(tao::binary_view data)
+{
+  buffer_.reserve(buffer_.size() + data.size());
+  buffer_.insert(buffer_.end(), data.begin(), data.end());
+}
 
-  inline void escape(const std::string_view s)
-  {
-    static std::array h{
-      std::byte{ '0' }, std::byte{ '1' }, std::byte{ '2' }, std::byte{ '3' },
-      std::byte{ '4' }, std::byte{ '5' }, std::byte{ '6' }, std::byte{ '7' },
-      std::byte{ '8' }, std::byte{ '9' }, std::byte{ 'a' }, std::byte{ 'b' },
-      std::byte{ 'c' }, std::byte{ 'd' }, std::byte{ 'e' }, std::byte{ 'f' },
-    };
+void
+to_byte_vector::write(std::string_view data)
+{
+  buffer_.reserve(buffer_.size() + data.size());
+  const auto* begin = reinterpret_cast<const std::byte*>(data.data());
+  buffer_.insert(buffer_.end(), begin, begin + data.size());
+}
 
-    const char* p = s.data();
-    const char* l = p;
-    const char* const e = p + s.size();
-    while (p != e) {
-      const char c = *p;
-      if (c == '\\' || c == '"') {
-        write({ l, static_cast<std::size_t>(p - l) });
-        l = ++p;
-        buffer_.emplace_back(std::byte{ '\\' });
-        buffer_.emplace_back(static_cast<std::byte>(c));
-      } else if (static_cast<std::uint8_t>(c) < 32 || c == 127) {
-        write({ l, static_cast<std::size_t>(p - l) });
-        l = ++p;
-        switch (c) {
-          case '\b':
-            write("\\b");
-            break;
-          case '\f':
-            write("\\f");
-            break;
-          case '\n':
-            write("\\n");
-            break;
-          case '\r':
-            write("\\r");
-            break;
-          case '\t':
-            write("\\t");
-            break;
-          default:
-            write(std::array{
-              std::byte{ '\\' },
-              std::byte{ 'u' },
-              std::byte{ '0' },
-              std::byte{ '0' },
-              std::byte{ h[(c & 0xf0) >> 4] },
-              std::byte{ h[c & 0x0f] },
-            });
-        }
-      } else {
-        ++p;
+void
+to_byte_vector::escape(const std::string_view s)
+{
+  static std::array h{
+    std::byte{ '0' }, std::byte{ '1' }, std::byte{ '2' }, std::byte{ '3' },
+    std::byte{ '4' }, std::byte{ '5' }, std::byte{ '6' }, std::byte{ '7' },
+    std::byte{ '8' }, std::byte{ '9' }, std::byte{ 'a' }, std::byte{ 'b' },
+    std::byte{ 'c' }, std::byte{ 'd' }, std::byte{ 'e' }, std::byte{ 'f' },
+  };
+
+  const char* p = s.data();
+  const char* l = p;
+  const char* const e = p + s.size();
+  while (p != e) {
+    const char c = *p;
+    if (c == '\\' || c == '"') {
+      write({ l, static_cast<std::size_t>(p - l) });
+      l = ++p;
+      buffer_.emplace_back(std::byte{ '\\' });
+      buffer_.emplace_back(static_cast<std::byte>(c));
+    } else if (static_cast<std::uint8_t>(c) < 32 || c == 127) {
+      write({ l, static_cast<std::size_t>(p - l) });
+      l = ++p;
+      switch (c) {
+        case '\b':
+          write("\\b");
+          break;
+        case '\f':
+          write("\\f");
+          break;
+        case '\n':
+          write("\\n");
+          break;
+        case '\r':
+          write("\\r");
+          break;
+        case '\t':
+          write("\\t");
+          break;
+        default:
+          write(std::array{
+            std::byte{ '\\' },
+            std::byte{ 'u' },
+            std::byte{ '0' },
+            std::byte{ '0' },
+            std::byte{ h[(c & 0xf0) >> 4] },
+            std::byte{ h[c & 0x0f] },
+          });
       }
+    } else {
+      ++p;
     }
-    write({ l, static_cast<std::size_t>(p - l) });
   }
+  write({ l, static_cast<std::size_t>(p - l) });
+}
 
-public:
-  explicit to_byte_vector(std::vector<std::byte>& output) noexcept
-    : buffer_(output)
-  {
-  }
+void
+to_byte_vector::null()
+{
+  next();
+  static std::array literal_null{
+    std::byte{ 'n' },
+    std::byte{ 'u' },
+    std::byte{ 'l' },
+    std::byte{ 'l' },
+  };
+  write(literal_null);
+}
 
-  void null()
-  {
-    next();
-    static std::array literal_null{
-      std::byte{ 'n' },
+void
+to_byte_vector::boolean(const bool v)
+{
+  next();
+  if (v) {
+    static std::array literal_true{
+      std::byte{ 't' },
+      std::byte{ 'r' },
       std::byte{ 'u' },
-      std::byte{ 'l' },
-      std::byte{ 'l' },
+      std::byte{ 'e' },
     };
-    write(literal_null);
-  }
-
-  void boolean(const bool v)
-  {
-    next();
-    if (v) {
-      static std::array literal_true{
-        std::byte{ 't' },
-        std::byte{ 'r' },
-        std::byte{ 'u' },
-        std::byte{ 'e' },
-      };
-      write(literal_true);
-    } else {
-      static std::array literal_false{
-        std::byte{ 'f' }, std::byte{ 'a' }, std::byte{ 'l' }, std::byte{ 's' }, std::byte{ 'e' },
-      };
-      write(literal_false);
-    }
+    write(literal_true);
+  } else {
+    static std::array literal_false{
+      std::byte{ 'f' }, std::byte{ 'a' }, std::byte{ 'l' }, std::byte{ 's' }, std::byte{ 'e' },
+    };
+    write(literal_false);
   }
+}
 
-  void number(const std::int64_t v)
-  {
-    next();
-    char b[24]{};
-    const char* s = tao::json::itoa::i64toa(v, b);
-    write({ b, static_cast<std::size_t>(s - b) });
-  }
+void
+to_byte_vector::number(const std::int64_t v)
+{
+  next();
+  char b[24]{};
+  const char* s = tao::json::itoa::i64toa(v, b);
+  write({ b, static_cast<std::size_t>(s - b) });
+}
 
-  void number(const std::uint64_t v)
-  {
-    next();
-    char b[24]{};
-    const char* s = tao::json::itoa::u64toa(v, b);
-    write({ b, static_cast<std::size_t>(s - b) });
-  }
+void
+to_byte_vector::number(const std::uint64_t v)
+{
+  next();
+  char b[24]{};
+  const char* s = tao::json::itoa::u64toa(v, b);
+  write({ b, static_cast<std::size_t>(s - b) });
+}
 
-  void number(const double v)
-  {
-    next();
-    if (!std::isfinite(v)) {
-      // if this throws, consider using non_finite_to_* transformers
-      throw std::runtime_error("non-finite double value invalid for JSON string representation");
-    }
-    char b[28];
-    const auto s = tao::json::ryu::d2s_finite(v, b);
-    write({ b, s });
+void
+to_byte_vector::number(const double v)
+{
+  next();
+  if (!std::isfinite(v)) {
+    // if this throws, consider using non_finite_to_* transformers
+    throw std::runtime_error("non-finite double value invalid for JSON string representation");
   }
+  char b[28];
+  const auto s = tao::json::ryu::d2s_finite(v, b);
+  write({ b, s });
+}
 
-  void string(const std::string_view v)
-  {
-    next();
-    buffer_.emplace_back(std::byte{ '"' });
-    escape(v);
-    buffer_.emplace_back(std::byte{ '"' });
-  }
+void
+to_byte_vector::string(const std::string_view v)
+{
+  next();
+  buffer_.emplace_back(std::byte{ '"' });
+  escape(v);
+  buffer_.emplace_back(std::byte{ '"' });
+}
 
-  void binary(
-    const tao::binary_view /*unused*/) // NOLINT(readability-convert-member-functions-to-static)
-  {
-    // if this throws, consider using binary_to_* transformers
-    throw std::runtime_error("binary data invalid for JSON string representation");
-  }
+void
+to_byte_vector::binary(const tao::binary_view /* v */)
+{
+  // if this throws, consider using binary_to_* transformers
+  throw std::runtime_error("binary data invalid for JSON string representation");
+}
 
-  void begin_array(const std::size_t /*unused*/ = 0)
-  {
-    next();
-    buffer_.emplace_back(std::byte{ '[' });
-    first_ = true;
-  }
+void
+to_byte_vector::begin_array(const std::size_t /* size */)
+{
+  next();
+  buffer_.emplace_back(std::byte{ '[' });
+  first_ = true;
+}
 
-  void element() noexcept
-  {
-    first_ = false;
-  }
+void
+to_byte_vector::element() noexcept
+{
+  first_ = false;
+}
 
-  void end_array(const std::size_t /*unused*/ = 0)
-  {
-    buffer_.emplace_back(std::byte{ ']' });
-  }
+void
+to_byte_vector::end_array(const std::size_t /* size */)
+{
+  buffer_.emplace_back(std::byte{ ']' });
+}
 
-  void begin_object(const std::size_t /*unused*/ = 0)
-  {
-    next();
-    buffer_.emplace_back(std::byte{ '{' });
-    first_ = true;
-  }
+void
+to_byte_vector::begin_object(const std::size_t /* size */)
+{
+  next();
+  buffer_.emplace_back(std::byte{ '{' });
+  first_ = true;
+}
 
-  void key(const std::string_view v)
-  {
-    string(v);
-    buffer_.emplace_back(std::byte{ ':' });
-    first_ = true;
-  }
+void
+to_byte_vector::key(const std::string_view v)
+{
+  string(v);
+  buffer_.emplace_back(std::byte{ ':' });
+  first_ = true;
+}
 
-  void member() noexcept
-  {
-    first_ = false;
-  }
+void
+to_byte_vector::member() noexcept
+{
+  first_ = false;
+}
 
-  void end_object(const std::size_t /*unused*/ = 0)
-  {
-    buffer_.emplace_back(std::byte{ '}' });
-  }
-};
+void
+to_byte_vector::end_object(const std::size_t /* size */)
+{
+  buffer_.emplace_back(std::byte{ '}' });
+}
 
 auto
 generate_binary(const tao::json::value& object) -> std::vector<std::byte>
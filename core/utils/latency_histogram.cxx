@@ -0,0 +1,101 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "latency_histogram.hxx"
+
+#include <algorithm>
+#include <cmath>
+
+namespace couchbase::core::utils
+{
+namespace
+{
+constexpr std::uint64_t sub_bucket_count{ 4 };
+
+auto
+bucket_index(std::uint64_t value) -> std::size_t
+{
+  if (value < sub_bucket_count) {
+    return static_cast<std::size_t>(value);
+  }
+  std::size_t msb = 0;
+  while ((value >> (msb + 1)) != 0) {
+    ++msb;
+  }
+  // the two bits after the most significant one select the sub-bucket
+  auto sub_bucket = (value >> (msb - 2)) & (sub_bucket_count - 1);
+  return (msb - 1) * sub_bucket_count + static_cast<std::size_t>(sub_bucket);
+}
+
+auto
+bucket_upper_bound(std::size_t index) -> std::uint64_t
+{
+  if (index < sub_bucket_count) {
+    return index;
+  }
+  const auto msb = index / sub_bucket_count + 1;
+  const auto sub_bucket = index % sub_bucket_count;
+  return ((sub_bucket_count + sub_bucket + 1) << (msb - 2)) - 1;
+}
+} // namespace
+
+void
+latency_histogram::record(std::chrono::microseconds latency)
+{
+  const auto value = static_cast<std::uint64_t>(std::max<std::int64_t>(latency.count(), 0));
+  buckets_[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+  if (count_.fetch_add(1, std::memory_order_relaxed) + 1 < decay_threshold) {
+    return;
+  }
+  if (decaying_.exchange(true, std::memory_order_acquire)) {
+    return;
+  }
+  std::uint64_t remaining = 0;
+  for (auto& bucket : buckets_) {
+    auto current = bucket.load(std::memory_order_relaxed);
+    bucket.fetch_sub(current / 2, std::memory_order_relaxed);
+    remaining += current - current / 2;
+  }
+  count_.store(remaining, std::memory_order_relaxed);
+  decaying_.store(false, std::memory_order_release);
+}
+
+auto
+latency_histogram::percentile(double fraction) const -> std::chrono::microseconds
+{
+  std::array<std::uint64_t, number_of_buckets> snapshot{};
+  std::uint64_t total = 0;
+  for (std::size_t i = 0; i < number_of_buckets; ++i) {
+    snapshot[i] = buckets_[i].load(std::memory_order_relaxed);
+    total += snapshot[i];
+  }
+  if (total == 0) {
+    return std::chrono::microseconds::zero();
+  }
+  const auto target = std::max<std::uint64_t>(
+    1, static_cast<std::uint64_t>(std::ceil(fraction * static_cast<double>(total))));
+  std::uint64_t cumulative = 0;
+  for (std::size_t i = 0; i < number_of_buckets; ++i) {
+    cumulative += snapshot[i];
+    if (cumulative >= target) {
+      return std::chrono::microseconds{ bucket_upper_bound(i) };
+    }
+  }
+  return std::chrono::microseconds{ bucket_upper_bound(number_of_buckets - 1) };
+}
+} // namespace couchbase::core::utils
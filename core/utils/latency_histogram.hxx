@@ -0,0 +1,70 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace couchbase::core::utils
+{
+/**
+ * Histogram of operation latencies, that can be updated from many threads without locks.
+ *
+ * Buckets are logarithmic with four sub-buckets per power of two, so that percentiles are
+ * accurate within 25%. Once the histogram accumulates decay_threshold samples, all counters are
+ * halved, so the percentiles follow the recent behavior of the node.
+ */
+class latency_histogram
+{
+public:
+  static constexpr std::uint64_t decay_threshold{ 4'096 };
+
+  latency_histogram() = default;
+  latency_histogram(const latency_histogram&) = delete;
+  latency_histogram(latency_histogram&&) = delete;
+  auto operator=(const latency_histogram&) -> latency_histogram& = delete;
+  auto operator=(latency_histogram&&) -> latency_histogram& = delete;
+  ~latency_histogram() = default;
+
+  void record(std::chrono::microseconds latency);
+
+  [[nodiscard]] auto count() const -> std::uint64_t
+  {
+    return count_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @param fraction requested percentile, for example 0.95
+   * @return upper bound of the bucket, that contains the percentile, or zero if the histogram is
+   * empty
+   */
+  [[nodiscard]] auto percentile(double fraction) const -> std::chrono::microseconds;
+
+private:
+  static constexpr std::size_t sub_buckets_bits{ 2 };
+  static constexpr std::size_t number_of_buckets{ 64U << sub_buckets_bits };
+
+  std::array<std::atomic_uint64_t, number_of_buckets> buckets_{};
+  std::atomic_uint64_t count_{ 0 };
+  std::atomic_bool decaying_{ false };
+};
+} // namespace couchbase::core::utils
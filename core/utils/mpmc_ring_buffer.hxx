@@ -0,0 +1,127 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace couchbase::core::utils
+{
+/**
+ * Bounded multi-producer/multi-consumer queue, which does not take locks (D. Vyukov's algorithm).
+ *
+ * The capacity is rounded up to the power of two. When the buffer is full, try_push() fails
+ * instead of blocking, so that the caller can account the dropped item.
+ */
+template<typename T>
+class mpmc_ring_buffer
+{
+public:
+  explicit mpmc_ring_buffer(std::size_t capacity)
+    : mask_{ round_up_to_power_of_two(capacity) - 1 }
+    , cells_{ std::make_unique<cell[]>(mask_ + 1) }
+  {
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  mpmc_ring_buffer(const mpmc_ring_buffer&) = delete;
+  mpmc_ring_buffer(mpmc_ring_buffer&&) = delete;
+  auto operator=(const mpmc_ring_buffer&) -> mpmc_ring_buffer& = delete;
+  auto operator=(mpmc_ring_buffer&&) -> mpmc_ring_buffer& = delete;
+  ~mpmc_ring_buffer() = default;
+
+  [[nodiscard]] auto capacity() const -> std::size_t
+  {
+    return mask_ + 1;
+  }
+
+  auto try_push(T&& value) -> bool
+  {
+    cell* target{ nullptr };
+    auto position = enqueue_position_.load(std::memory_order_relaxed);
+    while (true) {
+      target = &cells_[position & mask_];
+      auto sequence = target->sequence.load(std::memory_order_acquire);
+      auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+      if (difference == 0) {
+        if (enqueue_position_.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = enqueue_position_.load(std::memory_order_relaxed);
+      }
+    }
+    target->value = std::move(value);
+    target->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  auto try_pop(T& value) -> bool
+  {
+    cell* source{ nullptr };
+    auto position = dequeue_position_.load(std::memory_order_relaxed);
+    while (true) {
+      source = &cells_[position & mask_];
+      auto sequence = source->sequence.load(std::memory_order_acquire);
+      auto difference =
+        static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+      if (difference == 0) {
+        if (dequeue_position_.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = dequeue_position_.load(std::memory_order_relaxed);
+      }
+    }
+    value = std::move(source->value);
+    source->value = T{};
+    source->sequence.store(position + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  struct cell {
+    std::atomic_size_t sequence{ 0 };
+    T value{};
+  };
+
+  static auto round_up_to_power_of_two(std::size_t value) -> std::size_t
+  {
+    std::size_t result = 2;
+    while (result < value) {
+      result <<= 1U;
+    }
+    return result;
+  }
+
+  std::size_t mask_;
+  std::unique_ptr<cell[]> cells_;
+  alignas(64) std::atomic_size_t enqueue_position_{ 0 };
+  alignas(64) std::atomic_size_t dequeue_position_{ 0 };
+};
+} // namespace couchbase::core::utils
@@ -0,0 +1,177 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace couchbase::core::utils
+{
+namespace priv
+{
+/**
+ * Process-wide cache of memory blocks of the same type, shared by all threads.
+ *
+ * KV commands are usually created on the application thread and released on an IO thread, so the
+ * cache has to be shared for the blocks to come back. It is a bounded lock-free MPMC queue
+ * (sequence numbers per cell avoid the ABA problem of a linked free list). Blocks which do not fit
+ * are returned to the system allocator.
+ */
+template<typename T, std::size_t Capacity>
+class shared_free_list
+{
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "capacity of the free list must be a power of two");
+
+public:
+  static auto instance() -> shared_free_list&
+  {
+    // never destroyed, blocks might be released by other static objects during shutdown
+    static auto* list = new shared_free_list();
+    return *list;
+  }
+
+  shared_free_list()
+  {
+    for (std::size_t i = 0; i < Capacity; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  shared_free_list(const shared_free_list&) = delete;
+  shared_free_list(shared_free_list&&) = delete;
+  auto operator=(const shared_free_list&) -> shared_free_list& = delete;
+  auto operator=(shared_free_list&&) -> shared_free_list& = delete;
+  ~shared_free_list() = default;
+
+  auto pop() -> T*
+  {
+    auto position = pop_position_.load(std::memory_order_relaxed);
+    while (true) {
+      auto& cell = cells_[position & (Capacity - 1)];
+      auto sequence = cell.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+      if (diff == 0) {
+        if (pop_position_.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed)) {
+          auto* block = cell.block;
+          cell.sequence.store(position + Capacity, std::memory_order_release);
+          return block;
+        }
+      } else if (diff < 0) {
+        return nullptr; // empty
+      } else {
+        position = pop_position_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  auto push(T* block) -> bool
+  {
+    auto position = push_position_.load(std::memory_order_relaxed);
+    while (true) {
+      auto& cell = cells_[position & (Capacity - 1)];
+      auto sequence = cell.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+      if (diff == 0) {
+        if (push_position_.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed)) {
+          cell.block = block;
+          cell.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false; // full
+      } else {
+        position = push_position_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+private:
+  struct cell {
+    std::atomic_size_t sequence{ 0 };
+    T* block{ nullptr };
+  };
+
+  std::array<cell, Capacity> cells_{};
+  alignas(64) std::atomic_size_t push_position_{ 0 };
+  alignas(64) std::atomic_size_t pop_position_{ 0 };
+};
+} // namespace priv
+
+/**
+ * Allocator for std::allocate_shared(), which recycles single-object allocations through a free
+ * list shared by all threads instead of going to the heap for every object.
+ *
+ * Intended for short-lived objects created at high rates, like KV commands, where the control
+ * block and the object have a fixed size.
+ */
+template<typename T, std::size_t Capacity = 1024>
+class pooled_allocator
+{
+public:
+  using value_type = T;
+
+  template<typename U>
+  struct rebind {
+    using other = pooled_allocator<U, Capacity>;
+  };
+
+  pooled_allocator() noexcept = default;
+
+  template<typename U>
+  pooled_allocator(const pooled_allocator<U, Capacity>& /* other */) noexcept
+  {
+  }
+
+  [[nodiscard]] auto allocate(std::size_t n) -> T*
+  {
+    if (n == 1) {
+      if (auto* block = priv::shared_free_list<T, Capacity>::instance().pop();
+          block != nullptr) {
+        return block;
+      }
+    }
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T* block, std::size_t n) noexcept
+  {
+    if (n == 1 && priv::shared_free_list<T, Capacity>::instance().push(block)) {
+      return;
+    }
+    std::allocator<T>{}.deallocate(block, n);
+  }
+
+  template<typename U>
+  auto operator==(const pooled_allocator<U, Capacity>& /* other */) const noexcept -> bool
+  {
+    return true;
+  }
+
+  template<typename U>
+  auto operator!=(const pooled_allocator<U, Capacity>& /* other */) const noexcept -> bool
+  {
+    return false;
+  }
+};
+} // namespace couchbase::core::utils
@@ -0,0 +1,316 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "telemetry_sink.hxx"
+
+#include "core/logger/logger.hxx"
+#include "core/utils/movable_function.hxx"
+
+#include <asio/connect.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/post.hpp>
+#include <asio/read.hpp>
+#include <asio/steady_timer.hpp>
+#include <asio/strand.hpp>
+#include <asio/streambuf.hpp>
+#include <asio/write.hpp>
+
+#include <fmt/chrono.h>
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <istream>
+
+namespace couchbase::core::utils
+{
+file_telemetry_sink::file_telemetry_sink(const std::string& path, std::size_t max_pending_batches)
+  : max_pending_batches_{ std::max<std::size_t>(max_pending_batches, 1) }
+  , output_{ path, std::ios::out | std::ios::app }
+  , writer_{ [this]() {
+    run();
+  } }
+{
+}
+
+file_telemetry_sink::~file_telemetry_sink()
+{
+  {
+    std::scoped_lock lock(mutex_);
+    stopped_ = true;
+  }
+  cv_.notify_one();
+  writer_.join();
+}
+
+void
+file_telemetry_sink::write(telemetry_batch&& batch)
+{
+  {
+    std::scoped_lock lock(mutex_);
+    if (pending_.size() >= max_pending_batches_) {
+      pending_.pop_front();
+      ++dropped_batches_;
+    }
+    pending_.emplace_back(std::move(batch));
+  }
+  cv_.notify_one();
+}
+
+auto
+file_telemetry_sink::dropped_batches() const -> std::size_t
+{
+  std::scoped_lock lock(mutex_);
+  return dropped_batches_;
+}
+
+void
+file_telemetry_sink::run()
+{
+  std::unique_lock lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [this]() {
+      return stopped_ || !pending_.empty();
+    });
+    if (pending_.empty()) {
+      // stopped, and everything has been written
+      return;
+    }
+    std::deque<telemetry_batch> batches{};
+    std::swap(batches, pending_);
+    lock.unlock();
+    for (const auto& batch : batches) {
+      output_ << batch.payload << '\n';
+    }
+    output_.flush();
+    lock.lock();
+  }
+}
+
+namespace
+{
+auto
+content_type(telemetry_format format) -> const char*
+{
+  switch (format) {
+    case telemetry_format::otlp_json:
+      return "application/json";
+    case telemetry_format::prometheus_text:
+      return "text/plain; version=0.0.4";
+  }
+  return "application/octet-stream";
+}
+
+class http_telemetry_request : public std::enable_shared_from_this<http_telemetry_request>
+{
+public:
+  http_telemetry_request(asio::io_context& ctx,
+                         std::string hostname,
+                         std::uint16_t port,
+                         std::string request,
+                         std::chrono::milliseconds timeout,
+                         utils::movable_function<void()>&& handler)
+    : strand_{ asio::make_strand(ctx) }
+    , resolver_{ strand_ }
+    , socket_{ strand_ }
+    , deadline_{ strand_ }
+    , hostname_{ std::move(hostname) }
+    , port_{ port }
+    , request_{ std::move(request) }
+    , timeout_{ timeout }
+    , handler_{ std::move(handler) }
+  {
+  }
+
+  void start()
+  {
+    asio::post(strand_, [self = shared_from_this()]() {
+      self->deadline_.expires_after(self->timeout_);
+      self->deadline_.async_wait([self](std::error_code ec) {
+        if (ec == asio::error::operation_aborted) {
+          return;
+        }
+        // the pending resolve, connect, write or read completes with operation_aborted
+        self->timed_out_ = true;
+        self->resolver_.cancel();
+        std::error_code ignored;
+        self->socket_.close(ignored);
+      });
+      self->resolve();
+    });
+  }
+
+private:
+  void resolve()
+  {
+    resolver_.async_resolve(
+      hostname_,
+      std::to_string(port_),
+      [self = shared_from_this()](std::error_code ec,
+                                  const asio::ip::tcp::resolver::results_type& endpoints) {
+        if (ec) {
+          return self->finish(ec);
+        }
+        asio::async_connect(
+          self->socket_,
+          endpoints,
+          [self](std::error_code connect_ec, const asio::ip::tcp::endpoint& /* endpoint */) {
+            if (connect_ec) {
+              return self->finish(connect_ec);
+            }
+            self->send();
+          });
+      });
+  }
+
+  void send()
+  {
+    asio::async_write(socket_,
+                      asio::buffer(request_),
+                      [self = shared_from_this()](std::error_code ec, std::size_t /* bytes */) {
+                        if (ec) {
+                          return self->finish(ec);
+                        }
+                        // the request asks to close the connection, so the response ends at EOF
+                        asio::async_read(self->socket_,
+                                         self->response_,
+                                         [self](std::error_code read_ec, std::size_t /* bytes */) {
+                                           if (read_ec && read_ec != asio::error::eof) {
+                                             return self->finish(read_ec);
+                                           }
+                                           self->finish({});
+                                         });
+                      });
+  }
+
+  void finish(std::error_code ec)
+  {
+    if (!handler_) {
+      return;
+    }
+    deadline_.cancel();
+    if (timed_out_) {
+      CB_LOG_DEBUG(
+        "unable to export telemetry to {}:{}: timed out after {}", hostname_, port_, timeout_);
+    } else if (ec) {
+      CB_LOG_DEBUG("unable to export telemetry to {}:{}: {}", hostname_, port_, ec.message());
+    } else {
+      std::istream response(&response_);
+      std::string http_version;
+      unsigned int status_code{ 0 };
+      response >> http_version >> status_code;
+      if (status_code < 200 || status_code >= 300) {
+        CB_LOG_DEBUG(
+          "telemetry collector at {}:{} rejected the batch, status={}", hostname_, port_, status_code);
+      }
+    }
+    std::error_code ignored;
+    socket_.close(ignored);
+    auto handler = std::move(handler_);
+    handler();
+  }
+
+  asio::strand<asio::io_context::executor_type> strand_;
+  asio::ip::tcp::resolver resolver_;
+  asio::ip::tcp::socket socket_;
+  asio::steady_timer deadline_;
+  std::string hostname_;
+  std::uint16_t port_;
+  std::string request_;
+  std::chrono::milliseconds timeout_;
+  bool timed_out_{ false };
+  asio::streambuf response_{};
+  utils::movable_function<void()> handler_;
+};
+} // namespace
+
+http_telemetry_sink::http_telemetry_sink(asio::io_context& ctx,
+                                         http_telemetry_sink_options options)
+  : ctx_{ ctx }
+  , options_{ std::move(options) }
+{
+}
+
+void
+http_telemetry_sink::write(telemetry_batch&& batch)
+{
+  {
+    std::scoped_lock lock(mutex_);
+    pending_.emplace_back(std::move(batch));
+    while (pending_.size() > options_.max_pending_batches) {
+      pending_.pop_front();
+      ++dropped_batches_;
+    }
+    if (sending_) {
+      return;
+    }
+    sending_ = true;
+  }
+  send_next();
+}
+
+auto
+http_telemetry_sink::dropped_batches() const -> std::size_t
+{
+  std::scoped_lock lock(mutex_);
+  return dropped_batches_;
+}
+
+void
+http_telemetry_sink::send_next()
+{
+  telemetry_batch batch{};
+  {
+    std::scoped_lock lock(mutex_);
+    if (pending_.empty()) {
+      sending_ = false;
+      return;
+    }
+    batch = std::move(pending_.front());
+    pending_.pop_front();
+  }
+  const auto& path =
+    batch.signal == telemetry_signal::metrics ? options_.metrics_path : options_.traces_path;
+  auto request = fmt::format("POST {} HTTP/1.1\r\n"
+                             "Host: {}:{}\r\n"
+                             "Content-Type: {}\r\n"
+                             "Content-Length: {}\r\n"
+                             "Connection: close\r\n"
+                             "\r\n"
+                             "{}",
+                             path,
+                             options_.hostname,
+                             options_.port,
+                             content_type(batch.format),
+                             batch.payload.size(),
+                             batch.payload);
+  std::make_shared<http_telemetry_request>(ctx_,
+                                           options_.hostname,
+                                           options_.port,
+                                           std::move(request),
+                                           options_.timeout,
+                                           [self = shared_from_this()]() {
+                                             self->on_sent();
+                                           })
+    ->start();
+}
+
+void
+http_telemetry_sink::on_sent()
+{
+  send_next();
+}
+} // namespace couchbase::core::utils
@@ -0,0 +1,150 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <asio/io_context.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace couchbase::core::utils
+{
+enum class telemetry_signal {
+  metrics,
+  traces,
+};
+
+enum class telemetry_format {
+  /**
+   * OTLP/HTTP with JSON encoding
+   */
+  otlp_json,
+
+  /**
+   * Prometheus text exposition format (metrics only)
+   */
+  prometheus_text,
+};
+
+struct telemetry_batch {
+  telemetry_signal signal{ telemetry_signal::metrics };
+  telemetry_format format{ telemetry_format::otlp_json };
+  std::string payload{};
+};
+
+/**
+ * Destination of the batches produced by the exporting meter and tracer. The exporters call
+ * write() from their flush timers, never from the operation path.
+ */
+class telemetry_sink
+{
+public:
+  telemetry_sink() = default;
+  telemetry_sink(const telemetry_sink&) = delete;
+  telemetry_sink(telemetry_sink&&) = delete;
+  auto operator=(const telemetry_sink&) -> telemetry_sink& = delete;
+  auto operator=(telemetry_sink&&) -> telemetry_sink& = delete;
+  virtual ~telemetry_sink() = default;
+
+  virtual void write(telemetry_batch&& batch) = 0;
+};
+
+/**
+ * Appends every batch to the file, followed by the new line.
+ *
+ * The file is written by a dedicated thread, so that the flush timers of the exporters (which
+ * run on the IO threads) never block on the disk. When the disk falls behind, the oldest pending
+ * batches are dropped. Pending batches are written before the destructor returns.
+ */
+class file_telemetry_sink : public telemetry_sink
+{
+public:
+  explicit file_telemetry_sink(const std::string& path, std::size_t max_pending_batches = 16);
+  file_telemetry_sink(const file_telemetry_sink&) = delete;
+  file_telemetry_sink(file_telemetry_sink&&) = delete;
+  auto operator=(const file_telemetry_sink&) -> file_telemetry_sink& = delete;
+  auto operator=(file_telemetry_sink&&) -> file_telemetry_sink& = delete;
+  ~file_telemetry_sink() override;
+
+  void write(telemetry_batch&& batch) override;
+
+  [[nodiscard]] auto dropped_batches() const -> std::size_t;
+
+private:
+  void run();
+
+  const std::size_t max_pending_batches_;
+  std::ofstream output_;
+  mutable std::mutex mutex_{};
+  std::condition_variable cv_{};
+  std::deque<telemetry_batch> pending_{};
+  std::size_t dropped_batches_{ 0 };
+  bool stopped_{ false };
+  std::thread writer_;
+};
+
+struct http_telemetry_sink_options {
+  std::string hostname{ "localhost" };
+  std::uint16_t port{ 4318 };
+  std::string metrics_path{ "/v1/metrics" };
+  std::string traces_path{ "/v1/traces" };
+  /**
+   * Batches waiting for delivery, the oldest ones are dropped when the collector is slow.
+   */
+  std::size_t max_pending_batches{ 16 };
+  /**
+   * Time allowed for resolving, connecting, sending the batch and reading the response. The
+   * connection is closed and the batch is dropped when it expires.
+   */
+  std::chrono::milliseconds timeout{ std::chrono::seconds{ 10 } };
+};
+
+/**
+ * POSTs every batch to the OTLP/HTTP collector (or the Prometheus push gateway). Batches are sent
+ * one at a time on the io_context, each over its own connection.
+ */
+class http_telemetry_sink
+  : public telemetry_sink
+  , public std::enable_shared_from_this<http_telemetry_sink>
+{
+public:
+  http_telemetry_sink(asio::io_context& ctx, http_telemetry_sink_options options);
+
+  void write(telemetry_batch&& batch) override;
+
+  [[nodiscard]] auto dropped_batches() const -> std::size_t;
+
+private:
+  void send_next();
+  void on_sent();
+
+  asio::io_context& ctx_;
+  const http_telemetry_sink_options options_;
+  mutable std::mutex mutex_{};
+  std::deque<telemetry_batch> pending_{};
+  bool sending_{ false };
+  std::size_t dropped_batches_{ 0 };
+};
+} // namespace couchbase::core::utils
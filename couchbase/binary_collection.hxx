@@ -21,6 +21,9 @@
 #include <couchbase/decrement_options.hxx>
 #include <couchbase/error.hxx>
 #include <couchbase/increment_options.hxx>
+#include <couchbase/large_object_options.hxx>
+#include <couchbase/large_object_reader.hxx>
+#include <couchbase/large_object_writer.hxx>
 #include <couchbase/prepend_options.hxx>
 
 #include <future>
@@ -248,6 +251,57 @@ public:
   [[nodiscard]] auto decrement(std::string document_id, const decrement_options& options) const
     -> std::future<std::pair<error, counter_result>>;
 
+  /**
+   * Starts writing a large binary object, which is stored as a manifest document under the given
+   * id plus the chunk documents it refers to. Nothing is sent until the first chunk is complete.
+   *
+   * @param document_id the document id of the manifest.
+   * @param options custom options to customize the chunking.
+   * @return the writer to stream the object into.
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto open_writer(std::string document_id,
+                                 const large_object_options& options) const -> large_object_writer;
+
+  /**
+   * Fetches the manifest of a large binary object written by @ref open_writer() and returns the
+   * reader for its chunks.
+   *
+   * @param document_id the document id of the manifest.
+   * @param options custom options to customize the prefetching.
+   * @param handler callable that implements @ref large_object_open_handler
+   *
+   * @exception errc::key_value::document_not_found the given document id is not found in the
+   * collection.
+   * @exception errc::common::decoding_failure the document is not a large object manifest.
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  void open_reader(std::string document_id,
+                   const large_object_options& options,
+                   large_object_open_handler&& handler) const;
+
+  /**
+   * Fetches the manifest of a large binary object written by @ref open_writer() and returns the
+   * reader for its chunks.
+   *
+   * @param document_id the document id of the manifest.
+   * @param options custom options to customize the prefetching.
+   * @return future object that carries result of the operation
+   *
+   * @exception errc::key_value::document_not_found the given document id is not found in the
+   * collection.
+   * @exception errc::common::decoding_failure the document is not a large object manifest.
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto open_reader(std::string document_id, const large_object_options& options) const
+    -> std::future<std::pair<error, large_object_reader>>;
+
 private:
   friend class collection;
 
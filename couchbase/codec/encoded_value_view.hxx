@@ -0,0 +1,149 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include <couchbase/codec/encoded_value.hxx>
+
+#include <cinttypes>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace couchbase::codec
+{
+/**
+ * Read-only view of the document contents, that shares ownership of the buffer it points to.
+ *
+ * The view stays valid as long as the view itself, one of its copies, or the handle returned by
+ * @ref owner() is alive, so it can be handed over to asynchronous writers without copying bytes.
+ *
+ * @since 1.0.0
+ * @uncommitted
+ */
+class encoded_value_view
+{
+public:
+  encoded_value_view() = default;
+
+  /**
+   * @param owner lifetime handle of the memory, might be empty if the memory is borrowed
+   * @param data pointer to the first byte of the value
+   * @param size number of bytes in the value
+   * @param flags flags describing structure of the value
+   *
+   * @since 1.0.0
+   * @internal
+   */
+  encoded_value_view(std::shared_ptr<const void> owner,
+                     const std::byte* data,
+                     std::size_t size,
+                     std::uint32_t flags)
+    : owner_{ std::move(owner) }
+    , data_{ data }
+    , size_{ size }
+    , flags_{ flags }
+  {
+  }
+
+  /**
+   * @return pointer to the first byte of the value
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto data() const -> const std::byte*
+  {
+    return data_;
+  }
+
+  /**
+   * @return number of bytes in the value
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto size() const -> std::size_t
+  {
+    return size_;
+  }
+
+  /**
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto empty() const -> bool
+  {
+    return size_ == 0;
+  }
+
+  /**
+   * @return flags describing structure of the value (see @ref codec_flags)
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto flags() const -> std::uint32_t
+  {
+    return flags_;
+  }
+
+  /**
+   * @return the value as a sequence of characters, convenient for writing it to text streams
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto as_string_view() const -> std::string_view
+  {
+    return { reinterpret_cast<const char*>(data_), size_ };
+  }
+
+  /**
+   * Lifetime handle of the underlying memory. Keep it alive to use @ref data() after the view
+   * itself has been destroyed.
+   *
+   * @return shared owner of the buffer, or empty pointer if the view borrows memory of another
+   * object (in this case the view is only valid while that object is alive)
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto owner() const -> const std::shared_ptr<const void>&
+  {
+    return owner_;
+  }
+
+  /**
+   * Copies the bytes into an owning value, for example to decode it with a transcoder.
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto to_encoded_value() const -> encoded_value
+  {
+    return { binary{ data_, data_ + size_ }, flags_ };
+  }
+
+private:
+  std::shared_ptr<const void> owner_{};
+  const std::byte* data_{ nullptr };
+  std::size_t size_{ 0 };
+  std::uint32_t flags_{ 0 };
+};
+} // namespace couchbase::codec
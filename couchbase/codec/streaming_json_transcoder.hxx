@@ -0,0 +1,46 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include <couchbase/codec/json_transcoder.hxx>
+#include <couchbase/codec/tao_json_streaming_serializer.hxx>
+#include <couchbase/codec/transcoder_traits.hxx>
+
+namespace couchbase
+{
+namespace codec
+{
+/**
+ * Drop-in replacement for @ref default_json_transcoder, that does not build intermediate JSON
+ * values when the document traits support streaming.
+ *
+ * @see tao_json_streaming_serializer
+ *
+ * @since 1.0.0
+ * @uncommitted
+ */
+using streaming_json_transcoder = json_transcoder<tao_json_streaming_serializer>;
+
+#ifndef COUCHBASE_CXX_CLIENT_DOXYGEN
+template<>
+struct is_transcoder<streaming_json_transcoder> : public std::true_type {
+};
+#endif
+} // namespace codec
+} // namespace couchbase
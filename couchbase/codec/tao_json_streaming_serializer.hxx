@@ -0,0 +1,187 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include <couchbase/codec/encoded_value.hxx>
+#include <couchbase/codec/serializer_traits.hxx>
+#include <couchbase/codec/tao_json_serializer.hxx>
+#include <couchbase/error_codes.hxx>
+
+#include <tao/json/consume_string.hpp>
+#include <tao/json/value.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace couchbase
+{
+#ifndef COUCHBASE_CXX_CLIENT_DOXYGEN
+namespace core::utils::json
+{
+/**
+ * tao::json events consumer, that writes JSON text directly into a byte vector.
+ *
+ * Implemented in core/utils/json.cxx, where generate_binary() uses it too.
+ */
+class to_byte_vector
+{
+public:
+  explicit to_byte_vector(std::vector<std::byte>& output) noexcept;
+
+  void null();
+  void boolean(bool v);
+  void number(std::int64_t v);
+  void number(std::uint64_t v);
+  void number(double v);
+  void string(std::string_view v);
+  void binary(tao::binary_view v);
+  void begin_array(std::size_t size = 0);
+  void element() noexcept;
+  void end_array(std::size_t size = 0);
+  void begin_object(std::size_t size = 0);
+  void key(std::string_view v);
+  void member() noexcept;
+  void end_object(std::size_t size = 0);
+
+private:
+  void next();
+  void write(tao::binary_view data);
+  void write(std::string_view data);
+  void escape(std::string_view s);
+
+  std::vector<std::byte>& buffer_;
+  bool first_{ true };
+};
+} // namespace core::utils::json
+#endif
+
+namespace codec
+{
+#ifndef COUCHBASE_CXX_CLIENT_DOXYGEN
+namespace internal
+{
+template<typename Document, typename = void>
+struct has_tao_json_produce : std::false_type {
+};
+
+template<typename Document>
+struct has_tao_json_produce<
+  Document,
+  std::void_t<decltype(tao::json::traits<Document>::template produce<tao::json::traits>(
+    std::declval<core::utils::json::to_byte_vector&>(),
+    std::declval<const Document&>()))>> : std::true_type {
+};
+
+template<typename Document, typename = void>
+struct has_tao_json_consume : std::false_type {
+};
+
+template<typename Document>
+struct has_tao_json_consume<
+  Document,
+  std::void_t<decltype(tao::json::traits<Document>::template consume<tao::json::traits>(
+    std::declval<tao::json::parts_parser&>()))>> : std::true_type {
+};
+} // namespace internal
+#endif
+
+/**
+ * JSON serializer, that converts documents to and from bytes without building intermediate
+ * `tao::json::value`.
+ *
+ * The document type is written by `tao::json::traits<Document>::produce()` and read by
+ * `tao::json::traits<Document>::consume()`. Traits generated with `tao::json::binding` and the
+ * traits for standard types provide both. When the traits only define `assign()` or `as()`, the
+ * serializer falls back to the same DOM conversion as @ref tao_json_serializer, so it is safe to
+ * use for any type the default serializer accepts.
+ *
+ * @see streaming_json_transcoder
+ *
+ * @since 1.0.0
+ * @uncommitted
+ */
+class tao_json_streaming_serializer
+{
+public:
+  using document_type = tao::json::value;
+
+  template<typename Document>
+  static auto serialize([[maybe_unused]] Document document) -> binary
+  {
+    if constexpr (std::is_null_pointer_v<Document> ||
+                  std::is_same_v<Document, tao::json::value> ||
+                  !internal::has_tao_json_produce<Document>::value) {
+      return tao_json_serializer::serialize(std::move(document));
+    } else {
+      try {
+        binary output;
+        core::utils::json::to_byte_vector consumer(output);
+        tao::json::traits<Document>::template produce<tao::json::traits>(consumer, document);
+        return output;
+      } catch (const tao::pegtl::parse_error& e) {
+        throw std::system_error(
+          errc::common::encoding_failure,
+          std::string("json_transcoder cannot generate document as JSON: ").append(e.message()));
+      } catch (const std::runtime_error& e) {
+        throw std::system_error(
+          errc::common::encoding_failure,
+          std::string("json_transcoder cannot generate document as JSON: ").append(e.what()));
+      }
+    }
+  }
+
+  template<typename Document>
+  static auto deserialize(const binary& data) -> Document
+  {
+    if constexpr (std::is_same_v<Document, tao::json::value> ||
+                  !internal::has_tao_json_consume<Document>::value) {
+      return tao_json_serializer::deserialize<Document>(data);
+    } else {
+      try {
+        return tao::json::consume_string<Document>(
+          std::string_view{ reinterpret_cast<const char*>(data.data()), data.size() });
+      } catch (const tao::pegtl::parse_error& e) {
+        throw std::system_error(
+          errc::common::decoding_failure,
+          std::string("json_transcoder cannot parse document as JSON: ").append(e.message()));
+      } catch (const std::out_of_range& e) {
+        throw std::system_error(
+          errc::common::decoding_failure,
+          std::string("json_transcoder cannot parse document: ").append(e.what()));
+      } catch (const std::runtime_error& e) {
+        throw std::system_error(
+          errc::common::decoding_failure,
+          std::string("json_transcoder cannot parse document: ").append(e.what()));
+      }
+    }
+  }
+};
+
+#ifndef COUCHBASE_CXX_CLIENT_DOXYGEN
+template<>
+struct is_serializer<tao_json_streaming_serializer> : public std::true_type {
+};
+#endif
+} // namespace codec
+} // namespace couchbase
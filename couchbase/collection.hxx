@@ -47,6 +47,8 @@
 
 #include <future>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace couchbase
 {
@@ -152,6 +154,48 @@ public:
   [[nodiscard]] auto get(std::string document_id, const get_options& options = {}) const
     -> std::future<std::pair<error, get_result>>;
 
+  /**
+   * Fetches several full documents from this collection with a single completion.
+   *
+   * The documents are grouped by the node that owns them, and the requests for the same node are
+   * written to the network together, which is much cheaper than issuing @ref get() for every
+   * document. Every document still has its own timeout and retries.
+   *
+   * When the options enable @ref get_options::hedged_read(), request expiry or projections, the
+   * documents are fetched with individual @ref get() requests, which honour these options, and
+   * only the completion is shared.
+   *
+   * @param document_ids the document ids to fetch.
+   * @param options options to customize the get requests.
+   * @param handler the handler that implements @ref get_multi_handler, it receives the results in
+   * the order of document_ids.
+   *
+   * @exception errc::key_value::document_not_found the given document id is not found in the
+   * collection (reported per document).
+   * @exception errc::common::ambiguous_timeout
+   * @exception errc::common::unambiguous_timeout
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  void get_multi(std::vector<std::string> document_ids,
+                 const get_options& options,
+                 get_multi_handler&& handler) const;
+
+  /**
+   * Fetches several full documents from this collection with a single completion.
+   *
+   * @param document_ids the document ids to fetch.
+   * @param options options to customize the get requests.
+   * @return future object that carries results in the order of document_ids
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto get_multi(std::vector<std::string> document_ids,
+                               const get_options& options = {}) const
+    -> std::future<std::vector<std::pair<error, get_result>>>;
+
   /**
    * Fetches a full document and resets its expiration time to the value provided.
    *
@@ -495,6 +539,91 @@ public:
     return upsert(std::move(document_id), Transcoder::encode(document), options);
   }
 
+  /**
+   * Upserts several encoded documents with a single completion.
+   *
+   * The documents are grouped by the node that owns them, and the requests for the same node are
+   * written to the network together. Every document still has its own timeout and retries.
+   *
+   * @param documents pairs of document id and encoded content.
+   * @param options custom options to customize the upsert behavior.
+   * @param handler callable that implements @ref upsert_multi_handler, it receives the results in
+   * the order of documents.
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  void upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                    const upsert_options& options,
+                    upsert_multi_handler&& handler) const;
+
+  /**
+   * Upserts several documents with a single completion.
+   *
+   * @tparam Transcoder type of the transcoder that will be used to encode the documents
+   * @tparam Document type of the documents
+   *
+   * @param documents pairs of document id and content.
+   * @param options custom options to customize the upsert behavior.
+   * @param handler callable that implements @ref upsert_multi_handler
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  template<typename Transcoder = codec::default_json_transcoder, typename Document>
+  void upsert_multi(std::vector<std::pair<std::string, Document>> documents,
+                    const upsert_options& options,
+                    upsert_multi_handler&& handler) const
+  {
+    std::vector<std::pair<std::string, codec::encoded_value>> encoded{};
+    encoded.reserve(documents.size());
+    for (auto& [document_id, document] : documents) {
+      encoded.emplace_back(std::move(document_id), Transcoder::encode(document));
+    }
+    return upsert_multi(std::move(encoded), options, std::move(handler));
+  }
+
+  /**
+   * Upserts several encoded documents with a single completion.
+   *
+   * @param documents pairs of document id and encoded content.
+   * @param options custom options to customize the upsert behavior.
+   * @return future object that carries results in the order of documents
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto upsert_multi(
+    std::vector<std::pair<std::string, codec::encoded_value>> documents,
+    const upsert_options& options = {}) const
+    -> std::future<std::vector<std::pair<error, mutation_result>>>;
+
+  /**
+   * Upserts several documents with a single completion.
+   *
+   * @tparam Transcoder type of the transcoder that will be used to encode the documents
+   * @tparam Document type of the documents
+   *
+   * @param documents pairs of document id and content.
+   * @param options custom options to customize the upsert behavior.
+   * @return future object that carries results in the order of documents
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  template<typename Transcoder = codec::default_json_transcoder, typename Document>
+  [[nodiscard]] auto upsert_multi(std::vector<std::pair<std::string, Document>> documents,
+                                  const upsert_options& options = {}) const
+    -> std::future<std::vector<std::pair<error, mutation_result>>>
+  {
+    std::vector<std::pair<std::string, codec::encoded_value>> encoded{};
+    encoded.reserve(documents.size());
+    for (auto& [document_id, document] : documents) {
+      encoded.emplace_back(std::move(document_id), Transcoder::encode(document));
+    }
+    return upsert_multi(std::move(encoded), options);
+  }
+
   /**
    * Inserts an encoded body of the document which does not exist yet with custom options.
    *
@@ -738,6 +867,38 @@ public:
   [[nodiscard]] auto remove(std::string document_id, const remove_options& options = {}) const
     -> std::future<std::pair<error, mutation_result>>;
 
+  /**
+   * Removes several documents from a collection with a single completion.
+   *
+   * The documents are grouped by the node that owns them, and the requests for the same node are
+   * written to the network together. Every document still has its own timeout and retries.
+   *
+   * @param document_ids the document ids to remove.
+   * @param options custom options to customize the remove behavior.
+   * @param handler callable that implements @ref remove_multi_handler, it receives the results in
+   * the order of document_ids.
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  void remove_multi(std::vector<std::string> document_ids,
+                    const remove_options& options,
+                    remove_multi_handler&& handler) const;
+
+  /**
+   * Removes several documents from a collection with a single completion.
+   *
+   * @param document_ids the document ids to remove.
+   * @param options custom options to customize the remove behavior.
+   * @return future object that carries results in the order of document_ids
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto remove_multi(std::vector<std::string> document_ids,
+                                  const remove_options& options = {}) const
+    -> std::future<std::vector<std::pair<error, mutation_result>>>;
+
   /**
    * Performs mutations to document fragments
    *
@@ -20,11 +20,14 @@
 #include <couchbase/common_options.hxx>
 #include <couchbase/error.hxx>
 #include <couchbase/get_result.hxx>
+#include <couchbase/read_preference.hxx>
 
 #include <chrono>
 #include <functional>
 #include <memory>
 #include <optional>
+#include <utility>
+#include <vector>
 
 namespace couchbase
 {
@@ -44,6 +47,9 @@ struct get_options : public common_options<get_options> {
   struct built : public common_options<get_options>::built {
     const bool with_expiry;
     const std::vector<std::string> projections;
+    const bool zero_copy;
+    const bool hedged_read;
+    const read_preference hedged_read_preference;
   };
 
   /**
@@ -59,7 +65,14 @@ struct get_options : public common_options<get_options> {
    */
   [[nodiscard]] auto build() const -> built
   {
-    return { build_common_options(), with_expiry_, projections_ };
+    return {
+      build_common_options(),
+      with_expiry_,
+      projections_,
+      zero_copy_,
+      hedged_read_,
+      hedged_read_preference_,
+    };
   }
 
   /**
@@ -97,9 +110,62 @@ struct get_options : public common_options<get_options> {
     return self();
   }
 
+  /**
+   * If set to true, the result will share the buffer received from the network instead of copying
+   * the document out of it. Use @ref get_result::content_as_view to access the bytes, for example
+   * to forward them to another connection without decoding.
+   *
+   * @note The option applies only to plain reads, it is ignored when the expiry or projections
+   * are requested.
+   *
+   * @param enable true if the result should share the network buffer.
+   * @return this options builder for chaining purposes.
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  auto zero_copy(bool enable) -> get_options&
+  {
+    zero_copy_ = enable;
+    return self();
+  }
+
+  /**
+   * If set to true, the read goes to the active node first, and when the node takes longer than
+   * it usually does, the same read is also sent to one replica. The first successful response is
+   * returned, which cuts the tail latency caused by a single slow node.
+   *
+   * The delay before the replica read is the 95th percentile of the recent latencies of the
+   * active node, and the share of reads that are allowed to hedge is capped by
+   * @ref network_options::max_hedged_read_ratio.
+   *
+   * @note The document returned from a replica might be stale. The option applies only to plain
+   * reads, it is ignored when the expiry or projections are requested, and it takes precedence
+   * over @ref zero_copy.
+   *
+   * @param enable true if the read should be hedged.
+   * @param preference which replicas are allowed to serve the hedged read.
+   * @return this options builder for chaining purposes.
+   *
+   * @see read_preference
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  auto hedged_read(bool enable, read_preference preference = read_preference::no_preference)
+    -> get_options&
+  {
+    hedged_read_ = enable;
+    hedged_read_preference_ = preference;
+    return self();
+  }
+
 private:
   bool with_expiry_{ false };
   std::vector<std::string> projections_{};
+  bool zero_copy_{ false };
+  bool hedged_read_{ false };
+  read_preference hedged_read_preference_{ read_preference::no_preference };
 };
 
 /**
@@ -109,4 +175,13 @@ private:
  * @uncommitted
  */
 using get_handler = std::function<void(error, get_result)>;
+
+/**
+ * The signature for the handler of the @ref collection#get_multi() operation. The results are
+ * in the order of the document ids.
+ *
+ * @since 1.0.0
+ * @uncommitted
+ */
+using get_multi_handler = std::function<void(std::vector<std::pair<error, get_result>>)>;
 } // namespace couchbase
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <couchbase/codec/default_json_transcoder.hxx>
+#include <couchbase/codec/encoded_value_view.hxx>
 #include <couchbase/result.hxx>
 
 #include <chrono>
@@ -62,6 +63,47 @@ public:
   {
   }
 
+  /**
+   * Constructs result for hedged get operation
+   *
+   * @param cas
+   * @param value raw document contents along with flags describing its structure
+   * @param is_replica true if the document originates from replica node
+   *
+   * @see get_options::hedged_read
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  get_result(couchbase::cas cas, codec::encoded_value value, bool is_replica)
+    : result{ cas }
+    , value_{ std::move(value) }
+    , is_replica_{ is_replica }
+  {
+  }
+
+  /**
+   * Constructs result for get operation, that shares the network buffer with the caller
+   *
+   * @param cas
+   * @param value view of the document contents along with flags describing its structure
+   * @param expiry_time optional point in time when the document will expire
+   *
+   * @see get_options::zero_copy
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  get_result(couchbase::cas cas,
+             codec::encoded_value_view value,
+             std::optional<std::chrono::system_clock::time_point> expiry_time)
+    : result{ cas }
+    , value_{ {}, value.flags() }
+    , shared_value_{ std::move(value) }
+    , expiry_time_{ expiry_time }
+  {
+  }
+
   /**
    * Decodes content of the document using given codec.
    *
@@ -79,6 +121,9 @@ public:
            std::enable_if_t<codec::is_transcoder_v<Transcoder>, bool> = true>
   [[nodiscard]] auto content_as() const -> Document
   {
+    if (shared_value_.owner()) {
+      return Transcoder::template decode<Document>(shared_value_.to_encoded_value());
+    }
     return Transcoder::template decode<Document>(value_);
   }
 
@@ -102,9 +147,35 @@ public:
   template<typename Transcoder, std::enable_if_t<codec::is_transcoder_v<Transcoder>, bool> = true>
   [[nodiscard]] auto content_as() const -> typename Transcoder::document_type
   {
+    if (shared_value_.owner()) {
+      return Transcoder::decode(shared_value_.to_encoded_value());
+    }
     return Transcoder::decode(value_);
   }
 
+  /**
+   * Returns raw contents of the document without copying or decoding them.
+   *
+   * When the document has been fetched with @ref get_options::zero_copy, the view shares
+   * ownership of the buffer received from the network and might outlive the result. Otherwise it
+   * borrows the bytes owned by this result, and must not be used after the result is destroyed.
+   *
+   * @note `content_as()` has to copy the bytes out of the shared buffer before decoding, so the
+   * zero-copy mode only pays off when the contents are used as they are.
+   *
+   * @return read-only view of the document contents with its flags
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto content_as_view() const -> codec::encoded_value_view
+  {
+    if (shared_value_.owner()) {
+      return shared_value_;
+    }
+    return { {}, value_.data.data(), value_.data.size(), value_.flags };
+  }
+
   /**
    * If the document has an expiry, returns the point in time when the loaded
    * document expires.
@@ -124,9 +195,27 @@ public:
     return expiry_time_;
   }
 
+  /**
+   * The hedged read returns the first copy of the document that arrives, which is not necessarily
+   * the one from the active node.
+   *
+   * @return true if the document came from replica, false for active node.
+   *
+   * @see get_options::hedged_read
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto is_replica() const -> bool
+  {
+    return is_replica_;
+  }
+
 private:
   codec::encoded_value value_{};
+  codec::encoded_value_view shared_value_{};
   std::optional<std::chrono::system_clock::time_point> expiry_time_{};
+  bool is_replica_{ false };
 };
 
 } // namespace couchbase
@@ -0,0 +1,137 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include <couchbase/common_options.hxx>
+#include <couchbase/durability_level.hxx>
+
+#include <chrono>
+#include <cstddef>
+
+namespace couchbase
+{
+/**
+ * Options for @ref binary_collection#open_writer() and @ref binary_collection#open_reader().
+ *
+ * @since 1.0.0
+ * @uncommitted
+ */
+struct large_object_options : public common_options<large_object_options> {
+  /**
+   * Immutable value object representing consistent options.
+   *
+   * @since 1.0.0
+   * @internal
+   */
+  struct built : public common_options<large_object_options>::built {
+    const std::size_t chunk_size;
+    const std::size_t max_in_flight_chunks;
+    const couchbase::durability_level durability_level;
+    const std::chrono::seconds replaced_chunks_grace_period;
+  };
+
+  /**
+   * Validates options and returns them as an immutable value.
+   *
+   * @return consistent options as an immutable value
+   *
+   * @since 1.0.0
+   * @internal
+   */
+  [[nodiscard]] auto build() const -> built
+  {
+    auto base = build_common_options();
+    return {
+      base, chunk_size_, max_in_flight_chunks_, durability_level_, replaced_chunks_grace_period_,
+    };
+  }
+
+  /**
+   * Size of the documents the object is split into. Only used by the writer, the reader takes it
+   * from the manifest. Must be positive and not exceed the maximum document size of the server
+   * (20 MiB). Defaults to 1 MiB.
+   *
+   * @param size number of bytes in every chunk except the last one
+   * @return the options builder for chaining purposes.
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  auto chunk_size(std::size_t size) -> large_object_options&
+  {
+    chunk_size_ = size;
+    return self();
+  }
+
+  /**
+   * Number of chunks that are allowed to be uploaded or downloaded at the same time. Together
+   * with the chunk size this bounds the memory held by a writer or a reader. Defaults to 4.
+   *
+   * @param number_of_chunks the limit, zero is treated as one
+   * @return the options builder for chaining purposes.
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  auto max_in_flight_chunks(std::size_t number_of_chunks) -> large_object_options&
+  {
+    max_in_flight_chunks_ = number_of_chunks;
+    return self();
+  }
+
+  /**
+   * Durability level for the chunks and the manifest. Only used by the writer.
+   *
+   * @param level the durability level
+   * @return the options builder for chaining purposes.
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  auto durability(durability_level level) -> large_object_options&
+  {
+    durability_level_ = level;
+    return self();
+  }
+
+  /**
+   * Time the chunks of the replaced object stay readable after the writer has published the new
+   * manifest. Readers that opened the object before that keep reading the old chunks, and have
+   * to finish (or open the object again) within this period. Only used by the writer, the period
+   * is capped at 30 days. Defaults to 5 minutes.
+   *
+   * @param period the grace period, at least one second
+   * @return the options builder for chaining purposes.
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  auto replaced_chunks_grace_period(std::chrono::seconds period) -> large_object_options&
+  {
+    replaced_chunks_grace_period_ = period;
+    return self();
+  }
+
+private:
+  std::size_t chunk_size_{ 1024 * 1024 };
+  std::size_t max_in_flight_chunks_{ 4 };
+  couchbase::durability_level durability_level_{ durability_level::none };
+  std::chrono::seconds replaced_chunks_grace_period_{ std::chrono::minutes{ 5 } };
+};
+} // namespace couchbase
@@ -0,0 +1,116 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include <couchbase/error.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace couchbase
+{
+#ifndef COUCHBASE_CXX_CLIENT_DOXYGEN
+class large_object_reader_impl;
+#endif
+
+/**
+ * The signature for the handler of the @ref large_object_reader#read() operation. Empty
+ * optional means that the whole object has been read.
+ *
+ * @since 1.0.0
+ * @uncommitted
+ */
+using large_object_read_handler = std::function<void(error, std::optional<std::vector<std::byte>>)>;
+
+/**
+ * Downloads a large binary object written by @ref large_object_writer, chunk by chunk and in
+ * order. The chunks that follow the one being read are prefetched in parallel, but no more than
+ * the configured number of chunks is held at a time.
+ *
+ * @see binary_collection#open_reader()
+ *
+ * @since 1.0.0
+ * @uncommitted
+ */
+class large_object_reader
+{
+public:
+  /**
+   * Constructs an empty reader, which does not have any data to read.
+   *
+   * @since 1.0.0
+   * @internal
+   */
+  large_object_reader() = default;
+
+  /**
+   * Constructs a reader from its implementation.
+   *
+   * @since 1.0.0
+   * @internal
+   */
+  explicit large_object_reader(std::shared_ptr<large_object_reader_impl> impl);
+
+  /**
+   * @return total size of the object in bytes, as recorded in the manifest.
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto size() const -> std::uint64_t;
+
+  /**
+   * Fetches the next chunk of the object.
+   *
+   * @param handler callable that implements @ref large_object_read_handler
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  void read(large_object_read_handler&& handler) const;
+
+  /**
+   * Fetches the next chunk of the object.
+   *
+   * @return future object that carries the result of the operation
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto read() const
+    -> std::future<std::pair<error, std::optional<std::vector<std::byte>>>>;
+
+private:
+  std::shared_ptr<large_object_reader_impl> impl_{};
+};
+
+/**
+ * The signature for the handler of the @ref binary_collection#open_reader() operation
+ *
+ * @since 1.0.0
+ * @uncommitted
+ */
+using large_object_open_handler = std::function<void(error, large_object_reader)>;
+} // namespace couchbase
@@ -0,0 +1,128 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+
+#include <couchbase/error.hxx>
+#include <couchbase/mutation_result.hxx>
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace couchbase
+{
+#ifndef COUCHBASE_CXX_CLIENT_DOXYGEN
+class large_object_writer_impl;
+#endif
+
+/**
+ * The signature for the handler of the @ref large_object_writer#write() operation
+ *
+ * @since 1.0.0
+ * @uncommitted
+ */
+using large_object_write_handler = std::function<void(error)>;
+
+/**
+ * The signature for the handler of the @ref large_object_writer#close() operation
+ *
+ * @since 1.0.0
+ * @uncommitted
+ */
+using large_object_close_handler = std::function<void(error, mutation_result)>;
+
+/**
+ * Uploads a large binary object as a sequence of chunk documents followed by a manifest.
+ *
+ * The object becomes visible to readers only after @ref close() has stored the manifest. If any
+ * chunk fails, the manifest is not written and the error is reported to the next write and to
+ * close. Every writer stores its chunks under a new generation, so rewriting an object never
+ * touches the chunks of the published manifest. Once the new manifest is stored, the chunks of
+ * the replaced one expire after @ref large_object_options#replaced_chunks_grace_period(), so
+ * that readers that opened the old object can still finish it. Chunks of an abandoned writer are
+ * left behind.
+ *
+ * @see binary_collection#open_writer()
+ *
+ * @since 1.0.0
+ * @uncommitted
+ */
+class large_object_writer
+{
+public:
+  /**
+   * Constructs a writer from its implementation.
+   *
+   * @since 1.0.0
+   * @internal
+   */
+  explicit large_object_writer(std::shared_ptr<large_object_writer_impl> impl);
+
+  /**
+   * Appends data to the object. At most @ref large_object_options#max_in_flight_chunks() chunks
+   * are uploaded at the same time and the rest are queued. The handler is invoked once every
+   * complete chunk of this write has been sent, so that waiting for the handler before the next
+   * write keeps the memory bounded.
+   *
+   * @param data the next part of the object
+   * @param handler callable that implements @ref large_object_write_handler
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  void write(std::vector<std::byte> data, large_object_write_handler&& handler) const;
+
+  /**
+   * Appends data to the object.
+   *
+   * @param data the next part of the object
+   * @return future object that carries the result of the operation
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto write(std::vector<std::byte> data) const -> std::future<error>;
+
+  /**
+   * Uploads the last chunk, waits for all the chunks and stores the manifest.
+   *
+   * @param handler callable that implements @ref large_object_close_handler
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  void close(large_object_close_handler&& handler) const;
+
+  /**
+   * Uploads the last chunk, waits for all the chunks and stores the manifest.
+   *
+   * @return future object that carries the result of the manifest mutation
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto close() const -> std::future<std::pair<error, mutation_result>>;
+
+private:
+  std::shared_ptr<large_object_writer_impl> impl_;
+};
+} // namespace couchbase
@@ -24,6 +24,7 @@
 #include <couchbase/error.hxx>
 #include <couchbase/expiry.hxx>
 #include <couchbase/lookup_in_result.hxx>
+#include <couchbase/read_preference.hxx>
 #include <couchbase/store_semantics.hxx>
 
 #include <chrono>
@@ -50,6 +51,8 @@ struct lookup_in_options : public common_durability_options<lookup_in_options> {
    */
   struct built : public common_durability_options<lookup_in_options>::built {
     const bool access_deleted;
+    const bool hedged_read;
+    const read_preference hedged_read_preference;
   };
 
   /**
@@ -66,7 +69,7 @@ struct lookup_in_options : public common_durability_options<lookup_in_options> {
   [[nodiscard]] auto build() const -> built
   {
     auto base = build_common_durability_options();
-    return { base, access_deleted_ };
+    return { base, access_deleted_, hedged_read_, hedged_read_preference_ };
   }
 
   /**
@@ -81,8 +84,36 @@ struct lookup_in_options : public common_durability_options<lookup_in_options> {
     return self();
   }
 
+  /**
+   * If set to true, the lookup goes to the active node first, and when the node takes longer
+   * than it usually does, the same lookup is also sent to one replica. The first successful
+   * response is returned.
+   *
+   * @note The replica is only asked when the cluster supports subdocument reads from replicas,
+   * and the result of a replica read might be stale. Hedging is not used together with
+   * @ref access_deleted.
+   *
+   * @param enable true if the lookup should be hedged.
+   * @param preference which replicas are allowed to serve the hedged lookup.
+   * @return this options builder for chaining purposes.
+   *
+   * @see get_options::hedged_read
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  auto hedged_read(bool enable, read_preference preference = read_preference::no_preference)
+    -> lookup_in_options&
+  {
+    hedged_read_ = enable;
+    hedged_read_preference_ = preference;
+    return self();
+  }
+
 private:
   bool access_deleted_{ false };
+  bool hedged_read_{ false };
+  read_preference hedged_read_preference_{ read_preference::no_preference };
 };
 
 /**
@@ -34,6 +34,11 @@ public:
   static constexpr std::chrono::milliseconds default_config_poll_interval{ 2'500 };
   static constexpr std::chrono::milliseconds default_config_poll_floor{ 50 };
   static constexpr std::chrono::milliseconds default_idle_http_connection_timeout{ 4'500 };
+  static constexpr std::size_t default_write_coalescing_threshold{ 64 * 1024 };
+  static constexpr double default_max_hedged_read_ratio{ 0.05 };
+  static constexpr std::size_t default_kv_initial_concurrency_limit{ 512 };
+  static constexpr std::size_t default_kv_max_concurrency_limit{ 8'192 };
+  static constexpr std::size_t default_kv_max_queued_requests{ 4'096 };
 
   auto preferred_network(std::string network_name) -> network_options&
   {
@@ -104,6 +109,126 @@ public:
     return *this;
   }
 
+  /**
+   * Gather KV requests issued within the given window into a single socket write.
+   *
+   * Under high concurrency this reduces the number of syscalls at the cost of up to `window` of
+   * extra latency per request. The buffer is written before the window closes once it holds at
+   * least `threshold` bytes. Zero window (the default) writes every request right away.
+   *
+   * @param window how long to wait for more requests before writing
+   * @param threshold number of buffered bytes that triggers the write immediately
+   * @return this options object for chaining
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  auto write_coalescing(std::chrono::microseconds window,
+                        std::size_t threshold = default_write_coalescing_threshold)
+    -> network_options&
+  {
+    write_coalescing_window_ = window;
+    write_coalescing_threshold_ = threshold;
+    return *this;
+  }
+
+  /**
+   * Limit the share of hedged reads that are allowed to send a second request to a replica.
+   *
+   * When the active node slows down, every hedged read would otherwise turn into two reads,
+   * adding load to the cluster exactly when it is struggling.
+   *
+   * @param ratio fraction of hedged reads (between 0 and 1) that may issue the replica read
+   * @return this options object for chaining
+   *
+   * @see get_options::hedged_read
+   * @see lookup_in_options::hedged_read
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  auto max_hedged_read_ratio(double ratio) -> network_options&
+  {
+    max_hedged_read_ratio_ = ratio;
+    return *this;
+  }
+
+  /**
+   * Adapt the number of KV requests in flight to every node to the latency of that node.
+   *
+   * When a node slows down, the requests above its limit wait in a queue instead of piling up on
+   * the socket, so they do not delay the requests to the other nodes.
+   *
+   * The limit is disabled by default, because a client that keeps more requests in flight to a
+   * node than the initial limit would see them queued until the limit has grown.
+   *
+   * @param enable true to limit the requests in flight
+   * @return this options object for chaining
+   *
+   * @see cluster::diagnostics
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  auto enable_kv_concurrency_limit(bool enable) -> network_options&
+  {
+    enable_kv_concurrency_limit_ = enable;
+    return *this;
+  }
+
+  /**
+   * Number of KV requests in flight to every node, that the adaptive limit starts from.
+   *
+   * @param number_of_requests the initial limit
+   * @return this options object for chaining
+   *
+   * @see enable_kv_concurrency_limit
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  auto kv_initial_concurrency_limit(std::size_t number_of_requests) -> network_options&
+  {
+    kv_initial_concurrency_limit_ = number_of_requests;
+    return *this;
+  }
+
+  /**
+   * Number of KV requests in flight to every node, that the adaptive limit never exceeds.
+   *
+   * @param number_of_requests the upper bound of the limit
+   * @return this options object for chaining
+   *
+   * @see enable_kv_concurrency_limit
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  auto kv_max_concurrency_limit(std::size_t number_of_requests) -> network_options&
+  {
+    kv_max_concurrency_limit_ = number_of_requests;
+    return *this;
+  }
+
+  /**
+   * Number of KV requests that may wait for a node that has reached its concurrency limit.
+   *
+   * Requests that do not fit into the queue are rejected and handled by the retry strategy as if
+   * the circuit breaker of the node was open. Zero disables the queue, so that the overload is
+   * reported right away.
+   *
+   * @param number_of_requests the size of the queue of every node
+   * @return this options object for chaining
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  auto kv_max_queued_requests(std::size_t number_of_requests) -> network_options&
+  {
+    kv_max_queued_requests_ = number_of_requests;
+    return *this;
+  }
+
   struct built {
     std::string network;
     std::string server_group;
@@ -113,6 +238,13 @@ public:
     std::chrono::milliseconds config_poll_interval;
     std::chrono::milliseconds idle_http_connection_timeout;
     std::optional<std::size_t> max_http_connections;
+    std::chrono::microseconds write_coalescing_window;
+    std::size_t write_coalescing_threshold;
+    double max_hedged_read_ratio;
+    bool enable_kv_concurrency_limit;
+    std::size_t kv_initial_concurrency_limit;
+    std::size_t kv_max_concurrency_limit;
+    std::size_t kv_max_queued_requests;
   };
 
   [[nodiscard]] auto build() const -> built
@@ -126,6 +258,13 @@ public:
       config_poll_interval_,
       idle_http_connection_timeout_,
       max_http_connections_,
+      write_coalescing_window_,
+      write_coalescing_threshold_,
+      max_hedged_read_ratio_,
+      enable_kv_concurrency_limit_,
+      kv_initial_concurrency_limit_,
+      kv_max_concurrency_limit_,
+      kv_max_queued_requests_,
     };
   }
 
@@ -139,5 +278,12 @@ private:
   std::chrono::milliseconds config_poll_floor_{ default_config_poll_floor };
   std::chrono::milliseconds idle_http_connection_timeout_{ default_idle_http_connection_timeout };
   std::optional<std::size_t> max_http_connections_{};
+  std::chrono::microseconds write_coalescing_window_{ 0 };
+  std::size_t write_coalescing_threshold_{ default_write_coalescing_threshold };
+  double max_hedged_read_ratio_{ default_max_hedged_read_ratio };
+  bool enable_kv_concurrency_limit_{ false };
+  std::size_t kv_initial_concurrency_limit_{ default_kv_initial_concurrency_limit };
+  std::size_t kv_max_concurrency_limit_{ default_kv_max_concurrency_limit };
+  std::size_t kv_max_queued_requests_{ default_kv_max_queued_requests };
 };
 } // namespace couchbase
@@ -27,6 +27,7 @@ namespace couchbase
  * * collection::get_any_replica
  * * collection::lookup_in_all_replicas
  * * collection::lookup_in_any_replica
+ * * collection::get and collection::lookup_in with hedged reads enabled
  *
  * @note all strategies except read_preference::no_preference, reduce number of the nodes
  * that the SDK will use for replica read operations. In other words, it will
@@ -27,6 +27,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 namespace couchbase
@@ -101,4 +102,13 @@ private:
  * @uncommitted
  */
 using remove_handler = std::function<void(error, mutation_result)>;
+
+/**
+ * The signature for the handler of the @ref collection#remove_multi() operation. The results are
+ * in the order of the documents.
+ *
+ * @since 1.0.0
+ * @uncommitted
+ */
+using remove_multi_handler = std::function<void(std::vector<std::pair<error, mutation_result>>)>;
 } // namespace couchbase
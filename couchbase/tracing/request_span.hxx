@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <array>
+#include <charconv>
 #include <cinttypes>
 #include <memory>
 #include <string>
@@ -46,6 +48,20 @@ public:
   virtual void add_tag(const std::string& name, const std::string& value) = 0;
   virtual void end() = 0;
 
+  /**
+   * Adds the identifier of the KV operation, which is the opaque of its request. By default it is
+   * added as the "cb.operation_id" string tag with the hexadecimal value. Spans that report only
+   * some of the operations can keep the number and format it when the span is reported.
+   *
+   * @param opaque the opaque of the request
+   */
+  virtual void add_operation_id(std::uint32_t opaque)
+  {
+    std::array<char, 10> buffer{ '0', 'x' };
+    auto result = std::to_chars(buffer.data() + 2, buffer.data() + buffer.size(), opaque, 16);
+    add_tag("cb.operation_id", std::string(buffer.data(), result.ptr));
+  }
+
   [[nodiscard]] auto name() const -> const std::string&
   {
     return name_;
@@ -22,6 +22,7 @@
 #include <couchbase/transactions/transactions_query_config.hxx>
 
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <optional>
 
@@ -187,6 +188,82 @@ public:
     return *this;
   }
 
+  /**
+   * Get the maximum number of asynchronous transactions which are executed concurrently.
+   *
+   * @return maximum number of concurrently running asynchronous transactions.
+   */
+  [[nodiscard]] auto max_concurrent_async_transactions() const -> std::size_t
+  {
+    return max_concurrent_async_transactions_;
+  }
+
+  /**
+   * Set the maximum number of asynchronous transactions which are executed concurrently.
+   *
+   * Asynchronous transactions are driven by a bounded pool of workers, those which cannot be
+   * started immediately wait in a queue.
+   *
+   * @param limit number of concurrently running asynchronous transactions.
+   * @return reference to this, so calls can be chained.
+   */
+  auto max_concurrent_async_transactions(std::size_t limit) -> transactions_config&
+  {
+    max_concurrent_async_transactions_ = limit;
+    return *this;
+  }
+
+  /**
+   * Get the maximum number of asynchronous transactions waiting for execution.
+   *
+   * @return maximum length of the queue of asynchronous transactions.
+   */
+  [[nodiscard]] auto max_queued_async_transactions() const -> std::size_t
+  {
+    return max_queued_async_transactions_;
+  }
+
+  /**
+   * Set the maximum number of asynchronous transactions waiting for execution.
+   *
+   * When the queue is full, new asynchronous transactions fail immediately with
+   * @ref errc::transaction::failed instead of being queued. Transactions still queued when the
+   * cluster is closed fail the same way without being started.
+   *
+   * @param limit maximum length of the queue of asynchronous transactions.
+   * @return reference to this, so calls can be chained.
+   */
+  auto max_queued_async_transactions(std::size_t limit) -> transactions_config&
+  {
+    max_queued_async_transactions_ = limit;
+    return *this;
+  }
+
+  /**
+   * Get the maximum number of documents which are committed or rolled back in parallel.
+   *
+   * @return maximum number of in-flight unstaging operations.
+   */
+  [[nodiscard]] auto max_parallel_unstaging() const -> std::size_t
+  {
+    return max_parallel_unstaging_;
+  }
+
+  /**
+   * Set the maximum number of documents which are committed or rolled back in parallel.
+   *
+   * Once a transaction has been committed or rolled back, its staged mutations are unstaged
+   * asynchronously. As soon as one of the operations completes, the next one is sent.
+   *
+   * @param limit maximum number of in-flight unstaging operations.
+   * @return reference to this, so calls can be chained.
+   */
+  auto max_parallel_unstaging(std::size_t limit) -> transactions_config&
+  {
+    max_parallel_unstaging_ = limit;
+    return *this;
+  }
+
   /** @private */
   auto test_factories(std::shared_ptr<core::transactions::attempt_context_testing_hooks> hooks,
                       std::shared_ptr<core::transactions::cleanup_testing_hooks> cleanup_hooks)
@@ -219,6 +296,9 @@ public:
     std::optional<couchbase::transactions::transaction_keyspace> metadata_collection;
     transactions_query_config::built query_config;
     transactions_cleanup_config::built cleanup_config;
+    std::size_t max_concurrent_async_transactions{ 16 };
+    std::size_t max_queued_async_transactions{ 100'000 };
+    std::size_t max_parallel_unstaging{ 1'000 };
   };
 
   /** @internal */
@@ -232,5 +312,8 @@ private:
   std::optional<couchbase::transactions::transaction_keyspace> metadata_collection_;
   transactions_query_config query_config_{};
   transactions_cleanup_config cleanup_config_{};
+  std::size_t max_concurrent_async_transactions_{ 16 };
+  std::size_t max_queued_async_transactions_{ 100'000 };
+  std::size_t max_parallel_unstaging_{ 1'000 };
 };
 } // namespace couchbase::transactions
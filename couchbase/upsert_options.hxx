@@ -27,6 +27,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 namespace couchbase
@@ -136,4 +137,13 @@ private:
  * @uncommitted
  */
 using upsert_handler = std::function<void(error, mutation_result)>;
+
+/**
+ * The signature for the handler of the @ref collection#upsert_multi() operation. The results are
+ * in the order of the documents.
+ *
+ * @since 1.0.0
+ * @uncommitted
+ */
+using upsert_multi_handler = std::function<void(std::vector<std::pair<error, mutation_result>>)>;
 } // namespace couchbase
@@ -20,6 +20,7 @@
 #include "core/operations/document_append.hxx"
 #include "core/operations/document_decrement.hxx"
 #include "core/operations/document_get.hxx"
+#include "core/operations/document_get_projected.hxx"
 #include "core/operations/document_increment.hxx"
 #include "core/operations/document_insert.hxx"
 #include "core/operations/document_mutate_in.hxx"
@@ -57,3 +58,44 @@ TEST_CASE("benchmark: get a document", "[benchmark]")
     REQUIRE_SUCCESS(resp.ctx.ec());
   };
 }
+
+TEST_CASE("benchmark: get projections of a wide document", "[benchmark]")
+{
+  test::utils::integration_test_guard integration;
+
+  test::utils::open_bucket(integration.cluster, integration.ctx.bucket);
+
+  couchbase::core::document_id id{
+    integration.ctx.bucket, "_default", "_default", test::utils::uniq_id("wide")
+  };
+
+  std::vector<std::string> fields{};
+  {
+    tao::json::value value = tao::json::empty_object;
+    for (int i = 0; i < 256; ++i) {
+      fields.emplace_back("field_" + std::to_string(i));
+      value[fields.back()] = { { "n", i }, { "s", std::string(32, 'x') } };
+    }
+    couchbase::core::operations::upsert_request req{
+      id, couchbase::core::utils::json::generate_binary(value)
+    };
+    auto resp = test::utils::execute(integration.cluster, req);
+    REQUIRE_SUCCESS(resp.ctx.ec());
+  }
+
+  BENCHMARK("project 8 paths")
+  {
+    couchbase::core::operations::get_projected_request req{ id };
+    req.projections.assign(fields.begin(), fields.begin() + 8);
+    auto resp = test::utils::execute(integration.cluster, req);
+    REQUIRE_SUCCESS(resp.ctx.ec());
+  };
+
+  BENCHMARK("project 64 paths")
+  {
+    couchbase::core::operations::get_projected_request req{ id };
+    req.projections.assign(fields.begin(), fields.begin() + 64);
+    auto resp = test::utils::execute(integration.cluster, req);
+    REQUIRE_SUCCESS(resp.ctx.ec());
+  };
+}
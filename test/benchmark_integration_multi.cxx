@@ -0,0 +1,92 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "benchmark_helper_integration.hxx"
+
+#include <couchbase/cluster.hxx>
+
+#include <future>
+
+namespace
+{
+constexpr std::size_t number_of_documents{ 1'000 };
+} // namespace
+
+TEST_CASE("benchmark: get many documents", "[benchmark]")
+{
+  test::utils::integration_test_guard integration;
+
+  auto test_ctx = integration.ctx;
+  auto [e, cluster] =
+    couchbase::cluster::connect(test_ctx.connection_string, test_ctx.build_options()).get();
+  REQUIRE_SUCCESS(e.ec());
+
+  auto collection = cluster.bucket(integration.ctx.bucket)
+                      .scope(couchbase::scope::default_name)
+                      .collection(couchbase::collection::default_name);
+
+  std::vector<std::string> ids{};
+  std::vector<std::pair<std::string, tao::json::value>> documents{};
+  for (std::size_t i = 0; i < number_of_documents; ++i) {
+    ids.emplace_back(test::utils::uniq_id("bench_multi"));
+    documents.emplace_back(ids.back(), tao::json::value{ { "a", 1.0 }, { "b", 2.0 } });
+  }
+  for (const auto& [err, resp] : collection.upsert_multi(documents).get()) {
+    REQUIRE_SUCCESS(err.ec());
+  }
+
+  BENCHMARK("individual get")
+  {
+    std::vector<std::future<std::pair<couchbase::error, couchbase::get_result>>> futures{};
+    futures.reserve(ids.size());
+    for (const auto& id : ids) {
+      futures.emplace_back(collection.get(id));
+    }
+    for (auto& f : futures) {
+      auto [err, resp] = f.get();
+      REQUIRE_SUCCESS(err.ec());
+    }
+  };
+
+  BENCHMARK("get_multi")
+  {
+    for (const auto& [err, resp] : collection.get_multi(ids).get()) {
+      REQUIRE_SUCCESS(err.ec());
+    }
+  };
+
+  BENCHMARK("individual upsert")
+  {
+    std::vector<std::future<std::pair<couchbase::error, couchbase::mutation_result>>> futures{};
+    futures.reserve(documents.size());
+    for (const auto& [id, document] : documents) {
+      futures.emplace_back(collection.upsert(id, document));
+    }
+    for (auto& f : futures) {
+      auto [err, resp] = f.get();
+      REQUIRE_SUCCESS(err.ec());
+    }
+  };
+
+  BENCHMARK("upsert_multi")
+  {
+    for (const auto& [err, resp] : collection.upsert_multi(documents).get()) {
+      REQUIRE_SUCCESS(err.ec());
+    }
+  };
+}
@@ -0,0 +1,59 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "benchmark_helper.hxx"
+
+#include "core/operations/document_get_projected.hxx"
+#include "core/utils/json.hxx"
+
+#include <tao/json.hpp>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST_CASE("benchmark: merge projected fragments", "[benchmark]")
+{
+  for (std::size_t number_of_paths : { 8, 64, 256 }) {
+    std::vector<std::string> paths{};
+    std::vector<std::string> values{};
+    for (std::size_t i = 0; i < number_of_paths; ++i) {
+      paths.emplace_back("field_" + std::to_string(i));
+      values.emplace_back(R"({"n":)" + std::to_string(i) + R"(,"s":")" + std::string(32, 'x') +
+                          R"("})");
+    }
+    const std::vector<std::optional<std::string_view>> fragments(values.begin(), values.end());
+    const auto suffix = std::to_string(number_of_paths) + " paths";
+
+    BENCHMARK("splice fragments, " + suffix)
+    {
+      return couchbase::core::operations::merge_projected_fragments(paths, fragments, false);
+    };
+
+    /* what the projection path did before: parse every fragment and serialize the DOM */
+    BENCHMARK("rebuild DOM, " + suffix)
+    {
+      tao::json::value document = tao::json::empty_object;
+      for (std::size_t i = 0; i < paths.size(); ++i) {
+        document[paths[i]] = couchbase::core::utils::json::parse(*fragments[i]);
+      }
+      return couchbase::core::utils::json::generate_binary(document);
+    };
+  }
+}
@@ -0,0 +1,113 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "benchmark_helper.hxx"
+
+#include <couchbase/codec/default_json_transcoder.hxx>
+#include <couchbase/codec/streaming_json_transcoder.hxx>
+
+#include <tao/json.hpp>
+#include <tao/json/binding.hpp>
+#include <tao/json/contrib/traits.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+struct line_item {
+  std::string sku{};
+  std::string description{};
+  std::uint64_t quantity{};
+  double price{};
+};
+
+struct order {
+  std::string id{};
+  std::string customer{};
+  bool shipped{};
+  std::vector<std::string> tags{};
+  std::vector<line_item> items{};
+};
+
+auto
+make_order(std::size_t number_of_items) -> order
+{
+  order result{ "order::42", "Albert Einstein", false, { "express", "gift" }, {} };
+  result.items.reserve(number_of_items);
+  for (std::size_t i = 0; i < number_of_items; ++i) {
+    result.items.push_back({
+      "sku-" + std::to_string(i),
+      "a reasonably long description of the item number " + std::to_string(i),
+      i % 7 + 1,
+      static_cast<double>(i) * 0.25 + 9.99,
+    });
+  }
+  return result;
+}
+} // namespace
+
+template<>
+struct tao::json::traits<line_item>
+  : tao::json::binding::object<TAO_JSON_BIND_REQUIRED("sku", &line_item::sku),
+                               TAO_JSON_BIND_REQUIRED("description", &line_item::description),
+                               TAO_JSON_BIND_REQUIRED("quantity", &line_item::quantity),
+                               TAO_JSON_BIND_REQUIRED("price", &line_item::price)> {
+};
+
+template<>
+struct tao::json::traits<order>
+  : tao::json::binding::object<TAO_JSON_BIND_REQUIRED("id", &order::id),
+                               TAO_JSON_BIND_REQUIRED("customer", &order::customer),
+                               TAO_JSON_BIND_REQUIRED("shipped", &order::shipped),
+                               TAO_JSON_BIND_REQUIRED("tags", &order::tags),
+                               TAO_JSON_BIND_REQUIRED("items", &order::items)> {
+};
+
+TEST_CASE("benchmark: encode and decode documents with JSON transcoders", "[benchmark]")
+{
+  using couchbase::codec::default_json_transcoder;
+  using couchbase::codec::streaming_json_transcoder;
+
+  // roughly 1 KB, 10 KB and 100 KB of JSON
+  for (std::size_t number_of_items : { 10, 100, 1'000 }) {
+    const auto document = make_order(number_of_items);
+    const auto encoded = default_json_transcoder::encode(document);
+    const auto size = std::to_string(encoded.data.size()) + " bytes";
+
+    BENCHMARK("encode " + size + ", default_json_transcoder")
+    {
+      return default_json_transcoder::encode(document);
+    };
+
+    BENCHMARK("encode " + size + ", streaming_json_transcoder")
+    {
+      return streaming_json_transcoder::encode(document);
+    };
+
+    BENCHMARK("decode " + size + ", default_json_transcoder")
+    {
+      return default_json_transcoder::decode<order>(encoded);
+    };
+
+    BENCHMARK("decode " + size + ", streaming_json_transcoder")
+    {
+      return streaming_json_transcoder::decode<order>(encoded);
+    };
+  }
+}
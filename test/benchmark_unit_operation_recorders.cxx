@@ -0,0 +1,105 @@
+/*
+ *     Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/metrics/logging_meter.hxx"
+#include "core/metrics/operation_recorders.hxx"
+#include "core/protocol/client_opcode_fmt.hxx"
+
+#include <asio/io_context.hpp>
+
+#include <thread>
+#include <vector>
+
+using couchbase::core::protocol::client_opcode;
+
+namespace
+{
+constexpr std::size_t values_per_thread{ 100'000 };
+
+template<typename Record>
+void
+record_concurrently(std::size_t number_of_threads, Record&& record)
+{
+  std::vector<std::thread> threads;
+  threads.reserve(number_of_threads);
+  for (std::size_t i = 0; i < number_of_threads; ++i) {
+    threads.emplace_back([&record]() {
+      for (std::size_t value = 1; value <= values_per_thread; ++value) {
+        record(static_cast<std::int64_t>(value));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+} // namespace
+
+TEST_CASE("benchmark: record operation latencies from multiple threads", "[benchmark]")
+{
+  asio::io_context io{};
+  auto meter = std::make_shared<couchbase::core::metrics::logging_meter>(
+    io, couchbase::core::metrics::logging_meter_options{});
+  couchbase::core::metrics::operation_recorders recorders(meter);
+
+  for (std::size_t number_of_threads : { 1, 4, 8 }) {
+    BENCHMARK(std::to_string(number_of_threads) + " threads, lookup per operation")
+    {
+      static const std::string meter_name = "db.couchbase.operations";
+      static const std::map<std::string, std::string> tags = {
+        { "db.couchbase.service", "kv" },
+        { "db.operation", fmt::format("{}", client_opcode::get) },
+      };
+      record_concurrently(number_of_threads, [&meter](std::int64_t value) {
+        meter->get_value_recorder(meter_name, tags)->record_value(value);
+      });
+    };
+
+    BENCHMARK(std::to_string(number_of_threads) + " threads, cached recorder")
+    {
+      record_concurrently(number_of_threads, [&recorders](std::int64_t value) {
+        recorders.recorder(client_opcode::get)->record_value(value);
+      });
+    };
+  }
+}
+
+TEST_CASE("unit: operation recorders resolve each opcode once", "[unit]")
+{
+  asio::io_context io{};
+  auto meter = std::make_shared<couchbase::core::metrics::logging_meter>(
+    io, couchbase::core::metrics::logging_meter_options{});
+  couchbase::core::metrics::operation_recorders recorders(meter);
+
+  auto* get = recorders.recorder(client_opcode::get);
+  auto* upsert = recorders.recorder(client_opcode::upsert);
+  REQUIRE(get != nullptr);
+  REQUIRE(upsert != nullptr);
+  REQUIRE(get != upsert);
+  REQUIRE(recorders.recorder(client_opcode::get) == get);
+
+  std::map<std::string, std::string> tags = {
+    { "db.couchbase.service", "kv" },
+    { "db.operation", fmt::format("{}", client_opcode::get) },
+  };
+  REQUIRE(meter->get_value_recorder("db.couchbase.operations", tags).get() == get);
+
+  record_concurrently(4, [get](std::int64_t value) {
+    get->record_value(value);
+  });
+}
@@ -0,0 +1,52 @@
+/*
+ *     Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/transactions/staged_mutation.hxx"
+
+#include <string>
+#include <vector>
+
+using couchbase::core::transactions::staged_mutation;
+using couchbase::core::transactions::staged_mutation_queue;
+using couchbase::core::transactions::staged_mutation_type;
+using couchbase::core::transactions::transaction_get_result;
+
+TEST_CASE("benchmark: stage mutations and check for own writes", "[benchmark]")
+{
+  for (std::size_t number_of_mutations : { 100, 1'000, 10'000, 50'000 }) {
+    std::vector<couchbase::core::document_id> ids;
+    ids.reserve(number_of_mutations);
+    for (std::size_t i = 0; i < number_of_mutations; ++i) {
+      ids.emplace_back("default", "_default", "_default", "doc-" + std::to_string(i));
+    }
+
+    BENCHMARK(std::to_string(number_of_mutations) + " mutations")
+    {
+      staged_mutation_queue queue;
+      for (const auto& id : ids) {
+        // every write inside the transaction checks whether the document is staged already
+        if (queue.find_any(id) == nullptr) {
+          queue.add(staged_mutation(
+            transaction_get_result(id, {}, 0, {}, {}), {}, staged_mutation_type::REPLACE, "op"));
+        }
+        REQUIRE(queue.find_replace(id) != nullptr);
+      }
+      return queue.empty();
+    };
+  }
+}
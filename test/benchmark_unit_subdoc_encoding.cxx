@@ -0,0 +1,80 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "benchmark_helper.hxx"
+
+#include "core/operations/document_mutate_in.hxx"
+
+#include <couchbase/mutate_in_specs.hxx>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace
+{
+/* a document with counters and flags, where every spec touches a separate field */
+auto
+make_specs(std::size_t number_of_specs) -> couchbase::mutate_in_specs
+{
+  couchbase::mutate_in_specs specs{};
+  for (std::size_t i = 0; i < number_of_specs; ++i) {
+    if (i % 2 == 0) {
+      specs.push_back(couchbase::mutate_in_specs::increment("counters.c" + std::to_string(i), 1));
+    } else {
+      specs.push_back(couchbase::mutate_in_specs::upsert("flags.f" + std::to_string(i), true));
+    }
+  }
+  return specs;
+}
+} // namespace
+
+TEST_CASE("benchmark: encode mutate_in requests", "[benchmark]")
+{
+  const std::optional<couchbase::core::topology::configuration> config{};
+  const std::vector<couchbase::core::protocol::hello_feature> features{};
+  const couchbase::core::document_id id{ "default", "_default", "_default", "counters" };
+
+  for (std::size_t number_of_specs : { 1, 16, 64 }) {
+    const auto specs = make_specs(number_of_specs);
+    const auto suffix = std::to_string(number_of_specs) + " specs";
+
+    BENCHMARK("build specs, " + suffix)
+    {
+      return make_specs(number_of_specs);
+    };
+
+    BENCHMARK("encode request, " + suffix)
+    {
+      couchbase::core::operations::mutate_in_request request{ id };
+      request.specs = specs.specs();
+      couchbase::core::operations::mutate_in_request::encoded_request_type encoded{};
+      static_cast<void>(request.encode_to(encoded, { config, features }));
+      return encoded.data();
+    };
+
+    couchbase::core::operations::mutate_in_request retried{ id };
+    retried.specs = specs.specs();
+    couchbase::core::operations::mutate_in_request::encoded_request_type reused{};
+    BENCHMARK("encode retried request, " + suffix)
+    {
+      static_cast<void>(retried.encode_to(reused, { config, features }));
+      return reused.data();
+    };
+  }
+}
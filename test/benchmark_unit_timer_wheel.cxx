@@ -0,0 +1,68 @@
+/*
+ *     Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/io/timer_wheel.hxx"
+
+#include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+
+#include <memory>
+#include <vector>
+
+using couchbase::core::io::timer_wheel;
+using couchbase::core::io::timer_wheel_entry;
+
+TEST_CASE("benchmark: arm and cancel operation deadlines", "[benchmark]")
+{
+  for (std::size_t number_of_operations : { 10'000, 100'000, 500'000 }) {
+    asio::io_context io{};
+
+    // every operation arms its deadline when dispatched, and cancels it when the response arrives
+    BENCHMARK(std::to_string(number_of_operations) + " asio::steady_timer")
+    {
+      std::vector<std::unique_ptr<asio::steady_timer>> timers;
+      timers.reserve(number_of_operations);
+      for (std::size_t i = 0; i < number_of_operations; ++i) {
+        auto& timer = timers.emplace_back(std::make_unique<asio::steady_timer>(io));
+        timer->expires_after(std::chrono::milliseconds(2'500 + i % 1'000));
+        timer->async_wait([](std::error_code /* ec */) {
+        });
+      }
+      for (auto& timer : timers) {
+        timer->cancel();
+      }
+      return io.poll();
+    };
+
+    BENCHMARK(std::to_string(number_of_operations) + " timer_wheel")
+    {
+      auto wheel = std::make_shared<timer_wheel>(io);
+      std::vector<std::unique_ptr<timer_wheel_entry>> entries;
+      entries.reserve(number_of_operations);
+      for (std::size_t i = 0; i < number_of_operations; ++i) {
+        auto& entry = entries.emplace_back(std::make_unique<timer_wheel_entry>());
+        wheel->schedule_after(*entry, std::chrono::milliseconds(2'500 + i % 1'000), []() {
+        });
+      }
+      for (auto& entry : entries) {
+        wheel->cancel(*entry);
+      }
+      return io.poll();
+    };
+  }
+}
@@ -29,6 +29,8 @@
 #include "core/operations/document_upsert.hxx"
 #include "core/utils/binary.hxx"
 
+#include <couchbase/cluster.hxx>
+
 TEST_CASE("integration: append", "[integration]")
 {
   test::utils::integration_test_guard integration;
@@ -118,3 +120,97 @@ TEST_CASE("integration: binary ops on missing document", "[integration]")
     REQUIRE(resp.ctx.ec() == couchbase::errc::key_value::document_not_found);
   }
 }
+
+TEST_CASE("integration: large object upload and download", "[integration]")
+{
+  test::utils::integration_test_guard integration;
+
+  auto test_ctx = integration.ctx;
+  auto [e, cluster] =
+    couchbase::cluster::connect(test_ctx.connection_string, test_ctx.build_options()).get();
+  REQUIRE_SUCCESS(e.ec());
+
+  auto collection = cluster.bucket(integration.ctx.bucket)
+                      .scope(couchbase::scope::default_name)
+                      .collection(couchbase::collection::default_name);
+  auto id = test::utils::uniq_id("blob");
+  const auto options = couchbase::large_object_options{}.chunk_size(1000).max_in_flight_chunks(2);
+
+  std::vector<std::byte> expected{};
+  {
+    auto writer = collection.binary().open_writer(id, options);
+    for (std::size_t i = 0; i < 10; ++i) {
+      std::vector<std::byte> part(777, static_cast<std::byte>(i));
+      expected.insert(expected.end(), part.begin(), part.end());
+      REQUIRE_SUCCESS(writer.write(std::move(part)).get().ec());
+    }
+    auto [err, result] = writer.close().get();
+    REQUIRE_SUCCESS(err.ec());
+    REQUIRE_FALSE(result.cas().empty());
+  }
+
+  {
+    auto [err, reader] = collection.binary().open_reader(id, options).get();
+    REQUIRE_SUCCESS(err.ec());
+    REQUIRE(reader.size() == expected.size());
+
+    std::vector<std::byte> actual{};
+    std::size_t number_of_chunks{ 0 };
+    while (true) {
+      auto [read_err, chunk] = reader.read().get();
+      REQUIRE_SUCCESS(read_err.ec());
+      if (!chunk) {
+        break;
+      }
+      ++number_of_chunks;
+      actual.insert(actual.end(), chunk->begin(), chunk->end());
+    }
+    REQUIRE(number_of_chunks == 8);
+    REQUIRE(actual == expected);
+  }
+
+  {
+    /* the rewritten object uses a new generation of chunks */
+    auto [stale_err, stale_reader] = collection.binary().open_reader(id, options).get();
+    REQUIRE_SUCCESS(stale_err.ec());
+
+    std::vector<std::byte> rewritten(1500, std::byte{ 42 });
+    auto writer = collection.binary().open_writer(id, options);
+    REQUIRE_SUCCESS(writer.write(rewritten).get().ec());
+    auto [err, result] = writer.close().get();
+    REQUIRE_SUCCESS(err.ec());
+
+    /* the replaced chunks expire after the grace period, so the old reader still finishes */
+    std::vector<std::byte> stale{};
+    while (true) {
+      auto [read_err, chunk] = stale_reader.read().get();
+      REQUIRE_SUCCESS(read_err.ec());
+      if (!chunk) {
+        break;
+      }
+      stale.insert(stale.end(), chunk->begin(), chunk->end());
+    }
+    REQUIRE(stale == expected);
+
+    auto [open_err, reader] = collection.binary().open_reader(id, options).get();
+    REQUIRE_SUCCESS(open_err.ec());
+    REQUIRE(reader.size() == rewritten.size());
+    std::vector<std::byte> actual{};
+    while (true) {
+      auto [read_err, chunk] = reader.read().get();
+      REQUIRE_SUCCESS(read_err.ec());
+      if (!chunk) {
+        break;
+      }
+      actual.insert(actual.end(), chunk->begin(), chunk->end());
+    }
+    REQUIRE(actual == rewritten);
+  }
+
+  {
+    auto [err, resp] = collection.upsert(id, tao::json::value{ { "a", 1 } }, {}).get();
+    REQUIRE_SUCCESS(err.ec());
+    auto [open_err, reader] = collection.binary().open_reader(id, options).get();
+    REQUIRE(open_err.ec() == couchbase::errc::common::decoding_failure);
+  }
+}
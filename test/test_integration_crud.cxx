@@ -38,6 +38,7 @@
 #include "core/operations/document_upsert.hxx"
 
 #include <couchbase/cluster.hxx>
+#include <couchbase/codec/raw_json_transcoder.hxx>
 #include <couchbase/lookup_in_specs.hxx>
 #include <couchbase/mutate_in_specs.hxx>
 
@@ -1093,3 +1094,155 @@ TEST_CASE("integration: get with expiry with public API", "[integration]")
     }
   }
 }
+
+TEST_CASE("integration: multi-document operations with public API", "[integration]")
+{
+  test::utils::integration_test_guard integration;
+
+  auto test_ctx = integration.ctx;
+  auto [e, cluster] =
+    couchbase::cluster::connect(test_ctx.connection_string, test_ctx.build_options()).get();
+  REQUIRE_SUCCESS(e.ec());
+
+  auto collection = cluster.bucket(integration.ctx.bucket)
+                      .scope(couchbase::scope::default_name)
+                      .collection(couchbase::collection::default_name);
+
+  std::vector<std::string> ids{};
+  std::vector<std::pair<std::string, tao::json::value>> documents{};
+  for (int i = 0; i < 64; ++i) {
+    ids.emplace_back(test::utils::uniq_id("multi"));
+    documents.emplace_back(ids.back(), tao::json::value{ { "index", i } });
+  }
+  auto missing_id = test::utils::uniq_id("multi_missing");
+
+  {
+    auto results = collection.upsert_multi(documents).get();
+    REQUIRE(results.size() == ids.size());
+    for (const auto& [err, resp] : results) {
+      REQUIRE_SUCCESS(err.ec());
+      REQUIRE_FALSE(resp.cas().empty());
+    }
+  }
+
+  {
+    auto keys = ids;
+    keys.emplace_back(missing_id);
+    auto results = collection.get_multi(keys).get();
+    REQUIRE(results.size() == keys.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+      const auto& [err, resp] = results[i];
+      REQUIRE_SUCCESS(err.ec());
+      REQUIRE(resp.content_as<tao::json::value>() == documents[i].second);
+    }
+    REQUIRE(results.back().first.ec() == couchbase::errc::key_value::document_not_found);
+  }
+
+  {
+    auto results = collection.remove_multi(ids).get();
+    REQUIRE(results.size() == ids.size());
+    for (const auto& [err, resp] : results) {
+      REQUIRE_SUCCESS(err.ec());
+    }
+  }
+
+  {
+    auto results = collection.get_multi(ids).get();
+    for (const auto& [err, resp] : results) {
+      REQUIRE(err.ec() == couchbase::errc::key_value::document_not_found);
+    }
+  }
+}
+
+TEST_CASE("integration: zero-copy get with public API", "[integration]")
+{
+  test::utils::integration_test_guard integration;
+
+  auto test_ctx = integration.ctx;
+  auto [e, cluster] =
+    couchbase::cluster::connect(test_ctx.connection_string, test_ctx.build_options()).get();
+  REQUIRE_SUCCESS(e.ec());
+
+  auto collection = cluster.bucket(integration.ctx.bucket)
+                      .scope(couchbase::scope::default_name)
+                      .collection(couchbase::collection::default_name);
+
+  auto id = test::utils::uniq_id("zero_copy");
+  const std::string content{ R"({"answer":42})" };
+  {
+    auto [err, resp] = collection.upsert<couchbase::codec::raw_json_transcoder>(id, content).get();
+    REQUIRE_SUCCESS(err.ec());
+  }
+
+  couchbase::codec::encoded_value_view view{};
+  {
+    auto [err, resp] = collection.get(id, couchbase::get_options{}.zero_copy(true)).get();
+    REQUIRE_SUCCESS(err.ec());
+    view = resp.content_as_view();
+    REQUIRE(view.owner() != nullptr);
+    REQUIRE(resp.content_as<tao::json::value>() == tao::json::value{ { "answer", 42 } });
+  }
+  // the view keeps the network buffer alive after the result is gone
+  REQUIRE(view.as_string_view() == content);
+  REQUIRE(view.flags() == couchbase::codec::codec_flags::json_common_flags);
+
+  {
+    auto [err, resp] = collection.get(id).get();
+    REQUIRE_SUCCESS(err.ec());
+    REQUIRE(resp.content_as_view().owner() == nullptr);
+    REQUIRE(resp.content_as_view().as_string_view() == content);
+  }
+}
+
+TEST_CASE("integration: hedged reads with public API", "[integration]")
+{
+  test::utils::integration_test_guard integration;
+
+  auto test_ctx = integration.ctx;
+  auto [e, cluster] =
+    couchbase::cluster::connect(test_ctx.connection_string, test_ctx.build_options()).get();
+  REQUIRE_SUCCESS(e.ec());
+
+  auto collection = cluster.bucket(integration.ctx.bucket)
+                      .scope(couchbase::scope::default_name)
+                      .collection(couchbase::collection::default_name);
+
+  auto id = test::utils::uniq_id("hedged_read");
+  const tao::json::value content{ { "answer", 42 } };
+  couchbase::cas cas{};
+  {
+    auto [err, resp] = collection.upsert(id, content).get();
+    REQUIRE_SUCCESS(err.ec());
+    cas = resp.cas();
+  }
+
+  {
+    auto [err, resp] = collection.get(id, couchbase::get_options{}.hedged_read(true)).get();
+    REQUIRE_SUCCESS(err.ec());
+    REQUIRE(resp.content_as<tao::json::value>() == content);
+    // a replica that has not received the document yet fails, and its response is ignored
+    REQUIRE(resp.cas() == cas);
+    if (integration.number_of_replicas() == 0) {
+      REQUIRE_FALSE(resp.is_replica());
+    }
+  }
+
+  {
+    auto [err, resp] = collection
+                         .lookup_in(id,
+                                    couchbase::lookup_in_specs{
+                                      couchbase::lookup_in_specs::get("answer"),
+                                    },
+                                    couchbase::lookup_in_options{}.hedged_read(true))
+                         .get();
+    REQUIRE_SUCCESS(err.ec());
+    REQUIRE(resp.content_as<int>(0) == 42);
+  }
+
+  {
+    auto [err, resp] =
+      collection.get(test::utils::uniq_id("missing"), couchbase::get_options{}.hedged_read(true))
+        .get();
+    REQUIRE(err.ec() == couchbase::errc::key_value::document_not_found);
+  }
+}
@@ -145,6 +145,43 @@ TEST_CASE("integration: legacy durability persist to active and replicate to one
   }
 }
 
+TEST_CASE("integration: legacy durability for many concurrent mutations", "[integration]")
+{
+  test::utils::integration_test_guard integration;
+  if (integration.number_of_replicas() == 0) {
+    SKIP("bucket has zero replicas");
+  }
+  if (integration.number_of_nodes() <= integration.number_of_replicas()) {
+    SKIP(fmt::format("number of nodes ({}) is less or equal to number of replicas ({})",
+                     integration.number_of_nodes(),
+                     integration.number_of_replicas()));
+  }
+
+  auto test_ctx = integration.ctx;
+  auto [e, cluster] =
+    couchbase::cluster::connect(test_ctx.connection_string, test_ctx.build_options()).get();
+  REQUIRE_SUCCESS(e.ec());
+
+  auto collection = cluster.bucket(integration.ctx.bucket)
+                      .scope(couchbase::scope::default_name)
+                      .collection(couchbase::collection::default_name);
+
+  // enough documents to put several waiters on the same partitions
+  std::vector<std::pair<std::string, profile>> documents{};
+  for (int i = 0; i < 2'048; ++i) {
+    documents.emplace_back(test::utils::uniq_id("upsert_legacy_multi"),
+                           profile{ "fry", "Philip J. Fry", 1974 });
+  }
+  auto options = couchbase::upsert_options{}.durability(couchbase::persist_to::active,
+                                                        couchbase::replicate_to::one);
+  auto results = collection.upsert_multi(documents, options).get();
+  REQUIRE(results.size() == documents.size());
+  for (const auto& [err, result] : results) {
+    REQUIRE_SUCCESS(err.ec());
+    REQUIRE(result.mutation_token().has_value());
+  }
+}
+
 TEST_CASE("integration: low level legacy durability impossible if number of nodes too high",
           "[integration]")
 {
@@ -20,6 +20,10 @@
 
 #include "core/transactions.hxx"
 #include "core/transactions/atr_ids.hxx"
+#include "core/transactions/attempt_context_impl.hxx"
+#include "core/transactions/attempt_context_testing_hooks.hxx"
+#include "core/transactions/internal/transaction_context.hxx"
+#include "core/transactions/internal/transactions_cleanup.hxx"
 
 #include <spdlog/spdlog.h>
 #include <tao/json.hpp>
@@ -1199,3 +1203,122 @@ TEST_CASE("transactions: sergey example", "[transactions]")
       CHECK_FALSE(remove_res.has_value());
     }));
 }
+
+TEST_CASE("transactions: get_multi returns present and missing documents in order",
+          "[transactions]")
+{
+  test::utils::integration_test_guard integration;
+  auto txn = integration.transactions();
+  couchbase::core::document_id first{
+    integration.ctx.bucket, "_default", "_default", test::utils::uniq_id("txn")
+  };
+  couchbase::core::document_id missing{
+    integration.ctx.bucket, "_default", "_default", test::utils::uniq_id("txn")
+  };
+  couchbase::core::document_id second{
+    integration.ctx.bucket, "_default", "_default", test::utils::uniq_id("txn")
+  };
+  for (const auto& id : { first, second }) {
+    couchbase::core::operations::upsert_request req{ id, content_json.data };
+    req.flags = content_json.flags;
+    auto resp = test::utils::execute(integration.cluster, req);
+    REQUIRE_SUCCESS(resp.ctx.ec());
+  }
+
+  REQUIRE_NOTHROW(
+    txn->run([&](std::shared_ptr<couchbase::core::transactions::attempt_context> ctx) {
+      auto results = ctx->get_multi({ first, missing, second });
+      REQUIRE(results.size() == 3);
+      REQUIRE(results[0].has_value());
+      CHECK(results[0]->id().key() == first.key());
+      CHECK(results[0]->content<tao::json::value>() == content);
+      CHECK_FALSE(results[1].has_value());
+      REQUIRE(results[2].has_value());
+      CHECK(results[2]->id().key() == second.key());
+      CHECK(results[2]->content<tao::json::value>() == content);
+    }));
+}
+
+TEST_CASE("transactions: get_multi resolves documents staged by another transaction",
+          "[transactions]")
+{
+  test::utils::integration_test_guard integration;
+  auto txn = integration.transactions();
+  couchbase::core::document_id first{
+    integration.ctx.bucket, "_default", "_default", test::utils::uniq_id("txn")
+  };
+  couchbase::core::document_id second{
+    integration.ctx.bucket, "_default", "_default", test::utils::uniq_id("txn")
+  };
+  for (const auto& id : { first, second }) {
+    couchbase::core::operations::upsert_request req{ id, content_json.data };
+    req.flags = content_json.flags;
+    auto resp = test::utils::execute(integration.cluster, req);
+    REQUIRE_SUCCESS(resp.ctx.ec());
+  }
+
+  // stage replacements of both documents, and leave the attempt pending
+  const tao::json::value staged_content{
+    { "some_number", 42 },
+  };
+  auto staging = couchbase::core::transactions::transaction_context::create(*txn);
+  staging->new_attempt_context();
+  auto attempt = staging->current_attempt_context();
+  attempt->replace(attempt->get(first), staged_content);
+  attempt->replace(attempt->get(second), staged_content);
+
+  auto lookups_before = txn->cleanup().atr_lookups_ref().stats().lookups;
+  REQUIRE_NOTHROW(
+    txn->run([&](std::shared_ptr<couchbase::core::transactions::attempt_context> ctx) {
+      // the other attempt is still pending, so its staged content must not be visible
+      auto results = ctx->get_multi({ first, second });
+      REQUIRE(results.size() == 2);
+      REQUIRE(results[0].has_value());
+      CHECK(results[0]->content<tao::json::value>() == content);
+      REQUIRE(results[1].has_value());
+      CHECK(results[1]->content<tao::json::value>() == content);
+    }));
+  // both documents have been resolved against the ATR of the pending attempt
+  CHECK(txn->cleanup().atr_lookups_ref().stats().lookups >= lookups_before + 2);
+
+  REQUIRE_NOTHROW(attempt->rollback());
+}
+
+TEST_CASE("transactions: get_multi fails the transaction when one document fails",
+          "[transactions]")
+{
+  test::utils::integration_test_guard integration;
+  couchbase::core::document_id first{
+    integration.ctx.bucket, "_default", "_default", test::utils::uniq_id("txn")
+  };
+  couchbase::core::document_id failing{
+    integration.ctx.bucket, "_default", "_default", test::utils::uniq_id("txn")
+  };
+  for (const auto& id : { first, failing }) {
+    couchbase::core::operations::upsert_request req{ id, content_json.data };
+    req.flags = content_json.flags;
+    auto resp = test::utils::execute(integration.cluster, req);
+    REQUIRE_SUCCESS(resp.ctx.ec());
+  }
+
+  auto cfg = get_conf();
+  cfg.attempt_context_hooks().before_doc_get =
+    [failing](auto /* ctx */, const std::string& key, auto&& handler) {
+      if (key == failing.key()) {
+        return handler(couchbase::core::transactions::FAIL_HARD);
+      }
+      return handler(std::nullopt);
+    };
+  auto [ec, txn] = couchbase::core::transactions::transactions::create(integration.cluster, cfg)
+                     .get();
+  REQUIRE_SUCCESS(ec);
+
+  bool completed_batch = false;
+  REQUIRE_THROWS_AS(
+    txn->run([&](std::shared_ptr<couchbase::core::transactions::attempt_context> ctx) {
+      ctx->get_multi({ first, failing });
+      completed_batch = true;
+    }),
+    couchbase::core::transactions::transaction_exception);
+  REQUIRE_FALSE(completed_batch);
+}
@@ -0,0 +1,121 @@
+/*
+ *     Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/collection_uid_cache.hxx"
+#include "core/topology/collections_manifest.hxx"
+
+#include <fmt/core.h>
+
+#include <atomic>
+#include <thread>
+
+using couchbase::core::io::collection_uid_cache;
+
+namespace
+{
+auto
+make_manifest(std::uint64_t uid, std::size_t number_of_collections)
+  -> couchbase::core::topology::collections_manifest
+{
+  couchbase::core::topology::collections_manifest manifest{};
+  manifest.uid = uid;
+  auto& scope = manifest.scopes.emplace_back();
+  scope.uid = 8;
+  scope.name = "inventory";
+  for (std::size_t i = 0; i < number_of_collections; ++i) {
+    auto& collection = scope.collections.emplace_back();
+    collection.uid = 8 + i;
+    collection.name = fmt::format("collection_{}", i);
+  }
+  return manifest;
+}
+} // namespace
+
+TEST_CASE("unit: collection uid cache resolves default collection", "[unit]")
+{
+  collection_uid_cache cache{};
+  REQUIRE(cache.get("_default._default") == 0);
+  REQUIRE_FALSE(cache.get("inventory.airline").has_value());
+  REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE("unit: collection uid cache is populated from manifest", "[unit]")
+{
+  collection_uid_cache cache{};
+  cache.populate(make_manifest(0x12, 1'000));
+  REQUIRE(cache.manifest_uid() == 0x12);
+  REQUIRE(cache.size() == 1'000);
+  REQUIRE(cache.get("inventory.collection_0") == 8);
+  REQUIRE(cache.get("inventory.collection_999") == 1'007);
+
+  /* older manifest does not overwrite the cache */
+  cache.populate(make_manifest(0x11, 1));
+  REQUIRE(cache.size() == 1'000);
+}
+
+TEST_CASE("unit: collection uid cache is invalidated by newer manifest uid", "[unit]")
+{
+  collection_uid_cache cache{};
+  REQUIRE(cache.invalidate(0x12));
+  cache.update("inventory.airline", 9, 0x12);
+  REQUIRE(cache.get("inventory.airline") == 9);
+
+  REQUIRE_FALSE(cache.invalidate(0x12));
+  REQUIRE(cache.get("inventory.airline") == 9);
+
+  REQUIRE(cache.invalidate(0x13));
+  REQUIRE_FALSE(cache.get("inventory.airline").has_value());
+  REQUIRE(cache.manifest_uid() == 0x13);
+
+  /* late response, resolved against the old manifest, is ignored */
+  cache.update("inventory.airline", 9, 0x12);
+  REQUIRE_FALSE(cache.get("inventory.airline").has_value());
+
+  cache.update("inventory.airline", 10, 0x13);
+  REQUIRE(cache.get("inventory.airline") == 10);
+  cache.remove("inventory.airline");
+  REQUIRE_FALSE(cache.get("inventory.airline").has_value());
+}
+
+TEST_CASE("unit: collection uid cache can be shared between threads", "[unit]")
+{
+  collection_uid_cache cache{};
+  cache.populate(make_manifest(1, 64));
+
+  std::atomic_size_t mismatches{ 0 };
+  std::vector<std::thread> threads;
+  for (std::uint32_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&cache, &mismatches, t]() {
+      for (std::uint32_t i = 0; i < 10'000; ++i) {
+        auto index = (i + t) % 64;
+        auto path = fmt::format("inventory.collection_{}", index);
+        if (i % 16 == 0) {
+          cache.update(path, 8 + index, 1);
+        }
+        if (cache.get(path) != 8 + index) {
+          ++mismatches;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  REQUIRE(mismatches == 0);
+  REQUIRE(cache.size() == 64);
+}
@@ -0,0 +1,101 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "test_helper.hxx"
+
+#include "core/utils/concurrency_limiter.hxx"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+void
+fill(couchbase::core::utils::concurrency_limiter& limiter)
+{
+  while (limiter.try_acquire()) {
+  }
+}
+} // namespace
+
+TEST_CASE("unit: concurrency limiter admits up to the limit", "[unit]")
+{
+  couchbase::core::utils::concurrency_limiter limiter{ { 4, 2, 16 } };
+  REQUIRE(limiter.limit() == 4);
+  fill(limiter);
+  REQUIRE(limiter.in_flight() == 4);
+  REQUIRE_FALSE(limiter.try_acquire());
+
+  limiter.on_ignored();
+  REQUIRE(limiter.in_flight() == 3);
+  REQUIRE(limiter.limit() == 4);
+  REQUIRE(limiter.try_acquire());
+}
+
+TEST_CASE("unit: concurrency limiter grows while it is used", "[unit]")
+{
+  couchbase::core::utils::concurrency_limiter limiter{ { 4, 2, 6 } };
+  for (int i = 0; i < 10; ++i) {
+    fill(limiter);
+    limiter.on_success(100us);
+  }
+  REQUIRE(limiter.limit() == 6);
+
+  SECTION("but not when most of it is idle")
+  {
+    couchbase::core::utils::concurrency_limiter idle{ { 8, 2, 64 } };
+    for (int i = 0; i < 100; ++i) {
+      REQUIRE(idle.try_acquire());
+      idle.on_success(100us);
+    }
+    REQUIRE(idle.limit() == 8);
+  }
+}
+
+TEST_CASE("unit: concurrency limiter backs off once per window", "[unit]")
+{
+  couchbase::core::utils::concurrency_limiter limiter{ { 100, 10, 1'000 } };
+  fill(limiter);
+  for (int i = 0; i < 99; ++i) {
+    limiter.on_dropped();
+  }
+  REQUIRE(limiter.limit() == 100);
+  limiter.on_dropped();
+  REQUIRE(limiter.limit() == 90);
+
+  for (int i = 0; i < 1'000; ++i) {
+    REQUIRE(limiter.try_acquire());
+    limiter.on_dropped();
+  }
+  REQUIRE(limiter.limit() == 10);
+}
+
+TEST_CASE("unit: concurrency limiter backs off when latency jumps", "[unit]")
+{
+  couchbase::core::utils::concurrency_limiter limiter{ { 32, 4, 32 } };
+  for (int i = 0; i < 1'000; ++i) {
+    REQUIRE(limiter.try_acquire());
+    limiter.on_success(100us);
+  }
+  REQUIRE(limiter.limit() == 32);
+
+  for (int i = 0; i < 200; ++i) {
+    REQUIRE(limiter.try_acquire());
+    limiter.on_success(10ms);
+  }
+  REQUIRE(limiter.limit() < 32);
+}
@@ -0,0 +1,89 @@
+/*
+ *     Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/protocol/cmd_get_cluster_config.hxx"
+#include "core/topology/config_revision.hxx"
+
+using couchbase::core::topology::config_revision;
+using couchbase::core::topology::scan_config_revision;
+
+namespace
+{
+constexpr auto bucket_config = R"({
+  "rev": 1073,
+  "nodesExt": [
+    {
+      "services": { "mgmt": 8091, "kv": 11210 },
+      "thisNode": true,
+      "hostname": "192.168.106.128"
+    }
+  ],
+  "clusterCapabilitiesVer": [1, 0],
+  "name": "default",
+  "nodeLocator": "vbucket",
+  "uuid": "a1fd1e8d2da3b0f2cd9f0cf3ae3c1d30",
+  "ddocs": { "uri": "/pools/default/buckets/default/ddocs" },
+  "vBucketServerMap": {
+    "hashAlgorithm": "CRC",
+    "numReplicas": 0,
+    "serverList": ["192.168.106.128:11210"],
+    "vBucketMap": [[0], [0], [0], [0]]
+  },
+  "bucketCapabilitiesVer": "",
+  "bucketCapabilities": ["collections", "durableWrite", "tombstonedUserXAttrs", "xattr"],
+  "revEpoch": 2
+})";
+} // namespace
+
+TEST_CASE("unit: scan revision of the cluster map", "[unit]")
+{
+  auto revision = scan_config_revision(bucket_config);
+  REQUIRE(revision.has_value());
+  REQUIRE(revision->rev == 1073);
+  REQUIRE(revision->epoch == 2);
+
+  auto config = couchbase::core::protocol::parse_config(bucket_config, "192.168.106.128", 11210);
+  REQUIRE(revision.value() == config_revision{ config.epoch, config.rev });
+}
+
+TEST_CASE("unit: scan revision skips nested values and strings", "[unit]")
+{
+  auto revision = scan_config_revision(
+    R"({"nodes":[{"rev":1,"revEpoch":5}],"name":"a\"}rev","rev":42})");
+  REQUIRE(revision.has_value());
+  REQUIRE(revision->rev == 42);
+  REQUIRE_FALSE(revision->epoch.has_value());
+}
+
+TEST_CASE("unit: scan revision falls back on unexpected input", "[unit]")
+{
+  REQUIRE_FALSE(scan_config_revision("").has_value());
+  REQUIRE_FALSE(scan_config_revision("[]").has_value());
+  REQUIRE_FALSE(scan_config_revision(R"({"name":"default"})").has_value());
+  REQUIRE_FALSE(scan_config_revision(R"({"rev":"1073"})").has_value());
+  REQUIRE_FALSE(scan_config_revision(R"({"rev":10.5})").has_value());
+  REQUIRE_FALSE(scan_config_revision(R"({"rev":1073,"name":"def)").has_value());
+}
+
+TEST_CASE("unit: config revisions are ordered by epoch first", "[unit]")
+{
+  REQUIRE(config_revision{ 1, 100 } < config_revision{ 2, 1 });
+  REQUIRE(config_revision{ 2, 1 } < config_revision{ 2, 2 });
+  REQUIRE(config_revision{ {}, 100 } < config_revision{ 0, 1 });
+  REQUIRE_FALSE(config_revision{ 2, 2 } < config_revision{ 2, 2 });
+}
@@ -0,0 +1,106 @@
+/*
+ *     Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/topology/configuration_delta.hxx"
+
+using couchbase::core::topology::configuration;
+using couchbase::core::topology::make_configuration_delta;
+
+namespace
+{
+auto
+make_node(std::size_t index, const std::string& hostname) -> configuration::node
+{
+  configuration::node node{};
+  node.index = index;
+  node.hostname = hostname;
+  node.services_plain.key_value = 11210;
+  node.services_plain.management = 8091;
+  return node;
+}
+
+auto
+make_config(std::int64_t rev, const std::vector<std::string>& hostnames) -> configuration
+{
+  configuration config{};
+  config.epoch = 1;
+  config.rev = rev;
+  for (const auto& hostname : hostnames) {
+    config.nodes.emplace_back(make_node(config.nodes.size(), hostname));
+  }
+  config.vbmap = configuration::vbucket_map{ { 0, 1 }, { 1, 0 }, { 0, 1 }, { 1, 0 } };
+  return config;
+}
+} // namespace
+
+TEST_CASE("unit: delta of the first configuration adds all nodes", "[unit]")
+{
+  auto next = make_config(10, { "node1", "node2" });
+  auto delta = make_configuration_delta({}, next);
+  REQUIRE_FALSE(delta.previous_revision.has_value());
+  REQUIRE(delta.revision.rev == 10);
+  REQUIRE(delta.added_nodes.size() == 2);
+  REQUIRE(delta.removed_nodes.empty());
+  REQUIRE(delta.nodes_changed());
+  REQUIRE(delta.vbucket_map_resized);
+}
+
+TEST_CASE("unit: delta of the identical configuration is empty", "[unit]")
+{
+  auto previous = make_config(10, { "node1", "node2" });
+  auto next = make_config(11, { "node1", "node2" });
+  auto delta = make_configuration_delta(previous, next);
+  REQUIRE(delta.previous_revision.has_value());
+  REQUIRE(delta.previous_revision->rev == 10);
+  REQUIRE(delta.revision.rev == 11);
+  REQUIRE(delta.empty());
+}
+
+TEST_CASE("unit: delta reports node membership and vbucket moves", "[unit]")
+{
+  auto previous = make_config(10, { "node1", "node2" });
+  auto next = make_config(11, { "node2", "node3" });
+  next.vbmap = configuration::vbucket_map{ { 0, 1 }, { 0, 1 }, { 0, 1 }, { 1, 0 } };
+
+  auto delta = make_configuration_delta(previous, next);
+  REQUIRE(delta.added_nodes.size() == 1);
+  REQUIRE(delta.added_nodes[0].hostname == "node3");
+  REQUIRE(delta.removed_nodes.size() == 1);
+  REQUIRE(delta.removed_nodes[0].hostname == "node1");
+  REQUIRE(delta.nodes_reordered);
+  REQUIRE(delta.moved_vbuckets == std::vector<std::uint16_t>{ 1 });
+  REQUIRE_FALSE(delta.vbucket_map_resized);
+}
+
+TEST_CASE("unit: delta reports changed services and capabilities", "[unit]")
+{
+  auto previous = make_config(10, { "node1", "node2" });
+  auto next = make_config(11, { "node1", "node2" });
+  next.nodes[1].services_plain.query = 8093;
+  next.capabilities.cluster.insert(
+    couchbase::core::cluster_capability::n1ql_enhanced_prepared_statements);
+
+  auto delta = make_configuration_delta(previous, next);
+  REQUIRE(delta.added_nodes.empty());
+  REQUIRE(delta.removed_nodes.empty());
+  REQUIRE_FALSE(delta.nodes_reordered);
+  REQUIRE(delta.changed_nodes.size() == 1);
+  REQUIRE(delta.changed_nodes[0].hostname == "node2");
+  REQUIRE(delta.capabilities_changed);
+  REQUIRE(delta.moved_vbuckets.empty());
+}
@@ -446,6 +446,23 @@ TEST_CASE("unit: connection string", "[unit]")
         "1%3B%20v8%2F7.7.299.11-node.12%3B%20ssl%2F1.1.1c)");
       CHECK(spec.options.user_agent_extra ==
             "couchnode/4.1.1 (node/12.11.1; v8/7.7.299.11-node.12; ssl/1.1.1c)");
+
+      spec = couchbase::core::utils::parse_connection_string(
+        "couchbase://127.0.0.1?write_coalescing_window=50&write_coalescing_threshold=4096");
+      CHECK(spec.options.write_coalescing_window == std::chrono::microseconds(50));
+      CHECK(spec.options.write_coalescing_threshold == 4096);
+
+      spec = couchbase::core::utils::parse_connection_string(
+        "couchbase://127.0.0.1?write_coalescing_window=1ms");
+      CHECK(spec.options.write_coalescing_window == std::chrono::microseconds(1000));
+
+      spec = couchbase::core::utils::parse_connection_string(
+        "couchbase://127.0.0.1?enable_kv_concurrency_limit=true&kv_initial_concurrency_limit=64&"
+        "kv_max_concurrency_limit=128&kv_max_queued_requests=0");
+      CHECK(spec.options.enable_kv_concurrency_limit);
+      CHECK(spec.options.kv_initial_concurrency_limit == 64);
+      CHECK(spec.options.kv_max_concurrency_limit == 128);
+      CHECK(spec.options.kv_max_queued_requests == 0);
     }
   }
 
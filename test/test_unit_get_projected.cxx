@@ -0,0 +1,106 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "test_helper.hxx"
+
+#include "core/impl/subdoc/splice_projections.hxx"
+#include "core/operations/document_get_projected.hxx"
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+auto
+merge(const std::vector<std::string>& paths,
+      const std::vector<std::optional<std::string_view>>& fragments,
+      bool preserve_array_indexes = false) -> std::string
+{
+  auto [ec, document] = couchbase::core::operations::merge_projected_fragments(
+    paths, fragments, preserve_array_indexes);
+  REQUIRE_SUCCESS(ec);
+  return test::utils::to_string(document);
+}
+} // namespace
+
+TEST_CASE("unit: projected fragments are spliced into document", "[unit]")
+{
+  SECTION("nested objects and arrays")
+  {
+    auto document =
+      merge({ "name", "address.city", "address.zip", "tags[1]", "items[0].sku" },
+            { R"("Bob")", R"({"name":"Paris"})", std::nullopt, R"("b")", R"("x-1")" });
+    REQUIRE(document == R"({"address":{"city":{"name":"Paris"}},)"
+                        R"("items":[{"sku":"x-1"}],"name":"Bob","tags":["b"]})");
+  }
+
+  SECTION("array indexes are preserved on request")
+  {
+    REQUIRE(merge({ "tags[2]", "tags[0]" }, { R"("c")", R"("a")" }, true) ==
+            R"({"tags":["a",null,"c"]})");
+  }
+
+  SECTION("keys are escaped")
+  {
+    REQUIRE(merge({ R"(say "hi")" }, { "1" }) == R"({"say \"hi\"":1})");
+  }
+
+  SECTION("nothing found")
+  {
+    REQUIRE(merge({ "a", "b" }, { std::nullopt, std::nullopt }) == "{}");
+  }
+}
+
+TEST_CASE("unit: overlapping projections fall back to DOM", "[unit]")
+{
+  REQUIRE_FALSE(
+    couchbase::core::impl::subdoc::splice_projections({ "a", "a.b" }, { R"({"c":1})", "2" }, false)
+      .has_value());
+  REQUIRE(merge({ "a", "a.b" }, { R"({"c":1})", "2" }) == R"({"a":{"b":2,"c":1}})");
+}
+
+TEST_CASE("unit: wide projections are split into several lookups", "[unit]")
+{
+  couchbase::core::operations::get_projected_request request{
+    { "default", "_default", "_default", "wide" }
+  };
+  for (int i = 0; i < 40; ++i) {
+    request.projections.emplace_back("field_" + std::to_string(i));
+  }
+  request.with_expiry = true;
+  REQUIRE(request.needs_split());
+
+  auto chunks = request.split();
+  REQUIRE(chunks.size() == 3);
+  // the flags take one spec in each lookup, and the expiry one more in the first
+  REQUIRE(chunks[0].projections.size() == 14);
+  REQUIRE(chunks[0].with_expiry);
+  REQUIRE(chunks[1].projections.size() == 15);
+  REQUIRE_FALSE(chunks[1].with_expiry);
+  REQUIRE(chunks[2].projections.size() == 11);
+  REQUIRE(chunks[2].projections.back() == "field_39");
+  for (const auto& chunk : chunks) {
+    REQUIRE(chunk.raw_fragments);
+    REQUIRE_FALSE(chunk.needs_split());
+  }
+
+  request.projections.resize(14);
+  REQUIRE_FALSE(request.needs_split());
+}
@@ -0,0 +1,129 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "test_helper.hxx"
+
+#include "core/io/happy_eyeballs.hxx"
+
+#include <asio.hpp>
+
+#include <future>
+#include <thread>
+
+namespace
+{
+struct connect_result {
+  std::error_code ec{};
+  asio::ip::tcp::endpoint endpoint{};
+  bool is_open{ false };
+};
+
+auto
+race(asio::io_context& ctx,
+     std::vector<asio::ip::tcp::endpoint> endpoints,
+     bool cancel_first = false) -> connect_result
+{
+  auto connector = std::make_shared<couchbase::core::io::happy_eyeballs_connector>(
+    asio::make_strand(ctx), std::move(endpoints), std::chrono::milliseconds{ 50 });
+  if (cancel_first) {
+    connector->cancel();
+  }
+  std::promise<connect_result> barrier;
+  auto f = barrier.get_future();
+  connector->async_connect(
+    [&barrier](std::error_code ec, asio::ip::tcp::socket socket, asio::ip::tcp::endpoint endpoint) {
+      barrier.set_value({ ec, endpoint, socket.is_open() });
+    });
+  return f.get();
+}
+
+auto
+refused_endpoint(asio::io_context& ctx) -> asio::ip::tcp::endpoint
+{
+  asio::ip::tcp::acceptor acceptor{ ctx,
+                                    asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0) };
+  auto endpoint = acceptor.local_endpoint();
+  acceptor.close();
+  return endpoint;
+}
+} // namespace
+
+TEST_CASE("unit: happy eyeballs interleaves address families", "[unit]")
+{
+  const auto v6_a = asio::ip::tcp::endpoint(asio::ip::make_address("fd00::1"), 11210);
+  const auto v6_b = asio::ip::tcp::endpoint(asio::ip::make_address("fd00::2"), 11210);
+  const auto v6_c = asio::ip::tcp::endpoint(asio::ip::make_address("fd00::3"), 11210);
+  const auto v4_a = asio::ip::tcp::endpoint(asio::ip::make_address("10.0.0.1"), 11210);
+  const auto v4_b = asio::ip::tcp::endpoint(asio::ip::make_address("10.0.0.2"), 11210);
+
+  using couchbase::core::io::interleave_address_families;
+  REQUIRE(interleave_address_families({}).empty());
+  REQUIRE(interleave_address_families({ v4_a }) ==
+          std::vector<asio::ip::tcp::endpoint>{ v4_a });
+  REQUIRE(interleave_address_families({ v6_a, v6_b, v6_c, v4_a, v4_b }) ==
+          std::vector<asio::ip::tcp::endpoint>{ v6_a, v4_a, v6_b, v4_b, v6_c });
+  REQUIRE(interleave_address_families({ v4_a, v4_b, v6_a }) ==
+          std::vector<asio::ip::tcp::endpoint>{ v4_a, v6_a, v4_b });
+}
+
+TEST_CASE("unit: happy eyeballs connector picks the reachable endpoint", "[unit]")
+{
+  asio::io_context ctx{};
+  auto guard = asio::make_work_guard(ctx);
+  std::thread io_thread([&ctx]() {
+    ctx.run();
+  });
+
+  asio::ip::tcp::acceptor acceptor{ ctx,
+                                    asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0) };
+  const auto listening = acceptor.local_endpoint();
+  const auto refused = refused_endpoint(ctx);
+
+  SECTION("the first endpoint refuses connection")
+  {
+    auto result = race(ctx, { refused, listening });
+    REQUIRE_FALSE(result.ec);
+    REQUIRE(result.endpoint == listening);
+    REQUIRE(result.is_open);
+  }
+
+  SECTION("all endpoints refuse connection")
+  {
+    auto result = race(ctx, { refused, refused });
+    REQUIRE(result.ec == asio::error::connection_refused);
+    REQUIRE_FALSE(result.is_open);
+  }
+
+  SECTION("no endpoints")
+  {
+    auto result = race(ctx, {});
+    REQUIRE(result.ec == asio::error::host_not_found);
+  }
+
+  SECTION("cancelled race")
+  {
+    auto result = race(ctx, { listening }, true);
+    REQUIRE(result.ec == asio::error::operation_aborted);
+    REQUIRE_FALSE(result.is_open);
+  }
+
+  acceptor.close();
+  guard.reset();
+  ctx.stop();
+  io_thread.join();
+}
@@ -0,0 +1,69 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "test_helper.hxx"
+
+#include "core/utils/hedge_budget.hxx"
+
+TEST_CASE("unit: hedge budget allows configured share of reads", "[unit]")
+{
+  couchbase::core::utils::hedge_budget budget{ 0.1 };
+
+  // the very first read is allowed to hedge
+  budget.record_read();
+  REQUIRE(budget.try_acquire());
+  REQUIRE_FALSE(budget.try_acquire());
+
+  std::size_t hedges = 1;
+  for (int i = 1; i < 100; ++i) {
+    budget.record_read();
+    if (budget.try_acquire()) {
+      ++hedges;
+    }
+  }
+  REQUIRE(hedges >= 10);
+  REQUIRE(hedges <= 11);
+}
+
+TEST_CASE("unit: hedge budget recovers after spike", "[unit]")
+{
+  couchbase::core::utils::hedge_budget budget{ 0.05 };
+  for (std::uint64_t i = 0; i < couchbase::core::utils::hedge_budget::window; ++i) {
+    budget.record_read();
+    static_cast<void>(budget.try_acquire());
+  }
+  REQUIRE_FALSE(budget.try_acquire());
+
+  std::size_t hedges = 0;
+  for (std::uint64_t i = 0; i < 4 * couchbase::core::utils::hedge_budget::window; ++i) {
+    budget.record_read();
+    if (i % 100 == 0 && budget.try_acquire()) {
+      ++hedges;
+    }
+  }
+  REQUIRE(hedges > 0);
+}
+
+TEST_CASE("unit: hedge budget with zero ratio disables hedging", "[unit]")
+{
+  couchbase::core::utils::hedge_budget budget{ 0 };
+  for (int i = 0; i < 100; ++i) {
+    budget.record_read();
+  }
+  REQUIRE_FALSE(budget.try_acquire());
+}
@@ -20,8 +20,11 @@
 #include <catch2/catch_approx.hpp>
 
 #include <couchbase/codec/default_json_transcoder.hxx>
+#include <couchbase/codec/streaming_json_transcoder.hxx>
 
 #include <tao/json.hpp>
+#include <tao/json/binding.hpp>
+#include <tao/json/contrib/traits.hpp>
 
 using Catch::Approx;
 
@@ -224,3 +227,70 @@ TEST_CASE("unit: default_json_transcoder decodes user data", "[unit]")
   REQUIRE(value.at("full_name").get_string() == "Albert Einstein");
   REQUIRE(value.at("birth_year").get_unsigned() == 1879);
 }
+
+struct coordinates {
+  std::string city{};
+  double latitude{};
+  double longitude{};
+  std::vector<std::string> aliases{};
+};
+
+template<>
+struct tao::json::traits<coordinates>
+  : tao::json::binding::object<TAO_JSON_BIND_REQUIRED("city", &coordinates::city),
+                               TAO_JSON_BIND_REQUIRED("latitude", &coordinates::latitude),
+                               TAO_JSON_BIND_REQUIRED("longitude", &coordinates::longitude),
+                               TAO_JSON_BIND_REQUIRED("aliases", &coordinates::aliases)> {
+};
+
+TEST_CASE("unit: streaming_json_transcoder round-trips bound user data", "[unit]")
+{
+  coordinates ulm{ "Ulm", 48.4011, 9.9876, { "Ulm an der Donau", "\"Ulm\"\n" } };
+
+  auto encoded = couchbase::codec::streaming_json_transcoder::encode(ulm);
+  REQUIRE(encoded.flags == couchbase::codec::codec_flags::json_common_flags);
+  REQUIRE(couchbase::codec::default_json_transcoder::decode<tao::json::value>(encoded) ==
+          couchbase::codec::default_json_transcoder::decode<tao::json::value>(
+            couchbase::codec::default_json_transcoder::encode(ulm)));
+
+  auto decoded = couchbase::codec::streaming_json_transcoder::decode<coordinates>(encoded);
+  REQUIRE(decoded.city == ulm.city);
+  REQUIRE(Approx(decoded.latitude) == ulm.latitude);
+  REQUIRE(Approx(decoded.longitude) == ulm.longitude);
+  REQUIRE(decoded.aliases == ulm.aliases);
+}
+
+TEST_CASE("unit: streaming_json_transcoder falls back to values for unbound user data", "[unit]")
+{
+  profile albert{ "this_guy_again", "Albert Einstein", 1879 };
+
+  auto encoded = couchbase::codec::streaming_json_transcoder::encode(albert);
+  REQUIRE(encoded.data == couchbase::codec::default_json_transcoder::encode(albert).data);
+
+  auto decoded = couchbase::codec::streaming_json_transcoder::decode<profile>(encoded);
+  REQUIRE(decoded.username == "this_guy_again");
+  REQUIRE(decoded.full_name == "Albert Einstein");
+  REQUIRE(decoded.birth_year == 1879);
+
+  REQUIRE(couchbase::codec::streaming_json_transcoder::decode<std::string>(
+            couchbase::codec::streaming_json_transcoder::encode("hello, world")) ==
+          "hello, world");
+}
+
+TEST_CASE("unit: streaming_json_transcoder reports malformed documents", "[unit]")
+{
+  const std::string text{ R"({"city":"Ulm","latitude":"north"})" };
+  couchbase::codec::encoded_value encoded{
+    { reinterpret_cast<const std::byte*>(text.data()),
+      reinterpret_cast<const std::byte*>(text.data()) + text.size() },
+    couchbase::codec::codec_flags::json_common_flags,
+  };
+
+  try {
+    [[maybe_unused]] auto decoded =
+      couchbase::codec::streaming_json_transcoder::decode<coordinates>(encoded);
+    FAIL("decode must throw on malformed document");
+  } catch (const std::system_error& e) {
+    REQUIRE(e.code() == couchbase::errc::common::decoding_failure);
+  }
+}
@@ -0,0 +1,434 @@
+/*
+ *     Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/mcbp_command.hxx"
+#include "core/io/timer_wheel.hxx"
+#include "core/metrics/noop_meter.hxx"
+#include "core/metrics/operation_recorders.hxx"
+#include "core/operations/document_get.hxx"
+#include "core/operations/document_upsert.hxx"
+#include "core/tracing/noop_tracer.hxx"
+#include "core/utils/pooled_allocator.hxx"
+
+#include <asio/io_context.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+namespace
+{
+std::atomic_size_t allocations{ 0 };
+} // namespace
+
+auto
+operator new(std::size_t size) -> void*
+{
+  ++allocations;
+  if (auto* ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t /* size */) noexcept
+{
+  std::free(ptr);
+}
+
+namespace
+{
+struct fake_session_state {
+  std::optional<couchbase::core::topology::configuration> config{};
+  std::vector<couchbase::core::protocol::hello_feature> supported_features{
+    couchbase::core::protocol::hello_feature::collections,
+  };
+  std::uint32_t opaque{ 0 };
+  std::uint32_t in_flight_opaque{ 0 };
+  std::vector<std::byte> written{};
+  couchbase::core::io::command_handler handler{};
+  std::string address{ "127.0.0.1:11210" };
+  std::string id{ "fake-session" };
+};
+
+/**
+ * Implements the part of io::mcbp_session, used by mcbp_command. Written packets and their
+ * handlers are kept in the state, so that the test can complete them.
+ */
+class fake_session
+{
+public:
+  explicit fake_session(std::shared_ptr<fake_session_state> state)
+    : state_{ std::move(state) }
+  {
+  }
+
+  [[nodiscard]] auto log_prefix() const -> const std::string&
+  {
+    return state_->id;
+  }
+
+  [[nodiscard]] auto cancel(std::uint32_t /* opaque */,
+                            std::error_code /* ec */,
+                            couchbase::retry_reason /* reason */) -> bool
+  {
+    return false;
+  }
+
+  [[nodiscard]] auto is_stopped() const -> bool
+  {
+    return false;
+  }
+
+  [[nodiscard]] auto next_opaque() -> std::uint32_t
+  {
+    return ++state_->opaque;
+  }
+
+  [[nodiscard]] auto get_collection_uid(const std::string& /* collection_path */)
+    -> std::optional<std::uint32_t>
+  {
+    return 0;
+  }
+
+  void update_collection_uid(const std::string& /* path */,
+                             std::uint32_t /* uid */,
+                             std::uint64_t /* manifest_uid */)
+  {
+  }
+
+  void remove_collection_uid(const std::string& /* path */)
+  {
+  }
+
+  [[nodiscard]] auto context() const -> couchbase::core::mcbp_context
+  {
+    return { state_->config, state_->supported_features };
+  }
+
+  [[nodiscard]] auto supports_feature(couchbase::core::protocol::hello_feature feature) -> bool
+  {
+    return context().supports_feature(feature);
+  }
+
+  [[nodiscard]] auto id() const -> const std::string&
+  {
+    return state_->id;
+  }
+
+  [[nodiscard]] auto remote_address() const -> std::string
+  {
+    return state_->address;
+  }
+
+  [[nodiscard]] auto local_address() const -> std::string
+  {
+    return state_->address;
+  }
+
+  [[nodiscard]] auto bootstrap_address() const -> const std::string&
+  {
+    return state_->address;
+  }
+
+  void write_and_subscribe(std::uint32_t opaque,
+                           std::vector<std::byte>&& data,
+                           couchbase::core::io::command_handler&& handler,
+                           bool /* flush_now */ = true)
+  {
+    state_->in_flight_opaque = opaque;
+    state_->written = std::move(data);
+    state_->handler = std::move(handler);
+  }
+
+  void write_and_subscribe_limited(std::uint32_t opaque,
+                                   std::vector<std::byte>&& data,
+                                   couchbase::core::io::command_handler&& handler,
+                                   bool flush_now = true)
+  {
+    write_and_subscribe(opaque, std::move(data), std::move(handler), flush_now);
+  }
+
+  [[nodiscard]] auto decode_error_code(std::uint16_t /* code */)
+    -> std::optional<couchbase::core::key_value_error_map_info>
+  {
+    return {};
+  }
+
+  void record_latency(std::chrono::microseconds /* latency */)
+  {
+  }
+
+private:
+  std::shared_ptr<fake_session_state> state_;
+};
+
+/**
+ * Implements the part of the bucket, used by mcbp_command.
+ */
+class fake_manager
+{
+public:
+  explicit fake_manager(asio::io_context& ctx)
+    : timer_wheel_{ std::make_shared<couchbase::core::io::timer_wheel>(ctx) }
+  {
+  }
+
+  [[nodiscard]] auto log_prefix() const -> const std::string&
+  {
+    return log_prefix_;
+  }
+
+  [[nodiscard]] auto tracer() const -> std::shared_ptr<couchbase::tracing::request_tracer>
+  {
+    return tracer_;
+  }
+
+  [[nodiscard]] auto operation_recorders() const -> couchbase::core::metrics::operation_recorders&
+  {
+    return *recorders_;
+  }
+
+  [[nodiscard]] auto timer_wheel() const -> const std::shared_ptr<couchbase::core::io::timer_wheel>&
+  {
+    return timer_wheel_;
+  }
+
+  [[nodiscard]] auto default_retry_strategy() const -> std::shared_ptr<couchbase::retry_strategy>
+  {
+    return nullptr;
+  }
+
+  void fetch_config()
+  {
+  }
+
+  template<typename Command>
+  void map_and_send(std::shared_ptr<Command> /* cmd */)
+  {
+    FAIL("the command must not be re-dispatched");
+  }
+
+  template<typename Command>
+  void schedule_for_retry(std::shared_ptr<Command> /* cmd */,
+                          std::chrono::milliseconds /* duration */)
+  {
+    FAIL("the command must not be retried");
+  }
+
+private:
+  std::string log_prefix_{ "[fake]" };
+  std::shared_ptr<couchbase::tracing::request_tracer> tracer_{
+    std::make_shared<couchbase::core::tracing::noop_tracer>()
+  };
+  std::shared_ptr<couchbase::core::metrics::operation_recorders> recorders_{
+    std::make_shared<couchbase::core::metrics::operation_recorders>(
+      std::make_shared<couchbase::core::metrics::noop_meter>())
+  };
+  std::shared_ptr<couchbase::core::io::timer_wheel> timer_wheel_;
+};
+
+template<typename Request>
+using command_type = couchbase::core::operations::mcbp_command<fake_manager, Request, fake_session>;
+
+template<typename Request>
+auto
+allocations_per_command(Request prototype) -> std::size_t
+{
+  asio::io_context ctx{};
+  auto manager = std::make_shared<fake_manager>(ctx);
+
+  std::size_t total = 0;
+  for (int round = 0; round < 3; ++round) {
+    // the request is owned by the caller, the command path should only move it
+    Request request = prototype;
+    auto before = allocations.load();
+    {
+      auto cmd = std::allocate_shared<command_type<Request>>(
+        couchbase::core::utils::pooled_allocator<command_type<Request>>{},
+        manager,
+        std::move(request),
+        std::chrono::milliseconds(2'500));
+    }
+    // the first round warms up the pool
+    if (round > 0) {
+      total += allocations.load() - before;
+    }
+  }
+  return total;
+}
+
+/**
+ * Runs the request through start(), send_to() and the completion of the written packet, and
+ * returns the number of allocations of the last round.
+ */
+template<typename Request>
+auto
+allocations_per_operation(Request prototype) -> std::size_t
+{
+  asio::io_context ctx{};
+  auto manager = std::make_shared<fake_manager>(ctx);
+  auto state = std::make_shared<fake_session_state>();
+
+  std::size_t last_round = 0;
+  for (int round = 0; round < 3; ++round) {
+    Request request = prototype;
+    couchbase::core::io::mcbp_message response{};
+    response.header.magic =
+      static_cast<std::uint8_t>(couchbase::core::protocol::magic::client_response);
+    response.header.opcode =
+      static_cast<std::uint8_t>(Request::encoded_request_type::body_type::opcode);
+    std::error_code completed_with{ couchbase::errc::common::request_canceled };
+    bool completed = false;
+    std::size_t written = 0;
+
+    // the first round warms up the pool, the operation recorders and the timer of the wheel
+    auto before = allocations.load();
+    {
+      auto cmd = std::allocate_shared<command_type<Request>>(
+        couchbase::core::utils::pooled_allocator<command_type<Request>>{},
+        manager,
+        std::move(request),
+        std::chrono::milliseconds(2'500));
+      cmd->start([completed = &completed, completed_with = &completed_with](
+                   std::error_code ec, std::optional<couchbase::core::io::mcbp_message>&& msg) {
+        *completed = msg.has_value();
+        *completed_with = ec;
+      });
+      cmd->send_to(fake_session{ state });
+      written = state->written.size();
+
+      response.header.opaque = state->in_flight_opaque;
+      if (auto handler = std::move(state->handler); handler) {
+        handler({}, couchbase::retry_reason::do_not_retry, std::move(response), {});
+      }
+    }
+    last_round = allocations.load() - before;
+
+    REQUIRE(written > 0);
+    REQUIRE(completed);
+    REQUIRE_FALSE(completed_with);
+    REQUIRE(manager->timer_wheel()->size() == 0);
+    state->written = {};
+  }
+  return last_round;
+}
+} // namespace
+
+TEST_CASE("unit: pooled allocator reuses blocks on the same thread", "[unit]")
+{
+  struct payload {
+    std::array<std::byte, 512> data;
+  };
+
+  {
+    auto warm_up = std::allocate_shared<payload>(couchbase::core::utils::pooled_allocator<payload>{});
+  }
+  auto before = allocations.load();
+  for (int i = 0; i < 100; ++i) {
+    auto ptr = std::allocate_shared<payload>(couchbase::core::utils::pooled_allocator<payload>{});
+  }
+  REQUIRE(allocations.load() - before == 0);
+}
+
+TEST_CASE("unit: pooled allocator reuses blocks released on another thread", "[unit]")
+{
+  // own type, so that no other test has filled the pool yet
+  struct cross_thread_payload {
+    std::array<std::byte, 512> data;
+  };
+  using allocator_type = couchbase::core::utils::pooled_allocator<cross_thread_payload>;
+
+  // like a KV command: created by the caller, released by the IO thread
+  auto ptr = std::allocate_shared<cross_thread_payload>(allocator_type{});
+  std::thread io_thread([ptr = std::move(ptr)]() mutable {
+    ptr.reset();
+  });
+  io_thread.join();
+
+  auto before = allocations.load();
+  auto reused = std::allocate_shared<cross_thread_payload>(allocator_type{});
+  REQUIRE(allocations.load() - before == 0);
+
+  allocator_type allocator{};
+  auto* block = allocator.allocate(1);
+  std::thread([&allocator, block]() {
+    allocator.deallocate(block, 1);
+  }).join();
+  REQUIRE(allocator.allocate(1) == block);
+  allocator.deallocate(block, 1);
+}
+
+TEST_CASE("unit: KV commands are created without heap allocations", "[unit]")
+{
+  SECTION("get")
+  {
+    couchbase::core::operations::get_request request{
+      { "default", "_default", "_default", "a-key-long-enough-to-avoid-small-string-optimization" },
+    };
+    REQUIRE(allocations_per_command(request) == 0);
+  }
+
+  SECTION("upsert")
+  {
+    couchbase::core::operations::upsert_request request{
+      { "default", "_default", "_default", "a-key-long-enough-to-avoid-small-string-optimization" },
+      std::vector<std::byte>(4096, std::byte{ 'x' }),
+    };
+    REQUIRE(allocations_per_command(request) == 0);
+  }
+}
+
+TEST_CASE("unit: KV operations allocate only their packets and callbacks", "[unit]")
+{
+  /*
+   * Every operation allocates the packet, which is handed over to the session, the deadline
+   * handler in the timer wheel, and the response handler in the session. Both handlers hold a
+   * reference to the command, which does not fit into the small buffer of std::function in
+   * libstdc++ (other standard libraries store them inline).
+   */
+  constexpr std::size_t packet_and_callbacks = 3;
+
+  SECTION("get")
+  {
+    couchbase::core::operations::get_request request{
+      { "default", "_default", "_default", "a-key-long-enough-to-avoid-small-string-optimization" },
+    };
+    // the encoded key is kept in the request body until the command is released
+    REQUIRE(allocations_per_operation(request) <= packet_and_callbacks + 1);
+  }
+
+  SECTION("upsert")
+  {
+    couchbase::core::operations::upsert_request request{
+      { "default", "_default", "_default", "a-key-long-enough-to-avoid-small-string-optimization" },
+      std::vector<std::byte>(4096, std::byte{ 'x' }),
+    };
+    // the request body keeps the encoded key, extras and a copy of the value
+    REQUIRE(allocations_per_operation(request) <= packet_and_callbacks + 3);
+  }
+}
@@ -0,0 +1,106 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "test_helper.hxx"
+
+#include "core/impl/large_object.hxx"
+#include "core/utils/binary.hxx"
+
+#include <vector>
+
+namespace
+{
+auto
+make_data(std::size_t size, std::size_t offset = 0) -> std::vector<std::byte>
+{
+  std::vector<std::byte> data(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<std::byte>((offset + i) % 251);
+  }
+  return data;
+}
+} // namespace
+
+TEST_CASE("unit: large object chunker", "[unit]")
+{
+  SECTION("small writes are coalesced")
+  {
+    couchbase::core::impl::large_object_chunker chunker{ 10 };
+    REQUIRE(chunker.feed(make_data(4, 0)).empty());
+    REQUIRE(chunker.feed(make_data(4, 4)).empty());
+    auto chunks = chunker.feed(make_data(4, 8));
+    REQUIRE(chunks.size() == 1);
+    REQUIRE(chunks[0] == make_data(10));
+    auto tail = chunker.flush();
+    REQUIRE(tail.has_value());
+    REQUIRE(tail.value() == make_data(2, 10));
+    REQUIRE_FALSE(chunker.flush().has_value());
+    REQUIRE(chunker.total_size() == 12);
+  }
+
+  SECTION("large write is split")
+  {
+    couchbase::core::impl::large_object_chunker chunker{ 10 };
+    REQUIRE(chunker.feed(make_data(3)).empty());
+    auto chunks = chunker.feed(make_data(27, 3));
+    REQUIRE(chunks.size() == 3);
+    REQUIRE(chunks[0] == make_data(10, 0));
+    REQUIRE(chunks[1] == make_data(10, 10));
+    REQUIRE(chunks[2] == make_data(10, 20));
+    REQUIRE_FALSE(chunker.flush().has_value());
+  }
+
+  SECTION("aligned chunk is passed through")
+  {
+    couchbase::core::impl::large_object_chunker chunker{ 1024 };
+    auto data = make_data(1024);
+    const auto* storage = data.data();
+    auto chunks = chunker.feed(std::move(data));
+    REQUIRE(chunks.size() == 1);
+    REQUIRE(chunks[0].data() == storage);
+  }
+}
+
+TEST_CASE("unit: large object manifest", "[unit]")
+{
+  couchbase::core::impl::large_object_manifest manifest{ 2500, 1000, 3, "f00d" };
+  auto decoded = couchbase::core::impl::decode_large_object_manifest(
+    couchbase::core::impl::encode_large_object_manifest(manifest));
+  REQUIRE(decoded.has_value());
+  REQUIRE(decoded->size == 2500);
+  REQUIRE(decoded->chunk_size == 1000);
+  REQUIRE(decoded->number_of_chunks == 3);
+  REQUIRE(decoded->generation == "f00d");
+
+  using couchbase::core::utils::to_binary;
+  REQUIRE_FALSE(couchbase::core::impl::decode_large_object_manifest(to_binary("[]")));
+  REQUIRE_FALSE(couchbase::core::impl::decode_large_object_manifest(to_binary("{\"a\":")));
+  REQUIRE_FALSE(couchbase::core::impl::decode_large_object_manifest(
+    to_binary(R"({"size":2500,"chunk_size":1000,"chunks":2,"generation":"f00d"})")));
+  REQUIRE_FALSE(couchbase::core::impl::decode_large_object_manifest(
+    to_binary(R"({"size":0,"chunk_size":0,"chunks":0,"generation":"f00d"})")));
+  REQUIRE_FALSE(couchbase::core::impl::decode_large_object_manifest(
+    to_binary(R"({"size":0,"chunk_size":1000,"chunks":0})")));
+  REQUIRE_FALSE(couchbase::core::impl::decode_large_object_manifest(
+    to_binary(R"({"size":0,"chunk_size":1000,"chunks":0,"generation":""})")));
+  REQUIRE(couchbase::core::impl::decode_large_object_manifest(
+    to_binary(R"({"size":0,"chunk_size":1000,"chunks":0,"generation":"f00d"})")));
+
+  REQUIRE(couchbase::core::impl::large_object_chunk_key("blob", "f00d", 7) ==
+          "blob::chunk::f00d::7");
+}
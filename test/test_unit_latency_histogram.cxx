@@ -0,0 +1,89 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "test_helper.hxx"
+
+#include "core/utils/latency_histogram.hxx"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("unit: latency histogram percentiles", "[unit]")
+{
+  couchbase::core::utils::latency_histogram histogram{};
+  REQUIRE(histogram.count() == 0);
+  REQUIRE(histogram.percentile(0.95) == 0us);
+
+  for (int i = 0; i < 95; ++i) {
+    histogram.record(100us);
+  }
+  for (int i = 0; i < 5; ++i) {
+    histogram.record(10ms);
+  }
+  REQUIRE(histogram.count() == 100);
+
+  // the buckets are accurate within 25%
+  auto median = histogram.percentile(0.5);
+  REQUIRE(median >= 100us);
+  REQUIRE(median < 125us);
+
+  auto p95 = histogram.percentile(0.95);
+  REQUIRE(p95 >= 100us);
+  REQUIRE(p95 < 125us);
+
+  auto p99 = histogram.percentile(0.99);
+  REQUIRE(p99 >= 10ms);
+  REQUIRE(p99 < 12'500us);
+}
+
+TEST_CASE("unit: latency histogram forgets old samples", "[unit]")
+{
+  couchbase::core::utils::latency_histogram histogram{};
+  for (std::uint64_t i = 0; i < couchbase::core::utils::latency_histogram::decay_threshold; ++i) {
+    histogram.record(50ms);
+  }
+  REQUIRE(histogram.count() < couchbase::core::utils::latency_histogram::decay_threshold);
+
+  // the node got faster, and the new samples take over the percentiles
+  for (std::uint64_t i = 0; i < 4 * couchbase::core::utils::latency_histogram::decay_threshold;
+       ++i) {
+    histogram.record(1ms);
+  }
+  REQUIRE(histogram.percentile(0.9) < 2ms);
+}
+
+TEST_CASE("unit: latency histogram accepts samples from many threads", "[unit]")
+{
+  couchbase::core::utils::latency_histogram histogram{};
+  std::vector<std::thread> threads{};
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&histogram]() {
+      for (int i = 0; i < 1'000; ++i) {
+        histogram.record(std::chrono::microseconds{ i });
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  REQUIRE(histogram.count() > 0);
+  REQUIRE(histogram.percentile(1.0) < 1'250us);
+}
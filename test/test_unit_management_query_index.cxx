@@ -30,7 +30,7 @@
 couchbase::core::http_context
 make_http_context()
 {
-  static couchbase::core::topology::configuration config{};
+  static auto config = std::make_shared<const couchbase::core::topology::configuration>();
   static couchbase::core::query_cache query_cache{};
   static couchbase::core::cluster_options cluster_options{};
   std::string hostname{};
@@ -22,13 +22,14 @@
 #include "core/operations/document_query.hxx"
 
 couchbase::core::http_context
-make_http_context(couchbase::core::topology::configuration& config)
+make_http_context(const couchbase::core::topology::configuration& config)
 {
   static couchbase::core::query_cache query_cache{};
   static couchbase::core::cluster_options cluster_options{};
   std::string hostname{};
   std::uint16_t port{};
-  couchbase::core::http_context ctx{ config, cluster_options, query_cache, hostname, port };
+  auto snapshot = std::make_shared<const couchbase::core::topology::configuration>(config);
+  couchbase::core::http_context ctx{ snapshot, cluster_options, query_cache, hostname, port };
   return ctx;
 }
 
@@ -0,0 +1,174 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "test_helper.hxx"
+
+#include "core/transactions/staged_mutation.hxx"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using couchbase::core::transactions::staged_mutation;
+using couchbase::core::transactions::staged_mutation_queue;
+using couchbase::core::transactions::staged_mutation_type;
+using couchbase::core::transactions::transaction_get_result;
+
+namespace
+{
+void
+stage_documents(staged_mutation_queue& queue, std::size_t number_of_documents)
+{
+  for (std::size_t i = 0; i < number_of_documents; ++i) {
+    couchbase::core::document_id id{ "default", "_default", "_default", std::to_string(i) };
+    queue.add(staged_mutation(transaction_get_result(id, {}, 0, {}, {}),
+                              {},
+                              staged_mutation_type::REPLACE,
+                              "op" + std::to_string(i)));
+  }
+}
+
+struct unstaging_recorder {
+  using completion = couchbase::core::utils::movable_function<void(std::exception_ptr)>;
+
+  std::vector<std::string> started{};
+  std::vector<completion> pending{};
+  bool done{ false };
+  std::exception_ptr error{};
+
+  void unstage(staged_mutation_queue& queue, std::size_t window, const bool& expired)
+  {
+    queue.unstage(
+      window,
+      [this](staged_mutation& item, completion&& callback) {
+        started.push_back(item.operation_id());
+        pending.push_back(std::move(callback));
+      },
+      [&expired]() {
+        return expired;
+      },
+      std::make_exception_ptr(std::runtime_error("aborted")),
+      [this](std::exception_ptr exc) {
+        done = true;
+        error = std::move(exc);
+      });
+  }
+
+  auto error_message() const -> std::string
+  {
+    try {
+      std::rethrow_exception(error);
+    } catch (const std::exception& e) {
+      return e.what();
+    }
+  }
+};
+} // namespace
+
+TEST_CASE("unit: staged mutation queue keeps one mutation per document", "[unit]")
+{
+  staged_mutation_queue queue;
+  couchbase::core::document_id first{ "default", "_default", "_default", "first" };
+  couchbase::core::document_id second{ "default", "_default", "_default", "second" };
+
+  queue.add(staged_mutation(
+    transaction_get_result(first, {}, 0, {}, {}), {}, staged_mutation_type::INSERT, "op1"));
+  queue.add(staged_mutation(
+    transaction_get_result(second, {}, 0, {}, {}), {}, staged_mutation_type::REPLACE, "op2"));
+  queue.add(staged_mutation(
+    transaction_get_result(first, {}, 0, {}, {}), {}, staged_mutation_type::REMOVE, "op3"));
+
+  REQUIRE(queue.find_insert(first) == nullptr);
+  REQUIRE(queue.find_remove(first) != nullptr);
+  REQUIRE(queue.find_replace(second) != nullptr);
+
+  std::vector<std::string> order;
+  queue.iterate([&order](staged_mutation& item) {
+    order.push_back(item.operation_id());
+  });
+  REQUIRE(order == std::vector<std::string>{ "op2", "op3" });
+
+  queue.remove_any(second);
+  REQUIRE(queue.find_any(second) == nullptr);
+  queue.remove_any(first);
+  REQUIRE(queue.empty());
+}
+
+TEST_CASE("unit: staged mutation queue unstages within the window", "[unit]")
+{
+  staged_mutation_queue queue;
+  stage_documents(queue, 3);
+
+  bool expired = false;
+  unstaging_recorder recorder;
+  recorder.unstage(queue, 2, expired);
+  REQUIRE(recorder.started == std::vector<std::string>{ "op0", "op1" });
+
+  recorder.pending[1]({});
+  REQUIRE(recorder.started == std::vector<std::string>{ "op0", "op1", "op2" });
+  recorder.pending[0]({});
+  REQUIRE_FALSE(recorder.done);
+  recorder.pending[2]({});
+  REQUIRE(recorder.done);
+  REQUIRE_FALSE(recorder.error);
+}
+
+TEST_CASE("unit: staged mutation queue stops unstaging after a failure", "[unit]")
+{
+  staged_mutation_queue queue;
+  stage_documents(queue, 6);
+
+  bool expired = false;
+  unstaging_recorder recorder;
+  recorder.unstage(queue, 2, expired);
+  REQUIRE(recorder.started.size() == 2);
+
+  recorder.pending[0](std::make_exception_ptr(std::runtime_error("op0 failed")));
+  // no more mutations are started, but the one in flight has to complete first
+  REQUIRE(recorder.started.size() == 2);
+  REQUIRE_FALSE(recorder.done);
+
+  recorder.pending[1]({});
+  REQUIRE(recorder.started.size() == 2);
+  REQUIRE(recorder.done);
+  REQUIRE(recorder.error_message() == "op0 failed");
+}
+
+TEST_CASE("unit: staged mutation queue aborts unstaging once the transaction has expired",
+          "[unit]")
+{
+  staged_mutation_queue queue;
+  stage_documents(queue, 5);
+
+  bool expired = false;
+  unstaging_recorder recorder;
+  recorder.unstage(queue, 2, expired);
+  REQUIRE(recorder.started == std::vector<std::string>{ "op0", "op1" });
+
+  recorder.pending[0]({});
+  REQUIRE(recorder.started == std::vector<std::string>{ "op0", "op1", "op2" });
+
+  expired = true;
+  recorder.pending[1]({});
+  REQUIRE(recorder.started == std::vector<std::string>{ "op0", "op1", "op2" });
+  REQUIRE_FALSE(recorder.done);
+
+  recorder.pending[2]({});
+  REQUIRE(recorder.done);
+  REQUIRE(recorder.error_message() == "aborted");
+}
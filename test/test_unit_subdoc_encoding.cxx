@@ -0,0 +1,94 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "test_helper.hxx"
+
+#include "core/operations/document_lookup_in.hxx"
+#include "core/operations/document_mutate_in.hxx"
+
+#include <couchbase/lookup_in_specs.hxx>
+#include <couchbase/mutate_in_specs.hxx>
+
+#include <optional>
+#include <vector>
+
+namespace
+{
+auto
+bytes(std::initializer_list<std::uint8_t> values) -> std::vector<std::byte>
+{
+  std::vector<std::byte> result{};
+  result.reserve(values.size());
+  for (auto value : values) {
+    result.push_back(static_cast<std::byte>(value));
+  }
+  return result;
+}
+
+const couchbase::core::document_id id{ "default", "_default", "_default", "counters" };
+} // namespace
+
+TEST_CASE("unit: mutate_in specs are encoded into the request value", "[unit]")
+{
+  const std::optional<couchbase::core::topology::configuration> config{};
+  const std::vector<couchbase::core::protocol::hello_feature> features{};
+
+  const couchbase::mutate_in_specs specs{
+    couchbase::mutate_in_specs::upsert("a", 1),
+    couchbase::mutate_in_specs::remove("bb"),
+  };
+  couchbase::core::operations::mutate_in_request request{ id };
+  request.specs = specs.specs();
+
+  const auto expected = bytes({
+    0xc8, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 'a', '1', // upsert
+    0xc9, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 'b', 'b', // remove
+  });
+
+  couchbase::core::operations::mutate_in_request::encoded_request_type encoded{};
+  REQUIRE_FALSE(request.encode_to(encoded, { config, features }));
+  REQUIRE(encoded.body().value() == expected);
+
+  // retries encode the same request again, and the buffer is reused
+  const auto* data = encoded.body().value().data();
+  REQUIRE_FALSE(request.encode_to(encoded, { config, features }));
+  REQUIRE(encoded.body().value() == expected);
+  REQUIRE(encoded.body().value().data() == data);
+}
+
+TEST_CASE("unit: lookup_in specs are encoded into the request value", "[unit]")
+{
+  const std::optional<couchbase::core::topology::configuration> config{};
+  const std::vector<couchbase::core::protocol::hello_feature> features{};
+
+  const couchbase::lookup_in_specs specs{
+    couchbase::lookup_in_specs::get("a"),
+    couchbase::lookup_in_specs::exists("bb"),
+  };
+  couchbase::core::operations::lookup_in_request request{ id };
+  request.specs = specs.specs();
+
+  const auto expected = bytes({
+    0xc5, 0x00, 0x00, 0x01, 'a',      // get
+    0xc6, 0x00, 0x00, 0x02, 'b', 'b', // exists
+  });
+
+  couchbase::core::operations::lookup_in_request::encoded_request_type encoded{};
+  REQUIRE_FALSE(request.encode_to(encoded, { config, features }));
+  REQUIRE(encoded.body().value() == expected);
+}
@@ -0,0 +1,213 @@
+/*
+ *     Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include <catch2/matchers/catch_matchers_string.hpp>
+
+#include "core/metrics/exporting_meter.hxx"
+#include "core/tracing/exporting_tracer.hxx"
+#include "core/utils/json.hxx"
+#include "core/utils/mpmc_ring_buffer.hxx"
+#include "core/utils/telemetry_sink.hxx"
+
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+using couchbase::core::utils::telemetry_batch;
+using couchbase::core::utils::telemetry_format;
+using couchbase::core::utils::telemetry_signal;
+
+namespace
+{
+class capturing_sink : public couchbase::core::utils::telemetry_sink
+{
+public:
+  void write(telemetry_batch&& batch) override
+  {
+    batches.emplace_back(std::move(batch));
+  }
+
+  std::vector<telemetry_batch> batches{};
+};
+} // namespace
+
+TEST_CASE("unit: ring buffer drops items when full", "[unit]")
+{
+  couchbase::core::utils::mpmc_ring_buffer<std::string> buffer(3);
+  REQUIRE(buffer.capacity() == 4);
+  for (const auto* item : { "a", "b", "c", "d" }) {
+    REQUIRE(buffer.try_push(item));
+  }
+  REQUIRE_FALSE(buffer.try_push("e"));
+
+  std::string item;
+  REQUIRE(buffer.try_pop(item));
+  REQUIRE(item == "a");
+  REQUIRE(buffer.try_push("e"));
+
+  std::vector<std::string> rest;
+  while (buffer.try_pop(item)) {
+    rest.emplace_back(item);
+  }
+  REQUIRE(rest == std::vector<std::string>{ "b", "c", "d", "e" });
+}
+
+TEST_CASE("unit: exporting meter emits OTLP histograms", "[unit]")
+{
+  asio::io_context io{};
+  auto sink = std::make_shared<capturing_sink>();
+  couchbase::core::metrics::exporting_meter_options options{};
+  options.sink = sink;
+  options.bucket_boundaries_us = { 100, 1'000 };
+  auto meter = std::make_shared<couchbase::core::metrics::exporting_meter>(io, options);
+
+  auto recorder = meter->get_value_recorder("db.couchbase.operations",
+                                            { { "db.couchbase.service", "kv" },
+                                              { "db.operation", "get" } });
+  REQUIRE(recorder == meter->get_value_recorder("db.couchbase.operations",
+                                                { { "db.couchbase.service", "kv" },
+                                                  { "db.operation", "get" } }));
+  for (std::int64_t value : { 50, 100, 500, 5'000 }) {
+    recorder->record_value(value);
+  }
+  meter->flush();
+
+  REQUIRE(sink->batches.size() == 1);
+  REQUIRE(sink->batches[0].signal == telemetry_signal::metrics);
+  REQUIRE(sink->batches[0].format == telemetry_format::otlp_json);
+  auto payload = couchbase::core::utils::json::parse(sink->batches[0].payload);
+  const auto& metric = payload["resourceMetrics"][0]["scopeMetrics"][0]["metrics"][0];
+  REQUIRE(metric["name"].get_string() == "db.couchbase.operations");
+  const auto& point = metric["histogram"]["dataPoints"][0];
+  REQUIRE(point["count"].get_string() == "4");
+  REQUIRE(point["sum"].as<std::uint64_t>() == 5'650);
+  std::vector<std::string> bucket_counts;
+  for (const auto& count : point["bucketCounts"].get_array()) {
+    bucket_counts.emplace_back(count.get_string());
+  }
+  REQUIRE(bucket_counts == std::vector<std::string>{ "2", "1", "1" });
+}
+
+TEST_CASE("unit: exporting meter emits Prometheus text", "[unit]")
+{
+  asio::io_context io{};
+  auto sink = std::make_shared<capturing_sink>();
+  couchbase::core::metrics::exporting_meter_options options{};
+  options.sink = sink;
+  options.format = telemetry_format::prometheus_text;
+  options.bucket_boundaries_us = { 100, 1'000 };
+  auto meter = std::make_shared<couchbase::core::metrics::exporting_meter>(io, options);
+
+  auto recorder = meter->get_value_recorder("db.couchbase.operations", { { "db.operation", "get" } });
+  recorder->record_value(50);
+  recorder->record_value(500);
+  meter->flush();
+
+  REQUIRE(sink->batches.size() == 1);
+  const auto& text = sink->batches[0].payload;
+  REQUIRE_THAT(text, Catch::Matchers::ContainsSubstring("# TYPE db_couchbase_operations histogram"));
+  REQUIRE_THAT(text,
+               Catch::Matchers::ContainsSubstring(
+                 R"(db_couchbase_operations_bucket{db_operation="get",le="100"} 1)"));
+  REQUIRE_THAT(text,
+               Catch::Matchers::ContainsSubstring(
+                 R"(db_couchbase_operations_bucket{db_operation="get",le="+Inf"} 2)"));
+  REQUIRE_THAT(
+    text, Catch::Matchers::ContainsSubstring(R"(db_couchbase_operations_count{db_operation="get"} 2)"));
+}
+
+TEST_CASE("unit: exporting tracer batches spans", "[unit]")
+{
+  asio::io_context io{};
+  auto sink = std::make_shared<capturing_sink>();
+  couchbase::core::tracing::exporting_tracer_options options{};
+  options.sink = sink;
+  options.buffer_capacity = 4;
+  options.max_batch_size = 2;
+  auto tracer = std::make_shared<couchbase::core::tracing::exporting_tracer>(io, options);
+
+  auto parent = tracer->start_span("cb.upsert", nullptr);
+  auto child = tracer->start_span("cb.dispatch_to_server", parent);
+  child->add_tag("cb.operation_id", "0x2a");
+  child->add_tag("cb.server_duration", 42);
+  child->end();
+  parent->end();
+  parent->end();
+
+  for (int i = 0; i < 3; ++i) {
+    tracer->start_span("cb.get", nullptr)->end();
+  }
+  REQUIRE(tracer->dropped_spans() == 1);
+
+  tracer->flush();
+  REQUIRE(sink->batches.size() == 2);
+  REQUIRE(sink->batches[0].signal == telemetry_signal::traces);
+
+  auto payload = couchbase::core::utils::json::parse(sink->batches[0].payload);
+  const auto& spans = payload["resourceSpans"][0]["scopeSpans"][0]["spans"].get_array();
+  REQUIRE(spans.size() == 2);
+  const auto& child_span = spans[0];
+  const auto& parent_span = spans[1];
+  REQUIRE(child_span["name"].get_string() == "cb.dispatch_to_server");
+  REQUIRE(parent_span["name"].get_string() == "cb.upsert");
+  REQUIRE(child_span["traceId"] == parent_span["traceId"]);
+  REQUIRE(child_span["parentSpanId"] == parent_span["spanId"]);
+  REQUIRE(parent_span.find("parentSpanId") == nullptr);
+  REQUIRE(child_span["attributes"].get_array().size() == 2);
+}
+
+TEST_CASE("unit: file telemetry sink appends batches", "[unit]")
+{
+  auto path = std::filesystem::temp_directory_path() / "couchbase_telemetry_sink_test.txt";
+  std::filesystem::remove(path);
+  {
+    couchbase::core::utils::file_telemetry_sink sink(path.string());
+    sink.write({ telemetry_signal::metrics, telemetry_format::otlp_json, "first" });
+    sink.write({ telemetry_signal::traces, telemetry_format::otlp_json, "second" });
+  }
+  std::ifstream input(path);
+  std::string line;
+  std::vector<std::string> lines;
+  while (std::getline(input, line)) {
+    lines.emplace_back(line);
+  }
+  REQUIRE(lines == std::vector<std::string>{ "first", "second" });
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("unit: http telemetry sink gives up on unresponsive collector", "[unit]")
+{
+  asio::io_context io{};
+  // the connection lands in the backlog of the acceptor, but nobody ever reads the request
+  asio::ip::tcp::acceptor acceptor(io, { asio::ip::address_v4::loopback(), 0 });
+
+  couchbase::core::utils::http_telemetry_sink_options options{};
+  options.hostname = "127.0.0.1";
+  options.port = acceptor.local_endpoint().port();
+  options.timeout = std::chrono::milliseconds(100);
+  auto sink = std::make_shared<couchbase::core::utils::http_telemetry_sink>(io, options);
+  sink->write({ telemetry_signal::metrics, telemetry_format::otlp_json, "{}" });
+
+  auto start = std::chrono::steady_clock::now();
+  io.run_for(std::chrono::seconds(5));
+  REQUIRE(io.stopped());
+  REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+}
@@ -0,0 +1,126 @@
+/*
+ *     Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/timer_wheel.hxx"
+
+#include <asio/error.hpp>
+#include <asio/io_context.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using couchbase::core::io::timer_wheel;
+using couchbase::core::io::timer_wheel_entry;
+
+TEST_CASE("unit: timer wheel never fires handlers early", "[unit]")
+{
+  asio::io_context io{};
+  auto wheel = std::make_shared<timer_wheel>(io, std::chrono::milliseconds(1));
+
+  constexpr std::size_t number_of_entries{ 100 };
+  std::vector<std::unique_ptr<timer_wheel_entry>> entries;
+  std::size_t fired{ 0 };
+  std::size_t early{ 0 };
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < number_of_entries; ++i) {
+    // spread over more than one level of the wheel
+    auto expiry = start + std::chrono::milliseconds(i * 7);
+    auto& entry = entries.emplace_back(std::make_unique<timer_wheel_entry>());
+    wheel->schedule(*entry, expiry, [&fired, &early, expiry](std::error_code /* ec */) {
+      ++fired;
+      if (std::chrono::steady_clock::now() < expiry) {
+        ++early;
+      }
+    });
+  }
+  REQUIRE(wheel->size() == number_of_entries);
+
+  io.run();
+  REQUIRE(fired == number_of_entries);
+  REQUIRE(early == 0);
+  REQUIRE(wheel->size() == 0);
+}
+
+TEST_CASE("unit: timer wheel does not invoke cancelled handlers", "[unit]")
+{
+  asio::io_context io{};
+  auto wheel = std::make_shared<timer_wheel>(io, std::chrono::milliseconds(1));
+
+  timer_wheel_entry cancelled{};
+  timer_wheel_entry rescheduled{};
+  auto owner = std::make_shared<int>(42);
+  std::vector<std::string> events{};
+
+  wheel->schedule_after(
+    cancelled, std::chrono::milliseconds(10), [owner, &events](std::error_code /* ec */) {
+      events.emplace_back("cancelled");
+    });
+  wheel->schedule_after(
+    rescheduled, std::chrono::milliseconds(10), [&events](std::error_code /* ec */) {
+      events.emplace_back("first");
+    });
+  wheel->schedule_after(
+    rescheduled, std::chrono::milliseconds(20), [&events](std::error_code /* ec */) {
+      events.emplace_back("second");
+    });
+  REQUIRE(owner.use_count() == 2);
+  REQUIRE(wheel->size() == 2);
+
+  REQUIRE(wheel->cancel(cancelled));
+  REQUIRE_FALSE(wheel->cancel(cancelled));
+  // the handler has been released, so it does not keep the owner alive
+  REQUIRE(owner.use_count() == 1);
+
+  io.run();
+  REQUIRE(events == std::vector<std::string>{ "second" });
+  REQUIRE_FALSE(wheel->cancel(rescheduled));
+}
+
+TEST_CASE("unit: timer wheel expires all pending handlers with the given error", "[unit]")
+{
+  asio::io_context io{};
+  auto wheel = std::make_shared<timer_wheel>(io, std::chrono::milliseconds(1));
+
+  timer_wheel_entry near{};
+  timer_wheel_entry far{};
+  auto owner = std::make_shared<int>(42);
+  std::vector<std::error_code> errors{};
+
+  wheel->schedule_after(near, std::chrono::milliseconds(10), [owner, &errors](std::error_code ec) {
+    errors.emplace_back(ec);
+  });
+  wheel->schedule_after(far, std::chrono::hours(1), [owner, &errors](std::error_code ec) {
+    errors.emplace_back(ec);
+  });
+  REQUIRE(owner.use_count() == 3);
+
+  wheel->expire_all(asio::error::operation_aborted);
+  REQUIRE(wheel->size() == 0);
+  // the handlers have been invoked and released, so they do not keep the owner alive
+  REQUIRE(owner.use_count() == 1);
+  REQUIRE(errors == std::vector<std::error_code>{ asio::error::operation_aborted,
+                                                  asio::error::operation_aborted });
+  REQUIRE_FALSE(wheel->cancel(near));
+  REQUIRE_FALSE(wheel->cancel(far));
+
+  io.run();
+  REQUIRE(errors.size() == 2);
+}
@@ -0,0 +1,206 @@
+/*
+ *     Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/streams.hxx"
+#include "core/io/tls_session_cache.hxx"
+
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+#include <future>
+#include <thread>
+
+namespace
+{
+/*
+ * Minimal TLS server, which answers every byte with the same byte. The certificate is generated
+ * on the fly, the client does not verify it.
+ */
+class tls_stub_server
+{
+public:
+  explicit tls_stub_server(asio::io_context& ctx)
+    : ctx_{ ctx }
+    , acceptor_{ ctx, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0) }
+  {
+    auto* key = generate_key();
+    auto* certificate = generate_certificate(key);
+    SSL_CTX_use_certificate(tls_.native_handle(), certificate);
+    SSL_CTX_use_PrivateKey(tls_.native_handle(), key);
+    X509_free(certificate);
+    EVP_PKEY_free(key);
+  }
+
+  [[nodiscard]] auto endpoint() const -> asio::ip::tcp::endpoint
+  {
+    return acceptor_.local_endpoint();
+  }
+
+  void accept()
+  {
+    acceptor_.async_accept([this](std::error_code ec, asio::ip::tcp::socket socket) {
+      if (ec) {
+        return;
+      }
+      auto stream =
+        std::make_shared<asio::ssl::stream<asio::ip::tcp::socket>>(std::move(socket), tls_);
+      stream->async_handshake(asio::ssl::stream_base::server, [stream](std::error_code e) {
+        if (!e) {
+          echo(stream);
+        }
+      });
+      accept();
+    });
+  }
+
+  void stop()
+  {
+    asio::error_code ec{};
+    acceptor_.close(ec);
+  }
+
+private:
+  static void echo(std::shared_ptr<asio::ssl::stream<asio::ip::tcp::socket>> stream)
+  {
+    auto buffer = std::make_shared<std::array<char, 1>>();
+    stream->async_read_some(asio::buffer(*buffer),
+                            [stream, buffer](std::error_code ec, std::size_t bytes_read) {
+                              if (ec || bytes_read == 0) {
+                                return;
+                              }
+                              asio::async_write(*stream,
+                                                asio::buffer(*buffer),
+                                                [stream](std::error_code e, std::size_t) {
+                                                  if (!e) {
+                                                    echo(stream);
+                                                  }
+                                                });
+                            });
+  }
+
+  static auto generate_key() -> EVP_PKEY*
+  {
+    EVP_PKEY* key{ nullptr };
+    auto* key_ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+    EVP_PKEY_keygen_init(key_ctx);
+    EVP_PKEY_CTX_set_ec_paramgen_curve_nid(key_ctx, NID_X9_62_prime256v1);
+    EVP_PKEY_keygen(key_ctx, &key);
+    EVP_PKEY_CTX_free(key_ctx);
+    return key;
+  }
+
+  static auto generate_certificate(EVP_PKEY* key) -> X509*
+  {
+    auto* certificate = X509_new();
+    X509_set_version(certificate, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1);
+    X509_gmtime_adj(X509_getm_notBefore(certificate), 0);
+    X509_gmtime_adj(X509_getm_notAfter(certificate), 3600);
+    X509_set_pubkey(certificate, key);
+    auto* name = X509_get_subject_name(certificate);
+    X509_NAME_add_entry_by_txt(
+      name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+    X509_set_issuer_name(certificate, name);
+    X509_sign(certificate, key, EVP_sha256());
+    return certificate;
+  }
+
+  asio::io_context& ctx_;
+  asio::ssl::context tls_{ asio::ssl::context::tls_server };
+  asio::ip::tcp::acceptor acceptor_;
+};
+
+/*
+ * Connects to the server and exchanges one byte, so that the client receives session ticket,
+ * which TLS 1.3 servers send after the handshake.
+ */
+void
+connect_and_ping(asio::io_context& ctx,
+                 asio::ssl::context& tls,
+                 const asio::ip::tcp::endpoint& endpoint)
+{
+  couchbase::core::io::tls_stream_impl stream(ctx, tls);
+  std::array<char, 1> request{ 'x' };
+  std::array<char, 1> response{};
+  std::promise<std::error_code> barrier;
+  auto done = barrier.get_future();
+  stream.async_connect(endpoint, [&](std::error_code ec) {
+    if (ec) {
+      return barrier.set_value(ec);
+    }
+    std::vector<asio::const_buffer> buffers{ asio::buffer(request) };
+    stream.async_write(buffers, [&](std::error_code write_ec, std::size_t) {
+      if (write_ec) {
+        return barrier.set_value(write_ec);
+      }
+      stream.async_read_some(asio::buffer(response), [&](std::error_code read_ec, std::size_t) {
+        barrier.set_value(read_ec);
+      });
+    });
+  });
+  REQUIRE_FALSE(done.get());
+  REQUIRE(response == request);
+
+  std::promise<void> closed;
+  stream.close([&](std::error_code) {
+    closed.set_value();
+  });
+  closed.get_future().get();
+}
+} // namespace
+
+TEST_CASE("unit: TLS sessions are resumed on reconnect", "[unit]")
+{
+  asio::io_context ctx{};
+  auto guard = asio::make_work_guard(ctx);
+  std::thread io_thread([&ctx]() {
+    ctx.run();
+  });
+
+  tls_stub_server server(ctx);
+  server.accept();
+
+  asio::ssl::context client_tls{ asio::ssl::context::tls_client };
+  client_tls.set_verify_mode(asio::ssl::verify_none);
+  couchbase::core::io::tls_session_cache cache{};
+  cache.install(client_tls.native_handle());
+  REQUIRE(couchbase::core::io::tls_session_cache::from_context(client_tls.native_handle()) ==
+          &cache);
+
+  connect_and_ping(ctx, client_tls, server.endpoint());
+  REQUIRE(cache.full_handshakes() == 1);
+  REQUIRE(cache.resumed_handshakes() == 0);
+  REQUIRE(cache.size() == 1);
+
+  connect_and_ping(ctx, client_tls, server.endpoint());
+  connect_and_ping(ctx, client_tls, server.endpoint());
+  REQUIRE(cache.full_handshakes() == 1);
+  REQUIRE(cache.resumed_handshakes() == 2);
+
+  server.stop();
+  guard.reset();
+  ctx.stop();
+  io_thread.join();
+}
+
+TEST_CASE("unit: TLS contexts without session cache use full handshakes", "[unit]")
+{
+  asio::ssl::context client_tls{ asio::ssl::context::tls_client };
+  REQUIRE(couchbase::core::io::tls_session_cache::from_context(client_tls.native_handle()) ==
+          nullptr);
+}
@@ -0,0 +1,126 @@
+/*
+ *     Copyright 2021-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/transactions/internal/atr_lookup_coalescer.hxx"
+
+#include <couchbase/error_codes.hxx>
+
+#include <memory>
+#include <vector>
+
+using couchbase::core::transactions::active_transaction_record;
+using couchbase::core::transactions::atr_lookup_coalescer;
+
+static const couchbase::core::document_id ATR_ID{ "default", "_default", "_default", "_txn:atr-1" };
+
+namespace
+{
+struct lookup_recorder {
+  std::size_t fetches{ 0 };
+  std::vector<atr_lookup_coalescer::callback> pending{};
+  std::vector<std::uint64_t> delivered{};
+  std::vector<std::error_code> errors{};
+
+  void get_atr(atr_lookup_coalescer& lookups)
+  {
+    lookups.get_atr(
+      ATR_ID,
+      [this](atr_lookup_coalescer::callback&& on_response) {
+        ++fetches;
+        pending.push_back(std::move(on_response));
+      },
+      [this](std::error_code ec, std::optional<active_transaction_record> atr) {
+        if (ec) {
+          errors.push_back(ec);
+          return;
+        }
+        delivered.push_back(atr->cas());
+      });
+  }
+};
+} // namespace
+
+TEST_CASE("transactions: concurrent ATR lookups share one request", "[unit]")
+{
+  atr_lookup_coalescer lookups;
+  lookup_recorder recorder;
+  recorder.get_atr(lookups);
+  recorder.get_atr(lookups);
+  recorder.get_atr(lookups);
+  REQUIRE(recorder.fetches == 1);
+  REQUIRE(lookups.stats().in_flight == 1);
+
+  recorder.pending[0]({}, active_transaction_record(ATR_ID, 42, {}));
+  REQUIRE(recorder.delivered == std::vector<std::uint64_t>{ 42, 42, 42 });
+
+  auto stats = lookups.stats();
+  REQUIRE(stats.lookups == 3);
+  REQUIRE(stats.coalesced == 2);
+  REQUIRE(stats.in_flight == 0);
+}
+
+TEST_CASE("transactions: completed ATR lookups are not reused", "[unit]")
+{
+  atr_lookup_coalescer lookups;
+  lookup_recorder recorder;
+  recorder.get_atr(lookups);
+  recorder.pending[0]({}, active_transaction_record(ATR_ID, 42, {}));
+
+  // the attempt might have moved on since, so the ATR has to be read again
+  recorder.get_atr(lookups);
+  REQUIRE(recorder.fetches == 2);
+  recorder.pending[1]({}, active_transaction_record(ATR_ID, 43, {}));
+  REQUIRE(recorder.delivered == std::vector<std::uint64_t>{ 42, 43 });
+  REQUIRE(lookups.stats().coalesced == 0);
+}
+
+TEST_CASE("transactions: failed ATR lookup is reported to every waiting read", "[unit]")
+{
+  atr_lookup_coalescer lookups;
+  lookup_recorder recorder;
+  recorder.get_atr(lookups);
+  recorder.get_atr(lookups);
+  recorder.pending[0](couchbase::errc::common::unambiguous_timeout, std::nullopt);
+  REQUIRE(recorder.errors.size() == 2);
+  REQUIRE(recorder.delivered.empty());
+  REQUIRE(lookups.stats().in_flight == 0);
+}
+
+TEST_CASE("transactions: ATR lookups are reported to the meter by outcome", "[unit]")
+{
+  struct counting_recorder : public couchbase::metrics::value_recorder {
+    std::size_t count{ 0 };
+
+    void record_value(std::int64_t /* value */) override
+    {
+      ++count;
+    }
+  };
+
+  auto fetched = std::make_shared<counting_recorder>();
+  auto coalesced = std::make_shared<counting_recorder>();
+  atr_lookup_coalescer lookups;
+  lookups.set_recorders(fetched, coalesced);
+  lookup_recorder recorder;
+  recorder.get_atr(lookups);
+  recorder.get_atr(lookups);
+  recorder.get_atr(lookups);
+  recorder.pending[0]({}, active_transaction_record(ATR_ID, 42, {}));
+  REQUIRE(fetched->count == 1);
+  REQUIRE(coalesced->count == 2);
+}
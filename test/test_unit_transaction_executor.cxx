@@ -0,0 +1,213 @@
+/*
+ *     Copyright 2021-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/transactions/internal/transaction_executor.hxx"
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <thread>
+
+using couchbase::core::transactions::transaction_executor;
+
+namespace
+{
+auto
+not_canceled()
+{
+  return []() {
+    FAIL("the task must not be canceled");
+  };
+}
+} // namespace
+
+TEST_CASE("transactions: executor runs submitted tasks", "[unit]")
+{
+  transaction_executor executor(4, 100);
+  std::atomic<int> counter{ 0 };
+  std::promise<void> done;
+  for (int i = 0; i < 50; ++i) {
+    REQUIRE(executor.submit(
+      [&counter, &done]() {
+        if (++counter == 50) {
+          done.set_value();
+        }
+      },
+      not_canceled()));
+  }
+  done.get_future().wait();
+  executor.close();
+  REQUIRE(counter == 50);
+  auto stats = executor.stats();
+  REQUIRE(stats.submitted == 50);
+  REQUIRE(stats.completed == 50);
+  REQUIRE(stats.rejected == 0);
+  REQUIRE(stats.canceled == 0);
+  REQUIRE(stats.workers == 0);
+  REQUIRE(stats.queued == 0);
+}
+
+TEST_CASE("transactions: executor bounds number of workers", "[unit]")
+{
+  transaction_executor executor(2, 100);
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::atomic<int> running{ 0 };
+  std::atomic<int> peak{ 0 };
+  std::atomic<int> finished{ 0 };
+  std::promise<void> done;
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(executor.submit(
+      [released, &running, &peak, &finished, &done]() {
+        auto now = ++running;
+        auto prev = peak.load();
+        while (now > prev && !peak.compare_exchange_weak(prev, now)) {
+        }
+        released.wait();
+        --running;
+        if (++finished == 10) {
+          done.set_value();
+        }
+      },
+      not_canceled()));
+  }
+  REQUIRE(executor.stats().workers <= 2);
+  release.set_value();
+  done.get_future().wait();
+  executor.close();
+  REQUIRE(peak <= 2);
+  REQUIRE(executor.stats().completed == 10);
+}
+
+TEST_CASE("transactions: executor rejects tasks when queue is full", "[unit]")
+{
+  transaction_executor executor(1, 2);
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::promise<void> started;
+  REQUIRE(executor.submit(
+    [released, &started]() {
+      started.set_value();
+      released.wait();
+    },
+    not_canceled()));
+  started.get_future().wait();
+  std::promise<void> first_queued;
+  std::promise<void> second_queued;
+  REQUIRE(executor.submit(
+    [&first_queued]() {
+      first_queued.set_value();
+    },
+    not_canceled()));
+  REQUIRE(executor.submit(
+    [&second_queued]() {
+      second_queued.set_value();
+    },
+    not_canceled()));
+  REQUIRE_FALSE(executor.submit([]() {}, not_canceled()));
+  auto stats = executor.stats();
+  REQUIRE(stats.running == 1);
+  REQUIRE(stats.queued == 2);
+  REQUIRE(stats.peak_queued == 2);
+  REQUIRE(stats.rejected == 1);
+  release.set_value();
+  first_queued.get_future().wait();
+  second_queued.get_future().wait();
+  executor.close();
+  REQUIRE_FALSE(executor.submit([]() {}, not_canceled()));
+  REQUIRE(executor.stats().completed == 3);
+}
+
+TEST_CASE("transactions: executor cancels queued tasks on close", "[unit]")
+{
+  transaction_executor executor(1, 10);
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::promise<void> started;
+  REQUIRE(executor.submit(
+    [released, &started]() {
+      started.set_value();
+      released.wait();
+    },
+    not_canceled()));
+  started.get_future().wait();
+
+  std::atomic<int> executed{ 0 };
+  std::atomic<int> canceled{ 0 };
+  for (int i = 0; i < 3; ++i) {
+    REQUIRE(executor.submit(
+      [&executed]() {
+        ++executed;
+      },
+      [&canceled]() {
+        ++canceled;
+      }));
+  }
+
+  // queued tasks are canceled before close() waits for the running one
+  auto closing = std::async(std::launch::async, [&executor]() {
+    executor.close();
+  });
+  while (canceled < 3) {
+    std::this_thread::yield();
+  }
+  release.set_value();
+  closing.get();
+
+  REQUIRE(executed == 0);
+  auto stats = executor.stats();
+  REQUIRE(stats.completed == 1);
+  REQUIRE(stats.canceled == 3);
+  REQUIRE(stats.queued == 0);
+}
+
+TEST_CASE("transactions: executor runs nested tasks inline", "[unit]")
+{
+  transaction_executor executor(1, 0);
+  std::promise<bool> outer;
+  REQUIRE(executor.submit(
+    [&executor, &outer]() {
+      // with one worker and no queue, waiting for a queued task would never finish
+      std::promise<void> inner;
+      auto submitted = executor.submit(
+        [&inner]() {
+          inner.set_value();
+        },
+        not_canceled());
+      inner.get_future().wait();
+      outer.set_value(submitted);
+    },
+    not_canceled()));
+  REQUIRE(outer.get_future().get());
+  executor.close();
+  REQUIRE(executor.stats().completed == 2);
+}
+
+TEST_CASE("transactions: executor can be destroyed from within a task", "[unit]")
+{
+  auto executor = std::make_unique<transaction_executor>(2, 10);
+  std::promise<void> destroyed;
+  REQUIRE(executor->submit(
+    [&executor, &destroyed]() {
+      executor.reset();
+      destroyed.set_value();
+    },
+    not_canceled()));
+  destroyed.get_future().wait();
+  REQUIRE(executor == nullptr);
+}
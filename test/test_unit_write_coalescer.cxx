@@ -0,0 +1,123 @@
+/*
+ *     Copyright 2024-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/write_coalescer.hxx"
+
+#include <asio/executor_work_guard.hpp>
+#include <asio/io_context.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using couchbase::core::io::write_coalescer;
+
+namespace
+{
+/**
+ * Imitates the output buffer of the session: flush() requests the write, and the write takes
+ * everything submitted so far as one batch.
+ */
+struct buffered_writer {
+  std::shared_ptr<write_coalescer> coalescer;
+  std::chrono::microseconds window{ std::chrono::milliseconds(20) };
+  std::mutex mutex{};
+  std::vector<int> buffer{};
+  std::vector<std::size_t> writes{};
+
+  void write_and_flush(int packet)
+  {
+    {
+      std::scoped_lock lock(mutex);
+      buffer.emplace_back(packet);
+    }
+    coalescer->schedule(window, [this]() {
+      std::scoped_lock lock(mutex);
+      writes.emplace_back(buffer.size());
+      buffer.clear();
+    });
+  }
+};
+} // namespace
+
+TEST_CASE("unit: write coalescer merges writes within the window", "[unit]")
+{
+  asio::io_context io{};
+  buffered_writer writer{ std::make_shared<write_coalescer>(io) };
+
+  auto start = std::chrono::steady_clock::now();
+  for (int packet = 0; packet < 5; ++packet) {
+    writer.write_and_flush(packet);
+  }
+  REQUIRE(writer.coalescer->is_scheduled());
+
+  io.run();
+  REQUIRE(std::chrono::steady_clock::now() - start >= writer.window);
+  REQUIRE(writer.writes == std::vector<std::size_t>{ 5 });
+  REQUIRE_FALSE(writer.coalescer->is_scheduled());
+
+  // the window has closed, so the next write opens another one
+  writer.write_and_flush(5);
+  io.restart();
+  io.run();
+  REQUIRE(writer.writes == std::vector<std::size_t>{ 5, 1 });
+}
+
+TEST_CASE("unit: write coalescer merges writes from several threads", "[unit]")
+{
+  asio::io_context io{};
+  buffered_writer writer{ std::make_shared<write_coalescer>(io) };
+  writer.window = std::chrono::milliseconds(200);
+
+  std::vector<std::thread> threads{};
+  for (int thread = 0; thread < 4; ++thread) {
+    threads.emplace_back([&writer, thread]() {
+      for (int packet = 0; packet < 10; ++packet) {
+        writer.write_and_flush(thread * 10 + packet);
+      }
+    });
+  }
+  auto guard = asio::make_work_guard(io);
+  std::thread io_thread([&io]() {
+    io.run();
+  });
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  guard.reset();
+  io_thread.join();
+
+  REQUIRE(writer.writes == std::vector<std::size_t>{ 40 });
+}
+
+TEST_CASE("unit: write coalescer does not flush after cancel", "[unit]")
+{
+  asio::io_context io{};
+  buffered_writer writer{ std::make_shared<write_coalescer>(io) };
+
+  writer.write_and_flush(0);
+  writer.coalescer->cancel();
+  writer.write_and_flush(1);
+
+  io.run();
+  REQUIRE(writer.writes.empty());
+  REQUIRE(writer.buffer.size() == 2);
+}